@@ -22,10 +22,7 @@
 #include "BenchmarkUtils.h"
 
 #include "AABBTree.h"
-#include "IO/DiskIO.h"
-#include "IO/File.h"
-#include "IO/Path.h"
-#include "IO/Reader.h"
+#include "IO/MapGenerator.h"
 #include "IO/TestParserStatus.h"
 #include "IO/WorldReader.h"
 #include "Model/Brush.h"
@@ -62,23 +59,24 @@ namespace TrenchBroom {
     };
 
     TEST(AABBTreeBenchmark, benchBuildTree) {
-
-        const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("fixture/benchmark/AABBTree/ne_ruins.map");
-        const auto file = IO::Disk::openFile(mapPath);
-        auto fileReader = file->reader().buffer();
+        const auto mapText = IO::generateMap(IO::MapGeneratorOptions());
 
         IO::TestParserStatus status;
-        IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+        IO::WorldReader worldReader(mapText);
 
         const vm::bbox3 worldBounds(8192.0);
         auto world = worldReader.read(Model::MapFormat::Standard, worldBounds, status);
 
         std::vector<AABB> trees(100);
-        timeLambda([&world, &trees]() {
+        runBenchmark("AABBTree: add objects to 100 trees", [&trees]() {
+            for (auto& tree : trees) {
+                tree.clear();
+            }
+        }, [&world, &trees]() {
             for (auto& tree : trees) {
                 TreeBuilder builder(tree);
                 world->acceptAndRecurse(builder);
             }
-        }, "Add objects to AABB tree");
+        });
     }
 }
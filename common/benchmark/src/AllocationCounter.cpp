@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace TrenchBroom {
+    static std::atomic<size_t> s_allocationCount(0);
+    static std::atomic<size_t> s_allocatedBytes(0);
+
+    static void* countedAlloc(const std::size_t size) {
+        s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    AllocationCounter::Snapshot AllocationCounter::snapshot() {
+        return { s_allocationCount.load(std::memory_order_relaxed), s_allocatedBytes.load(std::memory_order_relaxed) };
+    }
+}
+
+// Replacements for the global allocation functions. The aligned overloads are left alone, they are rare enough
+// not to matter for the counts and are paired with their own default deallocation functions.
+
+void* operator new(const std::size_t size) {
+    if (void* result = TrenchBroom::countedAlloc(size)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+    if (void* result = TrenchBroom::countedAlloc(size)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    return TrenchBroom::countedAlloc(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+    return TrenchBroom::countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::size_t /* size */) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::size_t /* size */) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
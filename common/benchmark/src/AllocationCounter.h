@@ -0,0 +1,41 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_AllocationCounter
+#define TrenchBroom_AllocationCounter
+
+#include <cstddef>
+
+namespace TrenchBroom {
+    /**
+     * Counts the calls to the global operator new made by the benchmark executable. The counters are process wide and
+     * are never reset, so callers should take a snapshot before and after the code under measurement and subtract.
+     */
+    class AllocationCounter {
+    public:
+        struct Snapshot {
+            size_t allocations;
+            size_t bytes;
+        };
+
+        static Snapshot snapshot();
+    };
+}
+
+#endif /* defined(TrenchBroom_AllocationCounter) */
@@ -0,0 +1,175 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include "Assets/EntityModel.h"
+#include "Renderer/IndexRangeMap.h"
+#include "Renderer/PrimType.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/constants.h>
+#include <vecmath/scalar.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        struct ModelSize {
+            std::string name;
+            size_t frameCount;
+            size_t rings;
+            size_t segments;
+        };
+
+        // the stock Quake models cannot be distributed, so these models only match their frame and triangle counts
+        // roughly: from small items to large monsters with a few hundred triangles and a couple of hundred frames
+        static const std::vector<ModelSize> ModelSizes = {
+            { "item", 1u, 6u, 8u },
+            { "weapon", 10u, 8u, 12u },
+            { "soldier", 120u, 12u, 16u },
+            { "shambler", 100u, 16u, 20u },
+            { "player", 200u, 16u, 24u }
+        };
+
+        static constexpr size_t NumModelCopies = 10u;
+
+        /**
+         * Creates a sphere with the given number of rings and segments, its radius varies with the frame.
+         */
+        static std::vector<EntityModelVertex> createFrameVertices(const ModelSize& size, const size_t frameIndex) {
+            const auto radius = 16.0f + static_cast<float>(frameIndex % 8u);
+            const auto position = [&](const size_t ring, const size_t segment) {
+                const auto theta = vm::Cf::pi() * static_cast<float>(ring) / static_cast<float>(size.rings);
+                const auto phi = 2.0f * vm::Cf::pi() * static_cast<float>(segment) / static_cast<float>(size.segments);
+                return vm::vec3f(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)) * radius;
+            };
+
+            std::vector<EntityModelVertex> result;
+            result.reserve(size.rings * size.segments * 6u);
+            for (size_t ring = 0; ring < size.rings; ++ring) {
+                for (size_t segment = 0; segment < size.segments; ++segment) {
+                    const auto p1 = position(ring, segment);
+                    const auto p2 = position(ring, segment + 1u);
+                    const auto p3 = position(ring + 1u, segment + 1u);
+                    const auto p4 = position(ring + 1u, segment);
+                    for (const auto& p : { p1, p2, p3, p1, p3, p4 }) {
+                        result.emplace_back(p, vm::vec2f::zero());
+                    }
+                }
+            }
+            return result;
+        }
+
+        static std::vector<std::unique_ptr<EntityModel>> createModels() {
+            std::vector<std::unique_ptr<EntityModel>> result;
+            for (size_t i = 0; i < NumModelCopies; ++i) {
+                for (const auto& size : ModelSizes) {
+                    auto model = std::make_unique<EntityModel>(size.name);
+                    model->addFrames(size.frameCount);
+                    auto& surface = model->addSurface("surface");
+                    for (size_t frameIndex = 0; frameIndex < size.frameCount; ++frameIndex) {
+                        auto& frame = model->loadFrame(frameIndex, "frame" + std::to_string(frameIndex), vm::bbox3f(24.0f));
+                        const auto vertices = createFrameVertices(size, frameIndex);
+                        surface.addIndexedMesh(frame, vertices, Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0, vertices.size()));
+                    }
+                    result.push_back(std::move(model));
+                }
+            }
+            return result;
+        }
+
+        static size_t countFrames() {
+            size_t result = 0u;
+            for (const auto& size : ModelSizes) {
+                result += size.frameCount;
+            }
+            return result * NumModelCopies;
+        }
+
+        static size_t countTriangles() {
+            size_t result = 0u;
+            for (const auto& size : ModelSizes) {
+                result += size.frameCount * size.rings * size.segments * 2u;
+            }
+            return result * NumModelCopies;
+        }
+
+        /**
+         * Picks every frame of every model with a few rays that start outside of the model and point at its center.
+         */
+        static float pickFrames(const std::vector<std::unique_ptr<EntityModel>>& models, const size_t raysPerFrame) {
+            auto result = 0.0f;
+            for (const auto& model : models) {
+                for (const auto* frame : model->frames()) {
+                    for (size_t i = 0; i < raysPerFrame; ++i) {
+                        const auto angle = 2.0f * vm::Cf::pi() * static_cast<float>(i) / static_cast<float>(raysPerFrame);
+                        const auto origin = vm::vec3f(std::cos(angle) * 64.0f, std::sin(angle) * 64.0f, 8.0f);
+                        const auto distance = frame->intersect(vm::ray3f(origin, vm::normalize(-origin)));
+                        if (!vm::is_nan(distance)) {
+                            result += distance;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Reports the memory allocated per triangle when loading models and when picking every frame for the first
+         * time, which builds the frames' spacial trees, as well as the time it takes to pick the frames afterwards.
+         */
+        TEST(EntityModelBenchmark, pickFrames) {
+            std::vector<std::unique_ptr<EntityModel>> models;
+            const auto loadResult = runBenchmark("EntityModel: load models", [&]() {
+                models.clear();
+            }, [&]() {
+                models = createModels();
+            });
+
+            auto distance = 0.0f;
+            const auto firstPickResult = runBenchmark("EntityModel: pick every frame for the first time", [&]() {
+                models = createModels();
+            }, [&]() {
+                distance += pickFrames(models, 1u);
+            });
+
+            const auto pickResult = runBenchmark("EntityModel: pick every frame 16 times", [&]() {
+                distance += pickFrames(models, 16u);
+            });
+            ASSERT_LT(0.0f, distance);
+
+            const auto triangleCount = static_cast<double>(countTriangles());
+            const auto rayCount = static_cast<double>(countFrames() * 16u);
+
+            auto& report = BenchmarkReport::instance();
+            report.setCounter(loadResult.name, "bytesPerTriangle", static_cast<double>(loadResult.allocatedBytes) / triangleCount);
+            report.setCounter(firstPickResult.name, "bytesPerTriangle", static_cast<double>(firstPickResult.allocatedBytes) / triangleCount);
+            report.setCounter(pickResult.name, "nsPerRay", pickResult.median * 1000000.0 / rayCount);
+        }
+    }
+}
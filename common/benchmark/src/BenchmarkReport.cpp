@@ -0,0 +1,279 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkReport.h"
+
+#include "Exceptions.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "IO/ELParser.h"
+
+#include <kdl/string_compare.h>
+#include <kdl/string_format.h>
+#include <kdl/string_utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace TrenchBroom {
+    BenchmarkOptions::BenchmarkOptions() :
+    warmupRuns(2u),
+    sampleRuns(10u) {}
+
+    BenchmarkOptions::BenchmarkOptions(const size_t i_warmupRuns, const size_t i_sampleRuns) :
+    warmupRuns(i_warmupRuns),
+    sampleRuns(i_sampleRuns) {}
+
+    BenchmarkResult::BenchmarkResult() :
+    samples(0u),
+    min(0.0),
+    max(0.0),
+    mean(0.0),
+    median(0.0),
+    p10(0.0),
+    p90(0.0),
+    stddev(0.0),
+    allocations(0u),
+    allocatedBytes(0u) {}
+
+    /**
+     * Linearly interpolated percentile of an ascending sequence.
+     */
+    static double percentile(const std::vector<double>& sorted, const double p) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        const auto rank = p * static_cast<double>(sorted.size() - 1u);
+        const auto lower = static_cast<size_t>(std::floor(rank));
+        const auto upper = std::min(lower + 1u, sorted.size() - 1u);
+        const auto t = rank - static_cast<double>(lower);
+        return sorted[lower] + t * (sorted[upper] - sorted[lower]);
+    }
+
+    BenchmarkResult BenchmarkResult::fromSamples(const std::string& name, std::vector<double> samplesMs, const size_t allocations, const size_t allocatedBytes) {
+        std::sort(std::begin(samplesMs), std::end(samplesMs));
+
+        BenchmarkResult result;
+        result.name = name;
+        result.samples = samplesMs.size();
+        result.allocations = allocations;
+        result.allocatedBytes = allocatedBytes;
+
+        if (!samplesMs.empty()) {
+            const auto count = static_cast<double>(samplesMs.size());
+            result.min = samplesMs.front();
+            result.max = samplesMs.back();
+            result.mean = std::accumulate(std::begin(samplesMs), std::end(samplesMs), 0.0) / count;
+            result.median = percentile(samplesMs, 0.5);
+            result.p10 = percentile(samplesMs, 0.1);
+            result.p90 = percentile(samplesMs, 0.9);
+
+            double sumOfSquares = 0.0;
+            for (const auto sample : samplesMs) {
+                sumOfSquares += (sample - result.mean) * (sample - result.mean);
+            }
+            result.stddev = std::sqrt(sumOfSquares / count);
+        }
+
+        return result;
+    }
+
+    BenchmarkReport::BenchmarkReport() :
+    m_threshold(0.05),
+    m_mapBrushCount(20000u) {}
+
+    BenchmarkReport& BenchmarkReport::instance() {
+        static BenchmarkReport report;
+        return report;
+    }
+
+    static bool parseOption(const std::string& arg, const std::string& name, std::string& value) {
+        const auto prefix = "--" + name + "=";
+        if (kdl::cs::str_is_prefix(arg, prefix)) {
+            value = arg.substr(prefix.size());
+            return true;
+        }
+        return false;
+    }
+
+    void BenchmarkReport::configure(int& argc, char** argv) {
+        int remaining = 1;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg(argv[i]);
+            std::string value;
+            if (parseOption(arg, "benchmark_warmup", value)) {
+                m_options.warmupRuns = kdl::str_to_size(value).value_or(m_options.warmupRuns);
+            } else if (parseOption(arg, "benchmark_samples", value)) {
+                m_options.sampleRuns = std::max(size_t(1), kdl::str_to_size(value).value_or(m_options.sampleRuns));
+            } else if (parseOption(arg, "benchmark_out", value)) {
+                m_outPath = value;
+            } else if (parseOption(arg, "benchmark_baseline", value)) {
+                m_baselinePath = value;
+            } else if (parseOption(arg, "benchmark_threshold", value)) {
+                m_threshold = kdl::str_to_double(value).value_or(m_threshold);
+            } else if (parseOption(arg, "benchmark_map_brushes", value)) {
+                m_mapBrushCount = kdl::str_to_size(value).value_or(m_mapBrushCount);
+            } else {
+                argv[remaining++] = argv[i];
+            }
+        }
+        argc = remaining;
+    }
+
+    const BenchmarkOptions& BenchmarkReport::options() const {
+        return m_options;
+    }
+
+    size_t BenchmarkReport::mapBrushCount() const {
+        return m_mapBrushCount;
+    }
+
+    const std::vector<BenchmarkResult>& BenchmarkReport::results() const {
+        return m_results;
+    }
+
+    void BenchmarkReport::add(BenchmarkResult result) {
+        printResult(result);
+        m_results.push_back(std::move(result));
+    }
+
+    void BenchmarkReport::setCounter(const std::string& benchmarkName, const std::string& counterName, const double value) {
+        for (auto& result : m_results) {
+            if (result.name == benchmarkName) {
+                result.counters[counterName] = value;
+            }
+        }
+    }
+
+    int BenchmarkReport::finish() {
+        if (!m_outPath.empty()) {
+            std::ofstream out(m_outPath);
+            if (!out) {
+                std::cerr << "Could not open benchmark output file '" << m_outPath << "'" << std::endl;
+                return 1;
+            }
+            writeJson(out);
+        }
+
+        if (m_baselinePath.empty()) {
+            return 0;
+        }
+
+        std::ifstream in(m_baselinePath);
+        if (!in) {
+            std::cerr << "Could not open benchmark baseline file '" << m_baselinePath << "'" << std::endl;
+            return 1;
+        }
+
+        std::stringstream baseline;
+        baseline << in.rdbuf();
+
+        try {
+            const auto regressions = compare(baseline.str());
+            for (const auto& regression : regressions) {
+                std::printf("REGRESSION '%s': median %fms -> %fms (%+.1f%%)\n",
+                            regression.name.c_str(), regression.baselineMedian, regression.currentMedian,
+                            (regression.ratio - 1.0) * 100.0);
+            }
+            if (regressions.empty()) {
+                std::printf("No regressions against '%s' (threshold %.1f%%)\n", m_baselinePath.c_str(), m_threshold * 100.0);
+            }
+            return regressions.empty() ? 0 : 1;
+        } catch (const Exception& e) {
+            std::cerr << "Could not parse benchmark baseline file '" << m_baselinePath << "': " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    static std::string escapeJson(const std::string& str) {
+        return kdl::str_escape(str, "\"\\");
+    }
+
+    void BenchmarkReport::writeJson(std::ostream& str) const {
+        str << std::setprecision(17);
+        str << "{\n";
+        str << "    \"version\": 1,\n";
+        str << "    \"benchmarks\": [";
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const auto& result = m_results[i];
+            str << (i == 0u ? "\n" : ",\n");
+            str << "        {\n";
+            str << "            \"name\": \"" << escapeJson(result.name) << "\",\n";
+            str << "            \"samples\": " << result.samples << ",\n";
+            str << "            \"min\": " << result.min << ",\n";
+            str << "            \"max\": " << result.max << ",\n";
+            str << "            \"mean\": " << result.mean << ",\n";
+            str << "            \"median\": " << result.median << ",\n";
+            str << "            \"p10\": " << result.p10 << ",\n";
+            str << "            \"p90\": " << result.p90 << ",\n";
+            str << "            \"stddev\": " << result.stddev << ",\n";
+            str << "            \"allocations\": " << result.allocations << ",\n";
+            str << "            \"allocatedBytes\": " << result.allocatedBytes << ",\n";
+            str << "            \"counters\": {";
+            bool first = true;
+            for (const auto& [name, value] : result.counters) {
+                str << (first ? " " : ", ") << "\"" << escapeJson(name) << "\": " << value;
+                first = false;
+            }
+            str << (first ? "}\n" : " }\n");
+            str << "        }";
+        }
+        str << "\n    ]\n";
+        str << "}\n";
+    }
+
+    std::vector<BenchmarkRegression> BenchmarkReport::compare(const std::string& baselineJson) const {
+        const auto root = IO::ELParser::parseStrict(baselineJson).evaluate(EL::EvaluationContext());
+
+        std::map<std::string, double> baselineMedians;
+        for (const auto& entry : root["benchmarks"].arrayValue()) {
+            baselineMedians[entry["name"].stringValue()] = entry["median"].numberValue();
+        }
+
+        std::vector<BenchmarkRegression> result;
+        for (const auto& current : m_results) {
+            const auto it = baselineMedians.find(current.name);
+            if (it == std::end(baselineMedians) || it->second <= 0.0) {
+                continue;
+            }
+
+            const auto ratio = current.median / it->second;
+            if (ratio > 1.0 + m_threshold) {
+                result.push_back({ current.name, it->second, current.median, ratio });
+            }
+        }
+        return result;
+    }
+
+    void printResult(const BenchmarkResult& result) {
+        std::printf("%s: median %fms, p10 %fms, p90 %fms, min %fms, max %fms (%zu samples, %zu allocations / %zu bytes per sample)\n",
+                    result.name.c_str(), result.median, result.p10, result.p90, result.min, result.max,
+                    result.samples, result.allocations, result.allocatedBytes);
+        for (const auto& [name, value] : result.counters) {
+            std::printf("    %s: %f\n", name.c_str(), value);
+        }
+    }
+}
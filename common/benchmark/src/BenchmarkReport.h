@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BenchmarkReport
+#define TrenchBroom_BenchmarkReport
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    struct BenchmarkOptions {
+        size_t warmupRuns;
+        size_t sampleRuns;
+
+        BenchmarkOptions();
+        BenchmarkOptions(size_t i_warmupRuns, size_t i_sampleRuns);
+    };
+
+    /**
+     * The statistics gathered for one benchmark. All times are in milliseconds, allocation counts are per sample.
+     */
+    class BenchmarkResult {
+    public:
+        std::string name;
+        size_t samples;
+        double min;
+        double max;
+        double mean;
+        double median;
+        double p10;
+        double p90;
+        double stddev;
+        size_t allocations;
+        size_t allocatedBytes;
+        std::map<std::string, double> counters;
+    public:
+        BenchmarkResult();
+
+        static BenchmarkResult fromSamples(const std::string& name, std::vector<double> samplesMs, size_t allocations, size_t allocatedBytes);
+    };
+
+    /**
+     * A benchmark whose median got slower than its baseline by more than the configured threshold.
+     */
+    struct BenchmarkRegression {
+        std::string name;
+        double baselineMedian;
+        double currentMedian;
+        double ratio;
+    };
+
+    /**
+     * Collects the results of all benchmarks run by this process. The report is configured from the command line:
+     *
+     * --benchmark_warmup=<n>       number of untimed warmup runs per benchmark (default 2)
+     * --benchmark_samples=<n>      number of timed samples per benchmark (default 10)
+     * --benchmark_out=<path>       write all results as JSON to the given file
+     * --benchmark_baseline=<path>  compare the results against a JSON file written by an earlier run
+     * --benchmark_threshold=<r>    relative slowdown of the median that counts as a regression (default 0.05)
+     * --benchmark_map_brushes=<n>  number of brushes in generated benchmark maps (default 20000)
+     */
+    class BenchmarkReport {
+    private:
+        BenchmarkOptions m_options;
+        std::string m_outPath;
+        std::string m_baselinePath;
+        double m_threshold;
+        size_t m_mapBrushCount;
+        std::vector<BenchmarkResult> m_results;
+    public:
+        static BenchmarkReport& instance();
+
+        /**
+         * Consumes all --benchmark_* arguments and removes them from argv.
+         */
+        void configure(int& argc, char** argv);
+
+        const BenchmarkOptions& options() const;
+        size_t mapBrushCount() const;
+        const std::vector<BenchmarkResult>& results() const;
+
+        void add(BenchmarkResult result);
+
+        /**
+         * Sets a counter of a benchmark that was already added, e.g. a throughput that is derived from its median.
+         */
+        void setCounter(const std::string& benchmarkName, const std::string& counterName, double value);
+
+        /**
+         * Writes the JSON report and performs the baseline comparison if requested.
+         *
+         * @return 0 if no regressions were detected and 1 otherwise
+         */
+        int finish();
+
+        void writeJson(std::ostream& str) const;
+        std::vector<BenchmarkRegression> compare(const std::string& baselineJson) const;
+    private:
+        BenchmarkReport();
+    };
+
+    void printResult(const BenchmarkResult& result);
+}
+
+#endif /* defined(TrenchBroom_BenchmarkReport) */
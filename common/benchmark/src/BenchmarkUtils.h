@@ -20,8 +20,13 @@
 #ifndef TRENCHBROOM_BENCHMARKUTILS_H
 #define TRENCHBROOM_BENCHMARKUTILS_H
 
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+
+#include <algorithm>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #ifdef __GNUC__
 #define TB_NOINLINE __attribute__((noinline))
@@ -29,15 +34,48 @@
 #define TB_NOINLINE
 #endif
 
-// the noinline is so you can see the timeLambda when profiling
-template<class L>
-TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
-    const auto start = std::chrono::high_resolution_clock::now();
-    lambda();
-    const auto end = std::chrono::high_resolution_clock::now();
+namespace TrenchBroom {
+    /**
+     * Runs the given lambda a number of times to warm up caches and allocators, then takes the configured number of
+     * timed samples. The setup lambda runs before every run, but is neither timed nor counted towards the
+     * allocations. The result is added to the global benchmark report and returned.
+     */
+    template<class S, class L>
+    TB_NOINLINE static BenchmarkResult runBenchmark(const std::string& name, S&& setup, L&& lambda, const BenchmarkOptions& options = BenchmarkReport::instance().options()) {
+        for (size_t i = 0; i < options.warmupRuns; ++i) {
+            setup();
+            lambda();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(options.sampleRuns);
+
+        size_t allocations = 0u;
+        size_t allocatedBytes = 0u;
+        for (size_t i = 0; i < options.sampleRuns; ++i) {
+            setup();
+
+            const auto allocationsBefore = AllocationCounter::snapshot();
+            const auto start = std::chrono::high_resolution_clock::now();
+            lambda();
+            const auto end = std::chrono::high_resolution_clock::now();
+            const auto allocationsAfter = AllocationCounter::snapshot();
+
+            samples.push_back(std::chrono::duration<double>(end - start).count() * 1000.0);
+            allocations += allocationsAfter.allocations - allocationsBefore.allocations;
+            allocatedBytes += allocationsAfter.bytes - allocationsBefore.bytes;
+        }
+
+        const auto sampleCount = std::max(size_t(1), options.sampleRuns);
+        auto result = BenchmarkResult::fromSamples(name, std::move(samples), allocations / sampleCount, allocatedBytes / sampleCount);
+        BenchmarkReport::instance().add(result);
+        return result;
+    }
 
-    printf("Time elapsed for '%s': %fms\n", message.c_str(),
-           std::chrono::duration<double>(end - start).count() * 1000.0);
+    template<class L>
+    TB_NOINLINE static BenchmarkResult runBenchmark(const std::string& name, L&& lambda, const BenchmarkOptions& options = BenchmarkReport::instance().options()) {
+        return runBenchmark(name, [](){}, std::forward<L>(lambda), options);
+    }
 }
 
 
@@ -0,0 +1,206 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapGenerator.h"
+
+#include "Macros.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace IO {
+        BenchmarkRandom::BenchmarkRandom(const uint64_t seed) :
+        m_state(seed != 0u ? seed : 0x9E3779B97F4A7C15ull) {}
+
+        uint64_t BenchmarkRandom::next() {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+        int BenchmarkRandom::nextInt(const int min, const int max) {
+            const auto range = static_cast<uint64_t>(max - min) + 1u;
+            return min + static_cast<int>(next() % range);
+        }
+
+        MapGeneratorOptions::MapGeneratorOptions() :
+        format(Model::MapFormat::Standard),
+        brushCount(10000u),
+        brushEntityCount(100u),
+        pointEntityCount(1000u),
+        textureCount(64u),
+        seed(1u) {}
+
+        using Point = std::array<int, 3>;
+
+        static void writePoint(std::ostream& str, const Point& p) {
+            str << "( " << p[0] << " " << p[1] << " " << p[2] << " )";
+        }
+
+        /**
+         * Writes a face whose normal is (mostly) aligned with the given axis.
+         */
+        static void writeFace(std::ostream& str, const Point& p0, const Point& p1, const Point& p2, const size_t axis, const size_t texture, const Model::MapFormat format, BenchmarkRandom& random) {
+            writePoint(str, p0);
+            str << " ";
+            writePoint(str, p1);
+            str << " ";
+            writePoint(str, p2);
+
+            const auto xOffset = random.nextInt(0, 63);
+            const auto yOffset = random.nextInt(0, 63);
+
+            switch (format) {
+                case Model::MapFormat::Valve: {
+                    static const char* UAxes[] = { "0 1 0", "1 0 0", "1 0 0" };
+                    static const char* VAxes[] = { "0 0 -1", "0 0 -1", "0 -1 0" };
+                    str << " tex" << texture
+                        << " [ " << UAxes[axis] << " " << xOffset << " ]"
+                        << " [ " << VAxes[axis] << " " << yOffset << " ] 0 1 1\n";
+                    break;
+                }
+                case Model::MapFormat::Quake2:
+                    str << " tex" << texture << " " << xOffset << " " << yOffset << " 0 1 1 0 0 0\n";
+                    break;
+                case Model::MapFormat::Quake3:
+                    str << " ( ( 0.015625 0 0 ) ( 0 0.015625 0 ) ) tex" << texture << " 0 0 0\n";
+                    break;
+                case Model::MapFormat::Standard:
+                case Model::MapFormat::Quake2_Valve:
+                case Model::MapFormat::Hexen2:
+                case Model::MapFormat::Daikatana:
+                case Model::MapFormat::Quake3_Legacy:
+                case Model::MapFormat::Unknown:
+                    str << " tex" << texture << " " << xOffset << " " << yOffset << " 0 1 1\n";
+                    break;
+                switchDefault()
+            }
+        }
+
+        static void writeBrush(std::ostream& str, const Point& min, const Point& max, const bool clipCorner, const MapGeneratorOptions& options, BenchmarkRandom& random) {
+            const auto [x0, y0, z0] = min;
+            const auto [x1, y1, z1] = max;
+            const auto textureCount = std::max(size_t(1), options.textureCount);
+            const auto texture = static_cast<size_t>(random.next() % textureCount);
+
+            const auto format = options.format;
+            if (format == Model::MapFormat::Quake3) {
+                str << "{\nbrushDef\n{\n";
+            } else {
+                str << "{\n";
+            }
+            writeFace(str, { x0, y0, z0 }, { x0, y0, z1 }, { x1, y0, z0 }, 1u, texture, format, random);
+            writeFace(str, { x0, y0, z0 }, { x0, y1, z0 }, { x0, y0, z1 }, 0u, texture, format, random);
+            writeFace(str, { x0, y0, z0 }, { x1, y0, z0 }, { x0, y1, z0 }, 2u, texture, format, random);
+            writeFace(str, { x1, y1, z1 }, { x0, y1, z1 }, { x1, y1, z0 }, 1u, texture, format, random);
+            writeFace(str, { x1, y1, z1 }, { x1, y1, z0 }, { x1, y0, z1 }, 0u, texture, format, random);
+            writeFace(str, { x1, y1, z1 }, { x1, y0, z1 }, { x0, y1, z1 }, 2u, texture, format, random);
+            if (clipCorner) {
+                // cut off the corner at max, the smallest brush extent is 16 units
+                const int c = 8;
+                writeFace(str, { x1 - c, y1, z1 }, { x1, y1, z1 - c }, { x1, y1 - c, z1 }, 0u, (texture + 1u) % textureCount, format, random);
+            }
+            if (format == Model::MapFormat::Quake3) {
+                str << "}\n}\n";
+            } else {
+                str << "}\n";
+            }
+        }
+
+        static void writeRandomBrush(std::ostream& str, const size_t index, const size_t cellsPerAxis, const MapGeneratorOptions& options, BenchmarkRandom& random) {
+            static const int CellSize = 128;
+
+            const auto cx = static_cast<int>(index % cellsPerAxis);
+            const auto cy = static_cast<int>((index / cellsPerAxis) % cellsPerAxis);
+            const auto cz = static_cast<int>(index / (cellsPerAxis * cellsPerAxis));
+            const auto offset = static_cast<int>(cellsPerAxis) * CellSize / 2;
+
+            const Point cellMin = { cx * CellSize - offset, cy * CellSize - offset, cz * CellSize - offset };
+            const Point size = { random.nextInt(1, 6) * 16, random.nextInt(1, 6) * 16, random.nextInt(1, 6) * 16 };
+            const Point min = {
+                cellMin[0] + random.nextInt(0, (CellSize - size[0]) / 16) * 16,
+                cellMin[1] + random.nextInt(0, (CellSize - size[1]) / 16) * 16,
+                cellMin[2] + random.nextInt(0, (CellSize - size[2]) / 16) * 16
+            };
+            const Point max = { min[0] + size[0], min[1] + size[1], min[2] + size[2] };
+
+            writeBrush(str, min, max, random.nextInt(0, 3) == 0, options, random);
+        }
+
+        std::string generateMap(const MapGeneratorOptions& options) {
+            BenchmarkRandom random(options.seed);
+            std::stringstream str;
+
+            const auto cellsPerAxis = std::max(size_t(1), static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(options.brushCount)))));
+
+            // every fourth brush goes into a brush entity if there are any
+            const auto entityBrushCount = options.brushEntityCount > 0u ? options.brushCount / 4u : 0u;
+            const auto worldBrushCount = options.brushCount - entityBrushCount;
+
+            size_t brushIndex = 0u;
+            str << "// Game: Quake\n";
+            str << "// Format: " << Model::formatName(options.format) << "\n";
+            str << "// entity 0\n";
+            str << "{\n";
+            str << "\"classname\" \"worldspawn\"\n";
+            str << "\"wad\" \"benchmark.wad\"\n";
+            for (size_t i = 0; i < worldBrushCount; ++i) {
+                writeRandomBrush(str, brushIndex++, cellsPerAxis, options, random);
+            }
+            str << "}\n";
+
+            size_t entityIndex = 1u;
+            for (size_t i = 0; i < options.brushEntityCount; ++i) {
+                const auto first = i * entityBrushCount / options.brushEntityCount;
+                const auto last = (i + 1u) * entityBrushCount / options.brushEntityCount;
+
+                str << "// entity " << entityIndex++ << "\n";
+                str << "{\n";
+                str << "\"classname\" \"func_detail\"\n";
+                for (size_t j = first; j < last; ++j) {
+                    writeRandomBrush(str, brushIndex++, cellsPerAxis, options, random);
+                }
+                str << "}\n";
+            }
+
+            const auto extent = static_cast<int>(cellsPerAxis) * 64;
+            for (size_t i = 0; i < options.pointEntityCount; ++i) {
+                str << "// entity " << entityIndex++ << "\n";
+                str << "{\n";
+                str << "\"classname\" \"light\"\n";
+                str << "\"origin\" \""
+                    << random.nextInt(-extent, extent) << " "
+                    << random.nextInt(-extent, extent) << " "
+                    << random.nextInt(-extent, extent) << "\"\n";
+                str << "\"light\" \"" << random.nextInt(100, 400) << "\"\n";
+                str << "\"targetname\" \"t" << i << "\"\n";
+                if (i + 1u < options.pointEntityCount) {
+                    str << "\"target\" \"t" << (i + 1u) << "\"\n";
+                }
+                str << "}\n";
+            }
+
+            return str.str();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapGenerator
+#define TrenchBroom_MapGenerator
+
+#include "Model/MapFormat.h"
+
+#include <cstdint>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * A small xorshift64* generator. We don't use the standard library distributions because their output is
+         * implementation defined, and the generated fixtures must be identical on every platform.
+         */
+        class BenchmarkRandom {
+        private:
+            uint64_t m_state;
+        public:
+            explicit BenchmarkRandom(uint64_t seed);
+
+            uint64_t next();
+
+            /**
+             * Returns a value in the closed interval [min, max].
+             */
+            int nextInt(int min, int max);
+        };
+
+        struct MapGeneratorOptions {
+            Model::MapFormat format;
+            size_t brushCount;
+            size_t brushEntityCount;
+            size_t pointEntityCount;
+            size_t textureCount;
+            uint64_t seed;
+
+            MapGeneratorOptions();
+        };
+
+        /**
+         * Generates the text of a map file according to the given options. Brushes are axis aligned boxes, some of
+         * which have a corner clipped off, laid out in a grid that fits into a world of 8192 units. A share of the
+         * brushes is moved into func_detail entities, and the point entities are chained by target / targetname
+         * pairs. The output only depends on the given options.
+         *
+         * Supported formats are Standard, Valve, Quake2 and Quake3. For Quake3, all brushes are written as brush
+         * primitives.
+         */
+        std::string generateMap(const MapGeneratorOptions& options);
+    }
+}
+
+#endif /* defined(TrenchBroom_MapGenerator) */
@@ -0,0 +1,361 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+#include "BenchmarkUtils.h"
+#include "Exceptions.h"
+#include "MemoryUsage.h"
+#include "IO/MapCache.h"
+#include "IO/MapGenerator.h"
+#include "IO/NodeWriter.h"
+#include "IO/StandardMapParser.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/Entity.h"
+#include "Model/EntityAttributes.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        struct ParsedFace {
+            vm::vec3 point1;
+            vm::vec3 point2;
+            vm::vec3 point3;
+            Model::BrushFaceAttributes attribs;
+            vm::vec3 texAxisX;
+            vm::vec3 texAxisY;
+        };
+
+        struct ParsedEntity {
+            std::vector<Model::EntityAttribute> attributes;
+            std::vector<std::vector<ParsedFace>> brushes;
+        };
+
+        /**
+         * Records the parser callbacks without creating any model objects so that parsing can be timed separately
+         * from building the brush geometry and the node tree.
+         */
+        class RecordingMapParser : public StandardMapParser {
+        private:
+            std::vector<ParsedEntity> m_entities;
+        public:
+            explicit RecordingMapParser(const std::string& str) :
+            StandardMapParser(str) {}
+
+            std::vector<ParsedEntity> parse(const Model::MapFormat format, ParserStatus& status) {
+                parseEntities(format, status);
+                return std::move(m_entities);
+            }
+        private:
+            void onFormatSet(Model::MapFormat /* format */) override {}
+
+            void onBeginEntity(size_t /* line */, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& /* extraAttributes */, ParserStatus& /* status */) override {
+                m_entities.push_back({ attributes, {} });
+            }
+
+            void onEndEntity(size_t /* startLine */, size_t /* lineCount */, ParserStatus& /* status */) override {}
+
+            void onBeginBrush(size_t /* line */, ParserStatus& /* status */) override {
+                m_entities.back().brushes.emplace_back();
+            }
+
+            void onEndBrush(size_t /* startLine */, size_t /* lineCount */, const ExtraAttributes& /* extraAttributes */, ParserStatus& /* status */) override {}
+
+            void onBrushFace(size_t /* line */, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& /* status */) override {
+                m_entities.back().brushes.back().push_back({ point1, point2, point3, attribs, texAxisX, texAxisY });
+            }
+        };
+
+        /**
+         * Collects timing and allocation samples of one phase over several iterations of the pipeline. The peak
+         * resident set size is reset before each phase, so transient peaks within a phase are included. Where the
+         * peak cannot be reset, it is the peak over the lifetime of the process, and peakIsPerPhase is 0.
+         */
+        class PhaseSamples {
+        private:
+            std::string m_name;
+            std::vector<double> m_samples;
+            size_t m_allocations;
+            size_t m_allocatedBytes;
+            size_t m_peakResidentBytes;
+            bool m_peakIsPerPhase;
+        public:
+            explicit PhaseSamples(const std::string& name) :
+            m_name(name),
+            m_allocations(0u),
+            m_allocatedBytes(0u),
+            m_peakResidentBytes(0u),
+            m_peakIsPerPhase(true) {}
+
+            template <typename L>
+            void measure(L&& lambda, const bool record) {
+                const auto peakReset = resetPeakResidentSetSize();
+                const auto allocationsBefore = AllocationCounter::snapshot();
+                const auto start = std::chrono::high_resolution_clock::now();
+                lambda();
+                const auto end = std::chrono::high_resolution_clock::now();
+                const auto allocationsAfter = AllocationCounter::snapshot();
+                const auto peakResidentBytes = peakResidentSetSize();
+
+                if (record) {
+                    m_samples.push_back(std::chrono::duration<double>(end - start).count() * 1000.0);
+                    m_allocations += allocationsAfter.allocations - allocationsBefore.allocations;
+                    m_allocatedBytes += allocationsAfter.bytes - allocationsBefore.bytes;
+                    m_peakResidentBytes = std::max(m_peakResidentBytes, peakResidentBytes);
+                    m_peakIsPerPhase = m_peakIsPerPhase && peakReset;
+                }
+            }
+
+            BenchmarkResult result() const {
+                const auto count = std::max(size_t(1), m_samples.size());
+                auto result = BenchmarkResult::fromSamples(m_name, m_samples, m_allocations / count, m_allocatedBytes / count);
+                // without a per-phase reset, this is the peak over the lifetime of the process
+                result.counters["peakResidentBytes"] = static_cast<double>(m_peakResidentBytes);
+                result.counters["peakIsPerPhase"] = m_peakIsPerPhase ? 1.0 : 0.0;
+                return result;
+            }
+        };
+
+        class MapLoadSaveBenchmark : public ::testing::TestWithParam<Model::MapFormat> {};
+
+        TEST_P(MapLoadSaveBenchmark, loadAndSaveMap) {
+            const auto format = GetParam();
+            const auto& report = BenchmarkReport::instance();
+            const auto& options = report.options();
+
+            MapGeneratorOptions generatorOptions;
+            generatorOptions.format = format;
+            generatorOptions.brushCount = report.mapBrushCount();
+            const auto mapText = generateMap(generatorOptions);
+
+            const auto prefix = "MapLoadSave (" + Model::formatName(format) + ", " + std::to_string(generatorOptions.brushCount) + " brushes): ";
+            const vm::bbox3 worldBounds(8192.0);
+
+            PhaseSamples parsing(prefix + "parse");
+            PhaseSamples geometry(prefix + "build geometry");
+            PhaseSamples tree(prefix + "build node tree");
+            PhaseSamples serialization(prefix + "serialize");
+            PhaseSamples destruction(prefix + "destroy");
+
+            size_t brushCount = 0u;
+            size_t faceCount = 0u;
+            size_t serializedBytes = 0u;
+
+            for (size_t i = 0; i < options.warmupRuns + options.sampleRuns; ++i) {
+                const auto record = i >= options.warmupRuns;
+                TestParserStatus status;
+
+                std::vector<ParsedEntity> entities;
+                parsing.measure([&]() {
+                    RecordingMapParser parser(mapText);
+                    entities = parser.parse(format, status);
+                }, record);
+
+                auto world = std::make_unique<Model::World>(format);
+                std::vector<std::vector<Model::Brush*>> brushes(entities.size());
+
+                geometry.measure([&]() {
+                    for (size_t j = 0; j < entities.size(); ++j) {
+                        for (const auto& parsedFaces : entities[j].brushes) {
+                            std::vector<Model::BrushFace*> faces;
+                            faces.reserve(parsedFaces.size());
+                            for (const auto& f : parsedFaces) {
+                                faces.push_back(world->createFace(f.point1, f.point2, f.point3, f.attribs, f.texAxisX, f.texAxisY));
+                            }
+
+                            try {
+                                brushes[j].push_back(world->createBrush(worldBounds, faces));
+                            } catch (const GeometryException&) {
+                                // the faces have been deleted by the brush's constructor
+                            }
+                        }
+                    }
+                }, record);
+
+                tree.measure([&]() {
+                    world->disableNodeTreeUpdates();
+                    for (size_t j = 0; j < entities.size(); ++j) {
+                        if (j == 0u) {
+                            // the first entity is always worldspawn
+                            world->setAttributes(entities[j].attributes);
+                            world->defaultLayer()->addChildren(std::begin(brushes[j]), std::end(brushes[j]), brushes[j].size());
+                        } else {
+                            auto* entity = world->createEntity();
+                            entity->setAttributes(entities[j].attributes);
+                            entity->addChildren(std::begin(brushes[j]), std::end(brushes[j]), brushes[j].size());
+                            world->defaultLayer()->addChild(entity);
+                        }
+                    }
+                    world->rebuildNodeTree();
+                    world->enableNodeTreeUpdates();
+                }, record);
+
+                brushCount = 0u;
+                faceCount = 0u;
+                for (const auto& entityBrushes : brushes) {
+                    brushCount += entityBrushes.size();
+                    for (const auto* brush : entityBrushes) {
+                        faceCount += brush->faceCount();
+                    }
+                }
+
+                serialization.measure([&]() {
+                    FILE* stream = std::tmpfile();
+                    ASSERT_NE(nullptr, stream);
+
+                    NodeWriter writer(*world, stream);
+                    writer.writeMap();
+
+                    serializedBytes = static_cast<size_t>(std::ftell(stream));
+                    std::fclose(stream);
+                }, record);
+
+                destruction.measure([&]() {
+                    world.reset();
+                }, record);
+            }
+
+            auto& mutableReport = BenchmarkReport::instance();
+            for (const auto* phase : { &parsing, &geometry, &tree, &serialization, &destruction }) {
+                auto result = phase->result();
+                result.counters["brushes"] = static_cast<double>(brushCount);
+                result.counters["faces"] = static_cast<double>(faceCount);
+                result.counters["inputBytes"] = static_cast<double>(mapText.size());
+                result.counters["outputBytes"] = static_cast<double>(serializedBytes);
+                mutableReport.add(std::move(result));
+            }
+        }
+
+        TEST_P(MapLoadSaveBenchmark, readWorld) {
+            const auto format = GetParam();
+
+            MapGeneratorOptions generatorOptions;
+            generatorOptions.format = format;
+            generatorOptions.brushCount = BenchmarkReport::instance().mapBrushCount();
+            const auto mapText = generateMap(generatorOptions);
+
+            const vm::bbox3 worldBounds(8192.0);
+            std::unique_ptr<Model::World> world;
+
+            const auto name = "MapLoadSave (" + Model::formatName(format) + ", " + std::to_string(generatorOptions.brushCount) + " brushes): WorldReader::read";
+            runBenchmark(name, [&]() {
+                world.reset();
+            }, [&]() {
+                TestParserStatus status;
+                WorldReader reader(mapText);
+                world = reader.read(format, worldBounds, status);
+            });
+        }
+
+        TEST_P(MapLoadSaveBenchmark, readWorldFromCache) {
+            const auto format = GetParam();
+
+            MapGeneratorOptions generatorOptions;
+            generatorOptions.format = format;
+            generatorOptions.brushCount = BenchmarkReport::instance().mapBrushCount();
+            const auto mapText = generateMap(generatorOptions);
+            const auto* begin = mapText.data();
+            const auto* end = begin + mapText.size();
+
+            const vm::bbox3 worldBounds(8192.0);
+            std::string cacheData;
+            {
+                MapCacheWriter cacheWriter;
+                TestParserStatus status;
+                WorldReader reader(mapText);
+                reader.setCacheWriter(&cacheWriter);
+                reader.read(format, worldBounds, status);
+                cacheData = cacheWriter.serialize(format, begin, end);
+            }
+
+            std::unique_ptr<Model::World> world;
+
+            const auto name = "MapLoadSave (" + Model::formatName(format) + ", " + std::to_string(generatorOptions.brushCount) + " brushes): WorldReader::read from cache";
+            runBenchmark(name, [&]() {
+                world.reset();
+            }, [&]() {
+                TestParserStatus status;
+                MapCacheReader cache(cacheData.data(), cacheData.data() + cacheData.size(), format, begin, end);
+                WorldReader reader(mapText);
+                world = reader.read(cache, worldBounds, status);
+            });
+
+            BenchmarkReport::instance().setCounter(name, "cacheBytes", static_cast<double>(cacheData.size()));
+        }
+
+        TEST_P(MapLoadSaveBenchmark, saveMap) {
+            const auto format = GetParam();
+
+            MapGeneratorOptions generatorOptions;
+            generatorOptions.format = format;
+            generatorOptions.brushCount = BenchmarkReport::instance().mapBrushCount();
+            const auto mapText = generateMap(generatorOptions);
+
+            const vm::bbox3 worldBounds(8192.0);
+            TestParserStatus status;
+            WorldReader reader(mapText);
+            const auto world = reader.read(format, worldBounds, status);
+
+            size_t serializedBytes = 0u;
+            const auto name = "MapLoadSave (" + Model::formatName(format) + ", " + std::to_string(generatorOptions.brushCount) + " brushes): NodeWriter::writeMap";
+            const auto result = runBenchmark(name, [&]() {
+                FILE* stream = std::tmpfile();
+                ASSERT_NE(nullptr, stream);
+
+                NodeWriter writer(*world, stream);
+                writer.writeMap();
+
+                serializedBytes = static_cast<size_t>(std::ftell(stream));
+                std::fclose(stream);
+            });
+
+            if (result.median > 0.0) {
+                const auto megabytesPerSecond = static_cast<double>(serializedBytes) / (1024.0 * 1024.0) / (result.median / 1000.0);
+                std::printf("    throughput: %f MiB/s (%zu bytes)\n", megabytesPerSecond, serializedBytes);
+
+                auto& report = BenchmarkReport::instance();
+                report.setCounter(name, "outputBytes", static_cast<double>(serializedBytes));
+                report.setCounter(name, "throughputMiBPerSecond", megabytesPerSecond);
+            }
+        }
+
+        INSTANTIATE_TEST_CASE_P(MapFormatInstantiations,
+                                MapLoadSaveBenchmark,
+                                ::testing::Values(Model::MapFormat::Standard, Model::MapFormat::Valve, Model::MapFormat::Quake2, Model::MapFormat::Quake3),
+                                );
+    }
+}
@@ -17,6 +17,18 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
-// Hack to reuse the same main() function as the test suite
-#include "../../test/src/RunAllTests.cpp"
+#include "BenchmarkReport.h"
+#include "TestApplication.h"
 
+int main(int argc, char **argv) {
+    TrenchBroom::TestApplication app(argc, argv);
+
+    // gtest has removed its own arguments, the remaining ones configure the benchmark report
+    auto& report = TrenchBroom::BenchmarkReport::instance();
+    report.configure(argc, argv);
+
+    const int result = app.runAllTests();
+    const int reportResult = report.finish();
+
+    return result != 0 ? result : reportResult;
+}
@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryUsage.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <sys/resource.h>
+#else
+#include <cstdio>
+#include <cstring>
+#endif
+
+namespace TrenchBroom {
+    bool resetPeakResidentSetSize() {
+#if defined(_WIN32) || defined(__APPLE__)
+        return false;
+#else
+        // writing 5 to clear_refs resets VmHWM to the current resident set size (Linux 4.0 and later)
+        FILE* file = std::fopen("/proc/self/clear_refs", "w");
+        if (file == nullptr) {
+            return false;
+        }
+
+        const auto written = std::fputs("5", file) >= 0;
+        return std::fclose(file) == 0 && written;
+#endif
+    }
+
+    size_t peakResidentSetSize() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<size_t>(counters.PeakWorkingSetSize);
+        }
+        return 0u;
+#elif defined(__APPLE__)
+        // ru_maxrss is given in bytes on macOS
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0u;
+        }
+        return static_cast<size_t>(usage.ru_maxrss);
+#else
+        FILE* file = std::fopen("/proc/self/status", "r");
+        if (file == nullptr) {
+            return 0u;
+        }
+
+        // the VmHWM line gives the peak resident set size in kB
+        size_t result = 0u;
+        char line[256];
+        while (std::fgets(line, sizeof(line), file) != nullptr) {
+            unsigned long kiloBytes = 0u;
+            if (std::strncmp(line, "VmHWM:", 6) == 0 && std::sscanf(line + 6, "%lu", &kiloBytes) == 1) {
+                result = static_cast<size_t>(kiloBytes) * 1024u;
+                break;
+            }
+        }
+        std::fclose(file);
+        return result;
+#endif
+    }
+}
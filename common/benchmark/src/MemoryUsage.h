@@ -0,0 +1,43 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MemoryUsage
+#define TrenchBroom_MemoryUsage
+
+#include <cstddef>
+
+namespace TrenchBroom {
+    /**
+     * Resets the peak resident set size of this process to its current resident set size so that
+     * peakResidentSetSize() returns the high-water mark since this call. This is only supported on Linux.
+     *
+     * @return true if the peak was reset, and false if peakResidentSetSize() keeps returning the peak over the
+     * lifetime of the process
+     */
+    bool resetPeakResidentSetSize();
+
+    /**
+     * Returns the peak resident set size of this process in bytes since the last successful call to
+     * resetPeakResidentSetSize(), or since the process was started. Returns 0 if it cannot be determined on this
+     * platform.
+     */
+    size_t peakResidentSetSize();
+}
+
+#endif /* defined(TrenchBroom_MemoryUsage) */
@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2018 Eric Wasylishen
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "AllocationCounter.h"
+#include "BenchmarkUtils.h"
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumMemoryBrushes = 20'000;
+
+        static std::vector<Brush*> createBrushes(const BrushBuilder& builder, const size_t count) {
+            std::vector<Brush*> result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                const auto min = vm::vec3(static_cast<FloatType>(i % 128u), static_cast<FloatType>(i / 128u), 0.0) * 32.0 - vm::vec3(2048.0, 2048.0, 0.0);
+                result.push_back(builder.createCuboid(vm::bbox3(min, min + vm::vec3(16.0, 16.0, 16.0)), "texture" + std::to_string(i % 64u)));
+            }
+            return result;
+        }
+
+        static size_t countFaces(const std::vector<Brush*>& brushes) {
+            size_t result = 0u;
+            for (const auto* brush : brushes) {
+                result += brush->faceCount();
+            }
+            return result;
+        }
+
+        /**
+         * Reports the heap memory allocated per brush face, including the brush geometry, when creating and when
+         * cloning brushes. The faces themselves come from the brush face pool, which is filled by the warmup runs,
+         * so their size is reported separately as sizeofBrushFace.
+         */
+        TEST(BrushMemoryBenchmark, memoryPerFace) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::vector<Brush*> brushes;
+            const auto createName = "Brush: create " + std::to_string(NumMemoryBrushes) + " brushes";
+            const auto createResult = runBenchmark(createName, [&]() {
+                kdl::vec_clear_and_delete(brushes);
+            }, [&]() {
+                brushes = createBrushes(builder, NumMemoryBrushes);
+            });
+
+            std::vector<Brush*> clones;
+            const auto cloneName = "Brush: clone " + std::to_string(NumMemoryBrushes) + " brushes";
+            const auto cloneResult = runBenchmark(cloneName, [&]() {
+                kdl::vec_clear_and_delete(clones);
+            }, [&]() {
+                for (const auto* brush : brushes) {
+                    clones.push_back(brush->clone(worldBounds));
+                }
+            });
+
+            const auto faceCount = static_cast<double>(countFaces(brushes));
+            auto& report = BenchmarkReport::instance();
+            report.setCounter(createName, "sizeofBrushFace", static_cast<double>(sizeof(BrushFace)));
+            report.setCounter(createName, "bytesPerFace", static_cast<double>(createResult.allocatedBytes) / faceCount);
+            report.setCounter(createName, "allocationsPerFace", static_cast<double>(createResult.allocations) / faceCount);
+            report.setCounter(cloneName, "bytesPerFace", static_cast<double>(cloneResult.allocatedBytes) / faceCount);
+            report.setCounter(cloneName, "allocationsPerFace", static_cast<double>(cloneResult.allocations) / faceCount);
+
+            kdl::vec_clear_and_delete(clones);
+            kdl::vec_clear_and_delete(brushes);
+        }
+
+        /**
+         * Clones brushes on the shared thread pool like the parallel transformation and serialization do. Every
+         * clone allocates its faces from the brush face pool and interns the texture names of the faces, so this
+         * shows whether the threads contend for the pool and the texture name table. Compare the sample times with
+         * those of the sequential clone benchmark.
+         */
+        TEST(BrushMemoryBenchmark, cloneConcurrently) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            auto brushes = createBrushes(builder, NumMemoryBrushes);
+            std::vector<Brush*> clones(brushes.size(), nullptr);
+
+            const auto name = "Brush: clone " + std::to_string(NumMemoryBrushes) + " brushes concurrently";
+            runBenchmark(name, [&]() {
+                for (auto*& clone : clones) {
+                    delete clone;
+                    clone = nullptr;
+                }
+            }, [&]() {
+                kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                    clones[i] = brushes[i]->clone(worldBounds);
+                }, 64u);
+            });
+
+            BenchmarkReport::instance().setCounter(name, "threads", static_cast<double>(kdl::parallel_thread_count()));
+
+            kdl::vec_clear_and_delete(clones);
+            kdl::vec_clear_and_delete(brushes);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2018 Eric Wasylishen
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumTransformedBrushes = 5'000;
+
+        /**
+         * Simulates dragging a selection of brushes: every step checks whether all brushes can be transformed and
+         * then transforms them, like MapDocumentCommandFacade::performTransform does.
+         */
+        static void transformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, const vm::bbox3& worldBounds) {
+            for (const auto* brush : brushes) {
+                ASSERT_TRUE(brush->canTransform(transformation, worldBounds));
+            }
+            for (auto* brush : brushes) {
+                brush->transform(transformation, false, worldBounds);
+            }
+        }
+
+        TEST(BrushTransformBenchmark, transformBrushes) {
+            const vm::bbox3 worldBounds(8192.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::vector<Brush*> brushes;
+            for (size_t i = 0; i < NumTransformedBrushes; ++i) {
+                const auto offset = vm::vec3(static_cast<FloatType>(i % 64u), static_cast<FloatType>(i / 64u), 0.0) * 80.0 - vm::vec3(2560.0, 2560.0, 0.0);
+                brushes.push_back(builder.createCuboid(vm::bbox3(offset, offset + vm::vec3(64.0, 64.0, 32.0)), "texture"));
+            }
+
+            const auto name = std::to_string(brushes.size()) + " brushes";
+            const auto forward = vm::translation_matrix(vm::vec3(16.0, 0.0, 0.0));
+            const auto backward = vm::translation_matrix(vm::vec3(-16.0, 0.0, 0.0));
+            runBenchmark("Brush: translate " + name, [&]() {
+                transformBrushes(brushes, forward, worldBounds);
+                transformBrushes(brushes, backward, worldBounds);
+            });
+
+            const auto rotate = vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0));
+            runBenchmark("Brush: rotate " + name, [&]() {
+                transformBrushes(brushes, rotate, worldBounds);
+            });
+
+            const auto mirror = vm::scaling_matrix(vm::vec3(-1.0, 1.0, 1.0));
+            runBenchmark("Brush: mirror " + name, [&]() {
+                transformBrushes(brushes, mirror, worldBounds);
+            });
+
+            kdl::vec_clear_and_delete(brushes);
+        }
+    }
+}
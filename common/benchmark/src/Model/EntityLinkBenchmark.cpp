@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+
+#include "Model/AttributableNode.h"
+#include "Model/AttributableNodeIndex.h"
+#include "Model/Entity.h"
+#include "Model/EntityAttributes.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumLinkedEntities = 10'000;
+
+        static std::string targetname(const size_t i) {
+            return "t" + std::to_string(i);
+        }
+
+        /**
+         * Creates a chain of entities that target their successors. Every tenth entity also kills its predecessor and
+         * every entity shares its classname with all the others, like the lights of a large map do.
+         */
+        static std::vector<Node*> createLinkedEntities(const size_t count) {
+            std::vector<Node*> result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                auto* entity = new Entity();
+                entity->addOrUpdateAttribute(AttributeNames::Classname, "light");
+                entity->addOrUpdateAttribute(AttributeNames::Targetname, targetname(i));
+                if (i + 1u < count) {
+                    entity->addOrUpdateAttribute(AttributeNames::Target, targetname(i + 1u));
+                }
+                if (i > 0u && i % 10u == 0u) {
+                    entity->addOrUpdateAttribute(AttributeNames::Killtarget, targetname(i - 1u));
+                }
+                result.push_back(entity);
+            }
+            return result;
+        }
+
+        static void removeEntities(Layer* layer, std::vector<Node*>& entities) {
+            layer->removeChildren(std::begin(entities), std::end(entities));
+            kdl::vec_clear_and_delete(entities);
+        }
+
+        /**
+         * Adding entities to the world indexes their attributes and resolves their links, like loading a map does.
+         */
+        TEST(EntityLinkBenchmark, resolveLinksOnLoad) {
+            World world(MapFormat::Standard);
+            auto* layer = world.defaultLayer();
+
+            std::vector<Node*> entities;
+            const auto name = "Entity links: resolve " + std::to_string(NumLinkedEntities) + " entities";
+            const auto result = runBenchmark(name, [&]() {
+                if (!entities.empty()) {
+                    removeEntities(layer, entities);
+                }
+                entities = createLinkedEntities(NumLinkedEntities);
+            }, [&]() {
+                layer->addChildren(entities);
+            });
+
+            BenchmarkReport::instance().setCounter(name, "allocationsPerEntity", static_cast<double>(result.allocations) / static_cast<double>(NumLinkedEntities));
+
+            const auto* first = static_cast<AttributableNode*>(entities.front());
+            ASSERT_EQ(1u, first->linkTargets().size());
+
+            removeEntities(layer, entities);
+        }
+
+        /**
+         * Runs the queries that link resolution issues for every entity: its link targets by targetname and its link
+         * sources by numbered target attribute.
+         */
+        TEST(EntityLinkBenchmark, findLinkTargets) {
+            World world(MapFormat::Standard);
+            auto* layer = world.defaultLayer();
+
+            auto entities = createLinkedEntities(NumLinkedEntities);
+            layer->addChildren(entities);
+
+            std::vector<std::string> targetnames;
+            targetnames.reserve(NumLinkedEntities);
+            for (size_t i = 0; i < NumLinkedEntities; ++i) {
+                targetnames.push_back(targetname(i));
+            }
+
+            const auto& index = world.attributableNodeIndex();
+            const auto targetnameQuery = AttributableNodeIndexQuery::exact(AttributeNames::Targetname);
+            const auto targetQuery = AttributableNodeIndexQuery::numbered(AttributeNames::Target);
+
+            std::vector<AttributableNode*> targets;
+            targets.reserve(NumLinkedEntities * 2u);
+
+            const auto name = "Entity links: find " + std::to_string(NumLinkedEntities) + " targets and sources";
+            const auto result = runBenchmark(name, [&]() {
+                targets.clear();
+            }, [&]() {
+                for (const auto& value : targetnames) {
+                    index.findAttributableNodes(targetnameQuery, value, targets);
+                    index.findAttributableNodes(targetQuery, value, targets);
+                }
+            });
+
+            BenchmarkReport::instance().setCounter(name, "allocationsPerQuery", static_cast<double>(result.allocations) / static_cast<double>(NumLinkedEntities * 2u));
+            ASSERT_EQ(NumLinkedEntities * 2u - 1u, targets.size());
+
+            removeEntities(layer, entities);
+        }
+    }
+}
@@ -86,24 +86,39 @@ namespace TrenchBroom {
 
             BrushRenderer r;
 
-            timeLambda([&](){ r.addBrushes(brushes); }, "add " + std::to_string(brushes.size()) + " brushes to BrushRenderer");
-            timeLambda([&](){
+            const auto validate = [&]() {
                 if (!r.valid()) {
                     r.validate();
                 }
-            }, "validate after adding " + std::to_string(brushes.size()) + " brushes to BrushRenderer");
+            };
+
+            runBenchmark("BrushRenderer: add " + std::to_string(brushes.size()) + " brushes", [&]() {
+                r.clear();
+            }, [&]() {
+                r.addBrushes(brushes);
+            });
+            runBenchmark("BrushRenderer: validate after adding " + std::to_string(brushes.size()) + " brushes", [&]() {
+                r.clear();
+                r.addBrushes(brushes);
+            }, validate);
 
             // Tiny change: remove the last brush
             std::vector<Model::Brush*> brushesMinusOne = brushes;
             assert(!brushesMinusOne.empty());
             brushesMinusOne.pop_back();
 
-            timeLambda([&](){ r.setBrushes(brushesMinusOne); }, "setBrushes to " + std::to_string(brushesMinusOne.size()) + " (removing one)");
-            timeLambda([&](){
-                if (!r.valid()) {
-                    r.validate();
-                }
-            }, "validate after removing one brush");
+            const auto resetToAllBrushes = [&]() {
+                r.setBrushes(brushes);
+                validate();
+            };
+
+            runBenchmark("BrushRenderer: setBrushes to " + std::to_string(brushesMinusOne.size()) + " (removing one)", resetToAllBrushes, [&]() {
+                r.setBrushes(brushesMinusOne);
+            });
+            runBenchmark("BrushRenderer: validate after removing one brush", [&]() {
+                resetToAllBrushes();
+                r.setBrushes(brushesMinusOne);
+            }, validate);
 
             // Large change: keep every second brush
             std::vector<Model::Brush*> brushesToKeep;
@@ -113,15 +128,13 @@ namespace TrenchBroom {
                 }
             }
 
-            timeLambda([&](){ r.setBrushes(brushesToKeep); },
-                       "set brushes from " + std::to_string(brushes.size()) +
-                       " to " + std::to_string(brushesToKeep.size()));
-
-            timeLambda([&](){
-                           if (!r.valid()) {
-                               r.validate();
-                           }
-                       }, "validate with " + std::to_string(brushesToKeep.size()) + " brushes");
+            runBenchmark("BrushRenderer: set brushes from " + std::to_string(brushes.size()) + " to " + std::to_string(brushesToKeep.size()), resetToAllBrushes, [&]() {
+                r.setBrushes(brushesToKeep);
+            });
+            runBenchmark("BrushRenderer: validate with " + std::to_string(brushesToKeep.size()) + " brushes", [&]() {
+                resetToAllBrushes();
+                r.setBrushes(brushesToKeep);
+            }, validate);
 
             kdl::vec_clear_and_delete(brushes);
             kdl::vec_clear_and_delete(textures);
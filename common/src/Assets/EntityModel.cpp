@@ -19,7 +19,7 @@
 
 #include "EntityModel.h"
 
-#include "AABBTree.h"
+#include "Assets/EntityModelPickingTree.h"
 #include "Assets/TextureCollection.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/PrimType.h"
@@ -28,8 +28,9 @@
 
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
-#include <vecmath/intersection.h>
+#include <vecmath/scalar.h>
 
+#include <mutex>
 #include <string>
 
 namespace TrenchBroom {
@@ -50,8 +51,7 @@ namespace TrenchBroom {
         EntityModelLoadedFrame::EntityModelLoadedFrame(const size_t index, const std::string& name, const vm::bbox3f& bounds) :
         EntityModelFrame(index),
         m_name(name),
-        m_bounds(bounds),
-        m_spacialTree(std::make_unique<SpacialTree>()) {}
+        m_bounds(bounds) {}
 
         EntityModelLoadedFrame::~EntityModelLoadedFrame() = default;
 
@@ -68,98 +68,29 @@ namespace TrenchBroom {
         }
 
         float EntityModelLoadedFrame::intersect(const vm::ray3f& ray) const {
-            auto closestDistance = vm::nan<float>();
-
-            const auto candidates = m_spacialTree->findIntersectors(ray);
-            for (const TriNum triNum : candidates) {
-                const vm::vec3f& p1 = m_tris[triNum * 3 + 0];
-                const vm::vec3f& p2 = m_tris[triNum * 3 + 1];
-                const vm::vec3f& p3 = m_tris[triNum * 3 + 2];
-                closestDistance = vm::safe_min(closestDistance, vm::intersect_ray_triangle(ray, p1, p2, p3));
-            }
-
-            return closestDistance;
+            return spacialTree().intersect(ray);
         }
 
         void EntityModelLoadedFrame::addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count) {
-            switch (primType) {
-                case Renderer::PrimType::Points:
-                case Renderer::PrimType::Lines:
-                case Renderer::PrimType::LineStrip:
-                case Renderer::PrimType::LineLoop:
-                    break;
-                case Renderer::PrimType::Triangles: {
-                    assert(count % 3 == 0);
-                    m_tris.reserve(m_tris.size() + count);
-                    for (size_t i = 0; i < count; i += 3) {
-                        vm::bbox3f::builder bounds;
-                        const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
-                        const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-                        const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
-
-                        const size_t triIndex = m_tris.size() / 3u;
-                        m_tris.push_back(p1);
-                        m_tris.push_back(p2);
-                        m_tris.push_back(p3);
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
-                    }
-                    break;
-                }
-                case Renderer::PrimType::Polygon:
-                case Renderer::PrimType::TriangleFan: {
-                    assert(count > 2);
-                    m_tris.reserve(m_tris.size() + (count - 2) * 3);
-
-                    const auto& p1 = Renderer::getVertexComponent<0>(vertices[index]);
-                    for (size_t i = 1; i < count - 1; ++i) {
-                        vm::bbox3f::builder bounds;
-                        const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i]);
-                        const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p2);
-
-                        const size_t triIndex = m_tris.size() / 3u;
-                        m_tris.push_back(p1);
-                        m_tris.push_back(p2);
-                        m_tris.push_back(p3);
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
-                    }
-                    break;
-                }
-                case Renderer::PrimType::Quads:
-                case Renderer::PrimType::QuadStrip:
-                case Renderer::PrimType::TriangleStrip: {
-                    assert(count > 2);
-                    m_tris.reserve(m_tris.size() + (count - 2) * 3);
-                    for (size_t i = 0; i < count-2; ++i) {
-                        vm::bbox3f::builder bounds;
-                        const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
-                        const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-                        const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p2);
-
-                        const size_t triIndex = m_tris.size() / 3u;
-                        if (i % 2 == 0) {
-                            m_tris.push_back(p1);
-                            m_tris.push_back(p2);
-                            m_tris.push_back(p3);
-                        } else {
-                            m_tris.push_back(p1);
-                            m_tris.push_back(p3);
-                            m_tris.push_back(p2);
-                        }
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
-                    }
-                    break;
+            assert(!hasSpacialTree());
+            m_spacialPrimitives.push_back(SpacialPrimitives{ &vertices, primType, index, count });
+        }
+
+        bool EntityModelLoadedFrame::hasSpacialTree() const {
+            return m_spacialTree != nullptr;
+        }
+
+        const EntityModelPickingTree& EntityModelLoadedFrame::spacialTree() const {
+            // most frames are never picked, so the tree is built on demand
+            std::call_once(m_spacialTreeBuilt, [this]() {
+                auto tree = std::make_unique<EntityModelPickingTree>();
+                for (const auto& primitives : m_spacialPrimitives) {
+                    tree->addPrimitives(*primitives.vertices, primitives.primType, primitives.index, primitives.count);
                 }
-                switchDefault();
-            }
+                tree->build();
+                m_spacialTree = std::move(tree);
+            });
+            return *m_spacialTree;
         }
 
         // EntityModel::UnloadedFrame
@@ -212,6 +143,15 @@ namespace TrenchBroom {
              */
             explicit EntityModelMesh(const std::vector<EntityModelVertex>& vertices) :
             m_vertices(vertices) {}
+
+            /**
+             * Returns the vertices of this mesh. They are never modified, so frames can reference them.
+             *
+             * @return the vertices
+             */
+            const std::vector<EntityModelVertex>& vertices() const {
+                return m_vertices;
+            }
         public:
             virtual ~EntityModelMesh() = default;
         public:
@@ -255,10 +195,10 @@ namespace TrenchBroom {
             EntityModelIndexedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelIndices& indices) :
             EntityModelMesh(vertices),
             m_indices(indices) {
-                m_indices.forEachPrimitive([&frame, &vertices](const Renderer::PrimType primType, const size_t index, const size_t count) {
-                    frame.addToSpacialTree(vertices, primType, index, count);
+                m_indices.forEachPrimitive([this, &frame](const Renderer::PrimType primType, const size_t index, const size_t count) {
+                    frame.addToSpacialTree(this->vertices(), primType, index, count);
                 });
-        }
+            }
         private:
             std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* skin, const Renderer::VertexArray& vertices) override {
                 const Renderer::TexturedIndexRangeMap texturedIndices(skin, m_indices);
@@ -285,8 +225,8 @@ namespace TrenchBroom {
             EntityModelTexturedMesh(EntityModelLoadedFrame& frame, const std::vector<EntityModelVertex>& vertices, const EntityModelTexturedIndices& indices) :
             EntityModelMesh(vertices),
             m_indices(indices) {
-                m_indices.forEachPrimitive([&frame, &vertices](const Assets::Texture* /* texture */, const Renderer::PrimType primType, const size_t index, const size_t count) {
-                    frame.addToSpacialTree(vertices, primType, index, count);
+                m_indices.forEachPrimitive([this, &frame](const Assets::Texture* /* texture */, const Renderer::PrimType primType, const size_t index, const size_t count) {
+                    frame.addToSpacialTree(this->vertices(), primType, index, count);
                 });
             }
         private:
@@ -365,7 +305,8 @@ namespace TrenchBroom {
 
         EntityModel::EntityModel(const std::string& name) :
         m_name(name),
-        m_prepared(false) {}
+        m_prepared(false),
+        m_skinsLoaded(true) {}
 
         std::unique_ptr<Renderer::TexturedRenderer> EntityModel::buildRenderer(const size_t skinIndex, const size_t frameIndex) const {
             std::vector<std::unique_ptr<Renderer::TexturedIndexRangeRenderer>> renderers;
@@ -409,6 +350,14 @@ namespace TrenchBroom {
             }
         }
 
+        bool EntityModel::skinsLoaded() const {
+            return m_skinsLoaded;
+        }
+
+        void EntityModel::setSkinsLoaded(const bool skinsLoaded) {
+            m_skinsLoaded = skinsLoaded;
+        }
+
         void EntityModel::addFrames(const size_t count) {
             for (size_t i = 0; i < count; ++i) {
                 m_frames.emplace_back(std::make_unique<EntityModelUnloadedFrame>(frameCount()));
@@ -426,6 +375,18 @@ namespace TrenchBroom {
             return result;
         }
 
+        void EntityModel::setFrameOffsets(std::vector<size_t> frameOffsets) {
+            assert(frameOffsets.size() == frameCount());
+            m_frameOffsets = std::move(frameOffsets);
+        }
+
+        size_t EntityModel::frameOffset(const size_t frameIndex) const {
+            if (frameIndex >= m_frameOffsets.size()) {
+                throw AssetException("No offset recorded for frame index " + std::to_string(frameIndex));
+            }
+            return m_frameOffsets[frameIndex];
+        }
+
         EntityModelSurface& EntityModel::addSurface(const std::string& name) {
             m_surfaces.push_back(std::make_unique<EntityModelSurface>(name, frameCount()));
             return *m_surfaces.back();
@@ -26,12 +26,11 @@
 #include <vecmath/bbox.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
-    template <typename T, size_t S, typename U> class AABBTree;
-
     namespace Renderer {
         enum class PrimType;
         class TexturedIndexRangeRenderer;
@@ -39,6 +38,7 @@ namespace TrenchBroom {
     }
 
     namespace Assets {
+        class EntityModelPickingTree;
         class Texture;
         class TextureCollection;
 
@@ -105,11 +105,16 @@ namespace TrenchBroom {
             std::string m_name;
             vm::bbox3f m_bounds;
 
-            // For hit testing
-            std::vector<vm::vec3f> m_tris;
-            using TriNum = size_t;
-            using SpacialTree = AABBTree<float, 3, TriNum>;
-            std::unique_ptr<SpacialTree> m_spacialTree;
+            // For hit testing, the spacial tree is built from the recorded primitives when the frame is first picked
+            struct SpacialPrimitives {
+                const std::vector<EntityModelVertex>* vertices;
+                Renderer::PrimType primType;
+                size_t index;
+                size_t count;
+            };
+            std::vector<SpacialPrimitives> m_spacialPrimitives;
+            mutable std::once_flag m_spacialTreeBuilt;
+            mutable std::unique_ptr<EntityModelPickingTree> m_spacialTree;
         public:
             /**
              * Creates a new frame with the given index, name and bounds.
@@ -128,7 +133,9 @@ namespace TrenchBroom {
             float intersect(const vm::ray3f& ray) const override;
 
             /**
-             * Adds the given primitives to the spacial tree for this frame.
+             * Adds the given primitives to the spacial tree for this frame. The tree is only built when this frame is
+             * intersected with a ray for the first time, and it references the given vertices instead of copying them,
+             * so they must remain unchanged for the lifetime of this frame.
              *
              * @param vertices the vertices
              * @param primType the primitive type
@@ -136,6 +143,16 @@ namespace TrenchBroom {
              * @param count the number of vertices that make up the primitive(s)
              */
             void addToSpacialTree(const std::vector<EntityModelVertex>& vertices, Renderer::PrimType primType, size_t index, size_t count);
+
+            /**
+             * Indicates whether the spacial tree of this frame has been built.
+             */
+            bool hasSpacialTree() const;
+
+            /**
+             * Returns the spacial tree of this frame, building it if necessary.
+             */
+            const EntityModelPickingTree& spacialTree() const;
         };
 
         class EntityModelUnloadedFrame;
@@ -258,7 +275,9 @@ namespace TrenchBroom {
         private:
             std::string m_name;
             bool m_prepared;
+            bool m_skinsLoaded;
             std::vector<std::unique_ptr<EntityModelFrame>> m_frames;
+            std::vector<size_t> m_frameOffsets;
             std::vector<std::unique_ptr<EntityModelSurface>> m_surfaces;
         public:
             /**
@@ -308,6 +327,21 @@ namespace TrenchBroom {
              */
             void setTextureMode(int minFilter, int magFilter);
 
+            /**
+             * Indicates whether the skins of this model have been loaded. Parsers may defer loading the skins until
+             * the model is rendered for the first time, in which case this returns false until then.
+             *
+             * @return true if the skins of this model have been loaded and false otherwise
+             */
+            bool skinsLoaded() const;
+
+            /**
+             * Sets whether the skins of this model have been loaded.
+             *
+             * @param skinsLoaded true if the skins have been loaded and false if they still need to be loaded
+             */
+            void setSkinsLoaded(bool skinsLoaded);
+
             /**
              * Adds the given number of frames to this model.
              *
@@ -327,6 +361,25 @@ namespace TrenchBroom {
              */
             EntityModelLoadedFrame& loadFrame(size_t frameIndex, const std::string& name, const vm::bbox3f& bounds);
 
+            /**
+             * Sets the offsets of the frames' data in the model file. Parsers for formats whose frames differ in size
+             * record these when the model is initialized so that a frame can be loaded without walking all of the
+             * preceding frames.
+             *
+             * @param frameOffsets the offset of each frame, must contain one offset per frame
+             */
+            void setFrameOffsets(std::vector<size_t> frameOffsets);
+
+            /**
+             * Returns the offset of the data of the given frame in the model file.
+             *
+             * @param frameIndex the index of the frame
+             * @return the offset of the frame
+             *
+             * @throws AssetException if no offset was recorded for the given frame
+             */
+            size_t frameOffset(size_t frameIndex) const;
+
             /**
              * Adds a surface with the given name.
              *
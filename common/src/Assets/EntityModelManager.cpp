@@ -80,6 +80,10 @@ namespace TrenchBroom {
                 return nullptr;
             }
 
+            if (!entityModel->skinsLoaded()) {
+                loadSkins(spec.path, *entityModel);
+            }
+
             auto renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex);
             if (renderer != nullptr) {
                 const auto [pos, success] = m_renderers.insert({ spec, std::move(renderer) });
@@ -129,7 +133,10 @@ namespace TrenchBroom {
                 assert(success); unused(success);
 
                 auto* model = pos->second.get();
-                m_unpreparedModels.push_back(model);
+                if (model->skinsLoaded()) {
+                    // models whose skins are deferred are prepared once their skins have been loaded
+                    m_unpreparedModels.push_back(model);
+                }
 
                 m_logger.debug() << "Loaded entity model " << path;
 
@@ -164,6 +171,20 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelManager::loadSkins(const IO::Path& path, Assets::EntityModel& model) const {
+            try {
+                ensure(m_loader != nullptr, "loader is null");
+                m_loader->loadSkins(path, model, m_logger);
+                m_logger.debug() << "Loaded entity model skins " << path;
+            } catch (const Exception& e) {
+                m_logger.error() << "Could not load entity model skins " << path << ": " << e.what();
+            }
+
+            // don't try again if loading failed, the model is rendered without skins instead
+            model.setSkinsLoaded(true);
+            m_unpreparedModels.push_back(&model);
+        }
+
         void EntityModelManager::prepare(Renderer::VboManager& vboManager) {
             resetTextureMode();
             prepareModels();
@@ -89,6 +89,7 @@ namespace TrenchBroom {
             EntityModel* safeGetModel(const IO::Path& path) const;
             std::unique_ptr<EntityModel> loadModel(const IO::Path& path) const;
             void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
+            void loadSkins(const IO::Path& path, EntityModel& model) const;
         public:
             void prepare(Renderer::VboManager& vboManager);
         private:
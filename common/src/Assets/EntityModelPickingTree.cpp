@@ -0,0 +1,328 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "EntityModelPickingTree.h"
+
+#include "Macros.h"
+#include "Renderer/GLVertex.h"
+#include "Renderer/PrimType.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/constants.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace TrenchBroom {
+    namespace Assets {
+        static constexpr auto Miss = std::numeric_limits<float>::infinity();
+
+        /**
+         * Returns the distance at which the given ray enters the given bounds, or Miss if the ray does not hit the bounds.
+         * Returns 0 if the ray origin is contained in the bounds.
+         */
+        static float intersectBounds(const vm::bbox3f& bounds, const vm::vec3f& origin, const vm::vec3f& invDirection) {
+            auto tNear = 0.0f;
+            auto tFar = std::numeric_limits<float>::max();
+            for (size_t i = 0; i < 3; ++i) {
+                auto t1 = (bounds.min[i] - origin[i]) * invDirection[i];
+                auto t2 = (bounds.max[i] - origin[i]) * invDirection[i];
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                }
+                // NaN (an axis parallel ray on a slab boundary) doesn't shrink the interval
+                if (t1 > tNear) {
+                    tNear = t1;
+                }
+                if (t2 < tFar) {
+                    tFar = t2;
+                }
+            }
+            return tNear <= tFar ? tNear : Miss;
+        }
+
+        void EntityModelPickingTree::addPrimitives(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count) {
+            if (m_meshes.empty() || m_meshes.back() != &vertices) {
+                m_meshes.push_back(&vertices);
+            }
+            assert(vertices.size() <= std::numeric_limits<std::uint32_t>::max());
+            const auto mesh = static_cast<std::uint32_t>(m_meshes.size() - 1u);
+
+            switch (primType) {
+                case Renderer::PrimType::Points:
+                case Renderer::PrimType::Lines:
+                case Renderer::PrimType::LineStrip:
+                case Renderer::PrimType::LineLoop:
+                    break;
+                case Renderer::PrimType::Triangles:
+                    assert(count % 3 == 0);
+                    m_triangles.reserve(m_triangles.size() + count / 3u);
+                    for (size_t i = 0; i < count; i += 3) {
+                        addTriangle(mesh, index + i + 0, index + i + 1, index + i + 2);
+                    }
+                    break;
+                case Renderer::PrimType::Polygon:
+                case Renderer::PrimType::TriangleFan:
+                    assert(count > 2);
+                    m_triangles.reserve(m_triangles.size() + count - 2u);
+                    for (size_t i = 1; i < count - 1; ++i) {
+                        addTriangle(mesh, index, index + i, index + i + 1);
+                    }
+                    break;
+                case Renderer::PrimType::Quads:
+                case Renderer::PrimType::QuadStrip:
+                case Renderer::PrimType::TriangleStrip:
+                    assert(count > 2);
+                    m_triangles.reserve(m_triangles.size() + count - 2u);
+                    for (size_t i = 0; i < count - 2; ++i) {
+                        if (i % 2 == 0) {
+                            addTriangle(mesh, index + i + 0, index + i + 1, index + i + 2);
+                        } else {
+                            addTriangle(mesh, index + i + 0, index + i + 2, index + i + 1);
+                        }
+                    }
+                    break;
+                switchDefault();
+            }
+        }
+
+        void EntityModelPickingTree::addTriangle(const std::uint32_t mesh, const size_t v1, const size_t v2, const size_t v3) {
+            m_triangles.push_back(Triangle{ mesh, {
+                static_cast<std::uint32_t>(v1),
+                static_cast<std::uint32_t>(v2),
+                static_cast<std::uint32_t>(v3)
+            }});
+        }
+
+        void EntityModelPickingTree::build() {
+            m_nodes.clear();
+            if (m_triangles.empty()) {
+                return;
+            }
+
+            // the triangle bounds and centers are only needed while building
+            std::vector<vm::bbox3f> bounds;
+            std::vector<vm::vec3f> centers;
+            bounds.reserve(m_triangles.size());
+            centers.reserve(m_triangles.size());
+
+            for (const auto& triangle : m_triangles) {
+                vm::bbox3f::builder builder;
+                for (const auto vertex : triangle.vertices) {
+                    builder.add(position(triangle.mesh, vertex));
+                }
+                bounds.push_back(builder.bounds());
+                centers.push_back(builder.bounds().center());
+            }
+
+            std::vector<std::uint32_t> order(m_triangles.size());
+            std::iota(std::begin(order), std::end(order), 0u);
+
+            // every leaf holds at least two triangles, so there are at most as many nodes as triangles
+            m_nodes.reserve(m_triangles.size());
+            buildNode(bounds, centers, order, 0u, m_triangles.size());
+            m_nodes.shrink_to_fit();
+
+            // store the triangles in leaf order
+            std::vector<Triangle> triangles;
+            triangles.reserve(m_triangles.size());
+            for (const auto i : order) {
+                triangles.push_back(m_triangles[i]);
+            }
+            m_triangles = std::move(triangles);
+            m_meshes.shrink_to_fit();
+        }
+
+        size_t EntityModelPickingTree::buildNode(const std::vector<vm::bbox3f>& bounds, const std::vector<vm::vec3f>& centers, std::vector<std::uint32_t>& order, const size_t first, const size_t count) {
+            assert(count > 0u);
+
+            const auto nodeIndex = m_nodes.size();
+            m_nodes.push_back(Node{ vm::bbox3f(), 0u, 0u });
+
+            vm::bbox3f::builder nodeBounds;
+            vm::bbox3f::builder centerBounds;
+            for (size_t i = first; i < first + count; ++i) {
+                nodeBounds.add(bounds[order[i]]);
+                centerBounds.add(centers[order[i]]);
+            }
+
+            if (count <= LeafSize) {
+                m_nodes[nodeIndex] = Node{ nodeBounds.bounds(), static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(count) };
+                return nodeIndex;
+            }
+
+            // split at the median center along the longest axis of the centers' bounds
+            const auto size = centerBounds.bounds().size();
+            size_t axis = 0u;
+            for (size_t i = 1u; i < 3u; ++i) {
+                if (size[i] > size[axis]) {
+                    axis = i;
+                }
+            }
+
+            const auto begin = std::next(std::begin(order), static_cast<std::ptrdiff_t>(first));
+            const auto mid = std::next(begin, static_cast<std::ptrdiff_t>(count / 2u));
+            const auto end = std::next(begin, static_cast<std::ptrdiff_t>(count));
+            std::nth_element(begin, mid, end, [&](const std::uint32_t lhs, const std::uint32_t rhs) {
+                return centers[lhs][axis] < centers[rhs][axis];
+            });
+
+            buildNode(bounds, centers, order, first, count / 2u);
+            const auto right = buildNode(bounds, centers, order, first + count / 2u, count - count / 2u);
+
+            m_nodes[nodeIndex] = Node{ nodeBounds.bounds(), static_cast<std::uint32_t>(right), 0u };
+            return nodeIndex;
+        }
+
+        bool EntityModelPickingTree::empty() const {
+            return m_nodes.empty();
+        }
+
+        size_t EntityModelPickingTree::triangleCount() const {
+            return m_triangles.size();
+        }
+
+        size_t EntityModelPickingTree::nodeCount() const {
+            return m_nodes.size();
+        }
+
+        size_t EntityModelPickingTree::memoryUsage() const {
+            return sizeof(EntityModelPickingTree)
+                + m_meshes.capacity() * sizeof(const std::vector<EntityModelVertex>*)
+                + m_triangles.capacity() * sizeof(Triangle)
+                + m_nodes.capacity() * sizeof(Node);
+        }
+
+        float EntityModelPickingTree::intersect(const vm::ray3f& ray) const {
+            if (m_nodes.empty()) {
+                return vm::nan<float>();
+            }
+
+            const auto invDirection = vm::vec3f(1.0f / ray.direction[0], 1.0f / ray.direction[1], 1.0f / ray.direction[2]);
+
+            struct Entry {
+                std::uint32_t node;
+                float distance;
+            };
+
+            // the tree is balanced, so its depth is bounded by the number of bits of the triangle indices
+            std::array<Entry, 64u> stack;
+            size_t top = 0u;
+
+            auto closest = Miss;
+            const auto rootDistance = intersectBounds(m_nodes.front().bounds, ray.origin, invDirection);
+            if (rootDistance < Miss) {
+                stack[top++] = Entry{ 0u, rootDistance };
+            }
+
+            while (top > 0u) {
+                const auto entry = stack[--top];
+                if (entry.distance >= closest) {
+                    continue;
+                }
+
+                const auto& node = m_nodes[entry.node];
+                if (node.count > 0u) {
+                    closest = std::min(closest, intersectLeaf(node, ray));
+                } else {
+                    auto nearChild = Entry{ entry.node + 1u, intersectBounds(m_nodes[entry.node + 1u].bounds, ray.origin, invDirection) };
+                    auto farChild = Entry{ node.index, intersectBounds(m_nodes[node.index].bounds, ray.origin, invDirection) };
+                    if (farChild.distance < nearChild.distance) {
+                        std::swap(nearChild, farChild);
+                    }
+
+                    // the nearer child is pushed last so that it is visited first
+                    assert(top + 2u <= stack.size());
+                    if (farChild.distance < closest) {
+                        stack[top++] = farChild;
+                    }
+                    if (nearChild.distance < closest) {
+                        stack[top++] = nearChild;
+                    }
+                }
+            }
+
+            return closest < Miss ? closest : vm::nan<float>();
+        }
+
+        const vm::vec3f& EntityModelPickingTree::position(const std::uint32_t mesh, const std::uint32_t vertex) const {
+            return Renderer::getVertexComponent<0>((*m_meshes[mesh])[vertex]);
+        }
+
+        float EntityModelPickingTree::intersectLeaf(const Node& leaf, const vm::ray3f& ray) const {
+            assert(leaf.count > 0u && leaf.count <= LeafSize);
+
+            // Gather the triangles into a structure of arrays so that the intersection loop below can be vectorized. A
+            // leaf with fewer triangles is padded by repeating its last triangle.
+            float p0[3][LeafSize];
+            float e1[3][LeafSize];
+            float e2[3][LeafSize];
+            for (size_t i = 0; i < LeafSize; ++i) {
+                const auto& triangle = m_triangles[leaf.index + std::min(static_cast<std::uint32_t>(i), leaf.count - 1u)];
+                const auto& v0 = position(triangle.mesh, triangle.vertices[0]);
+                const auto& v1 = position(triangle.mesh, triangle.vertices[1]);
+                const auto& v2 = position(triangle.mesh, triangle.vertices[2]);
+                for (size_t j = 0; j < 3; ++j) {
+                    p0[j][i] = v0[j];
+                    e1[j][i] = v1[j] - v0[j];
+                    e2[j][i] = v2[j] - v0[j];
+                }
+            }
+
+            const auto ox = ray.origin[0], oy = ray.origin[1], oz = ray.origin[2];
+            const auto dx = ray.direction[0], dy = ray.direction[1], dz = ray.direction[2];
+            const auto epsilon = vm::Cf::almost_zero();
+
+            // same computation as vm::intersect_ray_triangle, but without branches
+            float distances[LeafSize];
+            for (size_t i = 0; i < LeafSize; ++i) {
+                const auto px = dy * e2[2][i] - dz * e2[1][i];
+                const auto py = dz * e2[0][i] - dx * e2[2][i];
+                const auto pz = dx * e2[1][i] - dy * e2[0][i];
+                const auto a = px * e1[0][i] + py * e1[1][i] + pz * e1[2][i];
+                const auto f = 1.0f / a;
+
+                const auto tx = ox - p0[0][i];
+                const auto ty = oy - p0[1][i];
+                const auto tz = oz - p0[2][i];
+                const auto u = (px * tx + py * ty + pz * tz) * f;
+
+                const auto qx = ty * e1[2][i] - tz * e1[1][i];
+                const auto qy = tz * e1[0][i] - tx * e1[2][i];
+                const auto qz = tx * e1[1][i] - ty * e1[0][i];
+                const auto v = (dx * qx + dy * qy + dz * qz) * f;
+                const auto t = (e2[0][i] * qx + e2[1][i] * qy + e2[2][i] * qz) * f;
+
+                // not short circuited so that the loop body doesn't branch
+                const auto hit = (std::abs(a) > epsilon) & (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (t >= 0.0f);
+                distances[i] = hit ? t : Miss;
+            }
+
+            return *std::min_element(std::begin(distances), std::end(distances));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_EntityModelPickingTree
+#define TrenchBroom_EntityModelPickingTree
+
+#include "Assets/EntityModel_Forward.h"
+
+#include <vecmath/forward.h>
+#include <vecmath/bbox.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        enum class PrimType;
+    }
+
+    namespace Assets {
+        /**
+         * A bounding volume hierarchy over the triangles of a model frame that is used to pick the frame with a ray.
+         *
+         * The tree does not copy any vertex positions. Its triangles are stored as indices into the vertex arrays of the
+         * frame's meshes, which must outlive the tree and must not be modified. The nodes are stored in a flat array, and
+         * every leaf holds up to LeafSize triangles which are tested against the ray together.
+         */
+        class EntityModelPickingTree {
+        public:
+            /**
+             * The maximum number of triangles per leaf.
+             */
+            static constexpr size_t LeafSize = 4u;
+        private:
+            struct Triangle {
+                std::uint32_t mesh;
+                std::uint32_t vertices[3];
+            };
+
+            /**
+             * An inner node has a count of 0, its left child directly follows it and its right child is at the given
+             * index. A leaf references count triangles starting at the given index.
+             */
+            struct Node {
+                vm::bbox3f bounds;
+                std::uint32_t index;
+                std::uint32_t count;
+            };
+
+            std::vector<const std::vector<EntityModelVertex>*> m_meshes;
+            std::vector<Triangle> m_triangles;
+            std::vector<Node> m_nodes;
+        public:
+            /**
+             * Adds the triangles of the given primitives to this tree. The tree must be rebuilt afterwards.
+             *
+             * @param vertices the mesh vertices, which are referenced and not copied
+             * @param primType the primitive type, points and lines are ignored
+             * @param index the index of the first primitive's first vertex in the given vertex array
+             * @param count the number of vertices that make up the primitive(s)
+             */
+            void addPrimitives(const std::vector<EntityModelVertex>& vertices, Renderer::PrimType primType, size_t index, size_t count);
+
+            /**
+             * Builds the hierarchy over all triangles that were added.
+             */
+            void build();
+
+            bool empty() const;
+            size_t triangleCount() const;
+            size_t nodeCount() const;
+
+            /**
+             * Returns the number of bytes allocated by this tree.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * Intersects the triangles of this tree with the given ray.
+             *
+             * @param ray the ray to intersect
+             * @return the distance to the closest point of intersection or NaN if the given ray does not hit any triangle
+             */
+            float intersect(const vm::ray3f& ray) const;
+        private:
+            void addTriangle(std::uint32_t mesh, size_t v1, size_t v2, size_t v3);
+            size_t buildNode(const std::vector<vm::bbox3f>& bounds, const std::vector<vm::vec3f>& centers, std::vector<std::uint32_t>& order, size_t first, size_t count);
+            const vm::vec3f& position(std::uint32_t mesh, std::uint32_t vertex) const;
+            float intersectLeaf(const Node& leaf, const vm::ray3f& ray) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityModelPickingTree) */
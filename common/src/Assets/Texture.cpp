@@ -20,6 +20,7 @@
 #include "Texture.h"
 #include "Assets/TextureBuffer.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidency.h"
 #include "Renderer/GL.h"
 
 #include <algorithm> // for std::max
@@ -39,7 +40,10 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {
+        m_textureId(0),
+        m_array(nullptr),
+        m_layer(0),
+        m_residency(nullptr) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * bytesPerPixelForFormat(format));
@@ -59,7 +63,10 @@ namespace TrenchBroom {
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId(0),
-        m_buffers(std::move(buffers)) {
+        m_buffers(std::move(buffers)),
+        m_array(nullptr),
+        m_layer(0),
+        m_residency(nullptr) {
             assert(m_width > 0);
             assert(m_height > 0);
 
@@ -84,7 +91,10 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {}
+        m_textureId(0),
+        m_array(nullptr),
+        m_layer(0),
+        m_residency(nullptr) {}
 
         Texture::~Texture() {
             if (m_collection == nullptr && m_textureId != 0) {
@@ -145,6 +155,10 @@ namespace TrenchBroom {
             m_culling = culling;
         }
 
+        const TextureBlendFunc& Texture::blendFunc() const {
+            return m_blendFunc;
+        }
+
         void Texture::setBlendFunc(GLenum srcFactor, GLenum destFactor) {
             m_blendFunc.enable = TextureBlendFunc::Enable::UseFactors;
             m_blendFunc.srcFactor = srcFactor;
@@ -191,46 +205,83 @@ namespace TrenchBroom {
             assert(m_textureId == 0);
 
             if (!m_buffers.empty()) {
-                glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
-                glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
-                glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
-
-                glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+                uploadBuffers(textureId, minFilter, magFilter);
+                m_buffers.clear();
+                m_textureId = textureId;
+            }
+        }
 
-                if (m_type == TextureType::Masked) {
-                    // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-                } else if (m_buffers.size() == 1) {
-                    // generate mipmaps if we don't have any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
-                } else {
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
-                }
+        size_t Texture::upload(const int minFilter, const int magFilter) const {
+            assert(m_textureId == 0);
 
-                // Upload only the first mipmap for masked textures.
-                const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+            if (m_buffers.empty()) {
+                return 0u;
+            }
 
-                for (size_t j = 0; j < mipmapsToUpload; ++j) {
-                    const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+            GLuint textureId = 0;
+            glAssert(glGenTextures(1, &textureId));
+            uploadBuffers(textureId, minFilter, magFilter);
+            m_textureId = textureId;
+
+            // every level is stored as RGBA, and generated mipmaps add another third
+            const auto levels = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+            size_t result = 0u;
+            for (size_t level = 0; level < levels; ++level) {
+                const auto mipSize = sizeAtMipLevel(m_width, m_height, level);
+                result += mipSize.x() * mipSize.y() * 4u;
+            }
+            if (m_type != TextureType::Masked && m_buffers.size() == 1u) {
+                result += result / 3u;
+            }
+            return result;
+        }
 
-                    const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
-                    glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
-                                          static_cast<GLsizei>(mipSize.x()),
-                                          static_cast<GLsizei>(mipSize.y()),
-                                          0, m_format, GL_UNSIGNED_BYTE, data));
-                }
+        void Texture::evict() const {
+            if (m_textureId != 0) {
+                glAssert(glDeleteTextures(1, &m_textureId));
+                m_textureId = 0;
+            }
+        }
 
-                m_buffers.clear();
-                m_textureId = textureId;
+        void Texture::uploadBuffers(const GLuint textureId, const int minFilter, const int magFilter) const {
+            assert(!m_buffers.empty());
+
+            glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+            glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+            glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+            glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+
+            if (m_type == TextureType::Masked) {
+                // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            } else if (m_buffers.size() == 1) {
+                // generate mipmaps if we don't have any
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
+            } else {
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
+            }
+
+            // Upload only the first mipmap for masked textures.
+            const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+
+            for (size_t j = 0; j < mipmapsToUpload; ++j) {
+                const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+
+                const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
+                glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
+                                      static_cast<GLsizei>(mipSize.x()),
+                                      static_cast<GLsizei>(mipSize.y()),
+                                      0, m_format, GL_UNSIGNED_BYTE, data));
             }
         }
 
@@ -250,6 +301,10 @@ namespace TrenchBroom {
         }
 
         void Texture::activate() const {
+            if (m_residency != nullptr) {
+                m_residency->use(this);
+            }
+
             if (isPrepared()) {
                 glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
 
@@ -306,6 +361,14 @@ namespace TrenchBroom {
             }
         }
 
+        const TextureArray* Texture::array() const {
+            return m_array;
+        }
+
+        size_t Texture::layer() const {
+            return m_layer;
+        }
+
         const Texture::BufferList& Texture::buffersIfUnprepared() const {
             return m_buffers;
         }
@@ -321,5 +384,14 @@ namespace TrenchBroom {
         void Texture::setCollection(TextureCollection* collection) {
             m_collection = collection;
         }
+
+        void Texture::setArray(const TextureArray* array, const size_t layer) {
+            m_array = array;
+            m_layer = layer;
+        }
+
+        void Texture::setResidency(TextureResidency* residency) {
+            m_residency = residency;
+        }
     }
 }
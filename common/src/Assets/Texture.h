@@ -31,7 +31,9 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        class TextureArray;
         class TextureCollection;
+        class TextureResidency;
 
         enum class TextureType {
             Opaque,
@@ -99,6 +101,11 @@ namespace TrenchBroom {
 
             mutable GLuint m_textureId;
             mutable BufferList m_buffers;
+
+            const TextureArray* m_array;
+            size_t m_layer;
+
+            TextureResidency* m_residency;
         public:
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, Buffer&& buffer, GLenum format, TextureType type);
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, BufferList&& buffers, GLenum format, TextureType type);
@@ -124,6 +131,7 @@ namespace TrenchBroom {
             TextureCulling culling() const;
             void setCulling(TextureCulling culling);
 
+            const TextureBlendFunc& blendFunc() const;
             void setBlendFunc(GLenum srcFactor, GLenum destFactor);
             void disableBlend();
 
@@ -135,10 +143,35 @@ namespace TrenchBroom {
 
             bool isPrepared() const;
             void prepare(GLuint textureId, int minFilter, int magFilter);
+
+            /**
+             * Uploads this texture into a new OpenGL texture. Unlike prepare(), the texture data is kept so that the
+             * texture can be evicted and uploaded again later.
+             *
+             * @return the number of bytes of video memory used by the uploaded texture
+             */
+            size_t upload(int minFilter, int magFilter) const;
+
+            /**
+             * Deletes the OpenGL texture created by upload().
+             */
+            void evict() const;
             void setMode(int minFilter, int magFilter);
 
             void activate() const;
             void deactivate() const;
+
+            /**
+             * Returns the texture array that holds a copy of this texture, or null if this texture was not packed into
+             * an array. Faces using a texture that belongs to an array can be rendered together with the faces using
+             * the other textures of that array.
+             */
+            const TextureArray* array() const;
+
+            /**
+             * Returns the layer of this texture in its array, or 0 if this texture was not packed into an array.
+             */
+            size_t layer() const;
         public: // exposed for tests only
             /**
              * Returns the texture data in the format returned by format().
@@ -151,7 +184,16 @@ namespace TrenchBroom {
             GLenum format() const;
             TextureType type() const;
         private:
+            void uploadBuffers(GLuint textureId, int minFilter, int magFilter) const;
+
             void setCollection(TextureCollection* collection);
+            void setArray(const TextureArray* array, size_t layer);
+
+            /**
+             * Makes this texture use the given residency, which uploads it when it is first activated.
+             */
+            void setResidency(TextureResidency* residency);
+            friend class TextureArray;
             friend class TextureCollection;
         };
     }
@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureArray.h"
+
+#include "Ensure.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <map>
+#include <tuple>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureArray::TextureArray(std::vector<Texture*> textures) :
+        m_width(0),
+        m_height(0),
+        m_format(GL_RGBA),
+        m_type(TextureType::Opaque),
+        m_mipLevels(0),
+        m_textures(std::move(textures)),
+        m_textureId(0) {
+            ensure(!m_textures.empty(), "texture array must not be empty");
+
+            const auto* first = m_textures.front();
+            m_width = first->width();
+            m_height = first->height();
+            m_format = first->format();
+            m_type = first->type();
+            m_mipLevels = first->buffersIfUnprepared().size();
+
+            for (size_t i = 0; i < m_textures.size(); ++i) {
+                auto* texture = m_textures[i];
+                assert(canPack(texture));
+                assert(texture->width() == m_width && texture->height() == m_height);
+                assert(texture->format() == m_format && texture->type() == m_type);
+                assert(texture->buffersIfUnprepared().size() == m_mipLevels);
+                texture->setArray(this, i);
+            }
+        }
+
+        TextureArray::~TextureArray() {
+            if (m_textureId != 0) {
+                glAssert(glDeleteTextures(1, &m_textureId));
+                m_textureId = 0;
+            }
+        }
+
+        bool TextureArray::canPack(const Texture* texture) {
+            return !texture->isPrepared()
+                && !texture->buffersIfUnprepared().empty()
+                && texture->culling() == TextureCulling::CullDefault
+                && texture->blendFunc().enable == TextureBlendFunc::Enable::UseDefault;
+        }
+
+        std::vector<std::unique_ptr<TextureArray>> TextureArray::pack(const std::vector<Texture*>& textures, const size_t maxLayers) {
+            assert(maxLayers > 1u);
+
+            using Key = std::tuple<size_t, size_t, GLenum, TextureType, size_t>;
+            std::map<Key, std::vector<Texture*>> groups;
+
+            for (auto* texture : textures) {
+                if (canPack(texture)) {
+                    const auto key = Key(texture->width(), texture->height(), texture->format(), texture->type(), texture->buffersIfUnprepared().size());
+                    groups[key].push_back(texture);
+                }
+            }
+
+            std::vector<std::unique_ptr<TextureArray>> result;
+            for (const auto& [key, group] : groups) {
+                for (size_t first = 0; first < group.size(); first += maxLayers) {
+                    const auto last = std::min(first + maxLayers, group.size());
+
+                    // a single texture doesn't save any binds, so it's left to be drawn on its own
+                    if (last - first > 1u) {
+                        auto layers = std::vector<Texture*>(std::next(std::begin(group), static_cast<std::ptrdiff_t>(first)),
+                                                            std::next(std::begin(group), static_cast<std::ptrdiff_t>(last)));
+                        result.push_back(std::make_unique<TextureArray>(std::move(layers)));
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        size_t TextureArray::width() const {
+            return m_width;
+        }
+
+        size_t TextureArray::height() const {
+            return m_height;
+        }
+
+        bool TextureArray::masked() const {
+            return m_type == TextureType::Masked;
+        }
+
+        size_t TextureArray::layerCount() const {
+            return m_textures.size();
+        }
+
+        const std::vector<Texture*>& TextureArray::textures() const {
+            return m_textures;
+        }
+
+        const Texture* TextureArray::batchTexture() const {
+            return m_textures.front();
+        }
+
+        bool TextureArray::isPrepared() const {
+            return m_textureId != 0;
+        }
+
+        void TextureArray::prepare(const int minFilter, const int magFilter) {
+            assert(!isPrepared());
+
+            glAssert(glGenTextures(1, &m_textureId));
+
+            glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+            glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+            glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureId));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT));
+            glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT));
+
+            // same mipmap policy as Texture::prepare, except that mipmaps are generated explicitly after uploading
+            const auto generateMipmaps = !masked() && m_mipLevels == 1u;
+            const auto mipmapsToUpload = masked() ? 1u : m_mipLevels;
+            if (!generateMipmaps) {
+                glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipmapsToUpload - 1u)));
+            }
+
+            for (size_t level = 0; level < mipmapsToUpload; ++level) {
+                const auto mipSize = sizeAtMipLevel(m_width, m_height, level);
+                glAssert(glTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), GL_RGBA,
+                                      static_cast<GLsizei>(mipSize.x()),
+                                      static_cast<GLsizei>(mipSize.y()),
+                                      static_cast<GLsizei>(layerCount()),
+                                      0, m_format, GL_UNSIGNED_BYTE, nullptr));
+
+                for (size_t layer = 0; layer < layerCount(); ++layer) {
+                    const auto& buffer = m_textures[layer]->buffersIfUnprepared()[level];
+                    glAssert(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level),
+                                             0, 0, static_cast<GLint>(layer),
+                                             static_cast<GLsizei>(mipSize.x()),
+                                             static_cast<GLsizei>(mipSize.y()),
+                                             1, m_format, GL_UNSIGNED_BYTE,
+                                             reinterpret_cast<const GLvoid*>(buffer.data())));
+                }
+            }
+
+            if (generateMipmaps) {
+                glAssert(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+            }
+
+            glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+            setMode(minFilter, magFilter);
+        }
+
+        void TextureArray::setMode(const int minFilter, const int magFilter) {
+            if (isPrepared()) {
+                activate();
+                if (masked()) {
+                    // Force GL_NEAREST filtering for masked textures.
+                    glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+                } else {
+                    glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, magFilter));
+                }
+                deactivate();
+            }
+        }
+
+        void TextureArray::activate() const {
+            if (isPrepared()) {
+                glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureId));
+            }
+        }
+
+        void TextureArray::deactivate() const {
+            if (isPrepared()) {
+                glAssert(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+            }
+        }
+    }
+}
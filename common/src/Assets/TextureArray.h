@@ -0,0 +1,108 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureArray
+#define TrenchBroom_TextureArray
+
+#include "Macros.h"
+#include "Renderer/GL.h"
+
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+        enum class TextureType;
+
+        /**
+         * A 2D array texture that holds copies of textures which have the same size, format, type and number of mip
+         * levels, one texture per layer. Faces using any of these textures can be drawn with a single draw call while
+         * the array is bound.
+         *
+         * The textures keep their own 2D textures for the texture browser and the UV editor, the array only adds a
+         * second copy for the map views.
+         */
+        class TextureArray {
+        public:
+            /**
+             * The minimum value of GL_MAX_ARRAY_TEXTURE_LAYERS that every OpenGL 3.0 implementation supports.
+             */
+            static constexpr size_t MaxLayers = 256u;
+        private:
+            size_t m_width;
+            size_t m_height;
+            GLenum m_format;
+            TextureType m_type;
+            size_t m_mipLevels;
+            std::vector<Texture*> m_textures;
+
+            GLuint m_textureId;
+        public:
+            /**
+             * Creates an array holding the given textures and assigns each texture its layer.
+             *
+             * The textures must not be empty, must not be prepared yet and must be compatible with each other.
+             */
+            explicit TextureArray(std::vector<Texture*> textures);
+            ~TextureArray();
+
+            /**
+             * Indicates whether the given texture can be stored in an array at all. Textures that have already been
+             * prepared or that use custom culling or blending are excluded.
+             */
+            static bool canPack(const Texture* texture);
+
+            /**
+             * Packs the given textures into arrays of at most the given number of layers. Textures that cannot be packed
+             * and textures whose size, format, type and mip level count do not match any other texture are left out.
+             *
+             * This does not require an OpenGL context; the arrays are uploaded by calling prepare().
+             */
+            static std::vector<std::unique_ptr<TextureArray>> pack(const std::vector<Texture*>& textures, size_t maxLayers = MaxLayers);
+
+            size_t width() const;
+            size_t height() const;
+            bool masked() const;
+            size_t layerCount() const;
+            const std::vector<Texture*>& textures() const;
+
+            /**
+             * The texture that stands in for all textures of this array when grouping faces into draw calls.
+             */
+            const Texture* batchTexture() const;
+
+            bool isPrepared() const;
+
+            /**
+             * Uploads the textures' data into a new array texture. Must be called before the textures themselves are
+             * prepared since that discards their data.
+             */
+            void prepare(int minFilter, int magFilter);
+            void setMode(int minFilter, int magFilter);
+
+            void activate() const;
+            void deactivate() const;
+
+            deleteCopyAndMove(TextureArray)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureArray) */
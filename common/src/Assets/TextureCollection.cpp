@@ -21,6 +21,8 @@
 
 #include "Ensure.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
+#include "Assets/TextureResidency.h"
 
 #include <kdl/vector_utils.h>
 
@@ -31,27 +33,35 @@ namespace TrenchBroom {
     namespace Assets {
         TextureCollection::TextureCollection() :
         m_loaded(false),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_residency(nullptr) {}
 
         TextureCollection::TextureCollection(const std::vector<Texture*>& textures) :
         m_loaded(false),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_residency(nullptr) {
             addTextures(textures);
         }
 
         TextureCollection::TextureCollection(const IO::Path& path) :
         m_loaded(false),
         m_path(path),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_residency(nullptr) {}
 
         TextureCollection::TextureCollection(const IO::Path& path, const std::vector<Texture*>& textures) :
         m_loaded(true),
         m_path(path),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_residency(nullptr) {
             addTextures(textures);
         }
 
         TextureCollection::~TextureCollection() {
+            if (m_residency != nullptr) {
+                m_residency->remove(m_textures);
+            }
+            m_textureArrays.clear();
             kdl::vec_clear_and_delete(m_textures);
             if (!m_textureIds.empty()) {
                 glAssert(glDeleteTextures(static_cast<GLsizei>(m_textureIds.size()),
@@ -69,6 +79,9 @@ namespace TrenchBroom {
             ensure(texture != nullptr, "texture is null");
             m_textures.push_back(texture);
             texture->setCollection(this);
+            if (m_residency != nullptr) {
+                texture->setResidency(m_residency);
+            }
             m_loaded = true;
         }
 
@@ -115,13 +128,31 @@ namespace TrenchBroom {
             return m_usageCount;
         }
 
+        void TextureCollection::packTextureArrays(const size_t maxLayers) {
+            assert(!prepared());
+
+            for (auto* texture : m_textures) {
+                texture->setArray(nullptr, 0u);
+            }
+            m_textureArrays = TextureArray::pack(m_textures, maxLayers);
+        }
+
+        const std::vector<std::unique_ptr<TextureArray>>& TextureCollection::textureArrays() const {
+            return m_textureArrays;
+        }
+
         bool TextureCollection::prepared() const {
-            return !m_textureIds.empty();
+            return !m_textureIds.empty() || m_residency != nullptr;
         }
 
         void TextureCollection::prepare(const int minFilter, const int magFilter) {
             assert(!prepared());
 
+            // the arrays must be uploaded first because preparing a texture discards its data
+            for (auto& textureArray : m_textureArrays) {
+                textureArray->prepare(minFilter, magFilter);
+            }
+
             m_textureIds.resize(textureCount());
             glAssert(glGenTextures(static_cast<GLsizei>(textureCount()),
                                    static_cast<GLuint*>(&m_textureIds.front())));
@@ -132,10 +163,26 @@ namespace TrenchBroom {
             }
         }
 
+        void TextureCollection::prepareOnDemand(TextureResidency& residency, const int minFilter, const int magFilter) {
+            assert(!prepared());
+
+            for (auto& textureArray : m_textureArrays) {
+                textureArray->prepare(minFilter, magFilter);
+            }
+
+            m_residency = &residency;
+            for (auto* texture : m_textures) {
+                texture->setResidency(m_residency);
+            }
+        }
+
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
             for (auto* texture : m_textures) {
                 texture->setMode(minFilter, magFilter);
             }
+            for (auto& textureArray : m_textureArrays) {
+                textureArray->setMode(minFilter, magFilter);
+            }
         }
 
         void TextureCollection::incUsageCount() {
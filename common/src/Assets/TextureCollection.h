@@ -24,12 +24,15 @@
 #include "IO/Path.h"
 #include "Renderer/GL.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
         class Texture;
+        class TextureArray;
+        class TextureResidency;
 
         class TextureCollection {
         private:
@@ -38,10 +41,12 @@ namespace TrenchBroom {
             bool m_loaded;
             IO::Path m_path;
             std::vector<Texture*> m_textures;
+            std::vector<std::unique_ptr<TextureArray>> m_textureArrays;
 
             size_t m_usageCount;
 
             TextureIdList m_textureIds;
+            TextureResidency* m_residency;
 
             friend class Texture;
         public:
@@ -66,8 +71,21 @@ namespace TrenchBroom {
 
             size_t usageCount() const;
 
+            /**
+             * Packs the textures of this collection into texture arrays, replacing any previously packed arrays. Has no
+             * effect on the textures' own 2D textures. Must be called before this collection is prepared.
+             */
+            void packTextureArrays(size_t maxLayers);
+            const std::vector<std::unique_ptr<TextureArray>>& textureArrays() const;
+
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
+
+            /**
+             * Uploads the texture arrays of this collection, but leaves the textures to the given residency, which
+             * uploads each texture when it is first used.
+             */
+            void prepareOnDemand(TextureResidency& residency, int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
         private:
             void incUsageCount();
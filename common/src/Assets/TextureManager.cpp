@@ -22,7 +22,9 @@
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidency.h"
 #include "IO/TextureLoader.h"
 
 #include <kdl/map_utils.h>
@@ -56,10 +58,15 @@ namespace TrenchBroom {
         };
 
         TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger) :
+        TextureManager(magFilter, minFilter, logger, std::make_unique<GLTextureUploader>()) {}
+
+        TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger, std::unique_ptr<TextureUploader> uploader) :
         m_logger(logger),
+        m_residency(std::make_unique<TextureResidency>(std::move(uploader), TextureResidency::Unlimited, minFilter, magFilter)),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_useTextureArrays(false) {}
 
         TextureManager::~TextureManager() {
             clear();
@@ -116,6 +123,10 @@ namespace TrenchBroom {
         void TextureManager::addTextureCollection(Assets::TextureCollection* collection) {
             m_collections.push_back(collection);
             if (collection->loaded() && !collection->prepared()) {
+                if (m_useTextureArrays) {
+                    // pack now rather than in prepare so that the faces see their textures' layers before they are rendered
+                    collection->packTextureArrays(TextureArray::MaxLayers);
+                }
                 m_toPrepare.push_back(collection);
             }
 
@@ -137,12 +148,30 @@ namespace TrenchBroom {
             m_minFilter = minFilter;
             m_magFilter = magFilter;
             m_resetTextureMode = true;
+            m_residency->setTextureMode(m_minFilter, m_magFilter);
+        }
+
+        void TextureManager::setUseTextureArrays(const bool useTextureArrays) {
+            m_useTextureArrays = useTextureArrays;
+        }
+
+        bool TextureManager::useTextureArrays() const {
+            return m_useTextureArrays;
+        }
+
+        void TextureManager::setTextureBudget(const size_t budget) {
+            m_residency->setBudget(budget);
+        }
+
+        const TextureResidency& TextureManager::residency() const {
+            return *m_residency;
         }
 
         void TextureManager::commitChanges() {
             resetTextureMode();
             prepare();
             kdl::vec_clear_and_delete(m_toRemove);
+            m_residency->commit();
         }
 
         Texture* TextureManager::texture(const std::string& name) const {
@@ -180,7 +209,7 @@ namespace TrenchBroom {
 
         void TextureManager::prepare() {
             std::for_each(std::begin(m_toPrepare), std::end(m_toPrepare),
-                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter); });
+                          [this](auto collection) { collection->prepareOnDemand(*m_residency, m_minFilter, m_magFilter); });
             m_toPrepare.clear();
         }
 
@@ -23,6 +23,7 @@
 #include "Notifier.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,8 @@ namespace TrenchBroom {
     namespace Assets {
         class Texture;
         class TextureCollection;
+        class TextureResidency;
+        class TextureUploader;
 
         class TextureManager {
         private:
@@ -54,13 +57,17 @@ namespace TrenchBroom {
             TextureMap m_texturesByName;
             std::vector<Texture*> m_textures;
 
+            std::unique_ptr<TextureResidency> m_residency;
+
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
+            bool m_useTextureArrays;
         public:
             Notifier<> usageCountDidChange;
         public:
             TextureManager(int magFilter, int minFilter, Logger& logger);
+            TextureManager(int magFilter, int minFilter, Logger& logger, std::unique_ptr<TextureUploader> uploader);
             ~TextureManager();
 
             void setTextureCollections(const std::vector<IO::Path>& paths, IO::TextureLoader& loader);
@@ -72,6 +79,23 @@ namespace TrenchBroom {
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+
+            /**
+             * Controls whether textures of the same size are packed into texture arrays when their collections are
+             * prepared, so that the faces using them can be drawn in fewer calls. Only affects collections that are
+             * added after this is changed.
+             */
+            void setUseTextureArrays(bool useTextureArrays);
+            bool useTextureArrays() const;
+
+            /**
+             * Sets the number of bytes of video memory that the textures may use. Textures are uploaded when they are
+             * first rendered, and the least recently used ones are evicted when the budget is exceeded. A budget of 0
+             * does not limit the video memory.
+             */
+            void setTextureBudget(size_t budget);
+            const TextureResidency& residency() const;
+
             void commitChanges();
 
             Texture* texture(const std::string& name) const;
@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextureResidency.h"
+
+#include "Ensure.h"
+#include "Assets/Texture.h"
+
+#include <cassert>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureUploader::~TextureUploader() = default;
+
+        size_t GLTextureUploader::upload(const Texture& texture, const int minFilter, const int magFilter) {
+            return texture.upload(minFilter, magFilter);
+        }
+
+        void GLTextureUploader::evict(const Texture& texture) {
+            texture.evict();
+        }
+
+        TextureResidency::TextureResidency(std::unique_ptr<TextureUploader> uploader, const size_t budget, const int minFilter, const int magFilter) :
+        m_uploader(std::move(uploader)),
+        m_budget(budget),
+        m_minFilter(minFilter),
+        m_magFilter(magFilter),
+        m_frame(0u),
+        m_residentBytes(0u),
+        m_uploadCount(0u),
+        m_evictionCount(0u) {
+            ensure(m_uploader != nullptr, "uploader is null");
+        }
+
+        TextureResidency::~TextureResidency() {
+            clear();
+        }
+
+        size_t TextureResidency::budget() const {
+            return m_budget;
+        }
+
+        void TextureResidency::setBudget(const size_t budget) {
+            m_budget = budget;
+        }
+
+        void TextureResidency::setTextureMode(const int minFilter, const int magFilter) {
+            m_minFilter = minFilter;
+            m_magFilter = magFilter;
+        }
+
+        bool TextureResidency::isResident(const Texture* texture) const {
+            return m_entryMap.count(texture) > 0u;
+        }
+
+        size_t TextureResidency::residentCount() const {
+            return m_entries.size();
+        }
+
+        size_t TextureResidency::residentBytes() const {
+            return m_residentBytes;
+        }
+
+        size_t TextureResidency::uploadCount() const {
+            return m_uploadCount;
+        }
+
+        size_t TextureResidency::evictionCount() const {
+            return m_evictionCount;
+        }
+
+        void TextureResidency::use(const Texture* texture) {
+            const auto it = m_entryMap.find(texture);
+            if (it != std::end(m_entryMap)) {
+                auto entryIt = it->second;
+                entryIt->lastUsed = m_frame;
+                m_entries.splice(std::begin(m_entries), m_entries, entryIt);
+            } else {
+                const auto size = m_uploader->upload(*texture, m_minFilter, m_magFilter);
+                m_entries.push_front(Entry{ texture, size, m_frame });
+                m_entryMap.emplace(texture, std::begin(m_entries));
+                m_residentBytes += size;
+                ++m_uploadCount;
+            }
+        }
+
+        void TextureResidency::commit() {
+            if (m_budget != Unlimited) {
+                while (m_residentBytes > m_budget && !m_entries.empty()) {
+                    auto it = std::prev(std::end(m_entries));
+                    if (it->lastUsed + ProtectedFrames > m_frame) {
+                        // all other entries were used even more recently
+                        break;
+                    }
+                    evict(it);
+                    ++m_evictionCount;
+                }
+            }
+            ++m_frame;
+        }
+
+        void TextureResidency::remove(const std::vector<Texture*>& textures) {
+            for (const auto* texture : textures) {
+                const auto it = m_entryMap.find(texture);
+                if (it != std::end(m_entryMap)) {
+                    evict(it->second);
+                }
+            }
+        }
+
+        void TextureResidency::clear() {
+            while (!m_entries.empty()) {
+                evict(std::begin(m_entries));
+            }
+        }
+
+        void TextureResidency::evict(const EntryList::iterator it) {
+            assert(m_residentBytes >= it->size);
+
+            m_uploader->evict(*it->texture);
+            m_residentBytes -= it->size;
+            m_entryMap.erase(it->texture);
+            m_entries.erase(it);
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_TextureResidency
+#define TrenchBroom_TextureResidency
+
+#include "Macros.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+
+        /**
+         * Moves textures between their CPU buffers and video memory on behalf of a texture residency.
+         */
+        class TextureUploader {
+        public:
+            virtual ~TextureUploader();
+
+            /**
+             * Uploads the given texture.
+             *
+             * @return the number of bytes of video memory used by the texture
+             */
+            virtual size_t upload(const Texture& texture, int minFilter, int magFilter) = 0;
+
+            /**
+             * Deletes the uploaded copy of the given texture, its CPU buffers remain.
+             */
+            virtual void evict(const Texture& texture) = 0;
+        };
+
+        class GLTextureUploader : public TextureUploader {
+        public:
+            size_t upload(const Texture& texture, int minFilter, int magFilter) override;
+            void evict(const Texture& texture) override;
+        };
+
+        /**
+         * Decides which textures are kept in video memory.
+         *
+         * Textures are uploaded when they are first used for rendering. Every call to commit() ends a frame and evicts
+         * the least recently used textures until the uploaded textures fit into the budget again. Textures used during
+         * the last ProtectedFrames frames are never evicted, so a frame that needs more textures than the budget allows
+         * exceeds the budget instead of uploading them again and again.
+         */
+        class TextureResidency {
+        public:
+            /**
+             * The number of frames during which a used texture is protected from eviction. Each map view and the
+             * texture browser commit separately, so this covers a full redraw of the main window.
+             */
+            static constexpr size_t ProtectedFrames = 8u;
+
+            /**
+             * A budget of 0 bytes does not limit the number of uploaded textures.
+             */
+            static constexpr size_t Unlimited = 0u;
+        private:
+            struct Entry {
+                const Texture* texture;
+                size_t size;
+                size_t lastUsed;
+            };
+
+            using EntryList = std::list<Entry>;
+
+            std::unique_ptr<TextureUploader> m_uploader;
+            size_t m_budget;
+            int m_minFilter;
+            int m_magFilter;
+
+            size_t m_frame;
+            size_t m_residentBytes;
+            // most recently used first
+            EntryList m_entries;
+            std::unordered_map<const Texture*, EntryList::iterator> m_entryMap;
+
+            size_t m_uploadCount;
+            size_t m_evictionCount;
+        public:
+            TextureResidency(std::unique_ptr<TextureUploader> uploader, size_t budget, int minFilter, int magFilter);
+            ~TextureResidency();
+
+            size_t budget() const;
+            void setBudget(size_t budget);
+
+            /**
+             * Sets the filters for textures uploaded from now on. Textures that are already resident must be updated
+             * separately.
+             */
+            void setTextureMode(int minFilter, int magFilter);
+
+            bool isResident(const Texture* texture) const;
+            size_t residentCount() const;
+            size_t residentBytes() const;
+
+            size_t uploadCount() const;
+            size_t evictionCount() const;
+
+            /**
+             * Uploads the given texture unless it is resident already, and marks it as used in the current frame.
+             */
+            void use(const Texture* texture);
+
+            /**
+             * Ends the current frame and evicts the least recently used textures which aren't protected until the
+             * resident textures fit into the budget.
+             */
+            void commit();
+
+            /**
+             * Evicts the given textures and forgets them. Must be called before the textures are deleted.
+             */
+            void remove(const std::vector<Texture*>& textures);
+
+            /**
+             * Evicts all textures.
+             */
+            void clear();
+        private:
+            void evict(EntryList::iterator it);
+
+            deleteCopyAndMove(TextureResidency)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureResidency) */
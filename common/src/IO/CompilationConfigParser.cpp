@@ -97,10 +97,25 @@ namespace TrenchBroom {
             }
         }
 
+        static Model::CompilationExportMap::Scope parseExportScope(const EL::Value& value) {
+            const std::string& scope = value.stringValue();
+            if (scope == "map") {
+                return Model::CompilationExportMap::Scope::Map;
+            } else if (scope == "visibleLayers") {
+                return Model::CompilationExportMap::Scope::VisibleLayers;
+            } else if (scope == "selection") {
+                return Model::CompilationExportMap::Scope::Selection;
+            } else {
+                throw ParserException(value.line(), value.column(), "Unknown export scope '" + scope + "'");
+            }
+        }
+
         std::unique_ptr<Model::CompilationTask> CompilationConfigParser::parseExportTask(const EL::Value& value) const {
-            expectStructure(value, "[ {'type': 'String', 'target': 'String'}, {} ]");
+            expectStructure(value, "[ {'type': 'String', 'target': 'String'}, {'scope': 'String', 'sealTexture': 'String'} ]");
             const std::string& target = value["target"].stringValue();
-            return std::make_unique<Model::CompilationExportMap>(target);
+            const auto scope = !value["scope"].null() ? parseExportScope(value["scope"]) : Model::CompilationExportMap::Scope::Map;
+            const std::string sealTexture = !value["sealTexture"].null() ? value["sealTexture"].stringValue() : "skip";
+            return std::make_unique<Model::CompilationExportMap>(target, scope, sealTexture);
         }
 
         std::unique_ptr<Model::CompilationTask> CompilationConfigParser::parseCopyTask(const EL::Value& value) const {
@@ -113,12 +128,14 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<Model::CompilationTask> CompilationConfigParser::parseToolTask(const EL::Value& value) const {
-            expectStructure(value, "[ {'type': 'String', 'tool': 'String', 'parameters': 'String'}, {} ]");
+            expectStructure(value, "[ {'type': 'String', 'tool': 'String', 'parameters': 'String'}, {'inputs': 'String', 'outputs': 'String'} ]");
 
             const std::string& tool = value["tool"].stringValue();
             const std::string& parameters = value["parameters"].stringValue();
+            const std::string inputs = !value["inputs"].null() ? value["inputs"].stringValue() : "";
+            const std::string outputs = !value["outputs"].null() ? value["outputs"].stringValue() : "";
 
-            return std::make_unique<Model::CompilationRunTool>(tool, parameters);
+            return std::make_unique<Model::CompilationRunTool>(tool, parameters, inputs, outputs);
         }
     }
 }
@@ -19,6 +19,7 @@
 
 #include "CompilationConfigWriter.h"
 
+#include "Macros.h"
 #include "EL/Value.h"
 #include "EL/Types.h"
 #include "Model/CompilationConfig.h"
@@ -71,6 +72,18 @@ namespace TrenchBroom {
                 EL::MapType map;
                 map["type"] = EL::Value("export");
                 map["target"] = EL::Value(task.targetSpec());
+                switch (task.scope()) {
+                    case Model::CompilationExportMap::Scope::Map:
+                        break;
+                    case Model::CompilationExportMap::Scope::VisibleLayers:
+                        map["scope"] = EL::Value("visibleLayers");
+                        break;
+                    case Model::CompilationExportMap::Scope::Selection:
+                        map["scope"] = EL::Value("selection");
+                        map["sealTexture"] = EL::Value(task.sealTexture());
+                        break;
+                    switchDefault()
+                }
                 m_array.push_back(EL::Value(map));
             }
 
@@ -87,6 +100,12 @@ namespace TrenchBroom {
                 map["type"] = EL::Value("tool");
                 map["tool"] = EL::Value(task.toolSpec());
                 map["parameters"] = EL::Value(task.parameterSpec());
+                if (!task.inputSpec().empty()) {
+                    map["inputs"] = EL::Value(task.inputSpec());
+                }
+                if (!task.outputSpec().empty()) {
+                    map["outputs"] = EL::Value(task.outputSpec());
+                }
                 m_array.push_back(EL::Value(map));
             }
         };
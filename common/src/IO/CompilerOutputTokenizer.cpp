@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CompilerOutputTokenizer.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        const std::string CompilerOutputTokenizer::NumberDelims = " \t\n\r()";
+
+        CompilerOutputTokenizer::CompilerOutputTokenizer(const char* begin, const char* end) :
+        Tokenizer(begin, end, "", 0) {}
+
+        CompilerOutputTokenizer::Token CompilerOutputTokenizer::emitToken() {
+            while (!eof()) {
+                const auto startLine = line();
+                const auto startColumn = column();
+                const auto* c = curPos();
+
+                switch (*c) {
+                    case '\n':
+                        advance();
+                        return Token(CompilerOutputToken::Eol, c, c+1, offset(c), startLine, startColumn);
+                    case ' ':
+                    case '\t':
+                    case '\r':
+                    case '(':
+                    case ')':
+                        advance();
+                        break;
+                    default: {
+                        const auto* e = readInteger(NumberDelims);
+                        if (e != nullptr) {
+                            return Token(CompilerOutputToken::Integer, c, e, offset(c), startLine, startColumn);
+                        }
+
+                        e = readDecimal(NumberDelims);
+                        if (e != nullptr) {
+                            return Token(CompilerOutputToken::Decimal, c, e, offset(c), startLine, startColumn);
+                        }
+
+                        e = readUntil(NumberDelims);
+                        return Token(CompilerOutputToken::Word, c, e, offset(c), startLine, startColumn);
+                    }
+                }
+            }
+            return Token(CompilerOutputToken::Eof, nullptr, nullptr, length(), line(), column());
+        }
+    }
+}
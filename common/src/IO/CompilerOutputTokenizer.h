@@ -0,0 +1,56 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_CompilerOutputTokenizer
+#define TrenchBroom_CompilerOutputTokenizer
+
+#include "IO/Tokenizer.h"
+
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace CompilerOutputToken {
+            using Type = unsigned int;
+            static const Type Integer           = 1 << 0; // integer number
+            static const Type Decimal           = 1 << 1; // decimal number
+            static const Type Word              = 1 << 2; // anything else, i.e. a format code
+            static const Type Eol               = 1 << 3; // end of line
+            static const Type Eof               = 1 << 4; // end of file
+            static const Type Number            = Integer | Decimal;
+        }
+
+        /**
+         * Tokenizes the point files and portal files written by map compilers. These files consist of lines of numbers
+         * which may be grouped by parentheses, so parentheses are skipped like whitespace, but line breaks are
+         * returned as tokens.
+         */
+        class CompilerOutputTokenizer : public Tokenizer<CompilerOutputToken::Type> {
+        private:
+            static const std::string NumberDelims;
+        public:
+            CompilerOutputTokenizer(const char* begin, const char* end);
+        private:
+            Token emitToken() override;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_CompilerOutputTokenizer) */
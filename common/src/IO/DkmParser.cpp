@@ -269,7 +269,7 @@ namespace TrenchBroom {
             model->addFrames(frameCount);
 
             auto& surface = model->addSurface(m_name);
-            loadSkins(surface, skins, logger);
+            loadSurfaceSkins(surface, skins, logger);
 
             return model;
         }
@@ -380,7 +380,7 @@ namespace TrenchBroom {
             return meshes;
         }
 
-        void DkmParser::loadSkins(Assets::EntityModelSurface& surface, const DkmParser::DkmSkinList& skins, Logger& logger) {
+        void DkmParser::loadSurfaceSkins(Assets::EntityModelSurface& surface, const DkmParser::DkmSkinList& skins, Logger& logger) {
             for (const auto& skin : skins) {
                 const auto skinPath = findSkin(skin);
                 surface.addSkin(loadSkin(skinPath, m_fs, logger).release());
@@ -32,5 +32,9 @@ namespace TrenchBroom {
         void EntityModelLoader::loadFrame(const IO::Path& path, const size_t frameIndex, Assets::EntityModel& model, Logger& logger) const {
             return doLoadFrame(path, frameIndex, model, logger);
         }
+
+        void EntityModelLoader::loadSkins(const IO::Path& path, Assets::EntityModel& model, Logger& logger) const {
+            return doLoadSkins(path, model, logger);
+        }
     }
 }
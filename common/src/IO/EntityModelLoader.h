@@ -37,9 +37,11 @@ namespace TrenchBroom {
             virtual ~EntityModelLoader();
             std::unique_ptr<Assets::EntityModel> initializeModel(const Path& path, Logger& logger) const;
             void loadFrame(const Path& path, size_t frameIndex, Assets::EntityModel& model, Logger& logger) const;
+            void loadSkins(const Path& path, Assets::EntityModel& model, Logger& logger) const;
         private:
             virtual std::unique_ptr<Assets::EntityModel> doInitializeModel(const Path& path, Logger& logger) const = 0;
             virtual void doLoadFrame(const Path& path, size_t frameIndex, Assets::EntityModel& model, Logger& logger) const = 0;
+            virtual void doLoadSkins(const Path& path, Assets::EntityModel& model, Logger& logger) const = 0;
         };
     }
 }
@@ -33,6 +33,13 @@ namespace TrenchBroom {
             return doLoadFrame(frameIndex, model, logger);
         }
 
+        void EntityModelParser::loadSkins(Assets::EntityModel& model, Logger& logger) {
+            doLoadSkins(model, logger);
+            model.setSkinsLoaded(true);
+        }
+
         void EntityModelParser::doLoadFrame(const size_t /* frameIndex */, Assets::EntityModel& /* model */, Logger& /* logger */) {}
+
+        void EntityModelParser::doLoadSkins(Assets::EntityModel& /* model */, Logger& /* logger */) {}
     }
 }
@@ -36,9 +36,11 @@ namespace TrenchBroom {
 
             std::unique_ptr<Assets::EntityModel> initializeModel(Logger& logger);
             void loadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger);
+            void loadSkins(Assets::EntityModel& model, Logger& logger);
         private:
             virtual std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) = 0;
             virtual void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger);
+            virtual void doLoadSkins(Assets::EntityModel& model, Logger& logger);
         };
     }
 }
@@ -0,0 +1,385 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "Exceptions.h"
+#include "Logger.h"
+#include "IO/Path.h"
+
+#include <fstream>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace MapCache {
+            static const char Magic[4] = { 'T', 'B', 'M', 'C' };
+            static const uint32_t ByteOrderMark = 0x01020304u;
+
+            /**
+             * The layout of the header at the start of every cache file.
+             */
+            struct Header {
+                char magic[4];
+                uint32_t version;
+                uint32_t byteOrderMark;
+                int32_t format;
+                uint64_t mapSize;
+                uint64_t mapHash;
+                uint64_t stringCount;
+                uint64_t stringTableSize;
+                uint64_t eventStreamSize;
+                uint64_t payloadHash;
+            };
+
+            Path cachePath(const Path& mapPath) {
+                return mapPath.addExtension("tbcache");
+            }
+
+            uint64_t hash(const char* begin, const char* end) {
+                uint64_t result = 0xcbf29ce484222325ull;
+                for (const char* cur = begin; cur != end; ++cur) {
+                    result ^= static_cast<unsigned char>(*cur);
+                    result *= 0x100000001b3ull;
+                }
+                return result;
+            }
+        }
+
+        MapCacheEvent::MapCacheEvent() :
+        type(Type::FormatSet),
+        format(Model::MapFormat::Unknown),
+        line(0u),
+        lineCount(0u),
+        column(0u),
+        level(LogLevel::Warn),
+        attribs("") {}
+
+        void MapCacheWriter::formatSet(const Model::MapFormat format) {
+            writeValue(MapCacheEvent::Type::FormatSet);
+            writeValue(static_cast<int32_t>(format));
+        }
+
+        void MapCacheWriter::beginEntity(const size_t line, const std::vector<Model::EntityAttribute>& attributes, const MapParser::ExtraAttributes& extraAttributes) {
+            writeValue(MapCacheEvent::Type::BeginEntity);
+            writeValue(static_cast<uint64_t>(line));
+            writeValue(static_cast<uint32_t>(attributes.size()));
+            for (const auto& attribute : attributes) {
+                writeValue(stringIndex(attribute.name()));
+                writeValue(stringIndex(attribute.value()));
+            }
+            writeExtraAttributes(extraAttributes);
+        }
+
+        void MapCacheWriter::endEntity(const size_t startLine, const size_t lineCount) {
+            writeValue(MapCacheEvent::Type::EndEntity);
+            writeValue(static_cast<uint64_t>(startLine));
+            writeValue(static_cast<uint64_t>(lineCount));
+        }
+
+        void MapCacheWriter::beginBrush(const size_t line) {
+            writeValue(MapCacheEvent::Type::BeginBrush);
+            writeValue(static_cast<uint64_t>(line));
+        }
+
+        void MapCacheWriter::endBrush(const size_t startLine, const size_t lineCount, const MapParser::ExtraAttributes& extraAttributes) {
+            writeValue(MapCacheEvent::Type::EndBrush);
+            writeValue(static_cast<uint64_t>(startLine));
+            writeValue(static_cast<uint64_t>(lineCount));
+            writeExtraAttributes(extraAttributes);
+        }
+
+        void MapCacheWriter::brushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY) {
+            writeValue(MapCacheEvent::Type::BrushFace);
+            writeValue(static_cast<uint64_t>(line));
+            writeVec(point1);
+            writeVec(point2);
+            writeVec(point3);
+
+            writeValue(stringIndex(attribs.textureName()));
+            writeValue(attribs.xOffset());
+            writeValue(attribs.yOffset());
+            writeValue(attribs.xScale());
+            writeValue(attribs.yScale());
+            writeValue(attribs.rotation());
+            writeValue(static_cast<int32_t>(attribs.surfaceContents()));
+            writeValue(static_cast<int32_t>(attribs.surfaceFlags()));
+            writeValue(attribs.surfaceValue());
+
+            const auto& color = attribs.color();
+            writeValue(color.r());
+            writeValue(color.g());
+            writeValue(color.b());
+            writeValue(color.a());
+
+            writeVec(texAxisX);
+            writeVec(texAxisY);
+        }
+
+        void MapCacheWriter::diagnostic(const LogLevel level, const size_t line, const size_t column, const std::string& message) {
+            writeValue(MapCacheEvent::Type::Diagnostic);
+            writeValue(static_cast<uint8_t>(level));
+            writeValue(static_cast<uint64_t>(line));
+            writeValue(static_cast<uint64_t>(column));
+            writeValue(stringIndex(message));
+        }
+
+        void MapCacheWriter::write(const Path& path, const Model::MapFormat format, const char* begin, const char* end) const {
+            const auto data = serialize(format, begin, end);
+
+            std::ofstream stream(path.asString(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!stream) {
+                throw FileSystemException("Cannot open file: " + path.asString());
+            }
+
+            stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!stream) {
+                throw FileSystemException("Cannot write file: " + path.asString());
+            }
+        }
+
+        std::string MapCacheWriter::serialize(const Model::MapFormat format, const char* begin, const char* end) const {
+            std::string stringTable;
+            for (const auto& str : m_strings) {
+                const auto length = static_cast<uint32_t>(str.size());
+                stringTable.append(reinterpret_cast<const char*>(&length), sizeof(length));
+                stringTable.append(str);
+            }
+
+            auto payload = std::move(stringTable);
+            const auto stringTableSize = payload.size();
+            payload.append(m_events);
+
+            MapCache::Header header;
+            std::copy(std::begin(MapCache::Magic), std::end(MapCache::Magic), std::begin(header.magic));
+            header.version = MapCache::Version;
+            header.byteOrderMark = MapCache::ByteOrderMark;
+            header.format = static_cast<int32_t>(format);
+            header.mapSize = static_cast<uint64_t>(end - begin);
+            header.mapHash = MapCache::hash(begin, end);
+            header.stringCount = m_strings.size();
+            header.stringTableSize = stringTableSize;
+            header.eventStreamSize = m_events.size();
+            header.payloadHash = MapCache::hash(payload.data(), payload.data() + payload.size());
+
+            std::string result(reinterpret_cast<const char*>(&header), sizeof(header));
+            result.append(payload);
+            return result;
+        }
+
+        uint32_t MapCacheWriter::stringIndex(const std::string& str) {
+            const auto [it, inserted] = m_stringIndices.emplace(str, static_cast<uint32_t>(m_strings.size()));
+            if (inserted) {
+                m_strings.push_back(str);
+            }
+            return it->second;
+        }
+
+        void MapCacheWriter::writeExtraAttributes(const MapParser::ExtraAttributes& extraAttributes) {
+            writeValue(static_cast<uint32_t>(extraAttributes.size()));
+            for (const auto& [name, attribute] : extraAttributes) {
+                writeValue(static_cast<uint8_t>(attribute.type()));
+                writeValue(stringIndex(name));
+                writeValue(stringIndex(attribute.strValue()));
+                writeValue(static_cast<uint64_t>(attribute.line()));
+                writeValue(static_cast<uint64_t>(attribute.column()));
+            }
+        }
+
+        void MapCacheWriter::writeVec(const vm::vec3& v) {
+            writeValue(v.x());
+            writeValue(v.y());
+            writeValue(v.z());
+        }
+
+        MapCacheReader::MapCacheReader(const char* cacheBegin, const char* cacheEnd, const Model::MapFormat format, const char* begin, const char* end) :
+        m_data(cacheBegin),
+        m_position(0u),
+        m_end(0u) {
+            const auto size = static_cast<size_t>(cacheEnd - cacheBegin);
+            if (size < sizeof(MapCache::Header)) {
+                throw FileFormatException("Map cache is truncated");
+            }
+
+            MapCache::Header header;
+            std::copy_n(m_data, sizeof(header), reinterpret_cast<char*>(&header));
+
+            if (!std::equal(std::begin(MapCache::Magic), std::end(MapCache::Magic), std::begin(header.magic))) {
+                throw FileFormatException("Not a map cache");
+            }
+            if (header.version != MapCache::Version || header.byteOrderMark != MapCache::ByteOrderMark) {
+                throw FileFormatException("Unsupported map cache version");
+            }
+            if (header.format != static_cast<int32_t>(format)) {
+                throw FileFormatException("Map cache was created for a different map format");
+            }
+            if (header.mapSize != static_cast<uint64_t>(end - begin) || header.mapHash != MapCache::hash(begin, end)) {
+                throw FileFormatException("Map cache is out of date");
+            }
+
+            const auto payloadSize = size - sizeof(header);
+            if (header.stringTableSize > payloadSize || header.eventStreamSize != payloadSize - header.stringTableSize) {
+                throw FileFormatException("Map cache is truncated");
+            }
+
+            const char* payload = m_data + sizeof(header);
+            if (header.payloadHash != MapCache::hash(payload, payload + payloadSize)) {
+                throw FileFormatException("Map cache is corrupt");
+            }
+
+            // every string takes at least four bytes for its length
+            if (header.stringCount > header.stringTableSize / sizeof(uint32_t)) {
+                throwCorrupt();
+            }
+
+            m_position = sizeof(header);
+            m_end = m_position + static_cast<size_t>(header.stringTableSize);
+
+            m_strings.reserve(static_cast<size_t>(header.stringCount));
+            for (uint64_t i = 0u; i < header.stringCount; ++i) {
+                const auto length = readValue<uint32_t>();
+                if (m_end - m_position < length) {
+                    throwCorrupt();
+                }
+                m_strings.emplace_back(m_data + m_position, length);
+                m_position += length;
+            }
+
+            if (m_position != m_end) {
+                throwCorrupt();
+            }
+            m_end = size;
+        }
+
+        bool MapCacheReader::next(MapCacheEvent& event) {
+            if (m_position == m_end) {
+                return false;
+            }
+
+            event.type = readValue<MapCacheEvent::Type>();
+            switch (event.type) {
+                case MapCacheEvent::Type::FormatSet:
+                    event.format = static_cast<Model::MapFormat>(readValue<int32_t>());
+                    break;
+                case MapCacheEvent::Type::BeginEntity: {
+                    event.line = static_cast<size_t>(readValue<uint64_t>());
+
+                    const auto attributeCount = readValue<uint32_t>();
+                    event.attributes.clear();
+                    event.attributes.reserve(attributeCount);
+                    for (uint32_t i = 0u; i < attributeCount; ++i) {
+                        const auto& name = readString();
+                        const auto& value = readString();
+                        event.attributes.emplace_back(name, value);
+                    }
+
+                    readExtraAttributes(event.extraAttributes);
+                    break;
+                }
+                case MapCacheEvent::Type::EndEntity:
+                    event.line = static_cast<size_t>(readValue<uint64_t>());
+                    event.lineCount = static_cast<size_t>(readValue<uint64_t>());
+                    break;
+                case MapCacheEvent::Type::BeginBrush:
+                    event.line = static_cast<size_t>(readValue<uint64_t>());
+                    break;
+                case MapCacheEvent::Type::EndBrush:
+                    event.line = static_cast<size_t>(readValue<uint64_t>());
+                    event.lineCount = static_cast<size_t>(readValue<uint64_t>());
+                    readExtraAttributes(event.extraAttributes);
+                    break;
+                case MapCacheEvent::Type::BrushFace: {
+                    event.line = static_cast<size_t>(readValue<uint64_t>());
+                    event.point1 = readVec();
+                    event.point2 = readVec();
+                    event.point3 = readVec();
+
+                    event.attribs = Model::BrushFaceAttributes(readString());
+                    event.attribs.setXOffset(readValue<float>());
+                    event.attribs.setYOffset(readValue<float>());
+                    event.attribs.setXScale(readValue<float>());
+                    event.attribs.setYScale(readValue<float>());
+                    event.attribs.setRotation(readValue<float>());
+                    event.attribs.setSurfaceContents(readValue<int32_t>());
+                    event.attribs.setSurfaceFlags(readValue<int32_t>());
+                    event.attribs.setSurfaceValue(readValue<float>());
+
+                    const auto r = readValue<float>();
+                    const auto g = readValue<float>();
+                    const auto b = readValue<float>();
+                    const auto a = readValue<float>();
+                    event.attribs.setColor(Color(r, g, b, a));
+
+                    event.texAxisX = readVec();
+                    event.texAxisY = readVec();
+                    break;
+                }
+                case MapCacheEvent::Type::Diagnostic: {
+                    const auto level = static_cast<LogLevel>(readValue<uint8_t>());
+                    if (level != LogLevel::Warn && level != LogLevel::Error) {
+                        throwCorrupt();
+                    }
+                    event.level = level;
+                    event.line = static_cast<size_t>(readValue<uint64_t>());
+                    event.column = static_cast<size_t>(readValue<uint64_t>());
+                    event.message = readString();
+                    break;
+                }
+                default:
+                    throwCorrupt();
+            }
+
+            return true;
+        }
+
+        const std::string& MapCacheReader::readString() {
+            const auto index = readValue<uint32_t>();
+            if (index >= m_strings.size()) {
+                throwCorrupt();
+            }
+            return m_strings[index];
+        }
+
+        vm::vec3 MapCacheReader::readVec() {
+            const auto x = readValue<FloatType>();
+            const auto y = readValue<FloatType>();
+            const auto z = readValue<FloatType>();
+            return vm::vec3(x, y, z);
+        }
+
+        void MapCacheReader::readExtraAttributes(MapParser::ExtraAttributes& extraAttributes) {
+            extraAttributes.clear();
+
+            const auto count = readValue<uint32_t>();
+            for (uint32_t i = 0u; i < count; ++i) {
+                const auto type = static_cast<MapParser::ExtraAttribute::Type>(readValue<uint8_t>());
+                const auto& name = readString();
+                const auto& value = readString();
+                const auto line = static_cast<size_t>(readValue<uint64_t>());
+                const auto column = static_cast<size_t>(readValue<uint64_t>());
+                extraAttributes.insert(std::make_pair(name, MapParser::ExtraAttribute(type, name, value, line, column)));
+            }
+        }
+
+        void MapCacheReader::throwCorrupt() {
+            throw FileFormatException("Map cache is corrupt");
+        }
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapCache
+#define TrenchBroom_MapCache
+
+#include "FloatType.h"
+#include "IO/MapParser.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/EntityAttributes.h"
+#include "Model/MapFormat.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        class Path;
+
+        /**
+         * The map cache is a binary sidecar file that stores the events reported by the map parser for a map file.
+         * Replaying these events into a map reader is much faster than tokenizing the map file again.
+         *
+         * The cache file consists of a fixed size header, a string table and the event stream. All values are stored
+         * in native byte order, which is validated by means of a marker in the header. Strings such as attribute
+         * names and texture names are stored only once and referenced by their index into the string table.
+         *
+         * The header contains the size and a hash of the map file, so a cache is only used for exactly the content it
+         * was created from. The map file always remains the source of truth.
+         */
+        namespace MapCache {
+            /**
+             * Incremented whenever the layout of the cache file changes.
+             */
+            const uint32_t Version = 2;
+
+            /**
+             * Returns the path of the cache file for the map file at the given path.
+             */
+            Path cachePath(const Path& mapPath);
+
+            /**
+             * Computes the 64 bit FNV-1a hash of the given bytes.
+             */
+            uint64_t hash(const char* begin, const char* end);
+        }
+
+        /**
+         * A single event read from a map cache.
+         */
+        struct MapCacheEvent {
+            enum class Type : uint8_t {
+                FormatSet = 1,
+                BeginEntity = 2,
+                EndEntity = 3,
+                BeginBrush = 4,
+                EndBrush = 5,
+                BrushFace = 6,
+                Diagnostic = 7
+            };
+
+            Type type;
+            Model::MapFormat format;
+            size_t line;
+            size_t lineCount;
+            size_t column;
+            LogLevel level;
+            std::string message;
+            std::vector<Model::EntityAttribute> attributes;
+            MapParser::ExtraAttributes extraAttributes;
+            vm::vec3 point1;
+            vm::vec3 point2;
+            vm::vec3 point3;
+            Model::BrushFaceAttributes attribs;
+            vm::vec3 texAxisX;
+            vm::vec3 texAxisY;
+
+            MapCacheEvent();
+        };
+
+        /**
+         * Records the events reported by a map parser and writes them to a cache file.
+         */
+        class MapCacheWriter {
+        private:
+            std::string m_events;
+            std::vector<std::string> m_strings;
+            std::unordered_map<std::string, uint32_t> m_stringIndices;
+        public:
+            void formatSet(Model::MapFormat format);
+            void beginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const MapParser::ExtraAttributes& extraAttributes);
+            void endEntity(size_t startLine, size_t lineCount);
+            void beginBrush(size_t line);
+            void endBrush(size_t startLine, size_t lineCount, const MapParser::ExtraAttributes& extraAttributes);
+            void brushFace(size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY);
+            void diagnostic(LogLevel level, size_t line, size_t column, const std::string& message);
+
+            /**
+             * Writes the recorded events to the given path.
+             *
+             * @param path the path of the cache file
+             * @param format the format that was used to parse the map file
+             * @param begin the start of the map file's contents
+             * @param end the end of the map file's contents
+             *
+             * @throw FileSystemException if the cache file cannot be written
+             */
+            void write(const Path& path, Model::MapFormat format, const char* begin, const char* end) const;
+
+            /**
+             * Returns the contents of the cache file that write would create.
+             */
+            std::string serialize(Model::MapFormat format, const char* begin, const char* end) const;
+        private:
+            uint32_t stringIndex(const std::string& str);
+            void writeExtraAttributes(const MapParser::ExtraAttributes& extraAttributes);
+
+            template <typename T>
+            void writeValue(const T value) {
+                m_events.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void writeVec(const vm::vec3& v);
+        };
+
+        /**
+         * Reads the events from a cache file. The header and the integrity of the entire file are validated when the
+         * reader is created, so that a reader that was created successfully will not fail while its events are being
+         * replayed.
+         *
+         * The reader does not copy the contents of the cache file, so they must outlive the reader.
+         */
+        class MapCacheReader {
+        private:
+            const char* m_data;
+            std::vector<std::string> m_strings;
+            size_t m_position;
+            size_t m_end;
+        public:
+            /**
+             * Creates a reader for the given cache file contents.
+             *
+             * @param cacheBegin the start of the cache file's contents
+             * @param cacheEnd the end of the cache file's contents
+             * @param format the map format that the map file is to be parsed with
+             * @param begin the start of the map file's contents
+             * @param end the end of the map file's contents
+             *
+             * @throw FileFormatException if the given data is not a valid cache for the given map file and format
+             */
+            MapCacheReader(const char* cacheBegin, const char* cacheEnd, Model::MapFormat format, const char* begin, const char* end);
+
+            /**
+             * Reads the next event into the given event object.
+             *
+             * @return true if an event was read and false if there are no more events
+             * @throw FileFormatException if the event stream is corrupt
+             */
+            bool next(MapCacheEvent& event);
+        private:
+            template <typename T>
+            T readValue() {
+                if (m_end - m_position < sizeof(T)) {
+                    throwCorrupt();
+                }
+
+                T result;
+                std::copy_n(m_data + m_position, sizeof(T), reinterpret_cast<char*>(&result));
+                m_position += sizeof(T);
+                return result;
+            }
+
+            const std::string& readString();
+            vm::vec3 readVec();
+            void readExtraAttributes(MapParser::ExtraAttributes& extraAttributes);
+
+            [[noreturn]] static void throwCorrupt();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapCache) */
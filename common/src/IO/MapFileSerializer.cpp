@@ -25,121 +25,109 @@
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/EntityAttributes.h"
+#include "IO/NumberFormat.h"
 
 #include <memory>
-#include <sstream>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
         class QuakeFileSerializer : public MapFileSerializer {
-        private:
-            std::string FacePointFormat;
-            std::string TextureInfoFormat;
-            std::string ValveTextureInfoFormat;
+        protected:
+            static const int TextureInfoPrecision = 6;
         public:
             explicit QuakeFileSerializer(FILE* stream) :
-            MapFileSerializer(stream),
-            FacePointFormat(getFacePointFormat()),
-            TextureInfoFormat(" %s %.6g %.6g %.6g %.6g %.6g"),
-            ValveTextureInfoFormat(" %s [ %.6g %.6g %.6g %.6g ] [ %.6g %.6g %.6g %.6g ] %.6g %.6g %.6g") {}
+            MapFileSerializer(stream) {}
         private:
-            static std::string getFacePointFormat() {
-                std::stringstream str;
-                str <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g )";
-                return str.str();
-            }
-        private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
+                str.append("\n");
                 return 1;
             }
         protected:
-            void writeFacePoints(FILE* stream, Model::BrushFace* face) {
+            void writeFacePoints(std::string& str, const Model::BrushFace* face) const {
                 const Model::BrushFace::Points& points = face->points();
 
-                std::fprintf(stream, FacePointFormat.c_str(),
-                             points[0].x(),
-                             points[0].y(),
-                             points[0].z(),
-                             points[1].x(),
-                             points[1].y(),
-                             points[1].z(),
-                             points[2].x(),
-                             points[2].y(),
-                             points[2].z());
+                for (size_t i = 0; i < 3; ++i) {
+                    str.append(i == 0 ? "( " : " ( ");
+                    appendFloat(str, points[i].x(), FloatPrecision);
+                    str.append(" ");
+                    appendFloat(str, points[i].y(), FloatPrecision);
+                    str.append(" ");
+                    appendFloat(str, points[i].z(), FloatPrecision);
+                    str.append(" )");
+                }
             }
 
-            void writeTextureInfo(FILE* stream, Model::BrushFace* face) {
+            void writeTextureInfo(std::string& str, const Model::BrushFace* face) const {
                 const std::string& textureName = face->textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face->textureName();
-                std::fprintf(stream, TextureInfoFormat.c_str(),
-                             textureName.c_str(),
-                             static_cast<double>(face->xOffset()),
-                             static_cast<double>(face->yOffset()),
-                             static_cast<double>(face->rotation()),
-                             static_cast<double>(face->xScale()),
-                             static_cast<double>(face->yScale()));
+                str.append(" ");
+                str.append(textureName);
+                writeTextureInfoValue(str, face->xOffset());
+                writeTextureInfoValue(str, face->yOffset());
+                writeTextureInfoValue(str, face->rotation());
+                writeTextureInfoValue(str, face->xScale());
+                writeTextureInfoValue(str, face->yScale());
             }
 
-            void writeValveTextureInfo(FILE* stream, Model::BrushFace* face) {
+            void writeValveTextureInfo(std::string& str, const Model::BrushFace* face) const {
                 const std::string& textureName = face->textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face->textureName();
                 const vm::vec3 xAxis = face->textureXAxis();
                 const vm::vec3 yAxis = face->textureYAxis();
 
-                std::fprintf(stream, ValveTextureInfoFormat.c_str(),
-                             textureName.c_str(),
-
-                             xAxis.x(),
-                             xAxis.y(),
-                             xAxis.z(),
-                             static_cast<double>(face->xOffset()),
-
-                             yAxis.x(),
-                             yAxis.y(),
-                             yAxis.z(),
-                             static_cast<double>(face->yOffset()),
+                str.append(" ");
+                str.append(textureName);
+
+                str.append(" [");
+                writeTextureInfoValue(str, xAxis.x());
+                writeTextureInfoValue(str, xAxis.y());
+                writeTextureInfoValue(str, xAxis.z());
+                writeTextureInfoValue(str, face->xOffset());
+                str.append(" ] [");
+                writeTextureInfoValue(str, yAxis.x());
+                writeTextureInfoValue(str, yAxis.y());
+                writeTextureInfoValue(str, yAxis.z());
+                writeTextureInfoValue(str, face->yOffset());
+                str.append(" ]");
+
+                writeTextureInfoValue(str, face->rotation());
+                writeTextureInfoValue(str, face->xScale());
+                writeTextureInfoValue(str, face->yScale());
+            }
 
-                             static_cast<double>(face->rotation()),
-                             static_cast<double>(face->xScale()),
-                             static_cast<double>(face->yScale()));
+            /**
+             * Writes a space followed by the given value, formatted like "%.6g".
+             */
+            static void writeTextureInfoValue(std::string& str, const double value) {
+                str.append(" ");
+                appendFloat(str, value, TextureInfoPrecision);
             }
         };
 
         class Quake2FileSerializer : public QuakeFileSerializer {
-        private:
-            std::string SurfaceAttributesFormat;
         public:
             explicit Quake2FileSerializer(FILE* stream) :
-            QuakeFileSerializer(stream),
-            SurfaceAttributesFormat(" %d %d %.6g") {}
+            QuakeFileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
 
                 // Neverball's "mapc" doesn't like it if surface attributes aren't present.
                 // This suggests the Radiants always output these, so it's probably a compatibility danger.
-                writeSurfaceAttributes(stream, face);
+                writeSurfaceAttributes(str, face);
 
-                std::fprintf(stream, "\n");
+                str.append("\n");
                 return 1;
             }
         protected:
-            void writeSurfaceAttributes(FILE* stream, Model::BrushFace* face) {
-                std::fprintf(stream, SurfaceAttributesFormat.c_str(),
-                             face->surfaceContents(),
-                             face->surfaceFlags(),
-                             static_cast<double>(face->surfaceValue()));
+            void writeSurfaceAttributes(std::string& str, const Model::BrushFace* face) const {
+                str.append(" ");
+                appendInteger(str, face->surfaceContents());
+                str.append(" ");
+                appendInteger(str, face->surfaceFlags());
+                writeTextureInfoValue(str, face->surfaceValue());
             }
         };
 
@@ -148,44 +136,43 @@ namespace TrenchBroom {
             explicit Quake2ValveFileSerializer(FILE* stream) :
             Quake2FileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                writeSurfaceAttributes(stream, face);
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const override {
+                writeFacePoints(str, face);
+                writeValveTextureInfo(str, face);
+                writeSurfaceAttributes(str, face);
 
-                std::fprintf(stream, "\n");
+                str.append("\n");
                 return 1;
             }
         };
 
         class DaikatanaFileSerializer : public Quake2FileSerializer {
-        private:
-            std::string SurfaceColorFormat;
         public:
             explicit DaikatanaFileSerializer(FILE* stream) :
-            Quake2FileSerializer(stream),
-            SurfaceColorFormat(" %d %d %d") {}
+            Quake2FileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
 
                 if (face->hasSurfaceAttributes() || face->hasColor()) {
-                    writeSurfaceAttributes(stream, face);
+                    writeSurfaceAttributes(str, face);
                 }
                 if (face->hasColor()) {
-                    writeSurfaceColor(stream, face);
+                    writeSurfaceColor(str, face);
                 }
 
-                std::fprintf(stream, "\n");
+                str.append("\n");
                 return 1;
             }
         protected:
-            void writeSurfaceColor(FILE* stream, Model::BrushFace* face) {
-                std::fprintf(stream, SurfaceColorFormat.c_str(),
-                             static_cast<int>(face->color().r()),
-                             static_cast<int>(face->color().g()),
-                             static_cast<int>(face->color().b()));
+            void writeSurfaceColor(std::string& str, const Model::BrushFace* face) const {
+                str.append(" ");
+                appendInteger(str, static_cast<int>(face->color().r()));
+                str.append(" ");
+                appendInteger(str, static_cast<int>(face->color().g()));
+                str.append(" ");
+                appendInteger(str, static_cast<int>(face->color().b()));
             }
         };
 
@@ -194,10 +181,10 @@ namespace TrenchBroom {
             explicit Hexen2FileSerializer(FILE* stream):
             QuakeFileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, " 0\n"); // extra value written here
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
+                str.append(" 0\n"); // extra value written here
                 return 1;
             }
         };
@@ -207,10 +194,10 @@ namespace TrenchBroom {
             explicit ValveFileSerializer(FILE* stream) :
             QuakeFileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const override {
+                writeFacePoints(str, face);
+                writeValveTextureInfo(str, face);
+                str.append("\n");
                 return 1;
             }
         };
@@ -242,52 +229,121 @@ namespace TrenchBroom {
         m_line(1),
         m_stream(stream) {
             ensure(m_stream != nullptr, "stream is null");
+            m_buffer.reserve(FlushThreshold + FlushThreshold / 4u);
+        }
+
+        MapFileSerializer::~MapFileSerializer() {
+            flush();
+        }
+
+        void MapFileSerializer::flushIfNecessary() {
+            if (m_buffer.size() >= FlushThreshold) {
+                flush();
+            }
+        }
+
+        void MapFileSerializer::flush() {
+            if (!m_buffer.empty()) {
+                std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_stream);
+                m_buffer.clear();
+            }
         }
 
         void MapFileSerializer::doBeginFile() {}
-        void MapFileSerializer::doEndFile() {}
+
+        void MapFileSerializer::doEndFile() {
+            flush();
+        }
 
         void MapFileSerializer::doBeginEntity(const Model::Node* /* node */) {
-            std::fprintf(m_stream, "// entity %u\n", entityNo());
+            m_buffer.append("// entity ");
+            appendInteger(m_buffer, static_cast<long long>(entityNo()));
+            m_buffer.append("\n");
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
+            m_buffer.append("{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndEntity(Model::Node* node) {
-            std::fprintf(m_stream, "}\n");
+            m_buffer.append("}\n");
             ++m_line;
             setFilePosition(node);
+            flushIfNecessary();
         }
 
         void MapFileSerializer::doEntityAttribute(const Model::EntityAttribute& attribute) {
-            std::fprintf(m_stream, "\"%s\" \"%s\"\n",
-                         escapeEntityAttribute( attribute.name()).c_str(),
-                         escapeEntityAttribute(attribute.value()).c_str());
+            m_buffer.append("\"");
+            m_buffer.append(escapeEntityAttribute(attribute.name()));
+            m_buffer.append("\" \"");
+            m_buffer.append(escapeEntityAttribute(attribute.value()));
+            m_buffer.append("\"\n");
             ++m_line;
         }
 
         void MapFileSerializer::doBeginBrush(const Model::Brush* /* brush */) {
-            std::fprintf(m_stream, "// brush %u\n", brushNo());
+            writeBrushHeader(m_buffer, brushNo());
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndBrush(Model::Brush* brush) {
-            std::fprintf(m_stream, "}\n");
+            m_buffer.append("}\n");
             ++m_line;
             setFilePosition(brush);
+            flushIfNecessary();
         }
 
         void MapFileSerializer::doBrushFace(Model::BrushFace* face) {
-            const size_t lines = doWriteBrushFace(m_stream, face);
+            const size_t lines = doWriteBrushFace(m_buffer, face);
             face->setFilePosition(m_line, lines);
             m_line += lines;
         }
 
+        bool MapFileSerializer::doCanFormatBrushesConcurrently() const {
+            return true;
+        }
+
+        void MapFileSerializer::doFormatBrushes(BrushChunk& chunk, BrushIterator first, const BrushIterator last, const ObjectNo firstBrushNo) const {
+            for (auto no = firstBrushNo; first != last; ++first, ++no) {
+                writeBrushHeader(chunk.text, no);
+                for (const auto* face : (*first)->faces()) {
+                    chunk.faceLineCounts.push_back(doWriteBrushFace(chunk.text, face));
+                }
+                chunk.text.append("}\n");
+            }
+        }
+
+        void MapFileSerializer::doWriteBrushChunk(const BrushChunk& chunk, BrushIterator first, const BrushIterator last) {
+            m_buffer.append(chunk.text);
+
+            // update the file positions exactly like doBeginBrush, doBrushFace and doEndBrush would
+            auto lineCount = std::begin(chunk.faceLineCounts);
+            for (; first != last; ++first) {
+                auto* brush = *first;
+                const size_t startLine = m_line + 1u;
+                m_line += 2u;
+
+                for (auto* face : brush->faces()) {
+                    assert(lineCount != std::end(chunk.faceLineCounts));
+                    face->setFilePosition(m_line, *lineCount);
+                    m_line += *lineCount++;
+                }
+
+                ++m_line;
+                brush->setFilePosition(startLine, m_line - startLine);
+            }
+
+            flushIfNecessary();
+        }
+
+        void MapFileSerializer::writeBrushHeader(std::string& str, const ObjectNo no) {
+            str.append("// brush ");
+            appendInteger(str, static_cast<long long>(no));
+            str.append("\n{\n");
+        }
+
         void MapFileSerializer::setFilePosition(Model::Node* node) {
             const size_t start = startLine();
             node->setFilePosition(start, m_line - start);
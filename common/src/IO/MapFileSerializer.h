@@ -25,6 +25,7 @@
 
 #include <cstdio> // for FILE*
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -36,16 +37,30 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        /**
+         * Writes map files. The text is formatted into an in-memory buffer which is written to the stream in large
+         * blocks, and numbers are formatted without going through the printf machinery where possible. The output is
+         * identical to formatting every value with std::fprintf. The brushes of large entities are formatted
+         * concurrently, see NodeSerializer::doFormatBrushes.
+         */
         class MapFileSerializer : public NodeSerializer {
         private:
+            static const size_t FlushThreshold = 1u << 20;
+
             using LineStack = std::vector<size_t>;
             LineStack m_startLineStack;
             size_t m_line;
             FILE* m_stream;
+            std::string m_buffer;
         public:
             static std::unique_ptr<NodeSerializer> create(Model::MapFormat format, FILE* stream);
         protected:
             explicit MapFileSerializer(FILE* file);
+        public:
+            ~MapFileSerializer() override;
+        private:
+            void flushIfNecessary();
+            void flush();
         private:
             void doBeginFile() override;
             void doEndFile() override;
@@ -56,11 +71,21 @@ namespace TrenchBroom {
             void doBeginBrush(const Model::Brush* brush) override;
             void doEndBrush(Model::Brush* brush) override;
             void doBrushFace(Model::BrushFace* face) override;
+
+            bool doCanFormatBrushesConcurrently() const override;
+            void doFormatBrushes(BrushChunk& chunk, BrushIterator first, BrushIterator last, ObjectNo firstBrushNo) const override;
+            void doWriteBrushChunk(const BrushChunk& chunk, BrushIterator first, BrushIterator last) override;
+
+            static void writeBrushHeader(std::string& str, ObjectNo no);
         private:
             void setFilePosition(Model::Node* node);
             size_t startLine();
         private:
-            virtual size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) = 0;
+            /**
+             * Appends the given face to the given string and returns the number of lines written. This is called
+             * concurrently when brushes are formatted in chunks, so it must not modify this serializer.
+             */
+            virtual size_t doWriteBrushFace(std::string& str, const Model::BrushFace* face) const = 0;
         };
     }
 }
@@ -20,6 +20,10 @@
 #include "MapParser.h"
 
 #include "Exceptions.h"
+#include "Logger.h"
+#include "Macros.h"
+#include "IO/MapCache.h"
+#include "IO/ParserStatus.h"
 #include "Model/EntityAttributes.h"
 
 #include <list>
@@ -45,35 +49,131 @@ namespace TrenchBroom {
             return m_value;
         }
 
+        size_t MapParser::ExtraAttribute::line() const {
+            return m_line;
+        }
+
+        size_t MapParser::ExtraAttribute::column() const {
+            return m_column;
+        }
+
         void MapParser::ExtraAttribute::assertType(const Type expected) const {
             if (expected != m_type)
                 throw ParserException(m_line, m_column, "Invalid extra property type");
         }
 
+        MapParser::MapParser() :
+        m_cacheWriter(nullptr) {}
+
         MapParser::~MapParser() = default;
 
+        void MapParser::setCacheWriter(MapCacheWriter* cacheWriter) {
+            m_cacheWriter = cacheWriter;
+        }
+
+        void MapParser::replay(MapCacheReader& reader, ParserStatus& status) {
+            MapCacheEvent event;
+            while (reader.next(event)) {
+                switch (event.type) {
+                    case MapCacheEvent::Type::FormatSet:
+                        formatSet(event.format);
+                        break;
+                    case MapCacheEvent::Type::BeginEntity:
+                        beginEntity(event.line, event.attributes, event.extraAttributes, status);
+                        break;
+                    case MapCacheEvent::Type::EndEntity:
+                        endEntity(event.line, event.lineCount, status);
+                        break;
+                    case MapCacheEvent::Type::BeginBrush:
+                        beginBrush(event.line, status);
+                        break;
+                    case MapCacheEvent::Type::EndBrush:
+                        endBrush(event.line, event.lineCount, event.extraAttributes, status);
+                        break;
+                    case MapCacheEvent::Type::BrushFace:
+                        brushFace(event.line, event.point1, event.point2, event.point3, event.attribs, event.texAxisX, event.texAxisY, status);
+                        break;
+                    case MapCacheEvent::Type::Diagnostic:
+                        report(status, event.level, event.line, event.column, event.message);
+                        break;
+                    switchDefault()
+                }
+            }
+        }
+
         void MapParser::formatSet(const Model::MapFormat format) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->formatSet(format);
+            }
             onFormatSet(format);
         }
 
         void MapParser::beginEntity(const size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->beginEntity(line, attributes, extraAttributes);
+            }
             onBeginEntity(line, attributes, extraAttributes, status);
         }
 
         void MapParser::endEntity(const size_t startLine, const size_t lineCount, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->endEntity(startLine, lineCount);
+            }
             onEndEntity(startLine, lineCount, status);
         }
 
         void MapParser::beginBrush(const size_t line, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->beginBrush(line);
+            }
             onBeginBrush(line, status);
         }
 
         void MapParser::endBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->endBrush(startLine, lineCount, extraAttributes);
+            }
             onEndBrush(startLine, lineCount, extraAttributes, status);
         }
 
         void MapParser::brushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->brushFace(line, point1, point2, point3, attribs, texAxisX, texAxisY);
+            }
             onBrushFace(line, point1, point2, point3, attribs, texAxisX, texAxisY, status);
         }
+
+        void MapParser::reportWarning(ParserStatus& status, const size_t line, const size_t column, const std::string& str) const {
+            report(status, LogLevel::Warn, line, column, str);
+        }
+
+        void MapParser::reportWarning(ParserStatus& status, const size_t line, const std::string& str) const {
+            report(status, LogLevel::Warn, line, 0u, str);
+        }
+
+        void MapParser::reportError(ParserStatus& status, const size_t line, const std::string& str) const {
+            report(status, LogLevel::Error, line, 0u, str);
+        }
+
+        void MapParser::report(ParserStatus& status, const LogLevel level, const size_t line, const size_t column, const std::string& str) const {
+            if (m_cacheWriter != nullptr) {
+                m_cacheWriter->diagnostic(level, line, column, str);
+            }
+
+            assert(level == LogLevel::Warn || level == LogLevel::Error);
+            if (level == LogLevel::Error) {
+                if (column > 0u) {
+                    status.error(line, column, str);
+                } else {
+                    status.error(line, str);
+                }
+            } else {
+                if (column > 0u) {
+                    status.warn(line, column, str);
+                } else {
+                    status.warn(line, str);
+                }
+            }
+        }
     }
 }
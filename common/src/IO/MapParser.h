@@ -31,16 +31,20 @@
 #include <vector>
 
 namespace TrenchBroom {
+    enum class LogLevel;
+
     namespace Model {
         class EntityAttribute;
         class BrushFaceAttributes;
     }
 
     namespace IO {
+        class MapCacheReader;
+        class MapCacheWriter;
         class ParserStatus;
 
         class MapParser {
-        protected:
+        public:
             class ExtraAttribute {
             public:
                 typedef enum {
@@ -59,6 +63,8 @@ namespace TrenchBroom {
                 Type type() const;
                 const std::string& name() const;
                 const std::string& strValue() const;
+                size_t line() const;
+                size_t column() const;
 
                 void assertType(Type expected) const;
 
@@ -70,15 +76,43 @@ namespace TrenchBroom {
             };
 
             using ExtraAttributes = std::map<std::string, ExtraAttribute>;
+        private:
+            MapCacheWriter* m_cacheWriter;
         public:
+            MapParser();
             virtual ~MapParser();
+
+            /**
+             * Records every event reported by this parser in the given cache writer. Pass nullptr to stop recording.
+             */
+            void setCacheWriter(MapCacheWriter* cacheWriter);
         protected:
+            /**
+             * Reports the events read from the given map cache instead of parsing any text.
+             *
+             * @throw FileFormatException if the cache is corrupt
+             */
+            void replay(MapCacheReader& reader, ParserStatus& status);
+
             void formatSet(Model::MapFormat format);
             void beginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status);
             void endEntity(size_t startLine, size_t lineCount, ParserStatus& status);
             void beginBrush(size_t line, ParserStatus& status);
             void endBrush(size_t startLine, size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status);
             void brushFace(size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status);
+
+            /**
+             * Reports a problem with the map text to the given status. Problems are recorded like the other events, so
+             * that they are reported again when the map is read from a cache.
+             */
+            void reportWarning(ParserStatus& status, size_t line, size_t column, const std::string& str) const;
+            void reportWarning(ParserStatus& status, size_t line, const std::string& str) const;
+            void reportError(ParserStatus& status, size_t line, const std::string& str) const;
+        private:
+            /**
+             * Reports the given problem, a column of 0 means that the problem does not refer to a particular column.
+             */
+            void report(ParserStatus& status, LogLevel level, size_t line, size_t column, const std::string& str) const;
         private: // subclassing interface for users of the parser
             virtual void onFormatSet(Model::MapFormat format) = 0;
             virtual void onBeginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) = 0;
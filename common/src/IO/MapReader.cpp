@@ -85,6 +85,12 @@ namespace TrenchBroom {
             resolveNodes(status);
         }
 
+        void MapReader::readEntities(MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status) {
+            m_worldBounds = worldBounds;
+            replay(cache, status);
+            resolveNodes(status);
+        }
+
         void MapReader::readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
             parseBrushes(format, status);
@@ -44,6 +44,7 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        class MapCacheReader;
         class ParserStatus;
 
         class MapReader : public StandardMapParser {
@@ -97,6 +98,7 @@ namespace TrenchBroom {
             explicit MapReader(const std::string& str);
 
             void readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
+            void readEntities(MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status);
             void readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
             void readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
         public:
@@ -21,6 +21,7 @@
 
 #include "Exceptions.h"
 #include "Macros.h"
+#include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/EntityAttributes.h"
 
@@ -35,14 +36,14 @@ namespace TrenchBroom {
             explicit QuakeStreamSerializer(std::ostream& stream) :
             MapStreamSerializer(stream) {}
         private:
-            virtual void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) override {
+            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const override {
                 writeFacePoints(stream, face);
                 stream << " ";
                 writeTextureInfo(stream, face);
                 stream << "\n";
             }
         protected:
-            void writeFacePoints(std::ostream& stream, Model::BrushFace* face) {
+            void writeFacePoints(std::ostream& stream, const Model::BrushFace* face) const {
                 const Model::BrushFace::Points& points = face->points();
 
                 stream.precision(FloatPrecision);
@@ -58,7 +59,7 @@ namespace TrenchBroom {
                 ftos(points[2].z(), FloatPrecision) << " )";
             }
 
-            void writeTextureInfo(std::ostream& stream, Model::BrushFace* face) {
+            void writeTextureInfo(std::ostream& stream, const Model::BrushFace* face) const {
                 const std::string& textureName = face->textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face->textureName();
                 stream << textureName << " " <<
                 ftos(face->xOffset(), FloatPrecision)  << " " <<
@@ -68,7 +69,7 @@ namespace TrenchBroom {
                 ftos(face->yScale(), FloatPrecision);
             }
 
-            void writeValveTextureInfo(std::ostream& stream, Model::BrushFace* face) {
+            void writeValveTextureInfo(std::ostream& stream, const Model::BrushFace* face) const {
                 const std::string& textureName = face->textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face->textureName();
                 const vm::vec3& xAxis = face->textureXAxis();
                 const vm::vec3& yAxis = face->textureYAxis();
@@ -98,7 +99,7 @@ namespace TrenchBroom {
             explicit Quake2StreamSerializer(std::ostream& stream) :
             QuakeStreamSerializer(stream) {}
         private:
-            virtual void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) override {
+            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const override {
                 writeFacePoints(stream, face);
                 stream << " ";
                 writeTextureInfo(stream, face);
@@ -108,7 +109,7 @@ namespace TrenchBroom {
                 stream << "\n";
             }
         protected:
-            void writeSurfaceAttributes(std::ostream& stream, Model::BrushFace* face) {
+            void writeSurfaceAttributes(std::ostream& stream, const Model::BrushFace* face) const {
                 stream <<
                 face->surfaceContents()  << " " <<
                 face->surfaceFlags()     << " " <<
@@ -121,7 +122,7 @@ namespace TrenchBroom {
             explicit Quake2ValveStreamSerializer(std::ostream& stream) :
             Quake2StreamSerializer(stream) {}
         private:
-            virtual void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) override {
+            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const override {
                 writeFacePoints(stream, face);
                 stream << " ";
                 writeValveTextureInfo(stream, face);
@@ -137,7 +138,7 @@ namespace TrenchBroom {
             explicit DaikatanaStreamSerializer(std::ostream& stream) :
             Quake2StreamSerializer(stream) {}
         private:
-            virtual void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) override {
+            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const override {
                 writeFacePoints(stream, face);
                 stream << " ";
                 writeTextureInfo(stream, face);
@@ -153,7 +154,7 @@ namespace TrenchBroom {
                 stream << "\n";
             }
         protected:
-            void writeSurfaceColor(std::ostream& stream, Model::BrushFace* face) {
+            void writeSurfaceColor(std::ostream& stream, const Model::BrushFace* face) const {
                 stream <<
                 static_cast<int>(face->color().r()) << " " <<
                 static_cast<int>(face->color().g()) << " " <<
@@ -166,7 +167,7 @@ namespace TrenchBroom {
             explicit ValveStreamSerializer(std::ostream& stream) :
             QuakeStreamSerializer(stream) {}
         private:
-            void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) override {
+            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const override {
 
                 writeFacePoints(stream, face);
                 stream << " ";
@@ -180,7 +181,7 @@ namespace TrenchBroom {
             explicit Hexen2StreamSerializer(std::ostream& stream) :
             QuakeStreamSerializer(stream) {}
         private:
-            virtual void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) override {
+            void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const override {
                 writeFacePoints(stream, face);
                 stream << " ";
                 writeTextureInfo(stream, face);
@@ -255,8 +256,7 @@ namespace TrenchBroom {
         }
 
         void MapStreamSerializer::doBeginBrush(const Model::Brush* /* brush */) {
-            m_stream << "// brush " << brushNo() << "\n";
-            m_stream << "{\n";
+            writeBrushHeader(m_stream, brushNo());
         }
 
         void MapStreamSerializer::doEndBrush(Model::Brush* /* brush */) {
@@ -266,5 +266,30 @@ namespace TrenchBroom {
         void MapStreamSerializer::doBrushFace(Model::BrushFace* face) {
             doWriteBrushFace(m_stream, face);
         }
+
+        bool MapStreamSerializer::doCanFormatBrushesConcurrently() const {
+            return true;
+        }
+
+        void MapStreamSerializer::doFormatBrushes(BrushChunk& chunk, BrushIterator first, const BrushIterator last, const ObjectNo firstBrushNo) const {
+            std::ostringstream stream;
+            for (auto no = firstBrushNo; first != last; ++first, ++no) {
+                writeBrushHeader(stream, no);
+                for (const auto* face : (*first)->faces()) {
+                    doWriteBrushFace(stream, face);
+                }
+                stream << "}\n";
+            }
+            chunk.text = stream.str();
+        }
+
+        void MapStreamSerializer::doWriteBrushChunk(const BrushChunk& chunk, BrushIterator /* first */, BrushIterator /* last */) {
+            m_stream << chunk.text;
+        }
+
+        void MapStreamSerializer::writeBrushHeader(std::ostream& stream, const ObjectNo no) {
+            stream << "// brush " << no << "\n";
+            stream << "{\n";
+        }
     }
 }
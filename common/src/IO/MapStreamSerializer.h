@@ -51,8 +51,18 @@ namespace TrenchBroom {
             void doBeginBrush(const Model::Brush* brush) override;
             void doEndBrush(Model::Brush* brush) override;
             void doBrushFace(Model::BrushFace* face) override;
+
+            bool doCanFormatBrushesConcurrently() const override;
+            void doFormatBrushes(BrushChunk& chunk, BrushIterator first, BrushIterator last, ObjectNo firstBrushNo) const override;
+            void doWriteBrushChunk(const BrushChunk& chunk, BrushIterator first, BrushIterator last) override;
+
+            static void writeBrushHeader(std::ostream& stream, ObjectNo no);
         private:
-            virtual void doWriteBrushFace(std::ostream& stream, Model::BrushFace* face) = 0;
+            /**
+             * Writes the given face to the given stream. This is called concurrently when brushes are formatted in
+             * chunks, so it must not modify this serializer.
+             */
+            virtual void doWriteBrushFace(std::ostream& stream, const Model::BrushFace* face) const = 0;
         };
     }
 }
@@ -231,7 +231,7 @@ namespace TrenchBroom {
         m_fs(fs) {}
 
         // http://tfc.duke.free.fr/old/models/md2.htm
-        std::unique_ptr<Assets::EntityModel> Md2Parser::doInitializeModel(Logger& logger) {
+        std::unique_ptr<Assets::EntityModel> Md2Parser::doInitializeModel(Logger& /* logger */) {
             auto reader = Reader::from(m_begin, m_end);
             const int ident = reader.readInt<int32_t>();
             const int version = reader.readInt<int32_t>();
@@ -247,22 +247,18 @@ namespace TrenchBroom {
             /*const size_t skinHeight =*/ reader.readSize<int32_t>();
             /*const size_t frameSize =*/ reader.readSize<int32_t>();
 
-            const size_t skinCount = reader.readSize<int32_t>();
+            /* const size_t skinCount = */ reader.readSize<int32_t>();
             /* const size_t frameVertexCount = */ reader.readSize<int32_t>();
             /* const size_t texCoordCount =*/ reader.readSize<int32_t>();
             /* const size_t triangleCount =*/ reader.readSize<int32_t>();
             /* const size_t commandCount = */ reader.readSize<int32_t>();
 
             const size_t frameCount = reader.readSize<int32_t>();
-            const size_t skinOffset = reader.readSize<int32_t>();
-
-            const Md2SkinList skins = parseSkins(reader.subReaderFromBegin(skinOffset), skinCount);
 
             auto model = std::make_unique<Assets::EntityModel>(m_name);
             model->addFrames(frameCount);
-
-            auto& surface = model->addSurface(m_name);
-            loadSkins(surface, skins, logger);
+            model->setSkinsLoaded(false);
+            model->addSurface(m_name);
 
             return model;
         }
@@ -304,6 +300,28 @@ namespace TrenchBroom {
             buildFrame(model, surface, frameIndex, frame, meshes);
         }
 
+        void Md2Parser::doLoadSkins(Assets::EntityModel& model, Logger& logger) {
+            auto reader = Reader::from(m_begin, m_end);
+            /* const auto ident = */ reader.readInt<int32_t>();
+            /* const auto version = */ reader.readInt<int32_t>();
+
+            /*const auto skinWidth =*/ reader.readSize<int32_t>();
+            /*const auto skinHeight =*/ reader.readSize<int32_t>();
+            /*const auto frameSize =*/ reader.readSize<int32_t>();
+
+            const auto skinCount = reader.readSize<int32_t>();
+            /* const auto vertexCount = */ reader.readSize<int32_t>();
+            /* const auto texCoordCount =*/ reader.readSize<int32_t>();
+            /* const auto triangleCount =*/ reader.readSize<int32_t>();
+            /* const auto commandCount = */ reader.readSize<int32_t>();
+            /* const auto frameCount = */ reader.readSize<int32_t>();
+
+            const auto skinOffset = reader.readSize<int32_t>();
+
+            const auto skins = parseSkins(reader.subReaderFromBegin(skinOffset), skinCount);
+            loadSurfaceSkins(model.surface(0), skins, logger);
+        }
+
         Md2Parser::Md2SkinList Md2Parser::parseSkins(Reader reader, const size_t skinCount) {
             Md2SkinList skins;
             skins.reserve(skinCount);
@@ -345,7 +363,7 @@ namespace TrenchBroom {
             return meshes;
         }
 
-        void Md2Parser::loadSkins(Assets::EntityModelSurface& surface, const Md2SkinList& skins, Logger& logger) {
+        void Md2Parser::loadSurfaceSkins(Assets::EntityModelSurface& surface, const Md2SkinList& skins, Logger& logger) {
             for (const auto& skin : skins) {
                 surface.addSkin(loadSkin(Path(skin), m_fs, logger, m_palette).release());
             }
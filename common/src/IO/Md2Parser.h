@@ -100,12 +100,13 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
+            void doLoadSkins(Assets::EntityModel& model, Logger& logger) override;
 
             Md2SkinList parseSkins(Reader reader, size_t skinCount);
             Md2Frame parseFrame(Reader reader, size_t frameIndex, size_t vertexCount);
             Md2MeshList parseMeshes(Reader reader, size_t commandCount);
 
-            void loadSkins(Assets::EntityModelSurface& surface, const Md2SkinList& skins, Logger& logger);
+            void loadSurfaceSkins(Assets::EntityModelSurface& surface, const Md2SkinList& skins, Logger& logger);
 
             void buildFrame(Assets::EntityModel& model, Assets::EntityModelSurface& surface, size_t frameIndex, const Md2Frame& frame, const Md2MeshList& meshes);
             std::vector<Assets::EntityModelVertex> getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const;
@@ -59,7 +59,7 @@ namespace TrenchBroom {
             unused(m_end);
         }
 
-        std::unique_ptr<Assets::EntityModel> Md3Parser::doInitializeModel(Logger& logger) {
+        std::unique_ptr<Assets::EntityModel> Md3Parser::doInitializeModel(Logger& /* logger */) {
             auto reader = Reader::from(m_begin, m_end);
 
             const auto ident = reader.readInt<int32_t>();
@@ -86,7 +86,8 @@ namespace TrenchBroom {
 
             auto model = std::make_unique<Assets::EntityModel>(m_name);
             model->addFrames(frameCount);
-            parseSurfaces(reader.subReaderFromBegin(surfaceOffset), surfaceCount, *model, logger);
+            model->setSkinsLoaded(false);
+            parseSurfaces(reader.subReaderFromBegin(surfaceOffset), surfaceCount, *model);
 
             return model;
         }
@@ -120,7 +121,28 @@ namespace TrenchBroom {
             parseFrameSurfaces(reader.subReaderFromBegin(surfaceOffset), frame, model);
         }
 
-        void Md3Parser::parseSurfaces(Reader reader, const size_t surfaceCount, Assets::EntityModel& model, Logger& logger) {
+        void Md3Parser::doLoadSkins(Assets::EntityModel& model, Logger& logger) {
+            auto reader = Reader::from(m_begin, m_end);
+
+            /* const auto ident = */ reader.readInt<int32_t>();
+            /* const auto version = */ reader.readInt<int32_t>();
+
+            /* const auto name = */ reader.readString(Md3Layout::ModelNameLength);
+            /* const auto flags = */ reader.readInt<int32_t>();
+
+            /* const auto frameCount = */ reader.readSize<int32_t>();
+            /* const auto tagCount = */ reader.readSize<int32_t>();
+            /* const auto surfaceCount = */ reader.readSize<int32_t>();
+            /* const auto skinCount = */ reader.readSize<int32_t>();
+
+            /* const auto frameOffset = */ reader.readSize<int32_t>();
+            /* const auto tagOffset = */ reader.readSize<int32_t>();
+            const auto surfaceOffset = reader.readSize<int32_t>();
+
+            parseSurfaceSkins(reader.subReaderFromBegin(surfaceOffset), model, logger);
+        }
+
+        void Md3Parser::parseSurfaces(Reader reader, const size_t surfaceCount, Assets::EntityModel& model) {
             for (size_t i = 0; i < surfaceCount; ++i) {
                 const auto ident = reader.readInt<int32_t>();
 
@@ -131,6 +153,33 @@ namespace TrenchBroom {
                 const auto surfaceName = reader.readString(Md3Layout::SurfaceNameLength);
                 /* const auto flags = */ reader.readInt<int32_t>();
                 /* const auto frameCount = */ reader.readSize<int32_t>();
+                /* const auto shaderCount = */ reader.readSize<int32_t>();
+                /* const auto vertexCount = */ reader.readSize<int32_t>(); // the number of vertices per frame!
+                /* const auto triangleCount = */ reader.readSize<int32_t>();
+
+                /* const auto triangleOffset = */ reader.readSize<int32_t>();
+                /* const auto shaderOffset = */ reader.readSize<int32_t>();
+                /* const auto texCoordOffset = */ reader.readSize<int32_t>();
+                /* const auto vertexOffset = */ reader.readSize<int32_t>(); // all vertices for all frames are stored there!
+                const auto endOffset = reader.readSize<int32_t>();
+
+                model.addSurface(surfaceName);
+
+                reader = reader.subReaderFromBegin(endOffset);
+            }
+        }
+
+        void Md3Parser::parseSurfaceSkins(Reader reader, Assets::EntityModel& model, Logger& logger) {
+            for (size_t i = 0; i < model.surfaceCount(); ++i) {
+                const auto ident = reader.readInt<int32_t>();
+
+                if (ident != Md3Layout::Ident) {
+                    throw AssetException("Unknown MD3 model surface ident: " + std::to_string(ident));
+                }
+
+                /* const auto surfaceName = */ reader.readString(Md3Layout::SurfaceNameLength);
+                /* const auto flags = */ reader.readInt<int32_t>();
+                /* const auto frameCount = */ reader.readSize<int32_t>();
                 const auto shaderCount = reader.readSize<int32_t>();
                 /* const auto vertexCount = */ reader.readSize<int32_t>(); // the number of vertices per frame!
                 /* const auto triangleCount = */ reader.readSize<int32_t>();
@@ -142,9 +191,7 @@ namespace TrenchBroom {
                 const auto endOffset = reader.readSize<int32_t>();
 
                 const auto shaders = parseShaders(reader.subReaderFromBegin(shaderOffset, shaderCount * Md3Layout::ShaderLength), shaderCount);
-
-                auto& surface = model.addSurface(surfaceName);
-                loadSurfaceSkins(surface, shaders, logger);
+                loadSurfaceSkins(model.surface(i), shaders, logger);
 
                 reader = reader.subReaderFromBegin(endOffset);
             }
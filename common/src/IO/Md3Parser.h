@@ -54,8 +54,10 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
+            void doLoadSkins(Assets::EntityModel& model, Logger& logger) override;
 
-            void parseSurfaces(Reader surfaceReader, size_t surfaceCount, Assets::EntityModel& model, Logger& logger);
+            void parseSurfaces(Reader surfaceReader, size_t surfaceCount, Assets::EntityModel& model);
+            void parseSurfaceSkins(Reader surfaceReader, Assets::EntityModel& model, Logger& logger);
             Assets::EntityModelLoadedFrame& parseFrame(Reader frameReader, size_t frameIndex, Assets::EntityModel& model);
             void parseFrameSurfaces(Reader surfaceReader, Assets::EntityModelLoadedFrame& frame, Assets::EntityModel& model);
 
@@ -39,12 +39,14 @@ namespace TrenchBroom {
             static const int Ident = (('O'<<24) + ('P'<<16) + ('D'<<8) + 'I');
             static const int Version6 = 6;
 
-            static const unsigned int HeaderNumSkins    = 0x30;
-            static const unsigned int Skins             = 0x54;
-            static const unsigned int SimpleFrameName   = 0x8;
-            static const unsigned int SimpleFrameLength = 0x10;
-            static const unsigned int MultiFrameTimes   = 0xC;
-            // static const unsigned int FrameVertexSize   = 0x4;
+            static const unsigned int HeaderNumSkins     = 0x30;
+            static const unsigned int Skins              = 0x54;
+            static const unsigned int SkinVertexLength   = 0xC;
+            static const unsigned int SkinTriangleLength = 0x10;
+            static const unsigned int SimpleFrameName    = 0x8;
+            static const unsigned int SimpleFrameLength  = 0x10;
+            static const unsigned int MultiFrameTimes    = 0xC;
+            // static const unsigned int FrameVertexSize    = 0x4;
         }
 
         const vm::vec3f MdlParser::Normals[] = {
@@ -243,18 +245,23 @@ namespace TrenchBroom {
             const auto skinCount = reader.readSize<int32_t>();
             const auto skinWidth = reader.readSize<int32_t>();
             const auto skinHeight = reader.readSize<int32_t>();
-            /* const auto skinVertexCount = */ reader.readSize<int32_t>();
-            /* const auto skinTriangleCount = */ reader.readSize<int32_t>();
+            const auto vertexCount = reader.readSize<int32_t>();
+            const auto triangleCount = reader.readSize<int32_t>();
             const auto frameCount = reader.readSize<int32_t>();
             /* const auto syncType = */ reader.readSize<int32_t>();
             const auto flags = reader.readInt<int32_t>();
 
+            // the skins are only decoded once the model is rendered, but they must be skipped to find the frames
+            reader.seekFromBegin(MdlLayout::Skins);
+            skipSkins(reader, skinCount, skinWidth, skinHeight, flags);
+            reader.seekForward(vertexCount * MdlLayout::SkinVertexLength);
+            reader.seekForward(triangleCount * MdlLayout::SkinTriangleLength);
+
             auto model = std::make_unique<Assets::EntityModel>(m_name);
             model->addFrames(frameCount);
-            auto& surface = model->addSurface(m_name);
-
-            reader.seekFromBegin(MdlLayout::Skins);
-            parseSkins(reader, surface, skinCount, skinWidth, skinHeight, flags);
+            model->setFrameOffsets(parseFrameOffsets(reader, frameCount, vertexCount));
+            model->setSkinsLoaded(false);
+            model->addSurface(m_name);
 
             return model;
         }
@@ -292,10 +299,28 @@ namespace TrenchBroom {
             const auto triangles = parseTriangles(reader, triangleCount);
 
             auto& surface = model.surface(0);
-            skipFrames(reader, frameIndex, vertexCount);
+            reader.seekFromBegin(model.frameOffset(frameIndex));
             parseFrame(reader, model, frameIndex, surface, triangles, vertices, skinWidth, skinHeight, origin, scale);
         }
 
+        void MdlParser::doLoadSkins(Assets::EntityModel& model, Logger& /* logger */) {
+            auto reader = Reader::from(m_begin, m_end);
+
+            reader.seekFromBegin(MdlLayout::HeaderNumSkins);
+            const auto skinCount = reader.readSize<int32_t>();
+            const auto skinWidth = reader.readSize<int32_t>();
+            const auto skinHeight = reader.readSize<int32_t>();
+            /* const auto vertexCount = */ reader.readSize<int32_t>();
+            /* const auto triangleCount = */ reader.readSize<int32_t>();
+            /* const auto frameCount = */ reader.readSize<int32_t>();
+            /* const auto syncType = */ reader.readSize<int32_t>();
+            const auto flags = reader.readInt<int32_t>();
+
+            auto& surface = model.surface(0);
+            reader.seekFromBegin(MdlLayout::Skins);
+            parseSkins(reader, surface, skinCount, skinWidth, skinHeight, flags);
+        }
+
         void MdlParser::parseSkins(Reader& reader, Assets::EntityModelSurface& surface, const size_t count, const size_t width, const size_t height, const int flags) {
             const auto size = width * height;
             const auto transparency = (flags & MF_HOLEY)
@@ -365,10 +390,15 @@ namespace TrenchBroom {
             return triangles;
         }
 
-        void MdlParser::skipFrames(Reader& reader, const size_t count, size_t vertexCount) {
+        std::vector<size_t> MdlParser::parseFrameOffsets(Reader& reader, const size_t count, const size_t vertexCount) {
             const auto frameLength = MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + vertexCount * 4;
 
+            std::vector<size_t> offsets;
+            offsets.reserve(count);
+
             for (size_t i = 0; i < count; ++i) {
+                offsets.push_back(reader.position());
+
                 const auto type = reader.readInt<int32_t>();
                 if (type == 0) { // single frame
                     reader.seekForward(frameLength);
@@ -382,6 +412,8 @@ namespace TrenchBroom {
                     reader.seekForward(frameTimeLength + groupFrameCount * frameLength);
                 }
             }
+
+            return offsets;
         }
 
         void MdlParser::parseFrame(Reader& reader, Assets::EntityModel& model, size_t frameIndex, Assets::EntityModelSurface& surface, const MdlSkinTriangleList& triangles, const MdlSkinVertexList& vertices, size_t skinWidth, size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale) {
@@ -66,6 +66,7 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<Assets::EntityModel> doInitializeModel(Logger& logger) override;
             void doLoadFrame(size_t frameIndex, Assets::EntityModel& model, Logger& logger) override;
+            void doLoadSkins(Assets::EntityModel& model, Logger& logger) override;
 
             void parseSkins(Reader& reader, Assets::EntityModelSurface& surface, size_t count, size_t width, size_t height, int flags);
             void skipSkins(Reader& reader, size_t count, size_t width, size_t height, int flags);
@@ -73,7 +74,7 @@ namespace TrenchBroom {
             MdlSkinVertexList parseVertices(Reader& reader, size_t count);
             MdlSkinTriangleList parseTriangles(Reader& reader, size_t count);
 
-            void skipFrames(Reader& reader, size_t count, size_t vertexCount);
+            std::vector<size_t> parseFrameOffsets(Reader& reader, size_t count, size_t vertexCount);
             void parseFrame(Reader& reader, Assets::EntityModel& model, size_t frameIndex, Assets::EntityModelSurface& surface, const MdlSkinTriangleList& triangles, const MdlSkinVertexList& vertices, size_t skinWidth, size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale);
             void doParseFrame(Reader reader, Assets::EntityModel& model, size_t frameIndex, Assets::EntityModelSurface& surface, const MdlSkinTriangleList& triangles, const MdlSkinVertexList& vertices, size_t skinWidth, size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale);
             vm::vec3f unpackFrameVertex(const PackedFrameVertex& vertex, const vm::vec3f& origin, const vm::vec3f& scale) const;
@@ -263,7 +263,7 @@ namespace TrenchBroom {
             model->addFrames(frameCount);
 
             auto& surface = model->addSurface(m_name);
-            loadSkins(surface, skins, logger);
+            loadSurfaceSkins(surface, skins, logger);
 
             return model;
         }
@@ -352,7 +352,7 @@ namespace TrenchBroom {
             return meshes;
         }
 
-        void MdxParser::loadSkins(Assets::EntityModelSurface& surface, const MdxSkinList& skins, Logger& logger) {
+        void MdxParser::loadSurfaceSkins(Assets::EntityModelSurface& surface, const MdxSkinList& skins, Logger& logger) {
             for (const auto& skin : skins) {
                 auto path = Path(skin);
                 if (path.isAbsolute()) {
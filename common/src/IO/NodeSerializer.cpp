@@ -26,24 +26,29 @@
 #include "Model/NodeVisitor.h"
 #include "Model/World.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 
 namespace TrenchBroom {
     namespace IO {
-        class NodeSerializer::BrushSerializer : public Model::NodeVisitor {
+        class NodeSerializer::CollectBrushes : public Model::NodeVisitor {
         private:
-            NodeSerializer& m_serializer;
+            std::vector<Model::Brush*> m_brushes;
         public:
-            explicit BrushSerializer(NodeSerializer& serializer) : m_serializer(serializer) {}
-
+            const std::vector<Model::Brush*>& brushes() const {
+                return m_brushes;
+            }
+        private:
             void doVisit(Model::World* /* world */) override   {}
             void doVisit(Model::Layer* /* layer */) override   {}
             void doVisit(Model::Group* /* group */) override   {}
             void doVisit(Model::Entity* /* entity */) override {}
-            void doVisit(Model::Brush* brush) override   { m_serializer.brush(brush); }
+            void doVisit(Model::Brush* brush) override   { m_brushes.push_back(brush); }
         };
 
         const std::string& NodeSerializer::IdManager::getId(const Model::Node* t) const {
@@ -102,8 +107,9 @@ namespace TrenchBroom {
         void NodeSerializer::entity(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, const std::vector<Model::EntityAttribute>& parentAttributes, Model::Node* brushParent) {
             beginEntity(node, attributes, parentAttributes);
 
-            BrushSerializer brushSerializer(*this);
-            brushParent->iterate(brushSerializer);
+            CollectBrushes collectBrushes;
+            brushParent->iterate(collectBrushes);
+            brushes(collectBrushes.brushes());
 
             endEntity(node);
         }
@@ -141,11 +147,43 @@ namespace TrenchBroom {
         }
 
         void NodeSerializer::brushes(const std::vector<Model::Brush*>& brushes) {
-            for (auto* brush : brushes) {
-                this->brush(brush);
+            if (brushes.size() >= 2u * BrushChunkSize && doCanFormatBrushesConcurrently()) {
+                formatBrushesConcurrently(brushes);
+            } else {
+                for (auto* brush : brushes) {
+                    this->brush(brush);
+                }
             }
         }
 
+        void NodeSerializer::formatBrushesConcurrently(const std::vector<Model::Brush*>& brushes) {
+            // Format a limited number of chunks at a time so that we never hold the text of all brushes in memory.
+            const size_t chunksPerBatch = 4u * kdl::parallel_thread_count();
+            const size_t chunkCount = (brushes.size() + BrushChunkSize - 1u) / BrushChunkSize;
+
+            std::vector<BrushChunk> chunks;
+            for (size_t firstChunk = 0u; firstChunk < chunkCount; firstChunk += chunksPerBatch) {
+                const size_t batchSize = std::min(chunksPerBatch, chunkCount - firstChunk);
+                chunks.clear();
+                chunks.resize(batchSize);
+
+                const auto chunkBegin = [&](const size_t i) {
+                    return std::next(std::begin(brushes), static_cast<std::ptrdiff_t>(std::min((firstChunk + i) * BrushChunkSize, brushes.size())));
+                };
+
+                kdl::parallel_for(batchSize, [&](const size_t i) {
+                    const auto firstBrushNo = m_brushNo + static_cast<ObjectNo>((firstChunk + i) * BrushChunkSize);
+                    doFormatBrushes(chunks[i], chunkBegin(i), chunkBegin(i + 1u), firstBrushNo);
+                });
+
+                for (size_t i = 0u; i < batchSize; ++i) {
+                    doWriteBrushChunk(chunks[i], chunkBegin(i), chunkBegin(i + 1u));
+                }
+            }
+
+            m_brushNo += static_cast<ObjectNo>(brushes.size());
+        }
+
         void NodeSerializer::brush(Model::Brush* brush) {
             beginBrush(brush);
             brushFaces(brush->faces());
@@ -171,6 +209,14 @@ namespace TrenchBroom {
             doBrushFace(face);
         }
 
+        bool NodeSerializer::doCanFormatBrushesConcurrently() const {
+            return false;
+        }
+
+        void NodeSerializer::doFormatBrushes(BrushChunk& /* chunk */, BrushIterator /* first */, BrushIterator /* last */, ObjectNo /* firstBrushNo */) const {}
+
+        void NodeSerializer::doWriteBrushChunk(const BrushChunk& /* chunk */, BrushIterator /* first */, BrushIterator /* last */) {}
+
         class NodeSerializer::GetParentAttributes : public Model::ConstNodeVisitor {
         private:
             const IdManager& m_layerIds;
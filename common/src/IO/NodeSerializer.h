@@ -40,10 +40,28 @@ namespace TrenchBroom {
     namespace IO {
         class NodeSerializer {
         private:
-            class BrushSerializer;
+            class CollectBrushes;
         protected:
             static const int FloatPrecision = 17;
             using ObjectNo = unsigned int;
+            using BrushIterator = std::vector<Model::Brush*>::const_iterator;
+
+            /**
+             * The text of a range of consecutive brushes that were formatted by a worker thread.
+             */
+            struct BrushChunk {
+                std::string text;
+                /**
+                 * The number of lines of each face in the order in which they were written. Serializers that do not
+                 * track file positions can leave this empty.
+                 */
+                std::vector<size_t> faceLineCounts;
+            };
+
+            /**
+             * The number of brushes that are formatted in one chunk when formatting brushes concurrently.
+             */
+            static const size_t BrushChunkSize = 64;
         private:
             class IdManager {
             private:
@@ -86,6 +104,7 @@ namespace TrenchBroom {
             void entityAttribute(const Model::EntityAttribute& attribute);
 
             void brushes(const std::vector<Model::Brush*>& brushes);
+            void formatBrushesConcurrently(const std::vector<Model::Brush*>& brushes);
             void brush(Model::Brush* brush);
 
             void beginBrush(const Model::Brush* brush);
@@ -114,6 +133,29 @@ namespace TrenchBroom {
             virtual void doBeginBrush(const Model::Brush* brush) = 0;
             virtual void doEndBrush(Model::Brush* brush) = 0;
             virtual void doBrushFace(Model::BrushFace* face) = 0;
+
+            /**
+             * Indicates whether this serializer implements doFormatBrushes and doWriteBrushChunk. If so, the brushes
+             * of large entities are formatted into chunks concurrently, and the chunks are written in order. The
+             * output must be identical to writing the brushes one by one.
+             */
+            virtual bool doCanFormatBrushesConcurrently() const;
+
+            /**
+             * Formats the brushes in the given range into the given chunk. This is called concurrently from several
+             * threads, so it must not modify this serializer.
+             *
+             * @param chunk the chunk to format into
+             * @param first the first brush to format
+             * @param last the end of the range of brushes to format
+             * @param firstBrushNo the number of the first brush
+             */
+            virtual void doFormatBrushes(BrushChunk& chunk, BrushIterator first, BrushIterator last, ObjectNo firstBrushNo) const;
+
+            /**
+             * Writes a chunk that was formatted by doFormatBrushes for the brushes in the given range.
+             */
+            virtual void doWriteBrushChunk(const BrushChunk& chunk, BrushIterator first, BrushIterator last);
         };
     }
 }
@@ -163,6 +163,29 @@ namespace TrenchBroom {
             m_serializer->endFile();
         }
 
+        void NodeWriter::writePartialMap(const std::vector<Model::Node*>& nodes, const std::vector<Model::Brush*>& additionalWorldBrushes) {
+            using CollectNodes = Model::AssortNodesVisitorT<Model::SkipLayersStrategy, Model::CollectGroupsStrategy, Model::CollectEntitiesStrategy, CollectEntityBrushesStrategy>;
+
+            m_serializer->beginFile();
+
+            CollectNodes collect;
+            Model::Node::accept(std::begin(nodes), std::end(nodes), collect);
+
+            auto worldBrushes = collect.worldBrushes();
+            worldBrushes.insert(std::end(worldBrushes), std::begin(additionalWorldBrushes), std::end(additionalWorldBrushes));
+            m_serializer->entity(&m_world, m_world.attributes(), {}, worldBrushes);
+            writeEntityBrushes(collect.entityBrushes());
+
+            const std::vector<Model::Group*>& groups = collect.groups();
+            const std::vector<Model::Entity*>& entities = collect.entities();
+
+            WriteNode visitor(*m_serializer);
+            Model::Node::accept(std::begin(groups), std::end(groups), visitor);
+            Model::Node::accept(std::begin(entities), std::end(entities), visitor);
+
+            m_serializer->endFile();
+        }
+
         void NodeWriter::writeWorldBrushes(const std::vector<Model::Brush*>& brushes) {
             if (!brushes.empty()) {
                 m_serializer->entity(&m_world, m_world.attributes(), {}, brushes);
@@ -58,6 +58,16 @@ namespace TrenchBroom {
             void writeCustomLayer(Model::Layer* layer);
         public:
             void writeNodes(const std::vector<Model::Node*>& nodes);
+
+            /**
+             * Writes the given nodes as a complete map for compiling a part of the world. The worldspawn entity is
+             * always written with the world's attributes, and the given additional brushes are added to it. These
+             * brushes need not belong to the world.
+             *
+             * @param nodes the nodes to write, layers are skipped
+             * @param additionalWorldBrushes brushes to add to the worldspawn entity
+             */
+            void writePartialMap(const std::vector<Model::Node*>& nodes, const std::vector<Model::Brush*>& additionalWorldBrushes);
         private:
             void writeWorldBrushes(const std::vector<Model::Brush*>& brushes);
             void writeEntityBrushes(const EntityBrushesMap& entityBrushes);
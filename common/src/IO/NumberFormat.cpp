@@ -0,0 +1,131 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumberFormat.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Writes the decimal digits of the given value into the given buffer, which must have room for 20 characters.
+         * Returns the number of digits written.
+         */
+        static int writeDigits(char* buffer, uint64_t value) {
+            char reversed[20];
+            int count = 0;
+            do {
+                reversed[count++] = static_cast<char>('0' + (value % 10u));
+                value /= 10u;
+            } while (value > 0u);
+
+            for (int i = 0; i < count; ++i) {
+                buffer[i] = reversed[count - i - 1];
+            }
+            return count;
+        }
+
+        /**
+         * Tries to write the given finite value without going through printf. This succeeds if the value can be
+         * written as m / 2^k for an integer m and a small k, because then its decimal expansion is finite and can be
+         * computed exactly as m * 5^k / 10^k. If that expansion fits into the given precision and %g would not
+         * switch to exponential notation, the result is identical to printf's output.
+         */
+        static bool appendExactFloat(std::string& str, const double value, const int precision) {
+            static const int MaxPowerOfTwo = 8;
+            static const double MaxInteger = 9007199254740992.0; // 2^53
+            static const double MaxFractionNumerator = 1099511627776.0; // 2^40, m * 5^8 must not overflow
+
+            const auto absValue = std::abs(value);
+
+            auto scaled = absValue;
+            int k = 0;
+            while (scaled != std::floor(scaled)) {
+                if (k == MaxPowerOfTwo || scaled >= MaxFractionNumerator) {
+                    return false;
+                }
+                scaled *= 2.0;
+                ++k;
+            }
+
+            if (scaled >= (k == 0 ? MaxInteger : MaxFractionNumerator)) {
+                return false;
+            }
+
+            auto decimal = static_cast<uint64_t>(scaled);
+            for (int i = 0; i < k; ++i) {
+                decimal *= 5u;
+            }
+
+            char digits[20];
+            const auto digitCount = writeDigits(digits, decimal);
+            const auto integerDigits = digitCount - k;
+
+            // %g rounds to the given number of significant digits, and it uses exponential notation if the decimal
+            // exponent is not less than the precision or less than -4
+            if (digitCount > precision || integerDigits < -3) {
+                return false;
+            }
+
+            if (std::signbit(value)) {
+                str.push_back('-');
+            }
+
+            if (integerDigits > 0) {
+                str.append(digits, static_cast<size_t>(integerDigits));
+                if (k > 0) {
+                    str.push_back('.');
+                    str.append(digits + integerDigits, static_cast<size_t>(k));
+                }
+            } else {
+                str.append("0.");
+                str.append(static_cast<size_t>(-integerDigits), '0');
+                str.append(digits, static_cast<size_t>(digitCount));
+            }
+            return true;
+        }
+
+        void appendFloat(std::string& str, const double value, const int precision) {
+            if (std::isfinite(value) && precision > 0 && precision <= 17 && appendExactFloat(str, value, precision)) {
+                return;
+            }
+
+            char buffer[64];
+            const auto length = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            if (length > 0) {
+                str.append(buffer, static_cast<size_t>(length));
+            }
+        }
+
+        void appendInteger(std::string& str, const long long value) {
+            char digits[20];
+            if (value < 0) {
+                str.push_back('-');
+                // negate in unsigned arithmetic so that the minimum value does not overflow
+                const auto count = writeDigits(digits, 0u - static_cast<uint64_t>(value));
+                str.append(digits, static_cast<size_t>(count));
+            } else {
+                const auto count = writeDigits(digits, static_cast<uint64_t>(value));
+                str.append(digits, static_cast<size_t>(count));
+            }
+        }
+    }
+}
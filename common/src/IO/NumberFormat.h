@@ -0,0 +1,43 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_NumberFormat
+#define TrenchBroom_NumberFormat
+
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Appends the given value to the given string exactly as std::printf would format it with the "%.<p>g"
+         * conversion in the C locale, where p is the given precision.
+         *
+         * Integers and fractions with small power of two denominators, which make up the vast majority of values
+         * in map files, are formatted directly. All other values are passed on to std::snprintf.
+         */
+        void appendFloat(std::string& str, double value, int precision);
+
+        /**
+         * Appends the decimal representation of the given value to the given string.
+         */
+        void appendInteger(std::string& str, long long value);
+    }
+}
+
+#endif /* defined(TrenchBroom_NumberFormat) */
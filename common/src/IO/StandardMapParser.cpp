@@ -306,7 +306,7 @@ namespace TrenchBroom {
                 attributes.push_back(Model::EntityAttribute(name, value, nullptr));
                 names.insert(name);
             } else {
-                status.warn(line, column, "Ignoring duplicate entity property '" + name + "'");
+                reportWarning(status, line, column, "Ignoring duplicate entity property '" + name + "'");
             }
         }
 
@@ -387,7 +387,7 @@ namespace TrenchBroom {
                             }
                             endBrush(startLine, token.line() - startLine, extraAttributes, status);
                         } else {
-                            status.warn(startLine, "Skipping brush primitive: currently not supported");
+                            reportWarning(status, startLine, "Skipping brush primitive: currently not supported");
                         }
                         return;
                     default: {
@@ -610,7 +610,7 @@ namespace TrenchBroom {
             const auto [result, plane] = vm::from_points(p1, p2, p3); // use the same test as in the brush face initializer
             unused(plane); // [[maybe_unused]] doesn't seem to work well with structured bindings
             if (!result) {
-                status.error(line, "Skipping face: face points are colinear");
+                reportError(status, line, "Skipping face: face points are colinear");
                 return false;
             } else {
                 return true;
@@ -628,14 +628,14 @@ namespace TrenchBroom {
             token = expect(QuakeMapToken::Integer, m_tokenizer.nextToken());
             auto h = token.toInteger<int>();
             if (h < 0) {
-                status.warn(token.line(), token.column(), "Negative patch height, assuming 0");
+                reportWarning(status, token.line(), token.column(), "Negative patch height, assuming 0");
                 h = 0;
             }
 
             token = expect(QuakeMapToken::Integer, m_tokenizer.nextToken());
             auto w = token.toInteger<int>();
             if (w < 0) {
-                status.warn(token.line(), token.column(), "Negative patch width, assuming 0");
+                reportWarning(status, token.line(), token.column(), "Negative patch width, assuming 0");
                 w = 0;
             }
 
@@ -657,7 +657,7 @@ namespace TrenchBroom {
             expect(QuakeMapToken::CBrace, m_tokenizer.nextToken());
 
             // TODO 2428: create the actual patch
-            status.warn(startLine, "Skipping patch: currently not supported");
+            reportWarning(status, startLine, "Skipping patch: currently not supported");
         }
 
         std::tuple<vm::vec3, vm::vec3, vm::vec3> StandardMapParser::parseFacePoints(ParserStatus& /* status */) {
@@ -44,6 +44,13 @@ namespace TrenchBroom {
             return std::move(m_world);
         }
 
+        std::unique_ptr<Model::World> WorldReader::read(MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status) {
+            readEntities(cache, worldBounds, status);
+            m_world->rebuildNodeTree();
+            m_world->enableNodeTreeUpdates();
+            return std::move(m_world);
+        }
+
         Model::ModelFactory& WorldReader::initialize(const Model::MapFormat format) {
             m_world = std::make_unique<Model::World>(format);
             m_world->disableNodeTreeUpdates();
@@ -26,8 +26,10 @@
 #include <kdl/compact_trie.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom {
@@ -48,6 +50,14 @@ namespace TrenchBroom {
             return AttributableNodeIndexQuery(Type_Any);
         }
 
+        AttributableNodeIndexQuery::Type AttributableNodeIndexQuery::type() const {
+            return m_type;
+        }
+
+        const std::string& AttributableNodeIndexQuery::pattern() const {
+            return m_pattern;
+        }
+
         std::set<AttributableNode*> AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
             std::set<AttributableNode*> result;
             switch (m_type) {
@@ -115,37 +125,141 @@ namespace TrenchBroom {
                 removeAttribute(attributable, attribute.name(), attribute.value());
         }
 
+        static bool isDigit(const char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        /**
+         * Returns the given attribute name without its trailing digits, e.g. "target12" becomes "target".
+         */
+        static std::string_view numberedPrefix(const std::string& name) {
+            auto length = name.size();
+            while (length > 0u && isDigit(name[length - 1u])) {
+                --length;
+            }
+            return std::string_view(name).substr(0u, length);
+        }
+
+        /**
+         * Numbered queries can only be answered from the numbered index if the pattern is a literal prefix that does not
+         * end in a digit, since otherwise the trailing digits of an attribute name could belong to the pattern.
+         */
+        static bool isIndexedNumberedPrefix(const std::string& prefix) {
+            if (!prefix.empty() && isDigit(prefix.back())) {
+                return false;
+            }
+            return prefix.find_first_of("*?%\\") == std::string::npos;
+        }
+
+        static void addToValueIndex(AttributableNode* attributable, const std::string& name, const std::string& value, AttributableNodeValueIndex& index) {
+            index[name][value].push_back(attributable);
+        }
+
+        static void removeFromValueIndex(AttributableNode* attributable, const std::string& name, const std::string& value, AttributableNodeValueIndex& index) {
+            auto nameIt = index.find(name);
+            if (nameIt == std::end(index)) {
+                return;
+            }
+
+            auto& values = nameIt->second;
+            auto valueIt = values.find(value);
+            if (valueIt == std::end(values)) {
+                return;
+            }
+
+            // the order of the nodes does not matter, so we can swap the removed node with the last one
+            auto& nodes = valueIt->second;
+            auto it = std::find(std::begin(nodes), std::end(nodes), attributable);
+            if (it != std::end(nodes)) {
+                *it = nodes.back();
+                nodes.pop_back();
+            }
+
+            if (nodes.empty()) {
+                values.erase(valueIt);
+                if (values.empty()) {
+                    index.erase(nameIt);
+                }
+            }
+        }
+
+        static const std::vector<AttributableNode*>* findInValueIndex(const std::string& name, const std::string& value, const AttributableNodeValueIndex& index) {
+            const auto nameIt = index.find(name);
+            if (nameIt == std::end(index)) {
+                return nullptr;
+            }
+
+            const auto& values = nameIt->second;
+            const auto valueIt = values.find(value);
+            if (valueIt == std::end(values)) {
+                return nullptr;
+            }
+
+            return &valueIt->second;
+        }
+
         void AttributableNodeIndex::addAttribute(AttributableNode* attributable, const std::string& name, const std::string& value) {
             m_nameIndex->insert(name, attributable);
             m_valueIndex->insert(value, attributable);
+            addToValueIndex(attributable, name, value, m_nameValueIndex);
+            addToValueIndex(attributable, std::string(numberedPrefix(name)), value, m_numberedValueIndex);
         }
 
         void AttributableNodeIndex::removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value) {
             m_nameIndex->remove(name, attributable);
             m_valueIndex->remove(value, attributable);
+            removeFromValueIndex(attributable, name, value, m_nameValueIndex);
+            removeFromValueIndex(attributable, std::string(numberedPrefix(name)), value, m_numberedValueIndex);
         }
 
         std::vector<AttributableNode*> AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const std::string& value) const {
+            std::vector<AttributableNode*> result;
+            findAttributableNodes(nameQuery, value, result);
+            return result;
+        }
+
+        void AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const std::string& value, std::vector<AttributableNode*>& result) const {
+            switch (nameQuery.type()) {
+                case AttributableNodeIndexQuery::Type_Exact:
+                    if (const auto* nodes = findInValueIndex(nameQuery.pattern(), value, m_nameValueIndex)) {
+                        result.insert(std::end(result), std::begin(*nodes), std::end(*nodes));
+                    }
+                    break;
+                case AttributableNodeIndexQuery::Type_Numbered:
+                    if (isIndexedNumberedPrefix(nameQuery.pattern())) {
+                        if (const auto* nodes = findInValueIndex(nameQuery.pattern(), value, m_numberedValueIndex)) {
+                            // a node with several matching attributes is listed more than once
+                            const auto first = static_cast<std::ptrdiff_t>(result.size());
+                            result.insert(std::end(result), std::begin(*nodes), std::end(*nodes));
+                            std::sort(std::next(std::begin(result), first), std::end(result));
+                            result.erase(std::unique(std::next(std::begin(result), first), std::end(result)), std::end(result));
+                        }
+                    } else {
+                        findAttributableNodesInTries(nameQuery, value, result);
+                    }
+                    break;
+                case AttributableNodeIndexQuery::Type_Prefix:
+                case AttributableNodeIndexQuery::Type_Any:
+                    findAttributableNodesInTries(nameQuery, value, result);
+                    break;
+                switchDefault()
+            }
+        }
+
+        void AttributableNodeIndex::findAttributableNodesInTries(const AttributableNodeIndexQuery& nameQuery, const std::string& value, std::vector<AttributableNode*>& result) const {
             const std::set<AttributableNode*> nameResult = nameQuery.execute(*m_nameIndex);
 
             std::set<AttributableNode*> valueResult;
             m_valueIndex->find_matches(value, std::inserter(valueResult, std::end(valueResult)));
             if (nameResult.empty() || valueResult.empty()) {
-                return {};
+                return;
             }
 
-            std::vector<AttributableNode*> result = kdl::set_intersection(nameResult, valueResult);
-
-            auto it = std::begin(result);
-            while (it != std::end(result)) {
-                const AttributableNode* node = *it;
-                if (!nameQuery.execute(node, value))
-                    it = result.erase(it);
-                else
-                    ++it;
+            for (AttributableNode* node : kdl::set_intersection(nameResult, valueResult)) {
+                if (nameQuery.execute(node, value)) {
+                    result.push_back(node);
+                }
             }
-
-            return result;
         }
 
         std::vector<std::string> AttributableNodeIndex::allNames() const {
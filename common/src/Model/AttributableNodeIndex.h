@@ -25,6 +25,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -33,6 +34,7 @@ namespace TrenchBroom {
         class EntityAttribute;
 
         using AttributableNodeStringIndex = kdl::compact_trie<AttributableNode*>;
+        using AttributableNodeValueIndex = std::unordered_map<std::string, std::unordered_map<std::string, std::vector<AttributableNode*>>>;
 
         class AttributableNodeIndexQuery {
         public:
@@ -51,6 +53,9 @@ namespace TrenchBroom {
             static AttributableNodeIndexQuery numbered(const std::string& pattern);
             static AttributableNodeIndexQuery any();
 
+            Type type() const;
+            const std::string& pattern() const;
+
             std::set<AttributableNode*> execute(const AttributableNodeStringIndex& index) const;
             bool execute(const AttributableNode* node, const std::string& value) const;
             std::vector<Model::EntityAttribute> execute(const AttributableNode* node) const;
@@ -62,6 +67,18 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<AttributableNodeStringIndex> m_nameIndex;
             std::unique_ptr<AttributableNodeStringIndex> m_valueIndex;
+
+            /**
+             * Maps exact (name, value) pairs to the nodes that have such an attribute.
+             */
+            AttributableNodeValueIndex m_nameValueIndex;
+
+            /**
+             * Maps (name, value) pairs to the nodes that have an attribute with the same value and whose name is the
+             * given name followed by zero or more digits, e.g. "target", "target1" and "target2" are indexed under
+             * "target". A node is listed once per matching attribute.
+             */
+            AttributableNodeValueIndex m_numberedValueIndex;
         public:
             AttributableNodeIndex();
             ~AttributableNodeIndex();
@@ -73,8 +90,16 @@ namespace TrenchBroom {
             void removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value);
 
             std::vector<AttributableNode*> findAttributableNodes(const AttributableNodeIndexQuery& keyQuery, const std::string& value) const;
+
+            /**
+             * Appends the nodes matching the given query and value to the given vector. Exact and numbered queries are
+             * answered from the (name, value) indices and do not allocate other than for growing the result.
+             */
+            void findAttributableNodes(const AttributableNodeIndexQuery& keyQuery, const std::string& value, std::vector<AttributableNode*>& result) const;
             std::vector<std::string> allNames() const;
             std::vector<std::string> allValuesForNames(const AttributableNodeIndexQuery& keyQuery) const;
+        private:
+            void findAttributableNodesInTries(const AttributableNodeIndexQuery& keyQuery, const std::string& value, std::vector<AttributableNode*>& result) const;
         };
     }
 }
@@ -39,6 +39,7 @@
 #include "Model/World.h"
 #include "Renderer/BrushRendererBrushCache.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/intersection.h>
@@ -51,6 +52,7 @@
 #include <vecmath/util.h>
 
 #include <algorithm> // for std::remove
+#include <exception>
 #include <iterator>
 #include <set>
 #include <string>
@@ -295,6 +297,7 @@ namespace TrenchBroom {
 
         Brush::Brush(const vm::bbox3& worldBounds, const std::vector<BrushFace*>& faces) :
         m_geometry(nullptr),
+        m_snapshot(nullptr),
         m_transparent(false),
         m_brushRendererBrushCache(std::make_unique<Renderer::BrushRendererBrushCache>()) {
             addFaces(faces);
@@ -311,6 +314,11 @@ namespace TrenchBroom {
         }
 
         void Brush::cleanup() {
+            if (m_snapshot != nullptr) {
+                // the snapshot cannot be restored anymore, so it doesn't need the geometry
+                m_snapshot->stopSharingGeometry();
+                m_snapshot = nullptr;
+            }
             deleteGeometry();
             kdl::vec_clear_and_delete(m_faces);
         }
@@ -396,6 +404,14 @@ namespace TrenchBroom {
             return m_faces.size();
         }
 
+        size_t Brush::memoryUsage() const {
+            auto result = sizeof(Brush) + m_faces.capacity() * sizeof(BrushFace*) + m_faces.size() * sizeof(BrushFace);
+            if (m_geometry != nullptr) {
+                result += m_geometry->memoryUsage();
+            }
+            return result;
+        }
+
         const std::vector<BrushFace*>& Brush::faces() const {
             return m_faces;
         }
@@ -1207,6 +1223,10 @@ namespace TrenchBroom {
         }
 
         bool Brush::canTransform(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const {
+            if (canTransformGeometry(transformation, worldBounds)) {
+                return true;
+            }
+
             auto* testBrush = clone(worldBounds);
             bool result = true;
 
@@ -1220,6 +1240,164 @@ namespace TrenchBroom {
             return result;
         }
 
+        /**
+         * Checks whether the given matrix is an affine transformation whose linear part has a positive determinant.
+         * Such transformations map a convex polyhedron onto a convex polyhedron with the same topology and the same
+         * face orientation.
+         */
+        static bool isOrientationPreservingAffine(const vm::mat4x4& transformation) {
+            if (transformation[0][3] != 0.0 || transformation[1][3] != 0.0 || transformation[2][3] != 0.0 || transformation[3][3] != 1.0) {
+                return false;
+            }
+
+            const auto x = vm::vec3(transformation[0][0], transformation[0][1], transformation[0][2]);
+            const auto y = vm::vec3(transformation[1][0], transformation[1][1], transformation[1][2]);
+            const auto z = vm::vec3(transformation[2][0], transformation[2][1], transformation[2][2]);
+            return vm::dot(x, vm::cross(y, z)) > vm::C::almost_zero();
+        }
+
+        /**
+         * Transforms the given position like the vertices of a rebuilt geometry would be transformed, including the
+         * correction that is applied after building a geometry.
+         */
+        static vm::vec3 transformPosition(const vm::mat4x4& transformation, const vm::vec3& position) {
+            return vm::correct(transformation * position);
+        }
+
+        bool Brush::canTransformGeometry(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const {
+            if (m_geometry == nullptr || !isOrientationPreservingAffine(transformation)) {
+                return false;
+            }
+
+            for (const auto* vertex : m_geometry->vertices()) {
+                if (!worldBounds.contains(transformPosition(transformation, vertex->position()))) {
+                    return false;
+                }
+            }
+
+            const auto minEdgeLength2 = BrushGeometry::MinEdgeLength * BrushGeometry::MinEdgeLength;
+            for (const auto* edge : m_geometry->edges()) {
+                const auto first = transformPosition(transformation, edge->firstVertex()->position());
+                const auto second = transformPosition(transformation, edge->secondVertex()->position());
+                if (vm::squared_length(second - first) < minEdgeLength2) {
+                    return false;
+                }
+            }
+
+            // compute the transformed face planes in the same way as BrushFace::transform does
+            for (const auto* face : m_faces) {
+                const auto& points = face->points();
+                const auto p0 = transformPosition(transformation, points[0]);
+                const auto p1 = transformPosition(transformation, points[1]);
+                const auto p2 = transformPosition(transformation, points[2]);
+
+                const auto [valid, plane] = vm::from_points(p0, p1, p2);
+                if (!valid || vm::dot(plane.normal, face->boundary().transform(transformation).normal) <= 0.0) {
+                    return false;
+                }
+
+                for (const auto* halfEdge : face->geometry()->boundary()) {
+                    const auto position = transformPosition(transformation, halfEdge->origin()->position());
+                    if (plane.point_status(position) != vm::plane_status::inside) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void Brush::transformGeometry(const vm::mat4x4& transformation) {
+            assert(m_geometry != nullptr);
+
+            if (m_snapshot != nullptr) {
+                // the snapshot keeps the untransformed geometry
+                releaseGeometryToSnapshot(std::make_unique<BrushGeometry>(*m_geometry));
+            }
+
+            for (auto* vertex : m_geometry->vertices()) {
+                vertex->setPosition(transformation * vertex->position());
+            }
+            m_geometry->correctVertexPositions();
+
+            for (auto* face : m_faces) {
+                face->resetTexCoordSystemCache();
+            }
+            invalidateVertexCache();
+        }
+
+        /**
+         * Transforming a single brush is cheap, so each range handed to the shared thread pool should contain enough
+         * brushes to make up for the cost of queueing it and waking a worker. The pool threads are created once, so
+         * repeated transformations during a drag do not start any threads.
+         */
+        static constexpr size_t MinBrushesPerTransformThread = 64u;
+
+        bool Brush::canTransformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, const vm::bbox3& worldBounds) {
+            // only the check of the in place transformation runs concurrently; the fallback clones the brush, which
+            // changes the usage counts of its textures and notifies the texture collections
+            std::vector<char> transformDirectly(brushes.size(), 0);
+            kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                transformDirectly[i] = brushes[i]->canTransformGeometry(transformation, worldBounds) ? 1 : 0;
+            }, MinBrushesPerTransformThread);
+
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                if (!transformDirectly[i] && !brushes[i]->canTransform(transformation, worldBounds)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void Brush::transformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) {
+            for (auto* brush : brushes) {
+                brush->nodeWillChange();
+            }
+
+            std::vector<vm::bbox3> oldBounds(brushes.size());
+            std::vector<std::exception_ptr> exceptions(brushes.size());
+            kdl::parallel_for(brushes.size(), [&](const size_t i) {
+                auto* brush = brushes[i];
+                oldBounds[i] = brush->physicalBounds();
+                try {
+                    brush->applyTransformation(transformation, lockTextures, worldBounds);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                }
+            }, MinBrushesPerTransformThread);
+
+            // the notifications update the node tree and invalidate issues, so they must be sent sequentially
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                auto* brush = brushes[i];
+                if (exceptions[i] == nullptr) {
+                    brush->nodePhysicalBoundsDidChange(oldBounds[i]);
+                }
+                brush->nodeDidChange();
+            }
+
+            for (const auto& exception : exceptions) {
+                if (exception != nullptr) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+
+        void Brush::applyTransformation(const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) {
+            // must be checked before the faces are transformed
+            const auto transformDirectly = canTransformGeometry(transformation, worldBounds);
+
+            for (auto* face : m_faces) {
+                face->transform(transformation, lockTextures);
+            }
+
+            if (transformDirectly) {
+                transformGeometry(transformation);
+            } else {
+                deleteGeometry();
+                buildGeometry(worldBounds);
+            }
+        }
+
         Brush* Brush::createBrush(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const BrushGeometry& geometry, const std::vector<Brush*>& subtrahends) const {
             std::vector<BrushFace*> faces(0);
             faces.reserve(geometry.faceCount());
@@ -1304,7 +1482,12 @@ namespace TrenchBroom {
             for (auto* brushFace : m_faces) {
                 brushFace->setGeometry(nullptr);
             }
-            delete m_geometry;
+
+            if (m_snapshot != nullptr) {
+                releaseGeometryToSnapshot(std::unique_ptr<BrushGeometry>(m_geometry));
+            } else {
+                delete m_geometry;
+            }
             m_geometry = nullptr;
         }
 
@@ -1330,6 +1513,45 @@ namespace TrenchBroom {
             return true;
         }
 
+        void Brush::setSnapshot(BrushSnapshot* snapshot) {
+            if (m_snapshot != nullptr) {
+                // only the most recent snapshot can share the geometry, older snapshots rebuild it when restored
+                m_snapshot->stopSharingGeometry();
+            }
+            m_snapshot = snapshot;
+        }
+
+        void Brush::releaseGeometryToSnapshot(std::unique_ptr<BrushGeometry> geometry) {
+            assert(m_snapshot != nullptr);
+
+            auto* snapshot = m_snapshot;
+            m_snapshot = nullptr;
+            snapshot->takeGeometry(std::move(geometry));
+        }
+
+        void Brush::restoreSnapshot(const vm::bbox3& worldBounds, BrushSnapshot& snapshot) {
+            const NotifyNodeChange nodeChange(this);
+
+            // if the snapshot still shares the current geometry, it receives the geometry here
+            const vm::bbox3 oldBounds = physicalBounds();
+            deleteGeometry();
+
+            detachFaces(m_faces);
+            kdl::vec_clear_and_delete(m_faces);
+
+            auto faces = snapshot.releaseFaces();
+            auto geometry = snapshot.releaseGeometry();
+            if (geometry != nullptr) {
+                // the faces are already linked with the geometry
+                m_geometry = geometry.release();
+                updateFacesFromGeometry(worldBounds, *m_geometry);
+            } else {
+                addFaces(faces);
+                buildGeometry(worldBounds);
+            }
+            nodePhysicalBoundsDidChange(oldBounds);
+        }
+
         void Brush::findIntegerPlanePoints(const vm::bbox3& worldBounds) {
             const NotifyNodeChange nodeChange(this);
 
@@ -1452,11 +1674,9 @@ namespace TrenchBroom {
         void Brush::doTransform(const vm::mat4x4& transformation, bool lockTextures, const vm::bbox3& worldBounds) {
             const NotifyNodeChange nodeChange(this);
 
-            for (auto* face : m_faces) {
-                face->transform(transformation, lockTextures);
-            }
-
-            rebuildGeometry(worldBounds);
+            const auto oldBounds = physicalBounds();
+            applyTransformation(transformation, lockTextures, worldBounds);
+            nodePhysicalBoundsDidChange(oldBounds);
         }
 
         class Brush::Contains : public ConstNodeVisitor, public NodeQuery<bool> {
@@ -1531,6 +1751,10 @@ namespace TrenchBroom {
             m_brushRendererBrushCache->invalidateVertexCache();
         }
 
+        void Brush::invalidateTextureCache() {
+            m_brushRendererBrushCache->invalidateTextureCache();
+        }
+
         Renderer::BrushRendererBrushCache& Brush::brushRendererBrushCache() const {
             return *m_brushRendererBrushCache;
         }
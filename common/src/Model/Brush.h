@@ -40,6 +40,7 @@ namespace TrenchBroom {
     }
 
     namespace Model {
+        class BrushSnapshot;
         class ModelFactory;
         template <typename P> class PolyhedronMatcher;
 
@@ -47,6 +48,7 @@ namespace TrenchBroom {
 
         class Brush : public Node, public Object {
         private:
+            friend class BrushSnapshot;
             friend class SetTempFaceLinks;
         public:
             static const HitType::Type BrushHit;
@@ -64,6 +66,13 @@ namespace TrenchBroom {
             std::vector<BrushFace*> m_faces;
             BrushGeometry* m_geometry;
 
+            /**
+             * The most recent snapshot of this brush if this brush's geometry hasn't changed since the snapshot was
+             * taken. The snapshot receives the geometry before it is changed or deleted, so that the geometry can be
+             * reattached when the snapshot is restored instead of being rebuilt.
+             */
+            BrushSnapshot* m_snapshot;
+
             mutable bool m_transparent;
             mutable std::unique_ptr<Renderer::BrushRendererBrushCache> m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
         public:
@@ -83,6 +92,11 @@ namespace TrenchBroom {
             BrushFace* findFace(const std::vector<vm::polygon3>& candidates, FloatType epsilon = static_cast<FloatType>(0.0)) const;
 
             size_t faceCount() const;
+
+            /**
+             * Returns an estimate of the number of bytes held by this brush, its faces and its geometry.
+             */
+            size_t memoryUsage() const;
             const std::vector<BrushFace*>& faces() const;
             void setFaces(const vm::bbox3& worldBounds, const std::vector<BrushFace*>& faces);
 
@@ -235,6 +249,51 @@ namespace TrenchBroom {
 
             // transformation
             bool canTransform(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const;
+
+            /**
+             * Checks whether all of the given brushes can be transformed. Whether a brush can be transformed in place is
+             * checked concurrently. The brushes that must be rebuilt are checked on the calling thread because checking
+             * them requires a clone, which changes the usage counts of the textures.
+             */
+            static bool canTransformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, const vm::bbox3& worldBounds);
+
+            /**
+             * Transforms the given brushes like calling transform on each of them, but transforms the brushes
+             * concurrently. The node change and bounds change notifications are sent on the calling thread in the
+             * order of the given brushes, so the updates of the node tree and the issue invalidation remain
+             * deterministic.
+             *
+             * If the transformation of any brush fails, the remaining brushes are still transformed and notified, and
+             * the exception of the first failed brush is rethrown afterwards.
+             */
+            static void transformBrushes(const std::vector<Brush*>& brushes, const vm::mat4x4& transformation, bool lockTextures, const vm::bbox3& worldBounds);
+        private:
+            /**
+             * Transforms the faces and the geometry of this brush without sending any notifications. Only touches
+             * this brush, so it is safe to call concurrently for different brushes.
+             */
+            void applyTransformation(const vm::mat4x4& transformation, bool lockTextures, const vm::bbox3& worldBounds);
+
+            /**
+             * Checks whether the given transformation can be applied by transforming the vertices of this brush's
+             * geometry in place instead of rebuilding it from the transformed faces. This is the case if the
+             * transformation is an orientation preserving affine transformation, all transformed vertices remain
+             * within the world bounds, no edge becomes shorter than the minimum edge length, and every transformed
+             * vertex lies on the transformed planes of its incident faces.
+             *
+             * @param transformation the transformation to check
+             * @param worldBounds the world bounds
+             * @return true if the geometry can be transformed directly
+             */
+            bool canTransformGeometry(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const;
+
+            /**
+             * Transforms the vertices of this brush's geometry in place, reusing its topology. The caller must have
+             * checked that this is possible using canTransformGeometry and must have transformed the faces already.
+             *
+             * @param transformation the transformation to apply
+             */
+            void transformGeometry(const vm::mat4x4& transformation);
         private:
             /**
              * Final step of CSG subtraction; takes the geometry that is the result of the subtraction, and turns it
@@ -258,6 +317,10 @@ namespace TrenchBroom {
             void buildGeometry(const vm::bbox3& worldBounds);
             void deleteGeometry();
             bool checkGeometry() const;
+        private: // snapshots
+            void setSnapshot(BrushSnapshot* snapshot);
+            void releaseGeometryToSnapshot(std::unique_ptr<BrushGeometry> geometry);
+            void restoreSnapshot(const vm::bbox3& worldBounds, BrushSnapshot& snapshot);
         public:
             void findIntegerPlanePoints(const vm::bbox3& worldBounds);
         private: // implement Node interface
@@ -308,6 +371,12 @@ namespace TrenchBroom {
              * Only exposed to be called by BrushFace
              */
             void invalidateVertexCache();
+
+            /**
+             * Only exposed to be called by BrushFace when a face's texture or texture coordinates change, but its
+             * geometry does not.
+             */
+            void invalidateTextureCache();
             Renderer::BrushRendererBrushCache& brushRendererBrushCache() const;
         private: // implement Taggable interface
         public:
@@ -44,8 +44,16 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef> // for std::max_align_t
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <variant>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -57,27 +65,274 @@ namespace TrenchBroom {
             return halfEdge->edge();
         }
 
+        /**
+         * Allocates brush faces from large blocks instead of allocating every face separately. Faces are created and
+         * destroyed on several threads (e.g. by Brush::canTransformBrushes), so every thread keeps its own list of
+         * free slots. A thread only locks the shared state to take or return a batch of slots, or to add a block.
+         *
+         * Freed slots are reused, but the blocks are only released by releaseUnusedMemory once no face is alive
+         * anymore. The threads notice this by the changed generation and drop their lists of free slots.
+         */
+        class BrushFaceAllocator {
+        private:
+            static constexpr size_t FacesPerBlock = 1024u;
+            static constexpr size_t SlotsPerBatch = 256u;
+            static_assert(alignof(BrushFace) <= alignof(std::max_align_t), "brush faces must not be over-aligned");
+
+            struct FreeSlot {
+                FreeSlot* next;
+            };
+
+            class FreeList {
+            private:
+                FreeSlot* m_head;
+                size_t m_size;
+            public:
+                FreeList() :
+                m_head(nullptr),
+                m_size(0u) {}
+
+                bool empty() const {
+                    return m_head == nullptr;
+                }
+
+                size_t size() const {
+                    return m_size;
+                }
+
+                void push(void* ptr) {
+                    auto* slot = static_cast<FreeSlot*>(ptr);
+                    slot->next = m_head;
+                    m_head = slot;
+                    ++m_size;
+                }
+
+                void* pop() {
+                    assert(!empty());
+                    auto* slot = m_head;
+                    m_head = slot->next;
+                    --m_size;
+                    return slot;
+                }
+
+                void moveTo(FreeList& other, const size_t count) {
+                    for (size_t i = 0u; i < count && !empty(); ++i) {
+                        other.push(pop());
+                    }
+                }
+
+                void clear() {
+                    m_head = nullptr;
+                    m_size = 0u;
+                }
+            };
+
+            struct ThreadCache {
+                FreeList freeList;
+                uint64_t generation;
+                // only written by the owning thread, read by releaseUnusedMemory
+                std::atomic<std::ptrdiff_t> liveCount;
+
+                explicit ThreadCache(const uint64_t i_generation) :
+                generation(i_generation),
+                liveCount(0) {}
+
+                ~ThreadCache();
+            };
+
+            std::mutex m_mutex;
+            std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+            FreeList m_freeList;
+            std::vector<ThreadCache*> m_threadCaches;
+            // the live faces counted by threads that have exited
+            std::ptrdiff_t m_retiredLiveCount;
+            std::atomic<uint64_t> m_generation;
+        public:
+            BrushFaceAllocator() :
+            m_retiredLiveCount(0),
+            m_generation(0u) {}
+
+            void* allocate() {
+                auto* cache = threadCache();
+                if (cache == nullptr) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    ++m_retiredLiveCount;
+                    return popSharedSlot();
+                }
+
+                validate(*cache);
+                if (cache->freeList.empty()) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    while (cache->freeList.size() < SlotsPerBatch) {
+                        cache->freeList.push(popSharedSlot());
+                    }
+                }
+
+                cache->liveCount.store(cache->liveCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return cache->freeList.pop();
+            }
+
+            void deallocate(void* ptr) {
+                auto* cache = threadCache();
+                if (cache == nullptr) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    --m_retiredLiveCount;
+                    m_freeList.push(ptr);
+                    return;
+                }
+
+                validate(*cache);
+                cache->freeList.push(ptr);
+                cache->liveCount.store(cache->liveCount.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+                // return a batch so that slots freed on one thread can be reused by the others
+                if (cache->freeList.size() >= 2u * SlotsPerBatch) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    cache->freeList.moveTo(m_freeList, SlotsPerBatch);
+                }
+            }
+
+            /**
+             * Releases all blocks if no face is alive. Must not be called while faces are created or destroyed on
+             * other threads.
+             */
+            bool releaseUnusedMemory() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                auto liveCount = m_retiredLiveCount;
+                for (const auto* cache : m_threadCaches) {
+                    liveCount += cache->liveCount.load(std::memory_order_relaxed);
+                }
+                assert(liveCount >= 0);
+
+                if (liveCount != 0 || m_blocks.empty()) {
+                    return false;
+                }
+
+                m_freeList.clear();
+                m_blocks.clear();
+                m_generation.fetch_add(1u, std::memory_order_release);
+                return true;
+            }
+        private:
+            ThreadCache* threadCache();
+
+            void validate(ThreadCache& cache) const {
+                const auto generation = m_generation.load(std::memory_order_acquire);
+                if (cache.generation != generation) {
+                    // the slots belong to released blocks
+                    cache.freeList.clear();
+                    cache.generation = generation;
+                }
+            }
+
+            void retire(ThreadCache& cache) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (cache.generation == m_generation.load(std::memory_order_relaxed)) {
+                    cache.freeList.moveTo(m_freeList, cache.freeList.size());
+                }
+                m_retiredLiveCount += cache.liveCount.load(std::memory_order_relaxed);
+                m_threadCaches.erase(std::remove(std::begin(m_threadCaches), std::end(m_threadCaches), &cache), std::end(m_threadCaches));
+            }
+
+            void* popSharedSlot() {
+                if (m_freeList.empty()) {
+                    addBlock();
+                }
+                return m_freeList.pop();
+            }
+
+            void addBlock() {
+                auto* block = new unsigned char[FacesPerBlock * sizeof(BrushFace)];
+                m_blocks.emplace_back(block);
+
+                // link the slots so that they are handed out in address order
+                for (size_t i = FacesPerBlock; i > 0u; --i) {
+                    m_freeList.push(block + (i - 1u) * sizeof(BrushFace));
+                }
+            }
+        };
+
+        static BrushFaceAllocator& brushFaceAllocator() {
+            // never destroyed because faces may still be deleted during static destruction
+            static auto* allocator = new BrushFaceAllocator();
+            return *allocator;
+        }
+
+        // set once the cache of the current thread is destroyed, faces deleted afterwards use the shared free list
+        static thread_local bool threadCacheDestroyed = false;
+
+        BrushFaceAllocator::ThreadCache::~ThreadCache() {
+            brushFaceAllocator().retire(*this);
+            threadCacheDestroyed = true;
+        }
+
+        BrushFaceAllocator::ThreadCache* BrushFaceAllocator::threadCache() {
+            if (threadCacheDestroyed) {
+                return nullptr;
+            }
+
+            static thread_local ThreadCache* cache = nullptr;
+            if (cache == nullptr) {
+                static thread_local ThreadCache threadLocalCache(m_generation.load(std::memory_order_acquire));
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_threadCaches.push_back(&threadLocalCache);
+                cache = &threadLocalCache;
+            }
+            return cache;
+        }
+
+        static BrushFace::TexCoordSystemStorage toTexCoordSystemStorage(std::unique_ptr<TexCoordSystem> texCoordSystem) {
+            ensure(texCoordSystem != nullptr, "texCoordSystem is null");
+            if (const auto* paraxial = dynamic_cast<const ParaxialTexCoordSystem*>(texCoordSystem.get())) {
+                return *paraxial;
+            }
+
+            const auto* parallel = dynamic_cast<const ParallelTexCoordSystem*>(texCoordSystem.get());
+            ensure(parallel != nullptr, "unknown texCoordSystem type");
+            return *parallel;
+        }
+
         BrushFace::BrushFace(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, std::unique_ptr<TexCoordSystem> texCoordSystem) :
+        BrushFace(point0, point1, point2, attribs, toTexCoordSystemStorage(std::move(texCoordSystem))) {}
+
+        BrushFace::BrushFace(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, const TexCoordSystemStorage& texCoordSystem) :
         m_brush(nullptr),
         m_lineNumber(0),
         m_lineCount(0),
         m_selected(false),
-        m_texCoordSystem(std::move(texCoordSystem)),
+        m_texCoordSystem(texCoordSystem),
         m_geometry(nullptr),
         m_markedToRenderFace(false),
         m_attribs(attribs) {
-            ensure(m_texCoordSystem != nullptr, "texCoordSystem is null");
             setPoints(point0, point1, point2);
         }
 
         BrushFace* BrushFace::createParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const std::string& textureName) {
             const BrushFaceAttributes attribs(textureName);
-            return new BrushFace(point0, point1, point2, attribs, std::make_unique<ParaxialTexCoordSystem>(point0, point1, point2, attribs));
+            return new BrushFace(point0, point1, point2, attribs, ParaxialTexCoordSystem(point0, point1, point2, attribs));
         }
 
         BrushFace* BrushFace::createParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const std::string& textureName) {
             const BrushFaceAttributes attribs(textureName);
-            return new BrushFace(point0, point1, point2, attribs, std::make_unique<ParallelTexCoordSystem>(point0, point1, point2, attribs));
+            return new BrushFace(point0, point1, point2, attribs, ParallelTexCoordSystem(point0, point1, point2, attribs));
+        }
+
+        void* BrushFace::operator new(const size_t size) {
+            assert(size == sizeof(BrushFace));
+            unused(size);
+            return brushFaceAllocator().allocate();
+        }
+
+        void BrushFace::operator delete(void* ptr) {
+            if (ptr != nullptr) {
+                brushFaceAllocator().deallocate(ptr);
+            }
+        }
+
+        bool BrushFace::releaseUnusedMemory() {
+            BrushFaceAttributes::releaseUnusedTextureNames();
+            return brushFaceAllocator().releaseUnusedMemory();
         }
 
         void BrushFace::sortFaces(std::vector<BrushFace*>& faces) {
@@ -109,12 +364,11 @@ namespace TrenchBroom {
             m_lineNumber = 0;
             m_lineCount = 0;
             m_selected = false;
-            m_texCoordSystem = nullptr;
             m_geometry = nullptr;
         }
 
         BrushFace* BrushFace::clone() const {
-            BrushFace* result = new BrushFace(points()[0], points()[1], points()[2], textureName(), m_texCoordSystem->clone());
+            BrushFace* result = new BrushFace(points()[0], points()[1], points()[2], textureName(), m_texCoordSystem);
             result->m_attribs = m_attribs;
             result->setFilePosition(m_lineNumber, m_lineCount);
             if (m_selected)
@@ -123,16 +377,16 @@ namespace TrenchBroom {
         }
 
         BrushFaceSnapshot* BrushFace::takeSnapshot() {
-            return new BrushFaceSnapshot(this, *m_texCoordSystem);
+            return new BrushFaceSnapshot(this, texCoordSystem());
         }
 
         std::unique_ptr<TexCoordSystemSnapshot> BrushFace::takeTexCoordSystemSnapshot() const {
-            return m_texCoordSystem->takeSnapshot();
+            return texCoordSystem().takeSnapshot();
         }
 
         void BrushFace::restoreTexCoordSystemSnapshot(const TexCoordSystemSnapshot& coordSystemSnapshot) {
-            coordSystemSnapshot.restore(*m_texCoordSystem);
-            invalidateVertexCache();
+            coordSystemSnapshot.restore(texCoordSystem());
+            invalidateTextureCache();
         }
 
         void BrushFace::copyTexCoordSystemFromFace(const TexCoordSystemSnapshot& coordSystemSnapshot, const BrushFaceAttributes& attribs, const vm::plane3& sourceFacePlane, const WrapStyle wrapStyle) {
@@ -140,21 +394,21 @@ namespace TrenchBroom {
             const auto seam = vm::intersect_plane_plane(sourceFacePlane, m_boundary);
             const auto refPoint = vm::project_point(seam, center());
 
-            coordSystemSnapshot.restore(*m_texCoordSystem);
+            coordSystemSnapshot.restore(texCoordSystem());
 
             // Get the texcoords at the refPoint using the source face's attribs and tex coord system
-            const auto desriedCoords = m_texCoordSystem->getTexCoords(refPoint, attribs) * attribs.textureSize();
+            const auto desriedCoords = texCoordSystem().getTexCoords(refPoint, attribs) * attribs.textureSize();
 
-            m_texCoordSystem->updateNormal(sourceFacePlane.normal, m_boundary.normal, m_attribs, wrapStyle);
+            texCoordSystem().updateNormal(sourceFacePlane.normal, m_boundary.normal, m_attribs, wrapStyle);
 
             // Adjust the offset on this face so that the texture coordinates at the refPoint stay the same
             if (!vm::is_zero(seam.direction, vm::C::almost_zero())) {
-                const auto currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
+                const auto currentCoords = texCoordSystem().getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
                 const auto offsetChange = desriedCoords - currentCoords;
                 m_attribs.setOffset(correct(m_attribs.modOffset(m_attribs.offset() + offsetChange), 4));
             }
 
-            invalidateVertexCache();
+            invalidateTextureCache();
         }
 
         Brush* BrushFace::brush() const {
@@ -245,14 +499,12 @@ namespace TrenchBroom {
         void BrushFace::setAttribs(const BrushFaceAttributes& attribs) {
             const float oldRotation = m_attribs.rotation();
             m_attribs = attribs;
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attribs.rotation());
+            texCoordSystem().setRotation(m_boundary.normal, oldRotation, m_attribs.rotation());
             updateBrush();
         }
 
         void BrushFace::resetTexCoordSystemCache() {
-            if (m_texCoordSystem != nullptr) {
-                m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attribs);
-            }
+            texCoordSystem().resetCache(m_points[0], m_points[1], m_points[2], m_attribs);
         }
 
         const std::string& BrushFace::textureName() const {
@@ -404,7 +656,7 @@ namespace TrenchBroom {
 
             const auto oldRotation = m_attribs.rotation();
             m_attribs.setRotation(rotation);
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, rotation);
+            texCoordSystem().setRotation(m_boundary.normal, oldRotation, rotation);
             updateBrush();
             return true;
         }
@@ -454,33 +706,33 @@ namespace TrenchBroom {
         }
 
         vm::vec3 BrushFace::textureXAxis() const {
-            return m_texCoordSystem->xAxis();
+            return texCoordSystem().xAxis();
         }
 
         vm::vec3 BrushFace::textureYAxis() const {
-            return m_texCoordSystem->yAxis();
+            return texCoordSystem().yAxis();
         }
 
         void BrushFace::resetTextureAxes() {
-            m_texCoordSystem->resetTextureAxes(m_boundary.normal);
-            invalidateVertexCache();
+            texCoordSystem().resetTextureAxes(m_boundary.normal);
+            invalidateTextureCache();
         }
 
         void BrushFace::moveTexture(const vm::vec3& up, const vm::vec3& right, const vm::vec2f& offset) {
-            m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, m_attribs);
-            invalidateVertexCache();
+            texCoordSystem().moveTexture(m_boundary.normal, up, right, offset, m_attribs);
+            invalidateTextureCache();
         }
 
         void BrushFace::rotateTexture(const float angle) {
             const float oldRotation = m_attribs.rotation();
-            m_texCoordSystem->rotateTexture(m_boundary.normal, angle, m_attribs);
-            m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attribs.rotation());
-            invalidateVertexCache();
+            texCoordSystem().rotateTexture(m_boundary.normal, angle, m_attribs);
+            texCoordSystem().setRotation(m_boundary.normal, oldRotation, m_attribs.rotation());
+            invalidateTextureCache();
         }
 
         void BrushFace::shearTexture(const vm::vec2f& factors) {
-            m_texCoordSystem->shearTexture(m_boundary.normal, factors);
-            invalidateVertexCache();
+            texCoordSystem().shearTexture(m_boundary.normal, factors);
+            invalidateTextureCache();
         }
 
         void BrushFace::transform(const vm::mat4x4& transform, const bool lockTexture) {
@@ -500,7 +752,7 @@ namespace TrenchBroom {
 
             setPoints(m_points[0], m_points[1], m_points[2]);
 
-            m_texCoordSystem->transform(oldBoundary, m_boundary, transform, m_attribs, lockTexture, invariant);
+            texCoordSystem().transform(oldBoundary, m_boundary, transform, m_attribs, lockTexture, invariant);
         }
 
         void BrushFace::invert() {
@@ -527,12 +779,12 @@ namespace TrenchBroom {
                 const auto refPoint = project_point(seam, center());
 
                 // Get the texcoords at the refPoint using the old face's attribs and tex coord system
-                const auto desriedCoords = m_texCoordSystem->getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
+                const auto desriedCoords = texCoordSystem().getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
 
-                m_texCoordSystem->updateNormal(oldPlane.normal, m_boundary.normal, m_attribs, WrapStyle::Projection);
+                texCoordSystem().updateNormal(oldPlane.normal, m_boundary.normal, m_attribs, WrapStyle::Projection);
 
                 // Adjust the offset on this face so that the texture coordinates at the refPoint stay the same
-                const auto currentCoords = m_texCoordSystem->getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
+                const auto currentCoords = texCoordSystem().getTexCoords(refPoint, m_attribs) * m_attribs.textureSize();
                 const auto offsetChange = desriedCoords - currentCoords;
                 m_attribs.setOffset(correct(m_attribs.modOffset(m_attribs.offset() + offsetChange), 4));
             }
@@ -551,7 +803,7 @@ namespace TrenchBroom {
         }
 
         vm::mat4x4 BrushFace::projectToBoundaryMatrix() const {
-            const auto texZAxis = m_texCoordSystem->fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
+            const auto texZAxis = texCoordSystem().fromMatrix(vm::vec2f::zero(), vm::vec2f::one()) * vm::vec3::pos_z();
             const auto worldToPlaneMatrix = vm::plane_projection_matrix(m_boundary.distance, m_boundary.normal, texZAxis);
             const auto [invertible, planeToWorldMatrix] = vm::invert(worldToPlaneMatrix); assert(invertible); unused(invertible);
             return planeToWorldMatrix * vm::mat4x4::zero_out<2>() * worldToPlaneMatrix;
@@ -559,22 +811,22 @@ namespace TrenchBroom {
 
         vm::mat4x4 BrushFace::toTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const {
             if (project) {
-                return vm::mat4x4::zero_out<2>() * m_texCoordSystem->toMatrix(offset, scale);
+                return vm::mat4x4::zero_out<2>() * texCoordSystem().toMatrix(offset, scale);
             } else {
-                return m_texCoordSystem->toMatrix(offset, scale);
+                return texCoordSystem().toMatrix(offset, scale);
             }
         }
 
         vm::mat4x4 BrushFace::fromTexCoordSystemMatrix(const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const {
             if (project) {
-                return projectToBoundaryMatrix() * m_texCoordSystem->fromMatrix(offset, scale);
+                return projectToBoundaryMatrix() * texCoordSystem().fromMatrix(offset, scale);
             } else {
-                return m_texCoordSystem->fromMatrix(offset, scale);
+                return texCoordSystem().fromMatrix(offset, scale);
             }
         }
 
         float BrushFace::measureTextureAngle(const vm::vec2f& center, const vm::vec2f& point) const {
-            return m_texCoordSystem->measureAngle(m_attribs.rotation(), center, point);
+            return texCoordSystem().measureAngle(m_attribs.rotation(), center, point);
         }
 
         size_t BrushFace::vertexCount() const {
@@ -656,7 +908,11 @@ namespace TrenchBroom {
         }
 
         vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const {
-            return m_texCoordSystem->getTexCoords(point, m_attribs);
+            return texCoordSystem().getTexCoords(point, m_attribs);
+        }
+
+        TexCoordProjection BrushFace::textureProjection() const {
+            return texCoordSystem().getTexCoordProjection(m_attribs);
         }
 
         FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const {
@@ -697,10 +953,18 @@ namespace TrenchBroom {
             }
         }
 
+        TexCoordSystem& BrushFace::texCoordSystem() {
+            return std::visit([](auto& texCoordSystem) -> TexCoordSystem& { return texCoordSystem; }, m_texCoordSystem);
+        }
+
+        const TexCoordSystem& BrushFace::texCoordSystem() const {
+            return std::visit([](const auto& texCoordSystem) -> const TexCoordSystem& { return texCoordSystem; }, m_texCoordSystem);
+        }
+
         void BrushFace::updateBrush() {
             if (m_brush != nullptr) {
                 m_brush->faceDidChange();
-                m_brush->invalidateVertexCache();
+                m_brush->invalidateTextureCache();
             }
         }
 
@@ -710,6 +974,12 @@ namespace TrenchBroom {
             }
         }
 
+        void BrushFace::invalidateTextureCache() {
+            if (m_brush != nullptr) {
+                m_brush->invalidateTextureCache();
+            }
+        }
+
         void BrushFace::setMarked(const bool marked) const {
             m_markedToRenderFace = marked;
         }
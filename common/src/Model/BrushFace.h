@@ -24,6 +24,8 @@
 #include "Macros.h"
 #include "Model/BrushFaceAttributes.h"
 #include "Model/BrushGeometry.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
 #include "Model/Tag.h" // BrushFace inherits from Taggable
 
 #include <kdl/transform_range.h>
@@ -34,6 +36,7 @@
 
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom {
@@ -79,6 +82,11 @@ namespace TrenchBroom {
         public:
             using VertexList = kdl::transform_adapter<BrushHalfEdgeList, TransformHalfEdgeToVertex>;
             using EdgeList = kdl::transform_adapter<BrushHalfEdgeList, TransformHalfEdgeToEdge>;
+
+            /**
+             * The texture coordinate system is stored inline instead of on the heap.
+             */
+            using TexCoordSystemStorage = std::variant<ParaxialTexCoordSystem, ParallelTexCoordSystem>;
         private:
             Brush* m_brush;
             BrushFace::Points m_points;
@@ -87,7 +95,7 @@ namespace TrenchBroom {
             size_t m_lineCount;
             bool m_selected;
 
-            std::unique_ptr<TexCoordSystem> m_texCoordSystem;
+            TexCoordSystemStorage m_texCoordSystem;
             BrushFaceGeometry* m_geometry;
 
             // brush renderer
@@ -96,6 +104,7 @@ namespace TrenchBroom {
             BrushFaceAttributes m_attribs;
         public:
             BrushFace(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, std::unique_ptr<TexCoordSystem> texCoordSystem);
+            BrushFace(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const BrushFaceAttributes& attribs, const TexCoordSystemStorage& texCoordSystem);
 
             static BrushFace* createParaxial(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const std::string& textureName = "");
             static BrushFace* createParallel(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2, const std::string& textureName = "");
@@ -104,6 +113,22 @@ namespace TrenchBroom {
 
             virtual ~BrushFace() override;
 
+            /**
+             * Brush faces are allocated from a pool of large blocks because a map can easily contain hundreds of
+             * thousands of them.
+             */
+            static void* operator new(size_t size);
+            static void operator delete(void* ptr);
+
+            /**
+             * Releases the memory pooled for brush faces if no face is alive anymore, and releases the texture names
+             * that are no longer used by any face attributes. Must not be called while faces or face attributes are
+             * created or destroyed on other threads.
+             *
+             * @return true if the pooled memory was released
+             */
+            static bool releaseUnusedMemory();
+
             BrushFace* clone() const;
 
             BrushFaceSnapshot* takeSnapshot();
@@ -205,16 +230,21 @@ namespace TrenchBroom {
             void deselect();
 
             vm::vec2f textureCoords(const vm::vec3& point) const;
+            TexCoordProjection textureProjection() const;
 
             FloatType intersectWithRay(const vm::ray3& ray) const;
         private:
             void setPoints(const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2);
             void correctPoints();
 
+            TexCoordSystem& texCoordSystem();
+            const TexCoordSystem& texCoordSystem() const;
+
             void updateBrush();
 
             // renderer cache
             void invalidateVertexCache();
+            void invalidateTextureCache();
         public: // brush renderer
             /**
              * This is used to cache results of evaluating the BrushRenderer Filter.
@@ -18,18 +18,128 @@
  */
 
 #include "BrushFaceAttributes.h"
+#include "Macros.h"
 #include "Assets/Texture.h"
 
 #include <vecmath/vec.h>
 
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Model {
         const std::string BrushFaceAttributes::NoTextureName = "__TB_empty";
 
+        /**
+         * The single shared copy of a texture name. A map uses few distinct texture names on many faces, so every
+         * face only stores a pointer to the shared name. The reference count does not release the name when it drops
+         * to zero, it only tells TextureNameTable::releaseUnused which names can be released.
+         */
+        class InternedTextureName {
+        public:
+            const std::string name;
+            mutable std::atomic<size_t> referenceCount;
+
+            explicit InternedTextureName(const std::string& i_name) :
+            name(i_name),
+            referenceCount(0u) {}
+        };
+
+        /**
+         * Interns the texture names of the face attributes. Attributes are created on several threads, so every
+         * thread keeps a cache of the names it has looked up already and only locks the table to look up a name for
+         * the first time.
+         */
+        class TextureNameTable {
+        private:
+            struct ThreadCache {
+                std::unordered_map<std::string_view, InternedTextureName*> names;
+                uint64_t generation = 0u;
+            };
+
+            std::mutex m_mutex;
+            std::unordered_map<std::string_view, std::unique_ptr<InternedTextureName>> m_names;
+            std::atomic<uint64_t> m_generation;
+        public:
+            TextureNameTable() :
+            m_generation(0u) {}
+
+            const InternedTextureName* acquire(const std::string& name) {
+                return acquire(find(name));
+            }
+
+            const InternedTextureName* acquire(const InternedTextureName* name) {
+                name->referenceCount.fetch_add(1u, std::memory_order_relaxed);
+                return name;
+            }
+
+            void release(const InternedTextureName* name) {
+                const auto previous = name->referenceCount.fetch_sub(1u, std::memory_order_relaxed);
+                assert(previous > 0u);
+                unused(previous);
+            }
+
+            size_t releaseUnused() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                size_t count = 0u;
+                for (auto it = std::begin(m_names); it != std::end(m_names);) {
+                    if (it->second->referenceCount.load(std::memory_order_relaxed) == 0u) {
+                        it = m_names.erase(it);
+                        ++count;
+                    } else {
+                        ++it;
+                    }
+                }
+
+                if (count > 0u) {
+                    // the thread caches refer to the released names
+                    m_generation.fetch_add(1u, std::memory_order_release);
+                }
+                return count;
+            }
+        private:
+            InternedTextureName* find(const std::string& name) {
+                static thread_local ThreadCache cache;
+
+                const auto generation = m_generation.load(std::memory_order_acquire);
+                if (cache.generation != generation) {
+                    cache.names.clear();
+                    cache.generation = generation;
+                }
+
+                const auto cached = cache.names.find(name);
+                if (cached != std::end(cache.names)) {
+                    return cached->second;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_names.find(name);
+                if (it == std::end(m_names)) {
+                    auto interned = std::make_unique<InternedTextureName>(name);
+                    const auto key = std::string_view(interned->name);
+                    it = m_names.emplace(key, std::move(interned)).first;
+                }
+
+                cache.names.emplace(it->first, it->second.get());
+                return it->second.get();
+            }
+        };
+
+        static TextureNameTable& textureNames() {
+            // never destroyed because attributes may still be destroyed during static destruction
+            static auto* table = new TextureNameTable();
+            return *table;
+        }
+
         BrushFaceAttributes::BrushFaceAttributes(const std::string& textureName) :
-        m_textureName(textureName),
+        m_textureName(textureNames().acquire(textureName)),
         m_texture(nullptr),
         m_offset(vm::vec2f::zero()),
         m_scale(vm::vec2f(1.0f, 1.0f)),
@@ -39,7 +149,7 @@ namespace TrenchBroom {
         m_surfaceValue(0.0f) {}
 
         BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other) :
-        m_textureName(other.m_textureName),
+        m_textureName(textureNames().acquire(other.m_textureName)),
         m_texture(other.m_texture),
         m_offset(other.m_offset),
         m_scale(other.m_scale),
@@ -54,7 +164,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceAttributes::BrushFaceAttributes(const std::string& textureName, const BrushFaceAttributes& other) :
-        m_textureName(textureName),
+        m_textureName(textureNames().acquire(textureName)),
         m_texture(nullptr),
         m_offset(other.m_offset),
         m_scale(other.m_scale),
@@ -68,6 +178,7 @@ namespace TrenchBroom {
             if (m_texture != nullptr) {
                 m_texture->decUsageCount();
             }
+            textureNames().release(m_textureName);
         }
 
         BrushFaceAttributes& BrushFaceAttributes::operator=(BrushFaceAttributes other) {
@@ -102,7 +213,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceAttributes BrushFaceAttributes::takeSnapshot() const {
-            BrushFaceAttributes result(m_textureName);
+            BrushFaceAttributes result(m_textureName->name);
             result.m_offset = m_offset;
             result.m_scale = m_scale;
             result.m_rotation = m_rotation;
@@ -113,8 +224,12 @@ namespace TrenchBroom {
             return result;
         }
 
+        size_t BrushFaceAttributes::releaseUnusedTextureNames() {
+            return textureNames().releaseUnused();
+        }
+
         const std::string& BrushFaceAttributes::textureName() const {
-            return m_textureName;
+            return m_textureName->name;
         }
 
         Assets::Texture* BrushFaceAttributes::texture() const {
@@ -181,7 +296,7 @@ namespace TrenchBroom {
             m_texture = texture;
             if (m_texture != nullptr) {
                 m_texture->incUsageCount();
-                m_textureName = m_texture->name();
+                setTextureName(m_texture->name());
             }
         }
 
@@ -190,7 +305,14 @@ namespace TrenchBroom {
                 m_texture->decUsageCount();
             }
             m_texture = nullptr;
-            m_textureName = BrushFaceAttributes::NoTextureName;
+            setTextureName(BrushFaceAttributes::NoTextureName);
+        }
+
+        void BrushFaceAttributes::setTextureName(const std::string& textureName) {
+            auto& names = textureNames();
+            const auto* newName = names.acquire(textureName);
+            names.release(m_textureName);
+            m_textureName = newName;
         }
 
         bool BrushFaceAttributes::valid() const {
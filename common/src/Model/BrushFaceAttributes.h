@@ -24,6 +24,7 @@
 
 #include <vecmath/forward.h>
 
+#include <cstddef>
 #include <string>
 
 namespace TrenchBroom {
@@ -32,11 +33,13 @@ namespace TrenchBroom {
     }
 
     namespace Model {
+        class InternedTextureName;
+
         class BrushFaceAttributes {
         public:
             static const std::string NoTextureName;
         private:
-            std::string m_textureName;
+            const InternedTextureName* m_textureName; // interned, compared by address
             Assets::Texture* m_texture;
 
             vm::vec2f m_offset;
@@ -59,6 +62,14 @@ namespace TrenchBroom {
 
             BrushFaceAttributes takeSnapshot() const;
 
+            /**
+             * Releases the interned texture names that are no longer used by any attributes. Must not be called while
+             * attributes are created or destroyed on other threads.
+             *
+             * @return the number of released names
+             */
+            static size_t releaseUnusedTextureNames();
+
             const std::string& textureName() const;
             Assets::Texture* texture() const;
             vm::vec2f textureSize() const;
@@ -96,6 +107,8 @@ namespace TrenchBroom {
 
             const Color& color() const;
             void setColor(const Color& color);
+        private:
+            void setTextureName(const std::string& textureName);
         };
     }
 }
@@ -38,5 +38,10 @@ namespace TrenchBroom {
                 face->restoreTexCoordSystemSnapshot(*m_coordSystemSnapshot);
             }
         }
+
+        size_t BrushFaceSnapshot::memoryUsage() const {
+            // the texture name is interned, and the coordinate system snapshot is a handful of vectors
+            return sizeof(BrushFaceSnapshot) + (m_coordSystemSnapshot != nullptr ? 2u * sizeof(vm::vec3) : 0u);
+        }
     }
 }
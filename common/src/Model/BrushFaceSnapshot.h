@@ -41,6 +41,11 @@ namespace TrenchBroom {
             ~BrushFaceSnapshot();
 
             void restore();
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memoryUsage() const;
         };
     }
 }
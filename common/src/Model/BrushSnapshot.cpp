@@ -19,33 +19,117 @@
 
 #include "BrushSnapshot.h"
 
+#include "Polyhedron.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <string>
+
 namespace TrenchBroom {
     namespace Model {
         BrushSnapshot::BrushSnapshot(Brush* brush) :
-        m_brush(brush) {
+        m_brush(brush),
+        m_sharesGeometry(false) {
             takeSnapshot(brush);
         }
 
         BrushSnapshot::~BrushSnapshot() {
+            if (m_sharesGeometry && m_brush->m_snapshot == this) {
+                m_brush->m_snapshot = nullptr;
+            }
+
+            // the geometry does not own its payloads
+            m_geometry.reset();
             kdl::vec_clear_and_delete(m_faces);
         }
 
+        bool BrushSnapshot::hasGeometry() const {
+            return m_geometry != nullptr;
+        }
+
         void BrushSnapshot::takeSnapshot(Brush* brush) {
-            for (BrushFace* face : brush->faces()) {
+            const auto& faces = brush->faces();
+            for (BrushFace* face : faces) {
                 BrushFace *faceClone = face->clone();
                 faceClone->setTexture(nullptr);
                 m_faces.push_back(faceClone);
             }
+
+            if (brush->m_geometry != nullptr) {
+                m_geometryFaces.reserve(faces.size());
+                for (const auto* faceGeometry : brush->m_geometry->faces()) {
+                    const auto it = std::find(std::begin(faces), std::end(faces), faceGeometry->payload());
+                    assert(it != std::end(faces));
+                    m_geometryFaces.push_back(static_cast<size_t>(std::distance(std::begin(faces), it)));
+                }
+
+                brush->setSnapshot(this);
+                m_sharesGeometry = true;
+            }
         }
 
         void BrushSnapshot::doRestore(const vm::bbox3& worldBounds) {
-            m_brush->setFaces(worldBounds, m_faces);
+            m_brush->restoreSnapshot(worldBounds, *this);
+        }
+
+        size_t BrushSnapshot::doGetMemoryUsage() const {
+            // texture names are interned and shared with the live faces
+            auto result = sizeof(BrushSnapshot)
+                + m_faces.capacity() * sizeof(BrushFace*)
+                + m_faces.size() * sizeof(BrushFace)
+                + m_geometryFaces.capacity() * sizeof(size_t);
+            if (m_geometry != nullptr) {
+                result += m_geometry->memoryUsage();
+            }
+            return result;
+        }
+
+        void BrushSnapshot::doCompact() {
+            if (m_sharesGeometry && m_brush->m_snapshot == this) {
+                m_brush->m_snapshot = nullptr;
+            }
+            m_sharesGeometry = false;
+
+            for (auto* face : m_faces) {
+                face->setGeometry(nullptr);
+            }
+            m_geometry.reset();
+
+            m_geometryFaces.clear();
+            m_geometryFaces.shrink_to_fit();
+        }
+
+        void BrushSnapshot::takeGeometry(std::unique_ptr<BrushGeometry> geometry) {
+            assert(m_sharesGeometry);
+            assert(geometry->faceCount() == m_geometryFaces.size());
+
+            // link the geometry with the copies of the faces
+            size_t i = 0u;
+            for (auto* faceGeometry : geometry->faces()) {
+                m_faces[m_geometryFaces[i++]]->setGeometry(faceGeometry);
+            }
+
+            m_geometry = std::move(geometry);
+            m_sharesGeometry = false;
+        }
+
+        void BrushSnapshot::stopSharingGeometry() {
+            m_sharesGeometry = false;
+        }
+
+        std::vector<BrushFace*> BrushSnapshot::releaseFaces() {
+            auto result = std::move(m_faces);
             m_faces.clear();
+            return result;
+        }
+
+        std::unique_ptr<BrushGeometry> BrushSnapshot::releaseGeometry() {
+            return std::move(m_geometry);
         }
     }
 }
@@ -20,8 +20,10 @@
 #ifndef TrenchBroom_BrushSnapshot
 #define TrenchBroom_BrushSnapshot
 
+#include "Model/BrushGeometry.h"
 #include "Model/NodeSnapshot.h"
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -29,16 +31,51 @@ namespace TrenchBroom {
         class Brush;
         class BrushFace;
 
+        /**
+         * Stores copies of a brush's faces so that they can be restored later.
+         *
+         * The snapshot shares the brush's geometry until the brush changes or deletes it for the first time, and
+         * only then receives the geometry (or a copy if it is changed in place). Restoring the snapshot reattaches
+         * that geometry to the brush instead of building it from the faces again. Only the most recent snapshot of
+         * a brush shares its geometry, older snapshots fall back to rebuilding it.
+         */
         class BrushSnapshot : public NodeSnapshot {
         private:
+            friend class Brush;
+
             Brush* m_brush;
             std::vector<BrushFace*> m_faces;
+
+            /**
+             * For every face of the brush's geometry in the order of the geometry's face list, the index of the copy
+             * of the face's payload in m_faces.
+             */
+            std::vector<size_t> m_geometryFaces;
+            std::unique_ptr<BrushGeometry> m_geometry;
+            bool m_sharesGeometry;
         public:
-            BrushSnapshot(Brush* brush);
+            explicit BrushSnapshot(Brush* brush);
             ~BrushSnapshot() override;
+
+            /**
+             * Indicates whether this snapshot has received a geometry that is reattached when it is restored.
+             */
+            bool hasGeometry() const;
         private:
             void takeSnapshot(Brush* brush);
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemoryUsage() const override;
+
+            /**
+             * Stops sharing the brush's geometry and discards any geometry received so far. The geometry is rebuilt
+             * from the faces when this snapshot is restored.
+             */
+            void doCompact() override;
+        private: // called by the brush
+            void takeGeometry(std::unique_ptr<BrushGeometry> geometry);
+            void stopSharingGeometry();
+            std::vector<BrushFace*> releaseFaces();
+            std::unique_ptr<BrushGeometry> releaseGeometry();
         };
     }
 }
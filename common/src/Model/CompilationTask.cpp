@@ -27,8 +27,10 @@ namespace TrenchBroom {
 
         CompilationTask::~CompilationTask() = default;
 
-        CompilationExportMap::CompilationExportMap(const std::string& targetSpec) :
-        m_targetSpec(targetSpec) {}
+        CompilationExportMap::CompilationExportMap(const std::string& targetSpec, const Scope scope, const std::string& sealTexture) :
+        m_targetSpec(targetSpec),
+        m_scope(scope),
+        m_sealTexture(sealTexture) {}
 
         void CompilationExportMap::accept(CompilationTaskVisitor& visitor) {
             visitor.visit(*this);
@@ -50,13 +52,31 @@ namespace TrenchBroom {
             return m_targetSpec;
         }
 
+        CompilationExportMap::Scope CompilationExportMap::scope() const {
+            return m_scope;
+        }
+
+        const std::string& CompilationExportMap::sealTexture() const {
+            return m_sealTexture;
+        }
+
         void CompilationExportMap::setTargetSpec(const std::string& targetSpec) {
             m_targetSpec = targetSpec;
             taskDidChange();
         }
 
+        void CompilationExportMap::setScope(const Scope scope) {
+            m_scope = scope;
+            taskDidChange();
+        }
+
+        void CompilationExportMap::setSealTexture(const std::string& sealTexture) {
+            m_sealTexture = sealTexture;
+            taskDidChange();
+        }
+
         CompilationExportMap* CompilationExportMap::clone() const {
-            return new CompilationExportMap(m_targetSpec);
+            return new CompilationExportMap(m_targetSpec, m_scope, m_sealTexture);
         }
 
         CompilationCopyFiles::CompilationCopyFiles(const std::string& sourceSpec, const std::string& targetSpec) :
@@ -102,10 +122,12 @@ namespace TrenchBroom {
             return new CompilationCopyFiles(m_sourceSpec, m_targetSpec);
         }
 
-        CompilationRunTool::CompilationRunTool(const std::string& toolSpec, const std::string& parameterSpec) :
+        CompilationRunTool::CompilationRunTool(const std::string& toolSpec, const std::string& parameterSpec, const std::string& inputSpec, const std::string& outputSpec) :
         CompilationTask(),
         m_toolSpec(toolSpec),
-        m_parameterSpec(parameterSpec) {}
+        m_parameterSpec(parameterSpec),
+        m_inputSpec(inputSpec),
+        m_outputSpec(outputSpec) {}
 
         void CompilationRunTool::accept(CompilationTaskVisitor& visitor) {
             visitor.visit(*this);
@@ -131,6 +153,14 @@ namespace TrenchBroom {
             return m_parameterSpec;
         }
 
+        const std::string& CompilationRunTool::inputSpec() const {
+            return m_inputSpec;
+        }
+
+        const std::string& CompilationRunTool::outputSpec() const {
+            return m_outputSpec;
+        }
+
         void CompilationRunTool::setToolSpec(const std::string& toolSpec) {
             m_toolSpec = toolSpec;
             taskDidChange();
@@ -141,8 +171,18 @@ namespace TrenchBroom {
             taskDidChange();
         }
 
+        void CompilationRunTool::setInputSpec(const std::string& inputSpec) {
+            m_inputSpec = inputSpec;
+            taskDidChange();
+        }
+
+        void CompilationRunTool::setOutputSpec(const std::string& outputSpec) {
+            m_outputSpec = outputSpec;
+            taskDidChange();
+        }
+
         CompilationRunTool* CompilationRunTool::clone() const {
-            return new CompilationRunTool(m_toolSpec, m_parameterSpec);
+            return new CompilationRunTool(m_toolSpec, m_parameterSpec, m_inputSpec, m_outputSpec);
         }
 
         CompilationTaskVisitor::~CompilationTaskVisitor() = default;
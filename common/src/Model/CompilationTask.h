@@ -52,10 +52,31 @@ namespace TrenchBroom {
         };
 
         class CompilationExportMap : public CompilationTask {
+        public:
+            /**
+             * Determines which part of the map is exported.
+             */
+            enum class Scope {
+                /**
+                 * The entire map.
+                 */
+                Map,
+                /**
+                 * The nodes of the layers that are currently visible.
+                 */
+                VisibleLayers,
+                /**
+                 * The brushes and point entities inside the bounds of the current selection. The region is sealed
+                 * with brushes so that the excluded parts of the map do not cause leaks.
+                 */
+                Selection
+            };
         private:
             std::string m_targetSpec;
+            Scope m_scope;
+            std::string m_sealTexture;
         public:
-            explicit CompilationExportMap(const std::string& targetSpec);
+            explicit CompilationExportMap(const std::string& targetSpec, Scope scope = Scope::Map, const std::string& sealTexture = "skip");
 
             void accept(CompilationTaskVisitor& visitor) override;
             void accept(ConstCompilationTaskVisitor& visitor) const override;
@@ -63,8 +84,16 @@ namespace TrenchBroom {
             void accept(const ConstCompilationTaskConstVisitor& visitor) const override;
 
             const std::string& targetSpec() const;
+            Scope scope() const;
+
+            /**
+             * The texture of the brushes that seal the exported region.
+             */
+            const std::string& sealTexture() const;
 
             void setTargetSpec(const std::string& targetSpec);
+            void setScope(Scope scope);
+            void setSealTexture(const std::string& sealTexture);
 
             CompilationExportMap* clone() const override;
 
@@ -98,8 +127,18 @@ namespace TrenchBroom {
         private:
             std::string m_toolSpec;
             std::string m_parameterSpec;
+            std::string m_inputSpec;
+            std::string m_outputSpec;
         public:
-            CompilationRunTool(const std::string& toolSpec, const std::string& parameterSpec);
+            /**
+             * Creates a task that runs the given tool.
+             *
+             * The input and output specs are semicolon separated lists of the files that the tool reads and writes. The
+             * last component of an input may be a glob pattern. Tools that declare their files can run concurrently with
+             * other tasks and are skipped if their inputs have not changed since they last succeeded. Tools that declare
+             * neither are run after all previous tasks have ended and before any following task starts.
+             */
+            CompilationRunTool(const std::string& toolSpec, const std::string& parameterSpec, const std::string& inputSpec = "", const std::string& outputSpec = "");
 
             void accept(CompilationTaskVisitor& visitor) override;
             void accept(ConstCompilationTaskVisitor& visitor) const override;
@@ -108,9 +147,13 @@ namespace TrenchBroom {
 
             const std::string& toolSpec() const;
             const std::string& parameterSpec() const;
+            const std::string& inputSpec() const;
+            const std::string& outputSpec() const;
 
             void setToolSpec(const std::string& toolSpec);
             void setParameterSpec(const std::string& parameterSpec);
+            void setInputSpec(const std::string& inputSpec);
+            void setOutputSpec(const std::string& outputSpec);
 
             CompilationRunTool* clone() const override;
 
@@ -30,6 +30,7 @@
 #include "Model/FindGroupVisitor.h"
 #include "Model/FindLayerVisitor.h"
 #include "Model/IssueGenerator.h"
+#include "Model/ModelUtils.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
@@ -351,29 +352,10 @@ namespace TrenchBroom {
             return visitor.hasResult() ? visitor.result() : nullptr;
         }
 
-        class TransformEntity : public NodeVisitor {
-        private:
-            const vm::mat4x4& m_transformation;
-            bool m_lockTextures;
-            const vm::bbox3& m_worldBounds;
-        public:
-            TransformEntity(const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) :
-            m_transformation(transformation),
-            m_lockTextures(lockTextures),
-            m_worldBounds(worldBounds) {}
-        private:
-            void doVisit(World*) override  {}
-            void doVisit(Layer*) override  {}
-            void doVisit(Group*) override  {}
-            void doVisit(Entity*) override {}
-            void doVisit(Brush* brush) override { brush->transform(m_transformation, m_lockTextures, m_worldBounds); }
-        };
-
         void Entity::doTransform(const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) {
             if (hasChildren()) {
                 const NotifyNodeChange nodeChange(this);
-                TransformEntity visitor(transformation, lockTextures, worldBounds);
-                iterate(visitor);
+                transformNodes(children(), transformation, lockTextures, worldBounds);
             } else {
                 // node change is called by setOrigin already
                 const auto center = logicalBounds().center();
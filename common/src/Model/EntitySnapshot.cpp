@@ -48,5 +48,13 @@ namespace TrenchBroom {
             restoreAttribute(m_entity, m_origin);
             restoreAttribute(m_entity, m_rotation);
         }
+
+        static size_t attributeMemoryUsage(const EntityAttribute& attribute) {
+            return attribute.name().capacity() + attribute.value().capacity();
+        }
+
+        size_t EntitySnapshot::doGetMemoryUsage() const {
+            return sizeof(EntitySnapshot) + attributeMemoryUsage(m_origin) + attributeMemoryUsage(m_rotation);
+        }
     }
 }
@@ -37,6 +37,7 @@ namespace TrenchBroom {
             EntitySnapshot(Entity* entity, const EntityAttribute& origin, const EntityAttribute& rotation);
         private:
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemoryUsage() const override;
         };
     }
 }
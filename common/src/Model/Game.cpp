@@ -69,14 +69,18 @@ namespace TrenchBroom {
             return doNewMap(format, worldBounds, logger);
         }
 
-        std::unique_ptr<World> Game::loadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const {
-            return doLoadMap(format, worldBounds, path, logger);
+        std::unique_ptr<World> Game::loadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, const bool useMapCache, Logger& logger) const {
+            return doLoadMap(format, worldBounds, path, useMapCache, logger);
         }
 
         void Game::writeMap(World& world, const IO::Path& path) const {
             doWriteMap(world, path);
         }
 
+        void Game::writePartialMap(World& world, const std::vector<Node*>& nodes, const std::vector<Brush*>& additionalWorldBrushes, const IO::Path& path) const {
+            doWritePartialMap(world, nodes, additionalWorldBrushes, path);
+        }
+
         void Game::exportMap(World& world, const Model::ExportFormat format, const IO::Path& path) const {
             doExportMap(world, format, path);
         }
@@ -40,6 +40,7 @@ namespace TrenchBroom {
 
     namespace Model {
         class AttributableNode;
+        class Brush;
         class BrushFace;
         class BrushFaceAttributes;
         class CompilationConfig;
@@ -73,8 +74,20 @@ namespace TrenchBroom {
             const std::vector<SmartTag>& smartTags() const;
         public: // loading and writing map files
             std::unique_ptr<World> newMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const;
-            std::unique_ptr<World> loadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const;
+
+            /**
+             * Loads the map file at the given path. If useMapCache is true, the map is read from its cache file if that
+             * is up to date, and the cache file is written after the map file was parsed otherwise.
+             */
+            std::unique_ptr<World> loadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const;
+
             void writeMap(World& world, const IO::Path& path) const;
+
+            /**
+             * Writes the given nodes of the given world to a map file for compiling a part of the map. The given
+             * additional brushes are added to the worldspawn entity. The file positions of the nodes are not changed.
+             */
+            void writePartialMap(World& world, const std::vector<Node*>& nodes, const std::vector<Brush*>& additionalWorldBrushes, const IO::Path& path) const;
             void exportMap(World& world, Model::ExportFormat format, const IO::Path& path) const;
         public: // parsing and serializing objects
             std::vector<Node*> parseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const;
@@ -116,8 +129,9 @@ namespace TrenchBroom {
             virtual const std::vector<SmartTag>& doSmartTags() const = 0;
 
             virtual std::unique_ptr<World> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const = 0;
-            virtual std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const = 0;
+            virtual std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const = 0;
             virtual void doWriteMap(World& world, const IO::Path& path) const = 0;
+            virtual void doWritePartialMap(World& world, const std::vector<Node*>& nodes, const std::vector<Brush*>& additionalWorldBrushes, const IO::Path& path) const = 0;
             virtual void doExportMap(World& world, Model::ExportFormat format, const IO::Path& path) const = 0;
 
             virtual std::vector<Node*> doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const = 0;
@@ -37,6 +37,7 @@
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/IOUtils.h"
+#include "IO/MapCache.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
@@ -62,6 +63,8 @@
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <cstdio>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -125,7 +128,7 @@ namespace TrenchBroom {
         std::unique_ptr<World> GameImpl::doNewMap(const MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const {
             const auto initialMapFilePath = m_config.findInitialMap(formatName(format));
             if (!initialMapFilePath.isEmpty() && IO::Disk::fileExists(initialMapFilePath)) {
-                return doLoadMap(format, worldBounds, initialMapFilePath, logger);
+                return doLoadMap(format, worldBounds, initialMapFilePath, false, logger);
             } else {
                 auto world = std::make_unique<World>(format);
 
@@ -141,12 +144,42 @@ namespace TrenchBroom {
             }
         }
 
-        std::unique_ptr<World> GameImpl::doLoadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const {
+        std::unique_ptr<World> GameImpl::doLoadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, const bool useMapCache, Logger& logger) const {
             IO::SimpleParserStatus parserStatus(logger);
             auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
             auto fileReader = file->reader().buffer();
+
+            if (!useMapCache) {
+                IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+                return worldReader.read(format, worldBounds, parserStatus);
+            }
+
+            const auto cachePath = IO::MapCache::cachePath(IO::Disk::fixPath(path));
+            if (IO::Disk::fileExists(cachePath)) {
+                try {
+                    auto cacheFile = IO::Disk::openFile(cachePath);
+                    auto cacheReader = cacheFile->reader().buffer();
+                    IO::MapCacheReader cache(std::begin(cacheReader), std::end(cacheReader), format, std::begin(fileReader), std::end(fileReader));
+
+                    IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+                    return worldReader.read(cache, worldBounds, parserStatus);
+                } catch (const Exception& e) {
+                    logger.info() << "Ignoring map cache '" << cachePath.asString() << "': " << e.what();
+                }
+            }
+
+            IO::MapCacheWriter cacheWriter;
             IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
-            return worldReader.read(format, worldBounds, parserStatus);
+            worldReader.setCacheWriter(&cacheWriter);
+            auto world = worldReader.read(format, worldBounds, parserStatus);
+
+            try {
+                cacheWriter.write(cachePath, format, std::begin(fileReader), std::end(fileReader));
+            } catch (const Exception& e) {
+                logger.warn() << "Could not write map cache '" << cachePath.asString() << "': " << e.what();
+            }
+
+            return world;
         }
 
         void GameImpl::doWriteMap(World& world, const IO::Path& path) const {
@@ -159,6 +192,21 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        void GameImpl::doWritePartialMap(World& world, const std::vector<Node*>& nodes, const std::vector<Brush*>& additionalWorldBrushes, const IO::Path& path) const {
+            const auto mapFormatName = formatName(world.format());
+
+            // the stream serializer leaves the file positions of the nodes alone, they must keep referring to the map file
+            std::stringstream stream;
+            IO::NodeWriter writer(world, stream);
+            writer.writePartialMap(nodes, additionalWorldBrushes);
+
+            IO::OpenFile open(path, true);
+            IO::writeGameComment(open.file, gameName(), mapFormatName);
+
+            const auto str = stream.str();
+            std::fwrite(str.data(), 1, str.size(), open.file);
+        }
+
         void GameImpl::doExportMap(World& world, const Model::ExportFormat format, const IO::Path& path) const {
             switch (format) {
                 case Model::ExportFormat::WavefrontObj:
@@ -478,6 +526,39 @@ namespace TrenchBroom {
             }
         }
 
+        void GameImpl::doLoadSkins(const IO::Path& path, Assets::EntityModel& model, Logger& logger) const {
+            try {
+                const auto file = m_fs.openFile(path);
+                ensure(file != nullptr, "file is null");
+
+                const auto modelName = path.lastComponent().asString();
+                const auto extension = kdl::str_to_lower(path.extension());
+                const auto supported = m_config.entityConfig().modelFormats;
+
+                if (extension == "mdl" && kdl::vec_contains(supported, "mdl")) {
+                    const auto palette = loadTexturePalette();
+                    auto reader = file->reader().buffer();
+                    IO::MdlParser parser(modelName, std::begin(reader), std::end(reader), palette);
+                    parser.loadSkins(model, logger);
+                } else if (extension == "md2" && kdl::vec_contains(supported, "md2")) {
+                    const auto palette = loadTexturePalette();
+                    auto reader = file->reader().buffer();
+                    IO::Md2Parser parser(modelName, std::begin(reader), std::end(reader), palette, m_fs);
+                    parser.loadSkins(model, logger);
+                } else if (extension == "md3" && kdl::vec_contains(supported, "md3")) {
+                    auto reader = file->reader().buffer();
+                    IO::Md3Parser parser(modelName, std::begin(reader), std::end(reader), m_fs);
+                    parser.loadSkins(model, logger);
+                } else {
+                    throw GameException("Unsupported model format '" + path.asString() + "'");
+                }
+            } catch (FileSystemException& e) {
+                throw GameException("Could not load model skins " + path.asString() + ": " + std::string(e.what()));
+            } catch (AssetException& e) {
+                throw GameException("Could not load model skins " + path.asString() + ": " + std::string(e.what()));
+            }
+        }
+
         Assets::Palette GameImpl::loadTexturePalette() const {
             const auto& path = m_config.textureConfig().palette;
             return Assets::Palette::loadFile(m_fs, path);
@@ -61,8 +61,9 @@ namespace TrenchBroom {
             const std::vector<SmartTag>& doSmartTags() const override;
 
             std::unique_ptr<World> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const override;
-            std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const override;
+            std::unique_ptr<World> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, bool useMapCache, Logger& logger) const override;
             void doWriteMap(World& world, const IO::Path& path) const override;
+            void doWritePartialMap(World& world, const std::vector<Node*>& nodes, const std::vector<Brush*>& additionalWorldBrushes, const IO::Path& path) const override;
             void doExportMap(World& world, Model::ExportFormat format, const IO::Path& path) const override;
 
             std::vector<Node*> doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& logger) const override;
@@ -90,6 +91,7 @@ namespace TrenchBroom {
 
             std::unique_ptr<Assets::EntityModel> doInitializeModel(const IO::Path& path, Logger& logger) const override;
             void doLoadFrame(const IO::Path& path, size_t frameIndex, Assets::EntityModel& model, Logger& logger) const override;
+            void doLoadSkins(const IO::Path& path, Assets::EntityModel& model, Logger& logger) const override;
 
             Assets::Palette loadTexturePalette() const;
 
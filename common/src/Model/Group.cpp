@@ -30,9 +30,9 @@
 #include "Model/FindLayerVisitor.h"
 #include "Model/GroupSnapshot.h"
 #include "Model/IssueGenerator.h"
+#include "Model/ModelUtils.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PickResult.h"
-#include "Model/TransformObjectVisitor.h"
 #include "Model/TagVisitor.h"
 
 #include <vecmath/ray.h>
@@ -227,8 +227,7 @@ namespace TrenchBroom {
         }
 
         void Group::doTransform(const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) {
-            TransformObjectVisitor visitor(transformation, lockTextures, worldBounds);
-            iterate(visitor);
+            transformNodes(children(), transformation, lockTextures, worldBounds);
         }
 
         bool Group::doContains(const Node* node) const {
@@ -47,5 +47,19 @@ namespace TrenchBroom {
             for (NodeSnapshot* snapshot : m_snapshots)
                 snapshot->restore(worldBounds);
         }
+
+        size_t GroupSnapshot::doGetMemoryUsage() const {
+            auto result = sizeof(GroupSnapshot) + m_snapshots.capacity() * sizeof(NodeSnapshot*);
+            for (const NodeSnapshot* snapshot : m_snapshots) {
+                result += snapshot->memoryUsage();
+            }
+            return result;
+        }
+
+        void GroupSnapshot::doCompact() {
+            for (NodeSnapshot* snapshot : m_snapshots) {
+                snapshot->compact();
+            }
+        }
     }
 }
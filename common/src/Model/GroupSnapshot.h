@@ -38,6 +38,8 @@ namespace TrenchBroom {
         private:
             void takeSnapshot(Group* group);
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemoryUsage() const override;
+            void doCompact() override;
         };
     }
 }
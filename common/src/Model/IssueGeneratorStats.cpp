@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueGeneratorStats.h"
+
+#include "Model/IssueGenerator.h"
+
+#include <kdl/vector_utils.h>
+
+#include <cassert>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace Model {
+        IssueGeneratorStats::IssueGeneratorStats(const std::vector<IssueGenerator*>& generators) :
+        m_generators(std::begin(generators), std::end(generators)),
+        m_counters(std::make_unique<Counters[]>(generators.size())) {
+            reset();
+        }
+
+        void IssueGeneratorStats::record(const size_t generatorIndex, const size_t issueCount, const std::chrono::nanoseconds time) {
+            assert(generatorIndex < m_generators.size());
+            auto& counters = m_counters[generatorIndex];
+            counters.nodeCount.fetch_add(1u, std::memory_order_relaxed);
+            counters.issueCount.fetch_add(issueCount, std::memory_order_relaxed);
+            counters.time.fetch_add(static_cast<int64_t>(time.count()), std::memory_order_relaxed);
+        }
+
+        std::vector<IssueGeneratorStats::Entry> IssueGeneratorStats::entries() const {
+            std::vector<Entry> result;
+            result.reserve(m_generators.size());
+            for (size_t i = 0; i < m_generators.size(); ++i) {
+                const auto& counters = m_counters[i];
+                result.push_back(Entry{
+                    m_generators[i],
+                    counters.nodeCount.load(std::memory_order_relaxed),
+                    counters.issueCount.load(std::memory_order_relaxed),
+                    std::chrono::nanoseconds(counters.time.load(std::memory_order_relaxed))
+                });
+            }
+            return result;
+        }
+
+        std::chrono::nanoseconds IssueGeneratorStats::totalTime() const {
+            auto result = std::chrono::nanoseconds(0);
+            for (size_t i = 0; i < m_generators.size(); ++i) {
+                result += std::chrono::nanoseconds(m_counters[i].time.load(std::memory_order_relaxed));
+            }
+            return result;
+        }
+
+        void IssueGeneratorStats::reset() {
+            for (size_t i = 0; i < m_generators.size(); ++i) {
+                m_counters[i].nodeCount = 0u;
+                m_counters[i].issueCount = 0u;
+                m_counters[i].time = 0;
+            }
+        }
+
+        std::string IssueGeneratorStats::summary() const {
+            auto sortedEntries = entries();
+            kdl::vec_sort(sortedEntries, [](const Entry& lhs, const Entry& rhs) { return lhs.time > rhs.time; });
+
+            std::stringstream str;
+            for (const auto& entry : sortedEntries) {
+                const auto ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(entry.time);
+                str << entry.generator->description() << ": " << ms.count() << " ms, "
+                    << entry.nodeCount << " nodes, " << entry.issueCount << " issues\n";
+            }
+            return str.str();
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_IssueGeneratorStats
+#define TrenchBroom_IssueGeneratorStats
+
+#include "Macros.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class IssueGenerator;
+
+        /**
+         * Accumulates how much time each issue generator spends generating issues, how many nodes it checked and how
+         * many issues it found. Recording is thread safe, so a single instance can be shared by the threads that
+         * validate nodes concurrently.
+         */
+        class IssueGeneratorStats {
+        public:
+            struct Entry {
+                const IssueGenerator* generator;
+                size_t nodeCount;
+                size_t issueCount;
+                std::chrono::nanoseconds time;
+            };
+        private:
+            struct Counters {
+                std::atomic<size_t> nodeCount;
+                std::atomic<size_t> issueCount;
+                std::atomic<int64_t> time;
+            };
+
+            std::vector<const IssueGenerator*> m_generators;
+            std::unique_ptr<Counters[]> m_counters;
+        public:
+            explicit IssueGeneratorStats(const std::vector<IssueGenerator*>& generators);
+
+            /**
+             * Adds a call of the generator at the given index of the generators passed to the constructor.
+             */
+            void record(size_t generatorIndex, size_t issueCount, std::chrono::nanoseconds time);
+
+            std::vector<Entry> entries() const;
+            std::chrono::nanoseconds totalTime() const;
+            void reset();
+
+            /**
+             * Returns a short summary listing the generators in order of decreasing time.
+             */
+            std::string summary() const;
+
+            deleteCopyAndMove(IssueGeneratorStats)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_IssueGeneratorStats) */
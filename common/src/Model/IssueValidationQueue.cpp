@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueValidationQueue.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        void IssueValidationQueue::nodeIssuesWereInvalidated(Node* node) {
+            if (m_invalidatedNodeSet.insert(node).second) {
+                m_invalidatedNodes.push_back(node);
+                m_removedNodes.erase(node);
+            }
+        }
+
+        void IssueValidationQueue::nodeWasRemoved(Node* node) {
+            // the node stays in m_invalidatedNodes until the list is taken, which skips nodes missing from the set
+            m_invalidatedNodeSet.erase(node);
+            m_removedNodes.insert(node);
+        }
+
+        bool IssueValidationQueue::empty() const {
+            return m_invalidatedNodeSet.empty() && m_removedNodes.empty();
+        }
+
+        size_t IssueValidationQueue::invalidatedNodeCount() const {
+            return m_invalidatedNodeSet.size();
+        }
+
+        std::vector<Node*> IssueValidationQueue::takeInvalidatedNodes() {
+            std::vector<Node*> result;
+            result.reserve(m_invalidatedNodeSet.size());
+            for (auto* node : m_invalidatedNodes) {
+                if (m_invalidatedNodeSet.erase(node) > 0u) {
+                    result.push_back(node);
+                }
+            }
+            m_invalidatedNodes.clear();
+            return result;
+        }
+
+        std::vector<Node*> IssueValidationQueue::takeRemovedNodes() {
+            auto result = std::vector<Node*>(std::begin(m_removedNodes), std::end(m_removedNodes));
+            m_removedNodes.clear();
+            return result;
+        }
+
+        void IssueValidationQueue::clear() {
+            m_invalidatedNodes.clear();
+            m_invalidatedNodeSet.clear();
+            m_removedNodes.clear();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_IssueValidationQueue
+#define TrenchBroom_IssueValidationQueue
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class Node;
+
+        /**
+         * Records which nodes of a world had their issues invalidated and which nodes were removed from the world since
+         * the queue was last drained. The world feeds the queue, and a consumer such as the issue browser takes the
+         * recorded nodes to revalidate only those nodes instead of walking the entire node tree.
+         *
+         * A node that is removed is dropped from the invalidated nodes, and a node that is added again is dropped from
+         * the removed nodes, so the consumer never sees a node in both lists.
+         */
+        class IssueValidationQueue {
+        private:
+            std::vector<Node*> m_invalidatedNodes;
+            std::unordered_set<Node*> m_invalidatedNodeSet;
+            std::unordered_set<Node*> m_removedNodes;
+        public:
+            void nodeIssuesWereInvalidated(Node* node);
+            void nodeWasRemoved(Node* node);
+
+            bool empty() const;
+            size_t invalidatedNodeCount() const;
+
+            /**
+             * Returns the invalidated nodes in the order in which they were first invalidated and empties the list.
+             */
+            std::vector<Node*> takeInvalidatedNodes();
+
+            /**
+             * Returns the removed nodes and empties the list. The nodes are no longer part of the world, but they have
+             * not been deleted yet.
+             */
+            std::vector<Node*> takeRemovedNodes();
+
+            void clear();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_IssueValidationQueue) */
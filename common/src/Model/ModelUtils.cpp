@@ -20,10 +20,17 @@
 #include "ModelUtils.h"
 
 #include "Ensure.h"
+#include "Model/AssortNodesVisitor.h"
+#include "Model/Brush.h"
 #include "Model/CollectNodesVisitor.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
 
 #include <kdl/vector_utils.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+
 #include <vector>
 
 namespace TrenchBroom {
@@ -69,5 +76,24 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        bool canTransformNodes(const std::vector<Node*>& nodes, const vm::mat4x4& transformation, const vm::bbox3& worldBounds) {
+            CollectBrushesVisitor visitor;
+            Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            return Brush::canTransformBrushes(visitor.brushes(), transformation, worldBounds);
+        }
+
+        void transformNodes(const std::vector<Node*>& nodes, const vm::mat4x4& transformation, const bool lockTextures, const vm::bbox3& worldBounds) {
+            CollectObjectsVisitor visitor;
+            Node::accept(std::begin(nodes), std::end(nodes), visitor);
+
+            Brush::transformBrushes(visitor.brushes(), transformation, lockTextures, worldBounds);
+            for (auto* group : visitor.groups()) {
+                group->transform(transformation, lockTextures, worldBounds);
+            }
+            for (auto* entity : visitor.entities()) {
+                entity->transform(transformation, lockTextures, worldBounds);
+            }
+        }
     }
 }
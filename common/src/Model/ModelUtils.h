@@ -23,6 +23,8 @@
 #include "Model/CollectUniqueNodesVisitor.h"
 #include "Model/Node.h"
 
+#include <vecmath/forward.h>
+
 #include <map>
 #include <vector>
 
@@ -43,6 +45,19 @@ namespace TrenchBroom {
         std::vector<Node*> collectChildren(const std::map<Node*, std::vector<Node*>>& nodes);
         std::vector<Node*> collectDescendants(const std::vector<Node*>& nodes);
         std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>& nodes);
+
+        /**
+         * Checks whether all brushes among the given nodes and their descendants can be transformed with the given
+         * transformation. The brushes are checked concurrently.
+         */
+        bool canTransformNodes(const std::vector<Node*>& nodes, const vm::mat4x4& transformation, const vm::bbox3& worldBounds);
+
+        /**
+         * Transforms the given nodes. The brushes among the given nodes are transformed concurrently, see
+         * Brush::transformBrushes. Afterwards, the given groups and entities are transformed in the order in which
+         * they appear.
+         */
+        void transformNodes(const std::vector<Node*>& nodes, const vm::mat4x4& transformation, bool lockTextures, const vm::bbox3& worldBounds);
     }
 }
 
@@ -23,14 +23,17 @@
 #include "Macros.h"
 #include "Model/Issue.h"
 #include "Model/IssueGenerator.h"
+#include "Model/IssueGeneratorStats.h"
 #include "Model/LockState.h"
 #include "Model/VisibilityState.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox.h>
 
 #include <cassert>
+#include <chrono>
 #include <iterator>
 #include <string>
 #include <vector>
@@ -592,7 +595,7 @@ namespace TrenchBroom {
         }
 
         const std::vector<Issue*>& Node::issues(const std::vector<IssueGenerator*>& issueGenerators) {
-            validateIssues(issueGenerators);
+            validateIssues(issueGenerators, nullptr);
             return m_issues;
         }
 
@@ -608,24 +611,45 @@ namespace TrenchBroom {
             }
         }
 
-        void Node::validateIssues(const std::vector<IssueGenerator*>& issueGenerators) {
+        void Node::validateIssues(const std::vector<Node*>& nodes, const std::vector<IssueGenerator*>& issueGenerators, IssueGeneratorStats* stats) {
+            kdl::parallel_for(nodes.size(), [&](const size_t i) {
+                nodes[i]->validateIssues(issueGenerators, stats);
+            }, 64u);
+        }
+
+        void Node::validateIssues(const std::vector<IssueGenerator*>& issueGenerators, IssueGeneratorStats* stats) {
             if (!m_issuesValid) {
-                for (const auto* generator : issueGenerators) {
-                    doGenerateIssues(generator, m_issues);
+                if (stats == nullptr) {
+                    for (const auto* generator : issueGenerators) {
+                        doGenerateIssues(generator, m_issues);
+                    }
+                } else {
+                    using Clock = std::chrono::steady_clock;
+                    for (size_t i = 0; i < issueGenerators.size(); ++i) {
+                        const auto issueCount = m_issues.size();
+                        const auto start = Clock::now();
+                        doGenerateIssues(issueGenerators[i], m_issues);
+                        stats->record(i, m_issues.size() - issueCount, Clock::now() - start);
+                    }
                 }
                 m_issuesValid = true;
             }
         }
 
-        void Node::invalidateIssues() const {
+        void Node::invalidateIssues() {
             clearIssues();
             m_issuesValid = false;
+            nodeIssuesWereInvalidated(this);
         }
 
         void Node::clearIssues() const {
             kdl::vec_clear_and_delete(m_issues);
         }
 
+        void Node::nodeIssuesWereInvalidated(Node* node) {
+            doNodeIssuesWereInvalidated(node);
+        }
+
         void Node::findAttributableNodesWithAttribute(const std::string& name, const std::string& value, std::vector<AttributableNode*>& result) const {
             return doFindAttributableNodesWithAttribute(name, value, result);
         }
@@ -696,5 +720,10 @@ namespace TrenchBroom {
             if (m_parent != nullptr)
                 m_parent->removeFromIndex(attributable, name, value);
         }
+
+        void Node::doNodeIssuesWereInvalidated(Node* node) {
+            if (m_parent != nullptr)
+                m_parent->nodeIssuesWereInvalidated(node);
+        }
     }
 }
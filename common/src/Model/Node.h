@@ -35,6 +35,7 @@ namespace TrenchBroom {
         class ConstNodeVisitor;
         class Issue;
         class IssueGenerator;
+        class IssueGeneratorStats;
         enum class LockState;
         class NodeSnapshot;
         class NodeVisitor;
@@ -283,11 +284,21 @@ namespace TrenchBroom {
 
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
+
+            /**
+             * Generates the issues of all given nodes whose issues are not valid. The nodes are validated
+             * concurrently, so the issue generators must only modify the node they are generating issues for.
+             *
+             * If stats are given, the time spent in each generator is recorded. The stats must have been created for
+             * the given generators.
+             */
+            static void validateIssues(const std::vector<Node*>& nodes, const std::vector<IssueGenerator*>& issueGenerators, IssueGeneratorStats* stats = nullptr);
         public: // should only be called from this and from the world
-            void invalidateIssues() const;
+            void invalidateIssues();
         private:
-            void validateIssues(const std::vector<IssueGenerator*>& issueGenerators);
+            void validateIssues(const std::vector<IssueGenerator*>& issueGenerators, IssueGeneratorStats* stats);
             void clearIssues() const;
+            void nodeIssuesWereInvalidated(Node* node);
         public: // visitors
             template <class V>
             void acceptAndRecurse(V& visitor) {
@@ -479,6 +490,8 @@ namespace TrenchBroom {
 
             virtual void doAddToIndex(AttributableNode* attributable, const std::string& name, const std::string& value);
             virtual void doRemoveFromIndex(AttributableNode* attributable, const std::string& name, const std::string& value);
+
+            virtual void doNodeIssuesWereInvalidated(Node* node);
         };
     }
 }
@@ -26,5 +26,15 @@ namespace TrenchBroom {
         void NodeSnapshot::restore(const vm::bbox3& worldBounds) {
             doRestore(worldBounds);
         }
+
+        size_t NodeSnapshot::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
+
+        void NodeSnapshot::compact() {
+            doCompact();
+        }
+
+        void NodeSnapshot::doCompact() {}
     }
 }
@@ -22,14 +22,28 @@
 
 #include "FloatType.h"
 
+#include <cstddef>
+
 namespace TrenchBroom {
     namespace Model {
         class NodeSnapshot {
         public:
             virtual ~NodeSnapshot();
             void restore(const vm::bbox3& worldBounds);
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * Discards any data held by this snapshot that can be reconstructed when it is restored.
+             */
+            void compact();
         private:
             virtual void doRestore(const vm::bbox3& worldBounds) = 0;
+            virtual size_t doGetMemoryUsage() const = 0;
+            virtual void doCompact();
         };
     }
 }
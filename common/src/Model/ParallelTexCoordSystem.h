@@ -83,8 +83,6 @@ namespace TrenchBroom {
 
             float doMeasureAngle(float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const override;
             void computeInitialAxes(const vm::vec3& normal, vm::vec3& xAxis, vm::vec3& yAxis) const;
-
-            deleteCopyAndMove(ParallelTexCoordSystem)
         };
     }
 }
@@ -19,13 +19,18 @@
 
 #include "PointFile.h"
 
+#include "Exceptions.h"
+#include "IO/CompilerOutputTokenizer.h"
+#include "IO/File.h"
 #include "IO/Path.h"
+#include "IO/Reader.h"
 
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
 #include <cassert>
 #include <fstream>
+#include <memory>
 #include <string>
 
 namespace TrenchBroom {
@@ -83,29 +88,56 @@ namespace TrenchBroom {
             --m_current;
         }
 
+        static std::vector<vm::vec3f> readPoints(const IO::Path& path) {
+            using Tokenizer = IO::CompilerOutputTokenizer;
+            namespace TokenType = IO::CompilerOutputToken;
+
+            std::unique_ptr<IO::CFile> file;
+            try {
+                file = std::make_unique<IO::CFile>(path);
+            } catch (const FileSystemException&) {
+                throw FileFormatException("Couldn't open file");
+            }
+
+            const auto reader = file->reader().buffer();
+            Tokenizer tokenizer(std::begin(reader), std::end(reader));
+
+            std::vector<vm::vec3f> result;
+            auto token = tokenizer.nextToken(TokenType::Eol);
+            while (!token.hasType(TokenType::Eof)) {
+                vm::vec3f point;
+                for (size_t i = 0; i < 3; ++i) {
+                    if (!token.hasType(TokenType::Number)) {
+                        throw FileFormatException("Error reading point at line " + std::to_string(token.line()));
+                    }
+                    point[i] = token.toFloat<float>();
+                    token = tokenizer.nextToken();
+                }
+                if (!token.hasType(TokenType::Eol | TokenType::Eof)) {
+                    throw FileFormatException("Error reading point at line " + std::to_string(token.line()));
+                }
+
+                result.push_back(point);
+                token = tokenizer.nextToken(TokenType::Eol);
+            }
+            return result;
+        }
+
         void PointFile::load(const IO::Path& path) {
             static const float Threshold = vm::to_radians(15.0f);
 
-            std::fstream stream(path.asString().c_str(), std::ios::in);
-            assert(stream.is_open());
-
+            const auto rawPoints = readPoints(path);
             std::vector<vm::vec3f> points;
 
-            if (!stream.eof()) {
-                std::string line;
-                std::getline(stream, line);
-                points.push_back(vm::parse<float, 3>(line));
-                vm::vec3f lastPoint = points.back();
+            if (!rawPoints.empty()) {
+                points.push_back(rawPoints.front());
 
-                if (!stream.eof()) {
-                    std::getline(stream, line);
-                    vm::vec3f curPoint = vm::parse<float, 3>(line);
-                    vm::vec3f refDir = normalize(curPoint - lastPoint);
+                if (rawPoints.size() > 1) {
+                    vm::vec3f refDir = normalize(rawPoints[1] - rawPoints[0]);
 
-                    while (!stream.eof()) {
-                        lastPoint = curPoint;
-                        std::getline(stream, line);
-                        curPoint = vm::parse<float, 3>(line);
+                    for (size_t i = 2; i < rawPoints.size(); ++i) {
+                        const vm::vec3f& lastPoint = rawPoints[i - 1];
+                        const vm::vec3f& curPoint = rawPoints[i];
 
                         const vm::vec3f dir = normalize(curPoint - lastPoint);
                         if (std::acos(dot(dir, refDir)) > Threshold) {
@@ -114,7 +146,7 @@ namespace TrenchBroom {
                         }
                     }
 
-                    points.push_back(curPoint);
+                    points.push_back(rawPoints.back());
                 }
             }
 
@@ -38,6 +38,10 @@ namespace TrenchBroom {
             size_t m_current;
         public:
             PointFile();
+
+            /**
+             * Constructor throws an exception if the point file couldn't be read.
+             */
             PointFile(const IO::Path& path);
 
             static bool canLoad(const IO::Path& path);
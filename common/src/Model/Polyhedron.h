@@ -972,9 +972,9 @@ namespace TrenchBroom {
             using FloatType = T;
             using FacePayloadType = FP;
             using VertexPayloadType = VP;
-        private:
+
             static constexpr const auto MinEdgeLength = T(0.01);
-        public:
+
             using Vertex = Polyhedron_Vertex<T,FP,VP>;
             using Edge = Polyhedron_Edge<T,FP,VP>;
             using HalfEdge = Polyhedron_HalfEdge<T,FP,VP>;
@@ -1229,6 +1229,12 @@ namespace TrenchBroom {
              */
             const FaceList& faces() const;
 
+            /**
+             * Returns an estimate of the number of bytes allocated by this polyhedron, including its vertices, edges,
+             * half edges and faces, but not their payloads.
+             */
+            size_t memoryUsage() const;
+
             /**
              * Checks whether this polyhedron has any face with the given vertex positions, up to the given epsilon.
              *
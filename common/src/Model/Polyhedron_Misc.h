@@ -479,6 +479,15 @@ namespace TrenchBroom {
             return m_faces.size();
         }
 
+        template <typename T, typename FP, typename VP>
+        size_t Polyhedron<T,FP,VP>::memoryUsage() const {
+            // every edge consists of two half edges
+            return sizeof(Polyhedron)
+                + vertexCount() * sizeof(Vertex)
+                + edgeCount() * (sizeof(Edge) + 2u * sizeof(HalfEdge))
+                + faceCount() * sizeof(Face);
+        }
+
         template <typename T, typename FP, typename VP>
         const typename Polyhedron<T,FP,VP>::FaceList& Polyhedron<T,FP,VP>::faces() const {
             return m_faces;
@@ -20,24 +20,56 @@
 #include "PortalFile.h"
 
 #include "Exceptions.h"
+#include "IO/CompilerOutputTokenizer.h"
+#include "IO/File.h"
 #include "IO/Path.h"
+#include "IO/Reader.h"
 
-#include <kdl/string_format.h>
-#include <kdl/string_utils.h>
-
-#include <vecmath/forward.h>
-#include <vecmath/polygon.h>
 #include <vecmath/vec.h>
 
 #include <fstream>
+#include <memory>
 #include <string>
 
 namespace TrenchBroom {
     namespace Model {
-        PortalFile::PortalFile() = default;
+        using Tokenizer = IO::CompilerOutputTokenizer;
+        using Token = Tokenizer::Token;
+        namespace TokenType = IO::CompilerOutputToken;
+
+        static Token expect(Tokenizer& tokenizer, const TokenType::Type typeMask, const std::string& context) {
+            const auto token = tokenizer.nextToken();
+            if (!token.hasType(typeMask)) {
+                throw FileFormatException("Error reading " + context + " at line " + std::to_string(token.line()));
+            }
+            return token;
+        }
+
+        static void expectEndOfLine(Tokenizer& tokenizer, const std::string& context) {
+            expect(tokenizer, TokenType::Eol | TokenType::Eof, context);
+        }
+
+        static size_t expectCount(Tokenizer& tokenizer, const std::string& context) {
+            const auto count = expect(tokenizer, TokenType::Integer, context).toInteger<long>();
+            if (count < 0) {
+                throw FileFormatException("Error reading " + context + ": negative count");
+            }
+            expectEndOfLine(tokenizer, context);
+            return static_cast<size_t>(count);
+        }
+
+        static void skipLine(Tokenizer& tokenizer, const std::string& context) {
+            expect(tokenizer, TokenType::Integer, context);
+            expectEndOfLine(tokenizer, context);
+        }
+
+        PortalFile::PortalFile() :
+        m_offsets({ 0u }) {}
+
         PortalFile::~PortalFile() = default;
 
-        PortalFile::PortalFile(const IO::Path& path) {
+        PortalFile::PortalFile(const IO::Path& path) :
+        m_offsets({ 0u }) {
             load(path);
         }
 
@@ -46,70 +78,78 @@ namespace TrenchBroom {
             return stream.is_open() && stream.good();
         }
 
-        const std::vector<vm::polygon3f>& PortalFile::portals() const {
-            return m_portals;
+        size_t PortalFile::portalCount() const {
+            return m_offsets.size() - 1u;
+        }
+
+        const std::vector<vm::vec3f>& PortalFile::vertices() const {
+            return m_vertices;
+        }
+
+        const std::vector<size_t>& PortalFile::offsets() const {
+            return m_offsets;
         }
 
         void PortalFile::load(const IO::Path& path) {
-            std::fstream stream(path.asString(), std::ios::in);
-            if (!stream.good()) {
+            std::unique_ptr<IO::CFile> file;
+            try {
+                file = std::make_unique<IO::CFile>(path);
+            } catch (const FileSystemException&) {
                 throw FileFormatException("Couldn't open file");
             }
 
-            std::string line;
-            int numPortals;
+            // the file is read into memory in one go, the tokens reference the buffer instead of copying lines
+            const auto reader = file->reader().buffer();
+            Tokenizer tokenizer(std::begin(reader), std::end(reader));
 
             // read header
-            std::getline(stream, line);
-            const std::string formatCode = kdl::str_trim(line); // trim off any trailing \r
+            const auto formatCode = expect(tokenizer, TokenType::Word, "header").data();
+            expectEndOfLine(tokenizer, "header");
 
+            size_t numPortals = 0u;
             if (formatCode == "PRT1") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
+                skipLine(tokenizer, "header"); // number of leafs (ignored)
+                numPortals = expectCount(tokenizer, "header");
             } else if (formatCode == "PRT2") {
-                std::getline(stream, line); // number of leafs (ignored)
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
+                skipLine(tokenizer, "header"); // number of leafs (ignored)
+                skipLine(tokenizer, "header"); // number of clusters (ignored)
+                numPortals = expectCount(tokenizer, "header");
             } else if (formatCode == "PRT1-AM") {
-                std::getline(stream, line); // number of clusters (ignored)
-                std::getline(stream, line); // number of portals
-                numPortals = std::stoi(line);
-                std::getline(stream, line); // number of leafs (ignored)
+                skipLine(tokenizer, "header"); // number of clusters (ignored)
+                numPortals = expectCount(tokenizer, "header");
+                skipLine(tokenizer, "header"); // number of leafs (ignored)
             } else {
                 throw FileFormatException("Unknown portal format: " + formatCode);
             }
 
-            if (!stream.good()) {
-                throw FileFormatException("Error reading header");
-            }
+            // most portals are quads, so this avoids most reallocations without trusting the count too much
+            m_offsets.reserve(numPortals + 1u);
+            m_vertices.reserve(numPortals * 4u);
 
             // read portals
-            for (int i = 0; i < numPortals; ++i) {
-                std::getline(stream, line);
-                const auto components = kdl::str_split(line, "() \n\t\r");
-
-                if (!stream.good() || components.size() < 3) {
-                    throw FileFormatException("Error reading portal");
+            for (size_t i = 0; i < numPortals; ++i) {
+                const auto numPoints = expect(tokenizer, TokenType::Integer, "portal").toInteger<long>();
+                if (numPoints < 3) {
+                    throw FileFormatException("Error reading portal at line " + std::to_string(tokenizer.line()) + ": too few points");
                 }
 
-                std::vector<vm::vec3f> verts;
-                size_t ptr = 3;
-                const int numPoints = std::stoi(components.at(0));
-                for (int j = 0; j < numPoints; ++j) {
-                    if (ptr + 2 >= components.size()) {
-                        throw FileFormatException("Error reading portal");
-                    }
-
-                    const vm::vec3f vert(std::stof(components.at(ptr)),
-                                     std::stof(components.at(ptr+1)),
-                                     std::stof(components.at(ptr+2)));
-                    verts.push_back(vert);
-                    ptr += 3;
+                // the leafs or clusters which the portal connects (ignored)
+                expect(tokenizer, TokenType::Integer, "portal");
+                expect(tokenizer, TokenType::Integer, "portal");
+
+                for (long j = 0; j < numPoints; ++j) {
+                    const auto x = expect(tokenizer, TokenType::Number, "portal").toFloat<float>();
+                    const auto y = expect(tokenizer, TokenType::Number, "portal").toFloat<float>();
+                    const auto z = expect(tokenizer, TokenType::Number, "portal").toFloat<float>();
+                    m_vertices.emplace_back(x, y, z);
                 }
+                m_offsets.push_back(m_vertices.size());
 
-                m_portals.push_back(vm::polygon3f(verts));
+                // anything following the points is ignored
+                auto token = tokenizer.nextToken();
+                while (!token.hasType(TokenType::Eol | TokenType::Eof)) {
+                    token = tokenizer.nextToken();
+                }
             }
         }
     }
@@ -21,7 +21,9 @@
 #define TrenchBroom_PortalFile
 
 #include <vecmath/forward.h>
+#include <vecmath/vec.h>
 
+#include <cstddef>
 #include <vector>
 
 namespace TrenchBroom {
@@ -29,9 +31,14 @@ namespace TrenchBroom {
         class Path;
     }
     namespace Model {
+        /**
+         * The portals of a compiled map. The vertices of all portals are stored in one array, and the portals are
+         * delimited by an array of offsets into it, so that they can be handed to the renderer without any copying.
+         */
         class PortalFile {
         private:
-            std::vector<vm::polygon3f> m_portals;
+            std::vector<vm::vec3f> m_vertices;
+            std::vector<size_t> m_offsets;
         public:
             PortalFile();
             ~PortalFile();
@@ -43,7 +50,18 @@ namespace TrenchBroom {
 
             static bool canLoad(const IO::Path& path);
 
-            const std::vector<vm::polygon3f>& portals() const;
+            size_t portalCount() const;
+
+            /**
+             * Returns the vertices of all portals.
+             */
+            const std::vector<vm::vec3f>& vertices() const;
+
+            /**
+             * Returns the offsets of the portals into the vertex array. The vertices of the i-th portal are stored in
+             * the range [offsets[i], offsets[i+1]), so this contains one more element than there are portals.
+             */
+            const std::vector<size_t>& offsets() const;
         private:
             void load(const IO::Path& path);
         };
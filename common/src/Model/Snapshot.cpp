@@ -43,6 +43,25 @@ namespace TrenchBroom {
                 snapshot->restore();
         }
 
+        size_t Snapshot::memoryUsage() const {
+            auto result = sizeof(Snapshot)
+                + m_nodeSnapshots.capacity() * sizeof(NodeSnapshot*)
+                + m_brushFaceSnapshots.capacity() * sizeof(BrushFaceSnapshot*);
+            for (const NodeSnapshot* snapshot : m_nodeSnapshots) {
+                result += snapshot->memoryUsage();
+            }
+            for (const BrushFaceSnapshot* snapshot : m_brushFaceSnapshots) {
+                result += snapshot->memoryUsage();
+            }
+            return result;
+        }
+
+        void Snapshot::compact() {
+            for (NodeSnapshot* snapshot : m_nodeSnapshots) {
+                snapshot->compact();
+            }
+        }
+
         void Snapshot::takeSnapshot(Node* node) {
             NodeSnapshot* snapshot = node->takeSnapshot();
             if (snapshot != nullptr)
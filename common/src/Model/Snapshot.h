@@ -48,6 +48,16 @@ namespace TrenchBroom {
 
             void restoreNodes(const vm::bbox3& worldBounds);
             void restoreBrushFaces();
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * Discards any data held by the node snapshots that can be reconstructed when they are restored.
+             */
+            void compact();
         private:
             void takeSnapshot(Node* node);
             void takeSnapshot(BrushFace* face);
@@ -254,5 +254,9 @@ namespace TrenchBroom {
         bool SmartTag::canDisable() const {
             return m_matcher->canDisable();
         }
+
+        const TagMatcher& SmartTag::matcher() const {
+            return *m_matcher;
+        }
     }
 }
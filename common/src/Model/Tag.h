@@ -398,6 +398,11 @@ namespace TrenchBroom {
              * @return true if this tag can modify the selection appropriately and false otherwise
              */
             bool canDisable() const;
+
+            /**
+             * Returns the matcher of this tag.
+             */
+            const TagMatcher& matcher() const;
         };
     }
 }
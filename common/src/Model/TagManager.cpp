@@ -20,8 +20,11 @@
 #include "TagManager.h"
 
 #include "Ensure.h"
+#include "Model/BrushFace.h"
 #include "Model/Tag.h"
+#include "Model/TagMatcher.h"
 #include "Model/TagType.h"
+#include "Model/TagVisitor.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -86,15 +89,58 @@ namespace TrenchBroom {
                     throw std::logic_error("Smart tag '" + tag.name() + "' already registered");
                 }
             }
+            compileTextureNameMatchers();
         }
 
         void TagManager::clearSmartTags() {
             m_smartTags.clear();
+            m_textureNameMatcher.clear();
         }
 
+        class TagManager::GetTextureNameMask : public ConstTagVisitor {
+        private:
+            const TextureNamePatternMatcher& m_matcher;
+            TagType::Type m_mask;
+        public:
+            explicit GetTextureNameMask(const TextureNamePatternMatcher& matcher) :
+            m_matcher(matcher),
+            m_mask(TagType::NoType) {}
+
+            TagType::Type mask() const {
+                return m_mask;
+            }
+
+            void visit(const BrushFace& face) override {
+                m_mask = m_matcher.matchCached(face.textureName());
+            }
+        };
+
         void TagManager::updateTags(Taggable& taggable) const {
+            const auto textureNameTags = m_textureNameMatcher.mask();
+            auto textureNameMask = TagType::NoType;
+            if (textureNameTags != TagType::NoType) {
+                GetTextureNameMask visitor(m_textureNameMatcher);
+                taggable.accept(visitor);
+                textureNameMask = visitor.mask();
+            }
+
             for (const auto& tag : m_smartTags) {
-                tag.update(taggable);
+                if ((tag.type() & textureNameTags) == 0u) {
+                    tag.update(taggable);
+                } else if ((tag.type() & textureNameMask) != 0u) {
+                    taggable.addTag(tag);
+                } else {
+                    taggable.removeTag(tag);
+                }
+            }
+        }
+
+        void TagManager::compileTextureNameMatchers() {
+            m_textureNameMatcher.clear();
+            for (const auto& tag : m_smartTags) {
+                if (const auto* matcher = dynamic_cast<const TextureNameTagMatcher*>(&tag.matcher())) {
+                    m_textureNameMatcher.addPattern(matcher->pattern(), tag.type());
+                }
             }
         }
 
@@ -21,6 +21,7 @@
 #define TRENCHBROOM_TAGMANAGER_H
 
 #include "Model/Tag.h"
+#include "Model/TextureNamePatternMatcher.h"
 
 #include <kdl/vector_set.h>
 
@@ -41,6 +42,12 @@ namespace TrenchBroom {
             };
 
             kdl::vector_set<SmartTag, TagCmp> m_smartTags;
+
+            /**
+             * The patterns of all smart tags that match brush faces by texture name, compiled into a single matcher
+             * whose results are cached per texture name.
+             */
+            TextureNamePatternMatcher m_textureNameMatcher;
         public:
             /**
              * Returns a vector containing all smart tags registered with this manager.
@@ -102,10 +109,16 @@ namespace TrenchBroom {
             /**
              * Update the smart tags of the given taggable object.
              *
+             * Smart tags that match texture names are not evaluated one by one. Instead, the texture name of a brush
+             * face is looked up once in a cached matcher for all of these tags.
+             *
              * @param taggable the object to update
              */
             void updateTags(Taggable& taggable) const;
         private:
+            class GetTextureNameMask;
+
+            void compileTextureNameMatchers();
             size_t freeTagIndex();
         };
     }
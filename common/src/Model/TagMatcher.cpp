@@ -64,12 +64,18 @@ namespace TrenchBroom {
         }
 
         TextureNameTagMatcher::TextureNameTagMatcher(const std::string& pattern) :
-        m_pattern(pattern) {}
+        m_pattern(pattern) {
+            m_matcher.addPattern(m_pattern, 1u);
+        }
 
         std::unique_ptr<TagMatcher> TextureNameTagMatcher::clone() const {
             return std::make_unique<TextureNameTagMatcher>(m_pattern);
         }
 
+        const std::string& TextureNameTagMatcher::pattern() const {
+            return m_pattern;
+        }
+
         bool TextureNameTagMatcher::matches(const Taggable& taggable) const {
             BrushFaceMatchVisitor visitor([this](const BrushFace& face) {
                 return matchesTextureName(face.textureName());
@@ -119,12 +125,7 @@ namespace TrenchBroom {
         }
 
         bool TextureNameTagMatcher::matchesTextureName(std::string_view textureName) const {
-            const auto pos = textureName.find_last_of('/');
-            if (pos != std::string::npos) {
-                textureName = textureName.substr(pos + 1);
-            }
-
-            return kdl::ci::str_matches_glob(textureName, m_pattern);
+            return m_matcher.match(textureName) != TagType::NoType;
         }
 
         SurfaceParmTagMatcher::SurfaceParmTagMatcher(const std::string& parameter) :
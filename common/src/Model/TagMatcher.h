@@ -22,6 +22,7 @@
 
 #include "Model/Tag.h"
 #include "Model/TagVisitor.h"
+#include "Model/TextureNamePatternMatcher.h"
 
 #include <functional>
 #include <memory>
@@ -71,9 +72,12 @@ namespace TrenchBroom {
         class TextureNameTagMatcher : public TagMatcher {
         private:
             std::string m_pattern;
+            TextureNamePatternMatcher m_matcher;
         public:
             explicit TextureNameTagMatcher(const std::string& pattern);
             std::unique_ptr<TagMatcher> clone() const override;
+
+            const std::string& pattern() const;
         public:
             bool matches(const Taggable& taggable) const override;
             void enable(TagMatcherCallback& callback, MapFacade& facade) const override;
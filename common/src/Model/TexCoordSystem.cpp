@@ -36,6 +36,16 @@ namespace TrenchBroom {
             return doClone();
         }
 
+        TexCoordProjection::TexCoordProjection(const vm::vec3& xAxis, const vm::vec3& yAxis, const vm::vec2f& offset, const vm::vec2f& textureSize) :
+        m_xAxis(xAxis),
+        m_yAxis(yAxis),
+        m_offset(offset),
+        m_textureSize(textureSize) {}
+
+        vm::vec2f TexCoordProjection::project(const vm::vec3& point) const {
+            return (vm::vec2f(dot(point, m_xAxis), dot(point, m_yAxis)) + m_offset) / m_textureSize;
+        }
+
         TexCoordSystem::TexCoordSystem() = default;
 
         TexCoordSystem::~TexCoordSystem() = default;
@@ -76,6 +86,13 @@ namespace TrenchBroom {
             return doGetTexCoords(point, attribs);
         }
 
+        TexCoordProjection TexCoordSystem::getTexCoordProjection(const BrushFaceAttributes& attribs) const {
+            return TexCoordProjection(safeScaleAxis(getXAxis(), attribs.scale().x()),
+                                      safeScaleAxis(getYAxis(), attribs.scale().y()),
+                                      attribs.offset(),
+                                      attribs.textureSize());
+        }
+
         void TexCoordSystem::setRotation(const vm::vec3& normal, const float oldAngle, const float newAngle) {
             doSetRotation(normal, oldAngle, newAngle);
         }
@@ -48,6 +48,22 @@ namespace TrenchBroom {
             friend class ParaxialTexCoordSystem;
         };
 
+        /**
+         * Computes the texture coordinates of points on a face. The texture axes are scaled once when the projection
+         * is created, so this is cheaper than calling TexCoordSystem::getTexCoords for each point of a face.
+         */
+        class TexCoordProjection {
+        private:
+            vm::vec3 m_xAxis;
+            vm::vec3 m_yAxis;
+            vm::vec2f m_offset;
+            vm::vec2f m_textureSize;
+        public:
+            TexCoordProjection(const vm::vec3& xAxis, const vm::vec3& yAxis, const vm::vec2f& offset, const vm::vec2f& textureSize);
+
+            vm::vec2f project(const vm::vec3& point) const;
+        };
+
         enum class WrapStyle {
             Projection,
             Rotation
@@ -71,6 +87,11 @@ namespace TrenchBroom {
 
             vm::vec2f getTexCoords(const vm::vec3& point, const BrushFaceAttributes& attribs) const;
 
+            /**
+             * Returns a projection that computes the same texture coordinates as getTexCoords for the given attributes.
+             */
+            TexCoordProjection getTexCoordProjection(const BrushFaceAttributes& attribs) const;
+
             void setRotation(const vm::vec3& normal, float oldAngle, float newAngle);
             void transform(const vm::plane3& oldBoundary, const vm::plane3& newBoundary, const vm::mat4x4& transformation, BrushFaceAttributes& attribs, bool lockTexture, const vm::vec3& invariant);
             void updateNormal(const vm::vec3& oldNormal, const vm::vec3& newNormal, const BrushFaceAttributes& attribs, const WrapStyle style);
@@ -121,7 +142,11 @@ namespace TrenchBroom {
                 return axis / safeScale(T1(factor));
             }
 
-            deleteCopyAndMove(TexCoordSystem)
+        protected:
+            // concrete coordinate systems are copied when brush faces are cloned, see BrushFace
+            TexCoordSystem(const TexCoordSystem& other) = default;
+        public:
+            TexCoordSystem& operator=(const TexCoordSystem& other) = delete;
         };
     }
 }
@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureNamePatternMatcher.h"
+
+#include <kdl/string_compare.h>
+#include <kdl/string_format.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace Model {
+        static bool isGlobChar(const char c) {
+            return c == '*' || c == '?' || c == '%' || c == '\\';
+        }
+
+        TextureNamePatternMatcher::TextureNamePatternMatcher() :
+        m_mask(TagType::NoType) {}
+
+        void TextureNamePatternMatcher::addPattern(const std::string& pattern, const Mask mask) {
+            const auto globPos = std::find_if(std::begin(pattern), std::end(pattern), isGlobChar);
+            if (globPos == std::end(pattern)) {
+                m_literals[kdl::str_to_lower(pattern)] |= mask;
+            } else if (*globPos == '*' && std::next(globPos) == std::end(pattern)) {
+                const auto prefix = std::string_view(pattern).substr(0, pattern.size() - 1u);
+                m_prefixes.emplace_back(kdl::str_to_lower(prefix), mask);
+            } else {
+                m_globs.emplace_back(pattern, mask);
+            }
+
+            m_mask |= mask;
+            m_cache.clear();
+        }
+
+        void TextureNamePatternMatcher::clear() {
+            m_literals.clear();
+            m_prefixes.clear();
+            m_globs.clear();
+            m_mask = TagType::NoType;
+            m_cache.clear();
+        }
+
+        TextureNamePatternMatcher::Mask TextureNamePatternMatcher::mask() const {
+            return m_mask;
+        }
+
+        TextureNamePatternMatcher::Mask TextureNamePatternMatcher::match(std::string_view textureName) const {
+            const auto pos = textureName.find_last_of('/');
+            if (pos != std::string_view::npos) {
+                textureName = textureName.substr(pos + 1);
+            }
+
+            auto result = TagType::NoType;
+            if (!m_literals.empty() || !m_prefixes.empty()) {
+                const auto lowerName = kdl::str_to_lower(textureName);
+
+                const auto it = m_literals.find(lowerName);
+                if (it != std::end(m_literals)) {
+                    result |= it->second;
+                }
+
+                for (const auto& [prefix, mask] : m_prefixes) {
+                    if (lowerName.compare(0u, prefix.size(), prefix) == 0) {
+                        result |= mask;
+                    }
+                }
+            }
+
+            for (const auto& [pattern, mask] : m_globs) {
+                if ((result & mask) != mask && kdl::ci::str_matches_glob(textureName, pattern)) {
+                    result |= mask;
+                }
+            }
+
+            return result;
+        }
+
+        TextureNamePatternMatcher::Mask TextureNamePatternMatcher::matchCached(const std::string& textureName) const {
+            const auto it = m_cache.find(textureName);
+            if (it != std::end(m_cache)) {
+                return it->second;
+            }
+
+            const auto result = match(textureName);
+            m_cache.emplace(textureName, result);
+            return result;
+        }
+
+        size_t TextureNamePatternMatcher::cacheSize() const {
+            return m_cache.size();
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_TEXTURENAMEPATTERNMATCHER_H
+#define TRENCHBROOM_TEXTURENAMEPATTERNMATCHER_H
+
+#include "Model/TagType.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Matches texture names against a set of glob patterns at once. Each pattern is associated with a bit mask,
+         * and matching a texture name returns the union of the masks of all patterns that match it.
+         *
+         * Patterns are matched case insensitively against the part of the texture name after the last '/'. When a
+         * pattern is added, it is classified as follows:
+         * - a pattern without any glob characters is stored in a hash map and looked up in constant time,
+         * - a pattern whose only glob character is a trailing '*' is matched as a prefix,
+         * - all other patterns are matched using kdl::ci::str_matches_glob.
+         *
+         * The results of matchCached are cached per texture name until the patterns change.
+         */
+        class TextureNamePatternMatcher {
+        public:
+            using Mask = TagType::Type;
+        private:
+            std::unordered_map<std::string, Mask> m_literals;
+            std::vector<std::pair<std::string, Mask>> m_prefixes;
+            std::vector<std::pair<std::string, Mask>> m_globs;
+            Mask m_mask;
+
+            mutable std::unordered_map<std::string, Mask> m_cache;
+        public:
+            TextureNamePatternMatcher();
+
+            void addPattern(const std::string& pattern, Mask mask);
+            void clear();
+
+            /**
+             * Returns the union of the masks of all patterns.
+             */
+            Mask mask() const;
+
+            Mask match(std::string_view textureName) const;
+
+            /**
+             * Like match, but caches the result for the given texture name. This is not thread safe.
+             */
+            Mask matchCached(const std::string& textureName) const;
+            size_t cacheSize() const;
+        };
+    }
+}
+
+#endif //TRENCHBROOM_TEXTURENAMEPATTERNMATCHER_H
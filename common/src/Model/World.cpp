@@ -25,13 +25,14 @@
 #include "Model/AttributableNodeIndex.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/CollectNodesWithDescendantSelectionCountVisitor.h"
 #include "Model/IssueGenerator.h"
 #include "Model/IssueGeneratorRegistry.h"
+#include "Model/IssueValidationQueue.h"
 #include "Model/ModelFactoryImpl.h"
 #include "Model/TagVisitor.h"
 
-#include <kdl/vector_utils.h>
 
 #include <vecmath/bbox_io.h>
 
@@ -46,6 +47,7 @@ namespace TrenchBroom {
         m_defaultLayer(nullptr),
         m_attributableIndex(std::make_unique<AttributableNodeIndex>()),
         m_issueGeneratorRegistry(std::make_unique<IssueGeneratorRegistry>()),
+        m_issueValidationQueue(std::make_unique<IssueValidationQueue>()),
         m_nodeTree(std::make_unique<NodeTree>()),
         m_updateNodeTree(true) {
             addOrUpdateAttribute(AttributeNames::Classname, AttributeValues::WorldspawnClassname);
@@ -99,6 +101,10 @@ namespace TrenchBroom {
             invalidateAllIssues();
         }
 
+        IssueValidationQueue& World::issueValidationQueue() {
+            return *m_issueValidationQueue;
+        }
+
         class World::AddNodeToNodeTree : public NodeVisitor {
         private:
             NodeTree& m_nodeTree;
@@ -149,6 +155,10 @@ namespace TrenchBroom {
             void doVisit(Brush* brush) override   { m_nodeTree.update(brush->physicalBounds(), brush); }
         };
 
+        std::vector<Node*> World::findNodesIntersecting(const vm::bbox3& bounds) const {
+            return m_nodeTree->findIntersectors(bounds);
+        }
+
         class World::MatchTreeNodes {
         public:
             bool operator()(const Model::Node* node) const   { return node->shouldAddToSpacialIndex(); }
@@ -282,6 +292,15 @@ namespace TrenchBroom {
             }
         }
 
+        void World::doDescendantWasRemoved(Node* /* oldParent */, Node* node, const size_t /* depth */) {
+            // `node` is already disconnected from this world, so its issues will no longer be reported to the queue
+            CollectNodesVisitor visitor;
+            node->acceptAndRecurse(visitor);
+            for (auto* removedNode : visitor.nodes()) {
+                m_issueValidationQueue->nodeWasRemoved(removedNode);
+            }
+        }
+
         void World::doDescendantPhysicalBoundsDidChange(Node* node) {
             if (m_updateNodeTree) {
                 UpdateNodeInNodeTree visitor(*m_nodeTree);
@@ -318,13 +337,11 @@ namespace TrenchBroom {
         }
 
         void World::doFindAttributableNodesWithAttribute(const std::string& name, const std::string& value, std::vector<Model::AttributableNode*>& result) const {
-            kdl::vec_append(result,
-                m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::exact(name), value));
+            m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::exact(name), value, result);
         }
 
         void World::doFindAttributableNodesWithNumberedAttribute(const std::string& prefix, const std::string& value, std::vector<Model::AttributableNode*>& result) const {
-            kdl::vec_append(result,
-                m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::numbered(prefix), value));
+            m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::numbered(prefix), value, result);
         }
 
         void World::doAddToIndex(AttributableNode* attributable, const std::string& name, const std::string& value) {
@@ -335,6 +352,10 @@ namespace TrenchBroom {
             m_attributableIndex->removeAttribute(attributable, name, value);
         }
 
+        void World::doNodeIssuesWereInvalidated(Node* node) {
+            m_issueValidationQueue->nodeIssuesWereInvalidated(node);
+        }
+
         void World::doAttributesDidChange(const vm::bbox3& /* oldBounds */) {}
 
         bool World::doIsAttributeNameMutable(const std::string& name) const {
@@ -38,6 +38,7 @@ namespace TrenchBroom {
         class AttributableNodeIndex;
         class IssueGeneratorRegistry;
         class IssueQuickFix;
+        class IssueValidationQueue;
         class PickResult;
 
         class World : public AttributableNode, public ModelFactory {
@@ -46,6 +47,7 @@ namespace TrenchBroom {
             Layer* m_defaultLayer;
             std::unique_ptr<AttributableNodeIndex> m_attributableIndex;
             std::unique_ptr<IssueGeneratorRegistry> m_issueGeneratorRegistry;
+            std::unique_ptr<IssueValidationQueue> m_issueValidationQueue;
 
             using NodeTree = AABBTree<FloatType, 3, Node*>;
             std::unique_ptr<NodeTree> m_nodeTree;
@@ -67,10 +69,21 @@ namespace TrenchBroom {
             std::vector<IssueQuickFix*> quickFixes(IssueType issueTypes) const;
             void registerIssueGenerator(IssueGenerator* issueGenerator);
             void unregisterAllIssueGenerators();
+
+            /**
+             * Records the nodes of this world whose issues were invalidated and the nodes that were removed from this
+             * world, so that their issues can be revalidated incrementally.
+             */
+            IssueValidationQueue& issueValidationQueue();
         private:
             class AddNodeToNodeTree;
             class RemoveNodeFromNodeTree;
             class UpdateNodeInNodeTree;
+        public: // spatial queries
+            /**
+             * Returns the entities and brushes of this world whose physical bounds intersect the given bounds.
+             */
+            std::vector<Node*> findNodesIntersecting(const vm::bbox3& bounds) const;
         public: // node tree bulk updating
             class MatchTreeNodes;
             void disableNodeTreeUpdates();
@@ -91,6 +104,7 @@ namespace TrenchBroom {
 
             void doDescendantWasAdded(Node* node, size_t depth) override;
             void doDescendantWillBeRemoved(Node* node, size_t depth) override;
+            void doDescendantWasRemoved(Node* oldParent, Node* node, size_t depth) override;
             void doDescendantPhysicalBoundsDidChange(Node* node) override;
 
             bool doSelectable() const override;
@@ -103,6 +117,7 @@ namespace TrenchBroom {
             void doFindAttributableNodesWithNumberedAttribute(const std::string& prefix, const std::string& value, std::vector<AttributableNode*>& result) const override;
             void doAddToIndex(AttributableNode* attributable, const std::string& name, const std::string& value) override;
             void doRemoveFromIndex(AttributableNode* attributable, const std::string& name, const std::string& value) override;
+            void doNodeIssuesWereInvalidated(Node* node) override;
         private: // implement AttributableNode interface
             void doAttributesDidChange(const vm::bbox3& oldBounds) override;
             bool doIsAttributeNameMutable(const std::string& name) const override;
@@ -120,10 +120,20 @@ namespace TrenchBroom {
 
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
+        Preference<bool> TextureArrays(IO::Path("Renderer/Texture arrays"), false);
+        // in MiB, 0 means unlimited
+        Preference<int> TextureBudget(IO::Path("Renderer/Texture budget"), 1024);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
 
+        Preference<bool> UseMapCache(IO::Path("Editor/Use map cache"), false);
+        // in MiB, 0 means unlimited
+        Preference<int> UndoBudget(IO::Path("Editor/Undo budget"), 512);
+
+        // the number of compilation tasks that may run at the same time, 0 means one per hardware thread
+        Preference<int> CompilationJobLimit(IO::Path("Compilation/Job limit"), 0);
+
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
             return fontPath;
@@ -247,8 +257,13 @@ namespace TrenchBroom {
                 &GridColor2D,
                 &TextureMinFilter,
                 &TextureMagFilter,
+                &TextureArrays,
+                &TextureBudget,
                 &TextureLock,
                 &UVLock,
+                &UseMapCache,
+                &UndoBudget,
+                &CompilationJobLimit,
                 &RendererFontPath(),
                 &RendererFontSize,
                 &BrowserFontSize,
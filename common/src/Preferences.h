@@ -116,10 +116,17 @@ namespace TrenchBroom {
 
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
+        extern Preference<bool> TextureArrays;
+        extern Preference<int> TextureBudget;
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
 
+        extern Preference<bool> UseMapCache;
+        extern Preference<int> UndoBudget;
+
+        extern Preference<int> CompilationJobLimit;
+
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
 
@@ -28,9 +28,13 @@
 #include "Model/TagAttribute.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
 
+#include <vecmath/bbox.h>
+
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <vector>
 
@@ -109,6 +113,16 @@ namespace TrenchBroom {
                                    EdgeRenderPolicy::RenderAll);
         }
 
+        // Chunk
+
+        BrushRenderer::Chunk::Chunk() :
+        vertexArray(std::make_shared<BrushVertexArray>()),
+        edgeIndices(std::make_shared<BrushIndexArray>()),
+        transparentFaces(std::make_shared<TextureToBrushIndicesMap>()),
+        opaqueFaces(std::make_shared<TextureToBrushIndicesMap>()),
+        brushCount(0u),
+        changed(true) {}
+
         // BrushRenderer
 
         BrushRenderer::BrushRenderer() :
@@ -158,8 +172,7 @@ namespace TrenchBroom {
             m_invalidBrushes = m_allBrushes;
 
             assert(m_brushInfo.empty());
-            assert(m_transparentFaces->empty());
-            assert(m_opaqueFaces->empty());
+            assert(m_chunks.empty());
         }
 
         void BrushRenderer::invalidateBrushes(const std::vector<Model::Brush*>& brushes) {
@@ -185,15 +198,7 @@ namespace TrenchBroom {
             m_brushInfo.clear();
             m_allBrushes.clear();
             m_invalidBrushes.clear();
-
-            m_vertexArray = std::make_shared<BrushVertexArray>();
-            m_edgeIndices = std::make_shared<BrushIndexArray>();
-            m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
-            m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
-
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            m_chunks.clear();
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -259,11 +264,13 @@ namespace TrenchBroom {
                 if (!valid()) {
                     validate();
                 }
-                if (renderContext.showFaces()) {
-                    renderOpaqueFaces(renderBatch);
-                }
-                if (renderContext.showEdges() || m_showEdges) {
-                    renderEdges(renderBatch);
+                for (auto* chunk : visibleChunks(renderContext.camera())) {
+                    if (renderContext.showFaces()) {
+                        renderOpaqueFaces(*chunk, renderBatch);
+                    }
+                    if (renderContext.showEdges() || m_showEdges) {
+                        renderEdges(*chunk, renderBatch);
+                    }
                 }
             }
         }
@@ -274,31 +281,44 @@ namespace TrenchBroom {
                     validate();
                 }
                 if (renderContext.showFaces()) {
-                    renderTransparentFaces(renderBatch);
+                    for (auto* chunk : visibleChunks(renderContext.camera())) {
+                        renderTransparentFaces(*chunk, renderBatch);
+                    }
                 }
             }
         }
 
-        void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch) {
-            m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-            m_opaqueFaceRenderer.setTint(m_tint);
-            m_opaqueFaceRenderer.setTintColor(m_tintColor);
-            m_opaqueFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderOpaqueFaces(Chunk& chunk, RenderBatch& renderBatch) {
+            chunk.opaqueFaceRenderer.setGrayscale(m_grayscale);
+            chunk.opaqueFaceRenderer.setTint(m_tint);
+            chunk.opaqueFaceRenderer.setTintColor(m_tintColor);
+            chunk.opaqueFaceRenderer.render(renderBatch);
         }
 
-        void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch) {
-            m_transparentFaceRenderer.setGrayscale(m_grayscale);
-            m_transparentFaceRenderer.setTint(m_tint);
-            m_transparentFaceRenderer.setTintColor(m_tintColor);
-            m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-            m_transparentFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderTransparentFaces(Chunk& chunk, RenderBatch& renderBatch) {
+            chunk.transparentFaceRenderer.setGrayscale(m_grayscale);
+            chunk.transparentFaceRenderer.setTint(m_tint);
+            chunk.transparentFaceRenderer.setTintColor(m_tintColor);
+            chunk.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+            chunk.transparentFaceRenderer.render(renderBatch);
         }
 
-        void BrushRenderer::renderEdges(RenderBatch& renderBatch) {
+        void BrushRenderer::renderEdges(Chunk& chunk, RenderBatch& renderBatch) {
             if (m_showOccludedEdges) {
-                m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+                chunk.edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+            }
+            chunk.edgeRenderer.render(renderBatch, m_edgeColor);
+        }
+
+        std::vector<BrushRenderer::Chunk*> BrushRenderer::visibleChunks(const Camera& camera) {
+            std::vector<Chunk*> result;
+            result.reserve(m_chunks.size());
+            for (auto& [key, chunk] : m_chunks) {
+                if (camera.frustumIntersects(chunk.bounds)) {
+                    result.push_back(&chunk);
+                }
             }
-            m_edgeRenderer.render(renderBatch, m_edgeColor);
+            return result;
         }
 
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
@@ -333,9 +353,40 @@ namespace TrenchBroom {
             m_invalidBrushes.clear();
             assert(valid());
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            // only the renderers of chunks whose brushes changed are recreated
+            for (auto& [key, chunk] : m_chunks) {
+                if (chunk.changed) {
+                    chunk.opaqueFaceRenderer = FaceRenderer(chunk.vertexArray, chunk.opaqueFaces, m_faceColor);
+                    chunk.transparentFaceRenderer = FaceRenderer(chunk.vertexArray, chunk.transparentFaces, m_faceColor);
+                    chunk.edgeRenderer = IndexedEdgeRenderer(chunk.vertexArray, chunk.edgeIndices);
+                    chunk.changed = false;
+                }
+            }
+        }
+
+        size_t BrushRenderer::chunkCount() const {
+            return m_chunks.size();
+        }
+
+        std::vector<vm::bbox3f> BrushRenderer::visibleChunkBounds(const Camera& camera) {
+            std::vector<vm::bbox3f> result;
+            for (const auto* chunk : visibleChunks(camera)) {
+                result.push_back(chunk->bounds);
+            }
+            return result;
+        }
+
+        BrushRenderer::ChunkKey BrushRenderer::chunkKey(const Model::Brush* brush) {
+            const auto center = vm::vec3f(brush->logicalBounds().center());
+            return {
+                static_cast<int>(std::floor(center.x() / ChunkSize)),
+                static_cast<int>(std::floor(center.y() / ChunkSize)),
+                static_cast<int>(std::floor(center.z() / ChunkSize))
+            };
+        }
+
+        BrushRenderer::Chunk& BrushRenderer::chunk(const ChunkKey& key) {
+            return m_chunks[key];
         }
 
         static size_t triIndicesCountForPolygon(const size_t vertexCount) {
@@ -442,6 +493,13 @@ namespace TrenchBroom {
             }
 
             BrushInfo& info = m_brushInfo[brush];
+            info.chunkKey = chunkKey(brush);
+
+            Chunk& chunk = this->chunk(info.chunkKey);
+            const auto brushBounds = vm::bbox3f(brush->logicalBounds());
+            chunk.bounds = chunk.brushCount == 0u ? brushBounds : vm::merge(chunk.bounds, brushBounds);
+            ++chunk.brushCount;
+            chunk.changed = true;
 
             // collect vertices
             auto& brushCache = brush->brushRendererBrushCache();
@@ -449,8 +507,7 @@ namespace TrenchBroom {
             const auto& cachedVertices = brushCache.cachedVertices();
             ensure(!cachedVertices.empty(), "Brush must have cached vertices");
 
-            assert(m_vertexArray != nullptr);
-            auto [vertBlock, dest] = m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+            auto [vertBlock, dest] = chunk.vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
             std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
             info.vertexHolderKey = vertBlock;
 
@@ -460,7 +517,7 @@ namespace TrenchBroom {
             {
                 const size_t edgeIndexCount = countMarkedEdgeIndices(brush, edgePolicy);
                 if (edgeIndexCount > 0) {
-                    auto [key, insertDest] = m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+                    auto [key, insertDest] = chunk.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
                     info.edgeIndicesKey = key;
                     getMarkedEdgeIndices(brush, edgePolicy, brushVerticesStartIndex, insertDest);
                 } else {
@@ -500,7 +557,7 @@ namespace TrenchBroom {
                 }
 
                 if (transparentIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_transparentFaces;
+                    TextureToBrushIndicesMap& faceVboMap = *chunk.transparentFaces;
                     auto& holderPtr = faceVboMap[texture];
                     if (holderPtr == nullptr) {
                         // inserts into map!
@@ -527,7 +584,7 @@ namespace TrenchBroom {
                 }
 
                 if (opaqueIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_opaqueFaces;
+                    TextureToBrushIndicesMap& faceVboMap = *chunk.opaqueFaces;
                     auto& holderPtr = faceVboMap[texture];
                     if (holderPtr == nullptr) {
                         // inserts into map!
@@ -587,32 +644,43 @@ namespace TrenchBroom {
             }
 
             const BrushInfo& info = it->second;
+            const auto chunkIt = m_chunks.find(info.chunkKey);
+            assert(chunkIt != std::end(m_chunks));
+            Chunk& chunk = chunkIt->second;
 
             // update Vbo's
-            m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+            chunk.vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
             if (info.edgeIndicesKey != nullptr) {
-                m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+                chunk.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
             }
 
             for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = chunk.opaqueFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_opaqueFaces->erase(texture);
+                    chunk.opaqueFaces->erase(texture);
                 }
             }
             for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = chunk.transparentFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(transparentKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_transparentFaces->erase(texture);
+                    chunk.transparentFaces->erase(texture);
                 }
             }
 
+            assert(chunk.brushCount > 0u);
+            if (--chunk.brushCount == 0u) {
+                // discard the chunk's arrays along with its stale bounds
+                m_chunks.erase(chunkIt);
+            } else {
+                chunk.changed = true;
+            }
+
             m_brushInfo.erase(it);
         }
     }
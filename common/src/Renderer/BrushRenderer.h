@@ -26,6 +26,10 @@
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
 
+#include <vecmath/bbox.h>
+
+#include <array>
+#include <map>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -40,6 +44,8 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class Camera;
+
         class BrushRenderer {
         public:
             class Filter {
@@ -118,7 +124,45 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<Filter> m_filter;
 
+            using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+            using ChunkKey = std::array<int, 3>;
+
+            /**
+             * Brushes are assigned to cubic chunks of this size by the centers of their bounds.
+             */
+            static constexpr float ChunkSize = 1024.0f;
+
+            /**
+             * Every chunk has its own vertex and index arrays, so that chunks outside of the camera's frustum can be
+             * skipped entirely and so that changing a brush only touches the arrays of its chunk.
+             */
+            struct Chunk {
+                std::shared_ptr<BrushVertexArray> vertexArray;
+                std::shared_ptr<BrushIndexArray> edgeIndices;
+                std::shared_ptr<TextureToBrushIndicesMap> transparentFaces;
+                std::shared_ptr<TextureToBrushIndicesMap> opaqueFaces;
+
+                FaceRenderer opaqueFaceRenderer;
+                FaceRenderer transparentFaceRenderer;
+                IndexedEdgeRenderer edgeRenderer;
+
+                /**
+                 * The union of the bounds of the brushes added to this chunk. It does not shrink when brushes are
+                 * removed, but empty chunks are discarded.
+                 */
+                vm::bbox3f bounds;
+                size_t brushCount;
+
+                /**
+                 * Whether brushes were added or removed since the renderers were last created.
+                 */
+                bool changed;
+
+                Chunk();
+            };
+
             struct BrushInfo {
+                ChunkKey chunkKey;
                 AllocationTracker::Block* vertexHolderKey;
                 AllocationTracker::Block* edgeIndicesKey;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> opaqueFaceIndicesKeys;
@@ -139,16 +183,7 @@ namespace TrenchBroom {
             std::unordered_set<const Model::Brush*> m_allBrushes;
             std::unordered_set<const Model::Brush*> m_invalidBrushes;
 
-            std::shared_ptr<BrushVertexArray> m_vertexArray;
-            std::shared_ptr<BrushIndexArray> m_edgeIndices;
-
-            using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
-            std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
-            std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
-
-            FaceRenderer m_opaqueFaceRenderer;
-            FaceRenderer m_transparentFaceRenderer;
-            IndexedEdgeRenderer m_edgeRenderer;
+            std::map<ChunkKey, Chunk> m_chunks;
 
             Color m_faceColor;
             bool m_showEdges;
@@ -195,8 +230,8 @@ namespace TrenchBroom {
              *
              * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the Brush object for modification.
              *
-             * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces, and m_opaqueFaces
-             * maps will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
+             * Additionally, calling `invalidate()` guarantees the m_brushInfo and m_chunks maps will be empty, so the
+             * BrushRenderer will not have any lingering Texture* pointers.
              */
             void invalidate();
             void invalidateBrushes(const std::vector<Model::Brush*>& brushes);
@@ -271,16 +306,32 @@ namespace TrenchBroom {
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
-            void renderOpaqueFaces(RenderBatch& renderBatch);
-            void renderTransparentFaces(RenderBatch& renderBatch);
-            void renderEdges(RenderBatch& renderBatch);
+            void renderOpaqueFaces(Chunk& chunk, RenderBatch& renderBatch);
+            void renderTransparentFaces(Chunk& chunk, RenderBatch& renderBatch);
+            void renderEdges(Chunk& chunk, RenderBatch& renderBatch);
 
+            /**
+             * Returns the chunks whose bounds intersect the given camera's frustum.
+             */
+            std::vector<Chunk*> visibleChunks(const Camera& camera);
         public:
             /**
              * Only exposed for benchmarking.
              */
             void validate();
+
+            /**
+             * Only exposed for testing.
+             */
+            size_t chunkCount() const;
+
+            /**
+             * Returns the bounds of the chunks that would be rendered for the given camera. Only exposed for testing.
+             */
+            std::vector<vm::bbox3f> visibleChunkBounds(const Camera& camera);
         private:
+            static ChunkKey chunkKey(const Model::Brush* brush);
+            Chunk& chunk(const ChunkKey& key);
             bool shouldDrawFaceInTransparentPass(const Model::Brush* brush, const Model::BrushFace* face) const;
             void validateBrush(const Model::Brush* brush);
             void addBrush(const Model::Brush* brush);
@@ -22,6 +22,7 @@
 #include <cassert>
 #include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace TrenchBroom {
     // BrushIndexArray
@@ -30,11 +31,11 @@ namespace TrenchBroom {
 
         // DirtyRangeTracker
 
-        DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity)
-                : m_dirtyPos(0), m_dirtySize(0), m_capacity(initial_capacity) {}
+        DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity, const size_t mergeThreshold)
+                : m_capacity(initial_capacity), m_mergeThreshold(mergeThreshold) {}
 
         DirtyRangeTracker::DirtyRangeTracker()
-                : m_dirtyPos(0), m_dirtySize(0), m_capacity(0) {}
+                : m_capacity(0), m_mergeThreshold(DefaultMergeThreshold) {}
 
         void DirtyRangeTracker::expand(const size_t newcap) {
             if (newcap <= m_capacity) {
@@ -55,24 +56,62 @@ namespace TrenchBroom {
             if (pos + size > m_capacity) {
                 throw std::invalid_argument("markDirty provided range out of bounds");
             }
+            if (size == 0) {
+                return;
+            }
 
-            const size_t newPos = std::min(pos, m_dirtyPos);
-            const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
+            size_t newPos = pos;
+            size_t newEnd = pos + size;
+
+            // the ranges are sorted and their gaps exceed the merge threshold, so the ranges to merge with are consecutive
+            auto first = std::lower_bound(std::begin(m_ranges), std::end(m_ranges), newPos, [&](const Range& range, const size_t p) {
+                return range.pos + range.size + m_mergeThreshold < p;
+            });
+            auto last = first;
+            while (last != std::end(m_ranges) && last->pos <= newEnd + m_mergeThreshold) {
+                newPos = std::min(newPos, last->pos);
+                newEnd = std::max(newEnd, last->pos + last->size);
+                ++last;
+            }
 
-            m_dirtyPos = newPos;
-            m_dirtySize = newEnd - newPos;
+            const auto it = m_ranges.erase(first, last);
+            m_ranges.insert(it, Range{newPos, newEnd - newPos});
         }
 
         bool DirtyRangeTracker::clean() const {
-            return m_dirtySize == 0;
+            return m_ranges.empty();
+        }
+
+        void DirtyRangeTracker::clear() {
+            m_ranges.clear();
+        }
+
+        const std::vector<DirtyRangeTracker::Range>& DirtyRangeTracker::ranges() const {
+            return m_ranges;
+        }
+
+        size_t DirtyRangeTracker::dirtySize() const {
+            size_t result = 0;
+            for (const auto& range : m_ranges) {
+                result += range.size;
+            }
+            return result;
+        }
+
+        size_t DirtyRangeTracker::mergeThreshold() const {
+            return m_mergeThreshold;
+        }
+
+        void DirtyRangeTracker::setMergeThreshold(const size_t mergeThreshold) {
+            m_mergeThreshold = mergeThreshold;
         }
 
         // IndexHolder
 
         IndexHolder::IndexHolder() : VboHolder<Index>(VboType::ElementArrayBuffer) {}
 
-        IndexHolder::IndexHolder(std::vector<Index> &elements)
-                : VboHolder<Index>(elements) {}
+        IndexHolder::IndexHolder(std::vector<Index> &elements, const VboSnapshot snapshotPolicy)
+                : VboHolder<Index>(VboType::ElementArrayBuffer, elements, snapshotPolicy) {}
 
         void IndexHolder::zeroRange(const size_t offsetWithinBlock, const size_t count) {
             Index* dest = getPointerToWriteElementsTo(offsetWithinBlock, count);
@@ -86,8 +125,8 @@ namespace TrenchBroom {
             glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
         }
 
-        std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements) {
-            return std::make_shared<IndexHolder>(elements);
+        std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements, const VboSnapshot snapshotPolicy) {
+            return std::make_shared<IndexHolder>(elements, snapshotPolicy);
         }
 
         VertexArrayInterface::~VertexArrayInterface() {}
@@ -37,15 +37,24 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        struct DirtyRangeTracker {
-            size_t m_dirtyPos;
-            size_t m_dirtySize;
-            size_t m_capacity;
+        /**
+         * Tracks the dirty ranges of a buffer as a sorted set of disjoint intervals. Ranges whose gap is at most the
+         * merge threshold are coalesced, since uploading a few clean elements is cheaper than issuing another upload.
+         */
+        class DirtyRangeTracker {
+        public:
+            using Range = AllocationTracker::Range;
 
+            static const size_t DefaultMergeThreshold = 256;
+        private:
+            std::vector<Range> m_ranges;
+            size_t m_capacity;
+            size_t m_mergeThreshold;
+        public:
             /**
              * New trackers are initially clean.
              */
-            explicit DirtyRangeTracker(size_t initial_capacity);
+            explicit DirtyRangeTracker(size_t initial_capacity, size_t mergeThreshold = DefaultMergeThreshold);
             DirtyRangeTracker();
 
             /**
@@ -55,6 +64,38 @@ namespace TrenchBroom {
             size_t capacity() const;
             void markDirty(size_t pos, size_t size);
             bool clean() const;
+
+            /**
+             * Marks all ranges as clean.
+             */
+            void clear();
+
+            /**
+             * The dirty ranges in ascending order.
+             */
+            const std::vector<Range>& ranges() const;
+
+            /**
+             * The number of elements covered by the dirty ranges.
+             */
+            size_t dirtySize() const;
+
+            size_t mergeThreshold() const;
+            void setMergeThreshold(size_t mergeThreshold);
+        };
+
+        /**
+         * Whether a VboHolder keeps its CPU side copy of the elements after uploading them.
+         */
+        enum class VboSnapshot {
+            /**
+             * Keep the copy so that the elements can be edited and reuploaded.
+             */
+            Keep,
+            /**
+             * Free the copy after the first upload. For static data that is never edited.
+             */
+            Discard
         };
 
         /**
@@ -63,14 +104,15 @@ namespace TrenchBroom {
          * Non-copyable; meant to be held in a std::shared_ptr.
          * Able to be resized, and handles copying edits made in the local std::vector to the VBO.
          *
-         * Currently uses a single range to track the modified region which might upload much more than necessary;
-         * it might be worth mapping the VBO and editing it directly.
+         * Edits are tracked as a set of dirty ranges, and only these ranges are uploaded when the holder is prepared.
          */
         template<typename T>
         class VboHolder {
         protected:
             VboType m_type;
+            VboSnapshot m_snapshotPolicy;
             std::vector<T> m_snapshot;
+            size_t m_size;
             DirtyRangeTracker m_dirtyRange;
             VboManager* m_vboManager;
             Vbo* m_vbo;
@@ -90,20 +132,30 @@ namespace TrenchBroom {
                 }
                 assert(m_vbo == nullptr);
 
-                m_vbo = m_vboManager->allocateVbo(m_type, m_snapshot.size() * sizeof(T), VboUsage::DynamicDraw);
+                const auto usage = m_snapshotPolicy == VboSnapshot::Discard ? VboUsage::StaticDraw : VboUsage::DynamicDraw;
+                m_vbo = m_vboManager->allocateVbo(m_type, m_snapshot.size() * sizeof(T), usage);
                 assert(m_vbo != nullptr);
 
                 m_vbo->writeElements(0, m_snapshot);
 
-                m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
+                m_dirtyRange = DirtyRangeTracker(m_snapshot.size(), m_dirtyRange.mergeThreshold());
                 assert(m_dirtyRange.clean());
                 assert((m_vbo->capacity() / sizeof(T)) == m_dirtyRange.capacity());
+
+                if (m_snapshotPolicy == VboSnapshot::Discard) {
+                    std::vector<T>().swap(m_snapshot);
+                }
             }
 
+            bool hasSnapshot() const {
+                return m_snapshotPolicy == VboSnapshot::Keep || m_vbo == nullptr;
+            }
         public:
             explicit VboHolder(VboType type) :
             m_type(type),
+            m_snapshotPolicy(VboSnapshot::Keep),
             m_snapshot(),
+            m_size(0u),
             m_dirtyRange(0),
             m_vboManager(nullptr),
             m_vbo(nullptr) {}
@@ -111,9 +163,13 @@ namespace TrenchBroom {
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
              */
-            explicit VboHolder(std::vector<T> &elements) :
+            VboHolder(VboType type, std::vector<T> &elements, VboSnapshot snapshotPolicy = VboSnapshot::Keep) :
+            m_type(type),
+            m_snapshotPolicy(snapshotPolicy),
             m_snapshot(),
+            m_size(elements.size()),
             m_dirtyRange(elements.size()),
+            m_vboManager(nullptr),
             m_vbo(nullptr) {
 
                 const size_t elementsCount = elements.size();
@@ -136,11 +192,14 @@ namespace TrenchBroom {
             }
 
             void resize(const size_t newSize) {
+                ensure(hasSnapshot(), "cannot resize a holder whose snapshot was discarded");
                 m_snapshot.resize(newSize);
+                m_size = newSize;
                 m_dirtyRange.expand(newSize);
             }
 
             T* getPointerToWriteElementsTo(const size_t offsetWithinBlock, const size_t elementCount) {
+                ensure(hasSnapshot(), "cannot write to a holder whose snapshot was discarded");
                 assert(offsetWithinBlock + elementCount <= m_snapshot.size());
 
                 // mark dirty range
@@ -149,6 +208,13 @@ namespace TrenchBroom {
                 return m_snapshot.data() + offsetWithinBlock;
             }
 
+            /**
+             * Sets the largest gap, in elements, between two dirty ranges that are uploaded as one.
+             */
+            void setMergeThreshold(const size_t mergeThreshold) {
+                m_dirtyRange.setMergeThreshold(mergeThreshold);
+            }
+
             bool prepared() const {
                 // NOTE: this returns true if the capacity is 0
                 return m_dirtyRange.clean();
@@ -179,27 +245,23 @@ namespace TrenchBroom {
                 }
 
                 // otherwise, it's an incremental update of the dirty ranges.
-
-                if (!m_dirtyRange.clean()) {
-                    const size_t pos = m_dirtyRange.m_dirtyPos;
-                    const size_t size = m_dirtyRange.m_dirtySize;
-
-                    const size_t bytesFromStart = pos * sizeof(T);
+                for (const auto& range : m_dirtyRange.ranges()) {
+                    const size_t bytesFromStart = range.pos * sizeof(T);
                     m_vbo->writeArray(bytesFromStart,
-                                      m_snapshot.data() + pos,
-                                      size);
+                                      m_snapshot.data() + range.pos,
+                                      range.size);
                 }
 
-                m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
+                m_dirtyRange.clear();
                 assert(prepared());
             }
 
             bool empty() const {
-                return m_snapshot.empty();
+                return m_size == 0u;
             }
 
             size_t size() const {
-                return m_snapshot.size();
+                return m_size;
             }
 
             void bindBlock() {
@@ -219,11 +281,11 @@ namespace TrenchBroom {
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
              */
-            explicit IndexHolder(std::vector<Index>& elements);
+            explicit IndexHolder(std::vector<Index>& elements, VboSnapshot snapshotPolicy = VboSnapshot::Keep);
             void zeroRange(size_t offsetWithinBlock, size_t count);
             void render(PrimType primType, size_t offset, size_t count) const;
 
-            static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
+            static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements, VboSnapshot snapshotPolicy = VboSnapshot::Keep);
         };
 
         /**
@@ -281,8 +343,8 @@ namespace TrenchBroom {
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
              */
-            explicit VertexHolder(std::vector<V>& elements)
-                    : VboHolder<V>(elements) {}
+            explicit VertexHolder(std::vector<V>& elements, const VboSnapshot snapshotPolicy = VboSnapshot::Keep)
+                    : VboHolder<V>(VboType::ArrayBuffer, elements, snapshotPolicy) {}
 
             bool setupVertices() override {
                 ensure(VboHolder<V>::m_vbo != nullptr, "block is null");
@@ -300,8 +362,8 @@ namespace TrenchBroom {
                 VboHolder<V>::m_vbo->unbind();
             }
 
-            static std::shared_ptr<VertexHolder<V>> swap(std::vector<V>& elements) {
-                return std::make_shared<VertexHolder<V>>(elements);
+            static std::shared_ptr<VertexHolder<V>> swap(std::vector<V>& elements, const VboSnapshot snapshotPolicy = VboSnapshot::Keep) {
+                return std::make_shared<VertexHolder<V>>(elements, snapshotPolicy);
             }
         };
 
@@ -312,7 +374,7 @@ namespace TrenchBroom {
          */
         class BrushVertexArray {
         private:
-            using Vertex = Renderer::GLVertexTypes::P3NT2::Vertex;
+            using Vertex = Renderer::GLVertexTypes::P3NT3::Vertex;
 
             VertexHolder<Vertex> m_vertexHolder;
             AllocationTracker m_allocationTracker;
@@ -19,6 +19,8 @@
 
 #include "BrushRendererBrushCache.h"
 
+#include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -28,9 +30,21 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        static const Assets::Texture* batchTexture(const Assets::Texture* texture) {
+            if (texture != nullptr && texture->array() != nullptr) {
+                return texture->array()->batchTexture();
+            } else {
+                return texture;
+            }
+        }
+
+        static float textureLayer(const Assets::Texture* texture) {
+            return texture != nullptr ? static_cast<float>(texture->layer()) : 0.0f;
+        }
+
         BrushRendererBrushCache::CachedFace::CachedFace(Model::BrushFace* i_face,
                                                         const size_t i_indexOfFirstVertexRelativeToBrush)
-                : texture(i_face->texture()),
+                : texture(batchTexture(i_face->texture())),
                   face(i_face),
                   vertexCount(i_face->vertexCount()),
                   indexOfFirstVertexRelativeToBrush(i_indexOfFirstVertexRelativeToBrush) {}
@@ -45,21 +59,32 @@ namespace TrenchBroom {
                   vertexIndex2RelativeToBrush(i_vertexIndex2RelativeToBrush) {}
 
         BrushRendererBrushCache::BrushRendererBrushCache()
-                : m_rendererCacheValid(false) {}
+                : m_rendererCacheValid(false),
+                  m_textureCacheValid(false) {}
 
         void BrushRendererBrushCache::invalidateVertexCache() {
             m_rendererCacheValid = false;
+            m_textureCacheValid = false;
             m_cachedVertices.clear();
             m_cachedEdges.clear();
             m_cachedFacesSortedByTexture.clear();
         }
 
+        void BrushRendererBrushCache::invalidateTextureCache() {
+            m_textureCacheValid = false;
+        }
+
         void BrushRendererBrushCache::validateVertexCache(const Model::Brush* brush) {
-            if (m_rendererCacheValid) {
-                return;
+            if (!m_rendererCacheValid) {
+                validateGeometryCache(brush);
             }
+            if (!m_textureCacheValid) {
+                validateTextureCache();
+            }
+        }
 
-            // build vertex cache and face cache
+        void BrushRendererBrushCache::validateGeometryCache(const Model::Brush* brush) {
+            // build vertex cache and face cache, the texture coordinates are filled in by validateTextureCache
 
             m_cachedVertices.clear();
             m_cachedVertices.reserve(brush->vertexCount());
@@ -69,6 +94,7 @@ namespace TrenchBroom {
 
             for (Model::BrushFace* face : brush->faces()) {
                 const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
+                const auto normal = vm::vec3f(face->boundary().normal);
 
                 // The boundary is in CCW order, but the renderer expects CW order:
                 auto& boundary = face->geometry()->boundary();
@@ -83,23 +109,13 @@ namespace TrenchBroom {
                     const auto currentIndex = m_cachedVertices.size();
                     vertex->setPayload(static_cast<GLuint>(currentIndex));
 
-                    const auto& position = vertex->position();
-                    m_cachedVertices.emplace_back(vm::vec3f(position), vm::vec3f(face->boundary().normal), face->textureCoords(position));
-
-                    current = current->previous();
+                    m_cachedVertices.emplace_back(vm::vec3f(vertex->position()), normal, vm::vec3f::zero());
                 }
 
                 // face cache
                 m_cachedFacesSortedByTexture.emplace_back(face, indexOfFirstVertexRelativeToBrush);
             }
 
-            // Sort by texture so BrushRenderer can efficiently step through the BrushFaces
-            // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`), without needing to build an std::map
-
-            std::sort(m_cachedFacesSortedByTexture.begin(),
-                      m_cachedFacesSortedByTexture.end(),
-                      [](const CachedFace& a, const CachedFace& b){ return a.texture < b.texture; });
-
             // Build edge index cache
 
             m_cachedEdges.clear();
@@ -115,20 +131,53 @@ namespace TrenchBroom {
             }
 
             m_rendererCacheValid = true;
+            m_textureCacheValid = false;
         }
 
-        const std::vector<BrushRendererBrushCache::Vertex>& BrushRendererBrushCache::cachedVertices() const {
+        void BrushRendererBrushCache::validateTextureCache() {
             assert(m_rendererCacheValid);
+
+            // The texture axes are scaled once per face, and the face's vertices are visited in the same order as
+            // when the vertex cache was built.
+            for (auto& cachedFace : m_cachedFacesSortedByTexture) {
+                const auto* face = cachedFace.face;
+                const auto projection = face->textureProjection();
+                const auto layer = textureLayer(face->texture());
+
+                auto index = cachedFace.indexOfFirstVertexRelativeToBrush;
+                const auto& boundary = face->geometry()->boundary();
+                for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it) {
+                    const auto& position = (*it)->origin()->position();
+                    auto& vertex = m_cachedVertices[index++];
+                    vertex = Vertex(getVertexComponent<0>(vertex), getVertexComponent<1>(vertex), vm::vec3f(projection.project(position), layer));
+                }
+
+                cachedFace.texture = batchTexture(face->texture());
+            }
+
+            // Sort by texture so BrushRenderer can efficiently step through the BrushFaces
+            // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`), without needing to build an std::map.
+            // Faces whose textures share a texture array have the same batch texture and end up in the same group.
+
+            std::sort(m_cachedFacesSortedByTexture.begin(),
+                      m_cachedFacesSortedByTexture.end(),
+                      [](const CachedFace& a, const CachedFace& b){ return a.texture < b.texture; });
+
+            m_textureCacheValid = true;
+        }
+
+        const std::vector<BrushRendererBrushCache::Vertex>& BrushRendererBrushCache::cachedVertices() const {
+            assert(m_rendererCacheValid && m_textureCacheValid);
             return m_cachedVertices;
         }
 
         const std::vector<BrushRendererBrushCache::CachedFace>& BrushRendererBrushCache::cachedFacesSortedByTexture() const {
-            assert(m_rendererCacheValid);
+            assert(m_rendererCacheValid && m_textureCacheValid);
             return m_cachedFacesSortedByTexture;
         }
 
         const std::vector<BrushRendererBrushCache::CachedEdge>& BrushRendererBrushCache::cachedEdges() const {
-            assert(m_rendererCacheValid);
+            assert(m_rendererCacheValid && m_textureCacheValid);
             return m_cachedEdges;
         }
     }
@@ -37,10 +37,17 @@ namespace TrenchBroom {
     namespace Renderer {
         class BrushRendererBrushCache {
         public:
-            using VertexSpec = Renderer::GLVertexTypes::P3NT2;
+            /**
+             * The third texture coordinate is the layer of the face's texture in its texture array.
+             */
+            using VertexSpec = Renderer::GLVertexTypes::P3NT3;
             using Vertex = VertexSpec::Vertex;
 
             struct CachedFace {
+                /**
+                 * The texture that the face is batched under: the face's texture, or the batch texture of its texture
+                 * array if it has one.
+                 */
                 const Assets::Texture* texture;
                 Model::BrushFace* face;
                 size_t vertexCount;
@@ -66,8 +73,17 @@ namespace TrenchBroom {
             std::vector<Vertex> m_cachedVertices;
             std::vector<CachedEdge> m_cachedEdges;
             std::vector<CachedFace> m_cachedFacesSortedByTexture;
+
+            /**
+             * Whether the vertex positions and normals, the edges and the vertex ranges of the faces are valid.
+             */
             bool m_rendererCacheValid;
 
+            /**
+             * Whether the texture coordinates of the vertices and the textures of the faces are valid.
+             */
+            bool m_textureCacheValid;
+
         public:
             BrushRendererBrushCache();
 
@@ -75,13 +91,20 @@ namespace TrenchBroom {
              * Only exposed to be called by BrushFace
              */
             void invalidateVertexCache();
+
+            /**
+             * Only exposed to be called by BrushFace. Keeps the vertex positions and the edges, so that only the
+             * texture coordinates are recomputed and the faces are regrouped by texture.
+             */
+            void invalidateTextureCache();
+
             /**
              * Call this before cachedVertices()/cachedFacesSortedByTexture()/cachedEdges()
              *
              * NOTE: The reason for having this cache is we often need to re-upload the brush to VBO's when the brush
              * itself hasn't changed, but we're moving it between VBO's for different rendering styles
              * (default/selected/locked), or need to re-evaluate the BrushRenderer::Filter to exclude certain
-             * faces/edges.
+             * faces/edges. None of this state is stored here, so changing it never invalidates the cache.
              */
             void validateVertexCache(const Model::Brush* brush);
 
@@ -91,6 +114,9 @@ namespace TrenchBroom {
             const std::vector<Vertex>& cachedVertices() const;
             const std::vector<CachedFace>& cachedFacesSortedByTexture() const;
             const std::vector<CachedEdge>& cachedEdges() const;
+        private:
+            void validateGeometryCache(const Model::Brush* brush);
+            void validateTextureCache();
         };
     }
 }
@@ -109,6 +109,13 @@ namespace TrenchBroom {
             const vm::mat4x4f verticalBillboardMatrix() const;
             void frustumPlanes(vm::plane3f& topPlane, vm::plane3f& rightPlane, vm::plane3f& bottomPlane, vm::plane3f& leftPlane) const;
 
+            /**
+             * Indicates whether the given box may be visible, i.e., whether it is not entirely outside one of the
+             * frustum's side planes. The near and far planes are not considered. This is conservative: boxes near the
+             * frustum's edges may be reported as visible even if they are not.
+             */
+            bool frustumIntersects(const vm::bbox3f& bounds) const;
+
             vm::ray3f viewRay() const;
             vm::ray3f pickRay(int x, int y) const;
             vm::ray3f pickRay(const vm::vec3f& point) const;
@@ -36,6 +36,7 @@
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
 
@@ -49,6 +50,7 @@ namespace TrenchBroom {
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
+        m_graphValid(false),
         m_valid(false) {}
 
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
@@ -70,6 +72,74 @@ namespace TrenchBroom {
         }
 
         void EntityLinkRenderer::invalidate() {
+            m_graphValid = false;
+            m_valid = false;
+        }
+
+        void EntityLinkRenderer::invalidateNodes(const std::vector<Model::Node*>& nodes) {
+            if (!m_graphValid || !showsAllLinks()) {
+                invalidate();
+                return;
+            }
+
+            // changing a brush moves the link anchors of its entity, and changing a group or layer affects the entities within
+            CollectLinkEntitiesVisitor collectEntities;
+            Model::Node::acceptAndEscalate(std::begin(nodes), std::end(nodes), collectEntities);
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collectEntities);
+
+            for (Model::Node* node : collectEntities.nodes()) {
+                auto* entity = static_cast<Model::Entity*>(node);
+
+                // the sources of the cached links ending at the entity cover the links it had before the change, and its
+                // current link and kill sources cover the links it has now
+                invalidateSource(entity);
+                const auto it = m_sourcesByTarget.find(entity);
+                if (it != std::end(m_sourcesByTarget)) {
+                    m_invalidSources.insert(std::begin(it->second), std::end(it->second));
+                }
+                invalidateSources(entity->linkSources());
+                invalidateSources(entity->killSources());
+            }
+
+            m_valid = false;
+        }
+
+        void EntityLinkRenderer::removeNodes(const std::vector<Model::Node*>& nodes) {
+            if (!m_graphValid || !showsAllLinks()) {
+                invalidate();
+                return;
+            }
+
+            CollectLinkEntitiesVisitor collectEntities;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collectEntities);
+
+            const auto& entities = collectEntities.nodes();
+            for (Model::Node* node : entities) {
+                auto* entity = static_cast<Model::Entity*>(node);
+
+                auto targetIt = m_sourcesByTarget.find(entity);
+                if (targetIt != std::end(m_sourcesByTarget)) {
+                    m_invalidSources.insert(std::begin(targetIt->second), std::end(targetIt->second));
+                    m_sourcesByTarget.erase(targetIt);
+                }
+
+                auto sourceIt = m_linksBySource.find(entity);
+                if (sourceIt != std::end(m_linksBySource)) {
+                    for (Model::AttributableNode* target : sourceIt->second.targets) {
+                        auto it = m_sourcesByTarget.find(target);
+                        if (it != std::end(m_sourcesByTarget)) {
+                            it->second.erase(entity);
+                        }
+                    }
+                    m_linksBySource.erase(sourceIt);
+                }
+            }
+
+            // removed entities must not be revalidated, they are no longer part of the map
+            for (Model::Node* node : entities) {
+                m_invalidSources.erase(static_cast<Model::Entity*>(node));
+            }
+
             m_valid = false;
         }
 
@@ -119,11 +189,30 @@ namespace TrenchBroom {
 
         void EntityLinkRenderer::validate() {
             std::vector<Vertex> links;
-            getLinks(links);
-
-            // build the arrows before destroying `links`
             std::vector<ArrowVertex> arrows;
-            getArrows(arrows, links);
+
+            if (showsAllLinks()) {
+                validateGraph();
+
+                size_t linkCount = 0u;
+                size_t arrowCount = 0u;
+                for (const auto& [source, sourceLinks] : m_linksBySource) {
+                    linkCount += sourceLinks.links.size();
+                    arrowCount += sourceLinks.arrows.size();
+                }
+
+                links.reserve(linkCount);
+                arrows.reserve(arrowCount);
+                for (const auto& [source, sourceLinks] : m_linksBySource) {
+                    links.insert(std::end(links), std::begin(sourceLinks.links), std::end(sourceLinks.links));
+                    arrows.insert(std::end(arrows), std::begin(sourceLinks.arrows), std::end(sourceLinks.arrows));
+                }
+            } else {
+                getLinks(links);
+
+                // build the arrows before destroying `links`
+                getArrows(arrows, links);
+            }
 
             m_entityLinks = VertexArray::move(std::move(links));
             m_entityLinkArrows = VertexArray::move(std::move(arrows));
@@ -131,6 +220,76 @@ namespace TrenchBroom {
             m_valid = true;
         }
 
+        void EntityLinkRenderer::validateGraph() {
+            if (!m_graphValid) {
+                m_linksBySource.clear();
+                m_sourcesByTarget.clear();
+                m_invalidSources.clear();
+
+                auto document = kdl::mem_lock(m_document);
+                Model::World* world = document->world();
+                if (world != nullptr) {
+                    CollectLinkEntitiesVisitor collectEntities;
+                    world->acceptAndRecurse(collectEntities);
+                    for (Model::Node* node : collectEntities.nodes()) {
+                        m_invalidSources.insert(static_cast<Model::Entity*>(node));
+                    }
+                }
+                m_graphValid = true;
+            }
+
+            for (Model::AttributableNode* source : m_invalidSources) {
+                updateSourceLinks(source);
+            }
+            m_invalidSources.clear();
+        }
+
+        void EntityLinkRenderer::updateSourceLinks(Model::AttributableNode* source) {
+            auto& sourceLinks = m_linksBySource[source];
+            for (Model::AttributableNode* target : sourceLinks.targets) {
+                auto it = m_sourcesByTarget.find(target);
+                if (it != std::end(m_sourcesByTarget)) {
+                    it->second.erase(source);
+                    if (it->second.empty()) {
+                        m_sourcesByTarget.erase(it);
+                    }
+                }
+            }
+
+            sourceLinks.targets = kdl::vec_concat(source->linkTargets(), source->killTargets());
+            for (Model::AttributableNode* target : sourceLinks.targets) {
+                m_sourcesByTarget[target].insert(source);
+            }
+
+            if (sourceLinks.targets.empty()) {
+                m_linksBySource.erase(source);
+                return;
+            }
+
+            auto document = kdl::mem_lock(m_document);
+            const Model::EditorContext& editorContext = document->editorContext();
+
+            sourceLinks.links.clear();
+            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, sourceLinks.links);
+            source->accept(collectLinks);
+
+            sourceLinks.arrows.clear();
+            getArrows(sourceLinks.arrows, sourceLinks.links);
+        }
+
+        void EntityLinkRenderer::invalidateSource(Model::AttributableNode* source) {
+            m_invalidSources.insert(source);
+        }
+
+        void EntityLinkRenderer::invalidateSources(const std::vector<Model::AttributableNode*>& sources) {
+            m_invalidSources.insert(std::begin(sources), std::end(sources));
+        }
+
+        bool EntityLinkRenderer::showsAllLinks() const {
+            auto document = kdl::mem_lock(m_document);
+            return document->editorContext().entityLinkMode() == Model::EditorContext::EntityLinkMode_All;
+        }
+
         void EntityLinkRenderer::getArrows(std::vector<ArrowVertex>& arrows, const std::vector<Vertex>& links) {
             assert((links.size() % 2) == 0);
             for (size_t i = 0; i < links.size(); i += 2) {
@@ -179,6 +338,11 @@ namespace TrenchBroom {
 
         class EntityLinkRenderer::CollectEntitiesVisitor : public Model::CollectMatchingNodesVisitor<MatchEntities, Model::UniqueNodeCollectionStrategy> {};
 
+        /**
+         * Collects the entities that can be the source or target of a link without visiting their brushes.
+         */
+        class EntityLinkRenderer::CollectLinkEntitiesVisitor : public Model::CollectMatchingNodesVisitor<MatchEntities, Model::UniqueNodeCollectionStrategy, Model::StopRecursionIfMatched> {};
+
         class EntityLinkRenderer::CollectLinksVisitor : public Model::NodeVisitor {
         protected:
             const Model::EditorContext& m_editorContext;
@@ -308,7 +472,7 @@ namespace TrenchBroom {
             const Model::EditorContext& editorContext = document->editorContext();
             switch (editorContext.entityLinkMode()) {
                 case Model::EditorContext::EntityLinkMode_All:
-                    getAllLinks(links);
+                    // all links are maintained in the link graph, see validateGraph
                     break;
                 case Model::EditorContext::EntityLinkMode_Transitive:
                     getTransitiveSelectedLinks(links);
@@ -322,17 +486,6 @@ namespace TrenchBroom {
             }
         }
 
-        void EntityLinkRenderer::getAllLinks(std::vector<Vertex>& links) const {
-            auto document = kdl::mem_lock(m_document);
-            const Model::EditorContext& editorContext = document->editorContext();
-
-            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
-
-            Model::World* world = document->world();
-            if (world != nullptr)
-                world->acceptAndRecurse(collectLinks);
-        }
-
         void EntityLinkRenderer::getTransitiveSelectedLinks(std::vector<Vertex>& links) const {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
@@ -28,9 +28,16 @@
 #include <vecmath/forward.h>
 
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
+    namespace Model {
+        class AttributableNode;
+        class Node;
+    }
+
     namespace View {
         class MapDocument; // FIXME: Renderer should not depend on View
     }
@@ -57,6 +64,25 @@ namespace TrenchBroom {
             Color m_defaultColor;
             Color m_selectedColor;
 
+            /**
+             * The cached links of a single link source, i.e. one line per link or kill target.
+             */
+            struct SourceLinks {
+                std::vector<Model::AttributableNode*> targets;
+                std::vector<Vertex> links;
+                std::vector<ArrowVertex> arrows;
+            };
+
+            /**
+             * The link graph used when all links are shown. It maps every source to its cached links and every target
+             * to the sources whose cached links end at it, so that changing a node only regenerates the links of the
+             * node itself and of its link neighbours.
+             */
+            std::unordered_map<Model::AttributableNode*, SourceLinks> m_linksBySource;
+            std::unordered_map<Model::AttributableNode*, std::unordered_set<Model::AttributableNode*>> m_sourcesByTarget;
+            std::unordered_set<Model::AttributableNode*> m_invalidSources;
+            bool m_graphValid;
+
             VertexArray m_entityLinks;
             VertexArray m_entityLinkArrows;
 
@@ -69,6 +95,18 @@ namespace TrenchBroom {
 
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+
+            /**
+             * Invalidates the links from and to the entities that contain or are contained in the given nodes. Use this
+             * when nodes were added, changed or their selection state changed.
+             */
+            void invalidateNodes(const std::vector<Model::Node*>& nodes);
+
+            /**
+             * Drops the links of the entities contained in the given nodes, which must already have been removed from
+             * the map, and invalidates the links of their former link sources.
+             */
+            void removeNodes(const std::vector<Model::Node*>& nodes);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
@@ -76,12 +114,18 @@ namespace TrenchBroom {
             void renderArrows(RenderContext& renderContext);
         private:
             void validate();
+            void validateGraph();
+            void updateSourceLinks(Model::AttributableNode* source);
+            void invalidateSource(Model::AttributableNode* source);
+            void invalidateSources(const std::vector<Model::AttributableNode*>& sources);
+            bool showsAllLinks() const;
 
             static void getArrows(std::vector<ArrowVertex>& arrows, const std::vector<Vertex>& links);
             static void addArrow(std::vector<ArrowVertex>& arrows, const vm::vec4f& color, const vm::vec3f& arrowPosition, const vm::vec3f& lineDir);
 
             class MatchEntities;
             class CollectEntitiesVisitor;
+            class CollectLinkEntitiesVisitor;
 
             class CollectLinksVisitor;
             class CollectAllLinksVisitor;
@@ -89,7 +133,6 @@ namespace TrenchBroom {
             class CollectDirectSelectedLinksVisitor;
 
             void getLinks(std::vector<Vertex>& links) const;
-            void getAllLinks(std::vector<Vertex>& links) const;
             void getTransitiveSelectedLinks(std::vector<Vertex>& links) const;
             void getDirectSelectedLinks(std::vector<Vertex>& links) const;
             void collectSelectedLinks(CollectLinksVisitor& collectLinks) const;
@@ -22,6 +22,7 @@
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
 #include "Renderer/ActiveShader.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/Camera.h"
@@ -32,6 +33,8 @@
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Renderer {
         struct FaceRenderer::RenderFunc : public TextureRenderFunc {
@@ -151,58 +154,92 @@ namespace TrenchBroom {
                 return;
 
             if (m_vertexArray->setupVertices()) {
-                ShaderManager& shaderManager = context.shaderManager();
-                ActiveShader shader(shaderManager, Shaders::FaceShader);
-                PreferenceManager& prefs = PreferenceManager::instance();
-
-                const bool applyTexture = context.showTextures();
-                const bool shadeFaces = context.shadeFaces();
-                const bool showFog = context.showFog();
-
                 glAssert(glEnable(GL_TEXTURE_2D));
                 glAssert(glActiveTexture(GL_TEXTURE0));
-                shader.set("Brightness", prefs.get(Preferences::Brightness));
-                shader.set("RenderGrid", context.showGrid());
-                shader.set("GridSize", static_cast<float>(context.gridSize()));
-                shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-                shader.set("ApplyTexture", applyTexture);
-                shader.set("Texture", 0);
-                shader.set("ApplyTinting", m_tint);
-                if (m_tint)
-                    shader.set("TintColor", m_tintColor);
-                shader.set("GrayScale", m_grayscale);
-                shader.set("CameraPosition", context.camera().position());
-                shader.set("ShadeFaces", shadeFaces);
-                shader.set("ShowFog", showFog);
-                shader.set("Alpha", m_alpha);
-                shader.set("EnableMasked", false);
-
-                RenderFunc func(shader, applyTexture, m_faceColor);
+
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_FALSE));
                 }
-                for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
-                    if (!brushIndexHolderPtr->hasValidIndices()) {
-                        continue;
-                    }
-
-                    const bool enableMasked = texture != nullptr && texture->masked();
-                    
-                    // set any per-texture uniforms
-                    shader.set("GridColor", gridColorForTexture(texture));
-                    shader.set("EnableMasked", enableMasked);
-
-                    func.before(texture);
-                    brushIndexHolderPtr->setupIndices();
-                    brushIndexHolderPtr->render(PrimType::Triangles);
-                    brushIndexHolderPtr->cleanupIndices();
-                    func.after(texture);
-                }
+                renderTextures(context);
+                renderTextureArrays(context);
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_TRUE));
                 }
                 m_vertexArray->cleanupVertices();
             }
         }
+
+        void FaceRenderer::setupShader(ActiveShader& shader, RenderContext& context) const {
+            PreferenceManager& prefs = PreferenceManager::instance();
+
+            shader.set("Brightness", prefs.get(Preferences::Brightness));
+            shader.set("RenderGrid", context.showGrid());
+            shader.set("GridSize", static_cast<float>(context.gridSize()));
+            shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
+            shader.set("ApplyTexture", context.showTextures());
+            shader.set("Texture", 0);
+            shader.set("ApplyTinting", m_tint);
+            if (m_tint)
+                shader.set("TintColor", m_tintColor);
+            shader.set("GrayScale", m_grayscale);
+            shader.set("CameraPosition", context.camera().position());
+            shader.set("ShadeFaces", context.shadeFaces());
+            shader.set("ShowFog", context.showFog());
+            shader.set("Alpha", m_alpha);
+            shader.set("EnableMasked", false);
+        }
+
+        void FaceRenderer::renderTextures(RenderContext& context) {
+            ActiveShader shader(context.shaderManager(), Shaders::FaceShader);
+            setupShader(shader, context);
+
+            RenderFunc func(shader, context.showTextures(), m_faceColor);
+            for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
+                if (!brushIndexHolderPtr->hasValidIndices() || (texture != nullptr && texture->array() != nullptr)) {
+                    continue;
+                }
+
+                const bool enableMasked = texture != nullptr && texture->masked();
+
+                // set any per-texture uniforms
+                shader.set("GridColor", gridColorForTexture(texture));
+                shader.set("EnableMasked", enableMasked);
+
+                func.before(texture);
+                brushIndexHolderPtr->setupIndices();
+                brushIndexHolderPtr->render(PrimType::Triangles);
+                brushIndexHolderPtr->cleanupIndices();
+                func.after(texture);
+            }
+        }
+
+        void FaceRenderer::renderTextureArrays(RenderContext& context) {
+            const auto hasTextureArrays = std::any_of(std::begin(*m_indexArrayMap), std::end(*m_indexArrayMap), [](const auto& pair) {
+                return pair.first != nullptr && pair.first->array() != nullptr;
+            });
+            if (!hasTextureArrays) {
+                return;
+            }
+
+            // The grid and face colors are derived from the textures' coarsest mip levels in the shader because the
+            // faces of one batch use different textures.
+            ActiveShader shader(context.shaderManager(), Shaders::FaceArrayShader);
+            setupShader(shader, context);
+
+            for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
+                if (!brushIndexHolderPtr->hasValidIndices() || texture == nullptr || texture->array() == nullptr) {
+                    continue;
+                }
+
+                const auto* textureArray = texture->array();
+                shader.set("EnableMasked", textureArray->masked());
+
+                textureArray->activate();
+                brushIndexHolderPtr->setupIndices();
+                brushIndexHolderPtr->render(PrimType::Triangles);
+                brushIndexHolderPtr->cleanupIndices();
+                textureArray->deactivate();
+            }
+        }
     }
 }
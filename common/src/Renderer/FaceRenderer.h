@@ -35,6 +35,7 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class ActiveShader;
         class BrushIndexArray;
         class BrushVertexArray;
         class RenderBatch;
@@ -70,6 +71,18 @@ namespace TrenchBroom {
         private:
             void prepareVerticesAndIndices(VboManager& vboManager) override;
             void doRender(RenderContext& context) override;
+
+            void setupShader(ActiveShader& shader, RenderContext& context) const;
+
+            /**
+             * Renders the faces whose textures are not stored in a texture array, one draw call per texture.
+             */
+            void renderTextures(RenderContext& context);
+
+            /**
+             * Renders the faces whose textures are stored in texture arrays, one draw call per array.
+             */
+            void renderTextureArrays(RenderContext& context);
         };
 
         void swap(FaceRenderer& left, FaceRenderer& right);
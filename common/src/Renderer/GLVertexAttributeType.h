@@ -308,6 +308,7 @@ namespace TrenchBroom {
             using P3  = GLVertexAttributeType<GLVertexAttributeTypeTag::Position, GL_FLOAT, 3>;
             using N   = GLVertexAttributeType<GLVertexAttributeTypeTag::Normal, GL_FLOAT, 3>;
             using T02 = GLVertexAttributeType<GLVertexAttributeTypeTag::TexCoord0, GL_FLOAT, 2>;
+            using T03 = GLVertexAttributeType<GLVertexAttributeTypeTag::TexCoord0, GL_FLOAT, 3>;
             using T12 = GLVertexAttributeType<GLVertexAttributeTypeTag::TexCoord1, GL_FLOAT, 2>;
             using C4  = GLVertexAttributeType<GLVertexAttributeTypeTag::Color, GL_FLOAT, 4>;
         }
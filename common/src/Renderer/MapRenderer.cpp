@@ -41,6 +41,7 @@
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/vector_utils.h>
 
 #include <set>
 #include <vector>
@@ -394,7 +395,6 @@ namespace TrenchBroom {
                                              collect.lockedNodes().entities(),
                                              collect.lockedNodes().brushes());
             }
-            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::invalidateRenderers(Renderer renderers) {
@@ -488,33 +488,39 @@ namespace TrenchBroom {
             updateRenderers(Renderer_All);
         }
 
-        void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>& nodes) {
             updateRenderers(Renderer_Default);
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
 
-        void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes) {
             updateRenderers(Renderer_Default);
+            m_entityLinkRenderer->removeNodes(nodes);
         }
 
-        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
 
-        void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>& nodes) {
             invalidateRenderers(Renderer_All);
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
 
         void MapRenderer::nodeLockingDidChange(const std::vector<Model::Node*>&) {
             updateRenderers(Renderer_Default_Locked);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::groupWasOpened(Model::Group*) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::groupWasClosed(Model::Group*) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::brushFacesDidChange(const std::vector<Model::BrushFace*>&) {
@@ -524,6 +530,9 @@ namespace TrenchBroom {
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
             updateRenderers(Renderer_All); // need to update locked objects also because a selected object may have been reparented into a locked layer before deselection
 
+            // only the links of entities whose selection state changed need to be recolored
+            m_entityLinkRenderer->invalidateNodes(kdl::vec_concat(selection.selectedNodes(), selection.deselectedNodes()));
+
             // selecting faces needs to invalidate the brushes
             if (!selection.selectedBrushFaces().empty()
                 || !selection.deselectedBrushFaces().empty()) {
@@ -222,6 +222,31 @@ namespace TrenchBroom {
             m_triangleMeshes[TriangleRenderAttributes(color, occlusionPolicy, cullingPolicy)].addTriangleFan(Vertex::toList(positions.size(), std::begin(positions)));
         }
 
+        template <typename VertexSpec>
+        static void addPolygons(IndexRangeMapBuilder<VertexSpec>& builder, const PrimType primType, const std::vector<vm::vec3f>& positions, const std::vector<size_t>& offsets) {
+            assert(!offsets.empty() && offsets.back() == positions.size());
+
+            auto& vertices = builder.vertices();
+            const auto first = vertices.size();
+            vertices.reserve(first + positions.size());
+            for (const auto& position : positions) {
+                vertices.emplace_back(position);
+            }
+
+            for (size_t i = 0; i + 1u < offsets.size(); ++i) {
+                assert(offsets[i + 1u] - offsets[i] >= 3u);
+                builder.indices().add(primType, first + offsets[i], offsets[i + 1u] - offsets[i]);
+            }
+        }
+
+        void PrimitiveRenderer::renderPolygons(const Color& color, const float lineWidth, const PrimitiveRendererOcclusionPolicy occlusionPolicy, const std::vector<vm::vec3f>& positions, const std::vector<size_t>& offsets) {
+            addPolygons(m_lineMeshes[LineRenderAttributes(color, lineWidth, occlusionPolicy)], PrimType::LineLoop, positions, offsets);
+        }
+
+        void PrimitiveRenderer::renderFilledPolygons(const Color& color, const PrimitiveRendererOcclusionPolicy occlusionPolicy, const PrimitiveRendererCullingPolicy cullingPolicy, const std::vector<vm::vec3f>& positions, const std::vector<size_t>& offsets) {
+            addPolygons(m_triangleMeshes[TriangleRenderAttributes(color, occlusionPolicy, cullingPolicy)], PrimType::TriangleFan, positions, offsets);
+        }
+
         void PrimitiveRenderer::renderCylinder(const Color& color, const float radius, const size_t segments, const PrimitiveRendererOcclusionPolicy occlusionPolicy, const PrimitiveRendererCullingPolicy cullingPolicy, const vm::vec3f& start, const vm::vec3f& end) {
             assert(radius > 0.0f);
             assert(segments > 2);
@@ -97,6 +97,13 @@ namespace TrenchBroom {
             void renderPolygon(const Color& color, float lineWidth, PrimitiveRendererOcclusionPolicy occlusionPolicy, const std::vector<vm::vec3f>& positions);
             void renderFilledPolygon(const Color& color, PrimitiveRendererOcclusionPolicy occlusionPolicy, PrimitiveRendererCullingPolicy cullingPolicy, const std::vector<vm::vec3f>& positions);
 
+            /**
+             * Renders the outlines of multiple polygons whose vertices are stored in one array. The i-th polygon
+             * consists of the positions in the range [offsets[i], offsets[i+1]).
+             */
+            void renderPolygons(const Color& color, float lineWidth, PrimitiveRendererOcclusionPolicy occlusionPolicy, const std::vector<vm::vec3f>& positions, const std::vector<size_t>& offsets);
+            void renderFilledPolygons(const Color& color, PrimitiveRendererOcclusionPolicy occlusionPolicy, PrimitiveRendererCullingPolicy cullingPolicy, const std::vector<vm::vec3f>& positions, const std::vector<size_t>& offsets);
+
             void renderCylinder(const Color& color, float radius, size_t segments, PrimitiveRendererOcclusionPolicy occlusionPolicy, PrimitiveRendererCullingPolicy cullingPolicy, const vm::vec3f& start, const vm::vec3f& end);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
@@ -28,6 +28,7 @@ namespace TrenchBroom {
             const ShaderConfig MiniMapEdgeShader          = ShaderConfig("MiniMap Edges",                    { "MiniMapEdge.vertsh" },          { "MiniMapEdge.fragsh" });
             const ShaderConfig EntityModelShader          = ShaderConfig("Entity Model",                     { "EntityModel.vertsh" },          { "EntityModel.fragsh" });
             const ShaderConfig FaceShader                 = ShaderConfig("Face",                             { "Face.vertsh" },                 { "Grid.fragsh", "Face.fragsh" });
+            const ShaderConfig FaceArrayShader            = ShaderConfig("Face Array",                       { "Face.vertsh" },                 { "Grid.fragsh", "FaceArray.fragsh" });
             const ShaderConfig ColoredTextShader          = ShaderConfig("Colored Text",                     { "ColoredText.vertsh" },          { "Text.fragsh" });
             const ShaderConfig TextShader                 = ShaderConfig("Text",                             { "Text.vertsh" },                 { "Text.fragsh" });
             const ShaderConfig TextBackgroundShader       = ShaderConfig("Text Background",                  { "TextBackground.vertsh" },       { "TextBackground.fragsh" });
@@ -20,25 +20,25 @@
 #include "Vbo.h"
 
 #include "Ensure.h"
+#include "Renderer/VboBackend.h"
 
 #include <cassert>
 
 namespace TrenchBroom {
     namespace Renderer {
-        Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage) :
+        Vbo::Vbo(VboBackend& backend, GLenum type, const size_t capacity, const GLenum usage) :
+        m_backend(backend),
         m_type(type),
         m_capacity(capacity) {
             assert(m_type == GL_ELEMENT_ARRAY_BUFFER
                    || m_type == GL_ARRAY_BUFFER);
 
-            glAssert(glGenBuffers(1, &m_bufferId));
-            glAssert(glBindBuffer(m_type, m_bufferId));
-            glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_capacity), nullptr, usage));
+            m_bufferId = m_backend.createBuffer(m_type, m_capacity, usage);
         }
 
         void Vbo::free() {
             assert(m_bufferId != 0);
-            glAssert(glDeleteBuffers(1, &m_bufferId));
+            m_backend.deleteBuffer(m_bufferId);
             m_bufferId = 0;
         }
 
@@ -56,12 +56,17 @@ namespace TrenchBroom {
 
         void Vbo::bind() {
             assert(m_bufferId != 0);
-            glAssert(glBindBuffer(m_type, m_bufferId));
+            m_backend.bindBuffer(m_type, m_bufferId);
         }
 
         void Vbo::unbind() {
             assert(m_bufferId != 0);
-            glAssert(glBindBuffer(m_type, 0));
+            m_backend.bindBuffer(m_type, 0);
+        }
+
+        void Vbo::writeBytes(const size_t address, const void* data, const size_t size) {
+            assert(m_bufferId != 0);
+            m_backend.writeBuffer(m_type, m_bufferId, address, data, size);
         }
     }
 }
@@ -28,6 +28,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        class VboBackend;
+
         /**
          * Wrapper around an OpenGL buffer
          */
@@ -35,6 +37,8 @@ namespace TrenchBroom {
         private:
             friend class VboManager;
 
+            VboBackend& m_backend;
+
             /**
              * e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
              */
@@ -46,7 +50,7 @@ namespace TrenchBroom {
              * Immediately creates and binds to a buffer of the given type and capacity.
              * The contents are initially unspecified.
              */
-            Vbo(GLenum type, size_t capacity, GLenum usage);
+            Vbo(VboBackend& backend, GLenum type, size_t capacity, GLenum usage);
             ~Vbo();
 
             /**
@@ -93,14 +97,11 @@ namespace TrenchBroom {
                 static_assert(std::is_trivially_copyable<T>::value);
                 static_assert(std::is_standard_layout<T>::value);
 
-                const GLvoid* ptr = static_cast<const GLvoid*>(array);
-                const GLintptr offset = static_cast<GLintptr>(address);
-                const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
-                glAssert(glBindBuffer(m_type, m_bufferId));
-                glAssert(glBufferSubData(m_type, offset, sizei, ptr));
-
+                writeBytes(address, static_cast<const void*>(array), size);
                 return size;
             }
+        private:
+            void writeBytes(size_t address, const void* data, size_t size);
         };
     }
 }
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "VboBackend.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        VboBackend::~VboBackend() = default;
+
+        // OpenGLVboBackend
+
+        GLuint OpenGLVboBackend::createBuffer(const GLenum type, const size_t capacity, const GLenum usage) {
+            GLuint bufferId = 0;
+            glAssert(glGenBuffers(1, &bufferId));
+            glAssert(glBindBuffer(type, bufferId));
+            glAssert(glBufferData(type, static_cast<GLsizeiptr>(capacity), nullptr, usage));
+            return bufferId;
+        }
+
+        void OpenGLVboBackend::deleteBuffer(GLuint bufferId) {
+            glAssert(glDeleteBuffers(1, &bufferId));
+        }
+
+        void OpenGLVboBackend::bindBuffer(const GLenum type, const GLuint bufferId) {
+            glAssert(glBindBuffer(type, bufferId));
+        }
+
+        void OpenGLVboBackend::writeBuffer(const GLenum type, const GLuint bufferId, const size_t offset, const void* data, const size_t size) {
+            glAssert(glBindBuffer(type, bufferId));
+            glAssert(glBufferSubData(type, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data));
+        }
+
+        // RecordingVboBackend
+
+        RecordingVboBackend::RecordingVboBackend() :
+        m_nextBufferId(1),
+        m_createdBytes(0u),
+        m_writtenBytes(0u) {}
+
+        GLuint RecordingVboBackend::createBuffer(const GLenum /* type */, const size_t capacity, const GLenum /* usage */) {
+            m_createdBytes += capacity;
+            return m_nextBufferId++;
+        }
+
+        void RecordingVboBackend::deleteBuffer(const GLuint /* bufferId */) {}
+
+        void RecordingVboBackend::bindBuffer(const GLenum /* type */, const GLuint /* bufferId */) {}
+
+        void RecordingVboBackend::writeBuffer(const GLenum /* type */, const GLuint bufferId, const size_t offset, const void* /* data */, const size_t size) {
+            m_writtenBytes += size;
+            m_writes.push_back({ bufferId, offset, size });
+        }
+
+        size_t RecordingVboBackend::createdBytes() const {
+            return m_createdBytes;
+        }
+
+        size_t RecordingVboBackend::writtenBytes() const {
+            return m_writtenBytes;
+        }
+
+        const std::vector<RecordingVboBackend::Write>& RecordingVboBackend::writes() const {
+            return m_writes;
+        }
+
+        void RecordingVboBackend::reset() {
+            m_createdBytes = 0u;
+            m_writtenBytes = 0u;
+            m_writes.clear();
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_VboBackend
+#define TrenchBroom_VboBackend
+
+#include "Renderer/GL.h"
+
+#include <cstddef> // for size_t
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         * The buffer object calls made by Vbo. The OpenGL backend forwards them to the current context, the recording
+         * backend only records them so that uploads can be inspected without a context.
+         */
+        class VboBackend {
+        public:
+            virtual ~VboBackend();
+
+            /**
+             * Creates and binds a buffer of the given type and capacity and returns its name.
+             */
+            virtual GLuint createBuffer(GLenum type, size_t capacity, GLenum usage) = 0;
+            virtual void deleteBuffer(GLuint bufferId) = 0;
+            virtual void bindBuffer(GLenum type, GLuint bufferId) = 0;
+
+            /**
+             * Binds the given buffer and writes the given number of bytes at the given byte offset.
+             */
+            virtual void writeBuffer(GLenum type, GLuint bufferId, size_t offset, const void* data, size_t size) = 0;
+        };
+
+        class OpenGLVboBackend : public VboBackend {
+        public:
+            GLuint createBuffer(GLenum type, size_t capacity, GLenum usage) override;
+            void deleteBuffer(GLuint bufferId) override;
+            void bindBuffer(GLenum type, GLuint bufferId) override;
+            void writeBuffer(GLenum type, GLuint bufferId, size_t offset, const void* data, size_t size) override;
+        };
+
+        /**
+         * Records the buffer calls instead of executing them, for headless tests and benchmarks.
+         */
+        class RecordingVboBackend : public VboBackend {
+        public:
+            struct Write {
+                GLuint bufferId;
+                size_t offset;
+                size_t size;
+            };
+        private:
+            GLuint m_nextBufferId;
+            size_t m_createdBytes;
+            size_t m_writtenBytes;
+            std::vector<Write> m_writes;
+        public:
+            RecordingVboBackend();
+
+            GLuint createBuffer(GLenum type, size_t capacity, GLenum usage) override;
+            void deleteBuffer(GLuint bufferId) override;
+            void bindBuffer(GLenum type, GLuint bufferId) override;
+            void writeBuffer(GLenum type, GLuint bufferId, size_t offset, const void* data, size_t size) override;
+
+            /**
+             * The total capacity of all buffers created so far.
+             */
+            size_t createdBytes() const;
+
+            /**
+             * The total number of bytes written to buffers so far.
+             */
+            size_t writtenBytes() const;
+            const std::vector<Write>& writes() const;
+
+            /**
+             * Forgets all recorded writes and resets the byte counters.
+             */
+            void reset();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_VboBackend) */
@@ -20,6 +20,7 @@
 #include "VboManager.h"
 
 #include "Vbo.h"
+#include "VboBackend.h"
 #include "GL.h"
 #include "Macros.h"
 
@@ -53,12 +54,18 @@ namespace TrenchBroom {
         // VboManager
 
         VboManager::VboManager() :
+        VboManager(std::make_unique<OpenGLVboBackend>()) {}
+
+        VboManager::VboManager(std::unique_ptr<VboBackend> backend) :
+        m_backend(std::move(backend)),
         m_peakVboCount(0u),
         m_currentVboCount(0u),
         m_currentVboSize(0u) {}
 
+        VboManager::~VboManager() = default;
+
         Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage) {
-            auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
+            auto* result = new Vbo(*m_backend, typeToOpenGL(type), capacity, usageToOpenGL(usage));
 
             m_currentVboSize += capacity;
             m_currentVboCount++;
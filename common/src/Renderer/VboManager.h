@@ -23,10 +23,12 @@
 #include "Renderer/GL.h"
 
 #include <cstddef> // for size_t
+#include <memory>
 
 namespace TrenchBroom {
     namespace Renderer {
         class Vbo;
+        class VboBackend;
 
         enum class VboType {
             ArrayBuffer,
@@ -40,11 +42,22 @@ namespace TrenchBroom {
 
         class VboManager {
         private:
+            std::unique_ptr<VboBackend> m_backend;
             size_t m_peakVboCount;
             size_t m_currentVboCount;
             size_t m_currentVboSize;
         public:
+            /**
+             * Creates a manager whose buffers are backed by the current OpenGL context.
+             */
             VboManager();
+
+            /**
+             * Creates a manager whose buffers use the given backend, e.g. a RecordingVboBackend in headless tests.
+             */
+            explicit VboManager(std::unique_ptr<VboBackend> backend);
+            ~VboManager();
+
             /**
             * Immediately creates and binds to an OpenGL buffer of the given type and capacity.
             * The contents are initially unspecified. See Vbo class.
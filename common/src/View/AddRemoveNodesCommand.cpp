@@ -21,7 +21,13 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/Brush.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
 #include "Model/Node.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
 #include "View/MapDocumentCommandFacade.h"
 
 #include <kdl/map_utils.h>
@@ -116,5 +122,33 @@ namespace TrenchBroom {
         bool AddRemoveNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        class EstimateMemoryUsageVisitor : public Model::ConstNodeVisitor {
+        private:
+            size_t m_result = 0u;
+        public:
+            size_t result() const { return m_result; }
+        private:
+            void doVisit(const Model::World*) override   { m_result += sizeof(Model::World); }
+            void doVisit(const Model::Layer*) override   { m_result += sizeof(Model::Layer); }
+            void doVisit(const Model::Group*) override   { m_result += sizeof(Model::Group); }
+            void doVisit(const Model::Entity* entity) override {
+                m_result += sizeof(Model::Entity);
+                for (const auto& attribute : entity->attributes()) {
+                    m_result += sizeof(Model::EntityAttribute) + attribute.name().capacity() + attribute.value().capacity();
+                }
+            }
+            void doVisit(const Model::Brush* brush) override { m_result += brush->memoryUsage(); }
+        };
+
+        size_t AddRemoveNodesCommand::doGetMemoryUsage() const {
+            // only the nodes to add are owned by this command, the nodes to remove are part of the document
+            EstimateMemoryUsageVisitor visitor;
+            for (const auto& entry : m_nodesToAdd) {
+                const auto& children = entry.second;
+                Model::Node::acceptAndRecurse(std::begin(children), std::end(children), visitor);
+            }
+            return sizeof(AddRemoveNodesCommand) + visitor.result();
+        }
     }
 }
@@ -28,6 +28,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef> // for std::ptrdiff_t
+#include <iterator>
 #include <vector>
 
 #include <QVariant>
@@ -410,6 +412,35 @@ namespace TrenchBroom {
                 }
             }
 
+            /**
+             * Removes the cells starting with the cell at the given index. The cells before it keep their bounds.
+             */
+            void removeCellsFrom(const size_t cellIndex) {
+                size_t rowIndex = 0;
+                size_t firstCellIndex = 0;
+                while (rowIndex < m_rows.size() && cellIndex >= firstCellIndex + m_rows[rowIndex].size()) {
+                    firstCellIndex += m_rows[rowIndex].size();
+                    ++rowIndex;
+                }
+
+                if (rowIndex == m_rows.size())
+                    return;
+
+                // the row that contains the first removed cell is rebuilt from the cells that remain in it
+                const std::vector<LayoutCell>& rowCells = m_rows[rowIndex].cells();
+                const std::vector<LayoutCell> keptCells(std::begin(rowCells), std::next(std::begin(rowCells), static_cast<std::ptrdiff_t>(cellIndex - firstCellIndex)));
+
+                m_rows.erase(std::next(std::begin(m_rows), static_cast<std::ptrdiff_t>(rowIndex)), std::end(m_rows));
+                const float contentHeight = m_rows.empty() ? 0.0f : m_rows.back().bounds().bottom() - m_contentBounds.top();
+                m_contentBounds = LayoutBounds(m_contentBounds.left(), m_contentBounds.top(), m_contentBounds.width(), contentHeight);
+
+                for (const LayoutCell& cell : keptCells) {
+                    const LayoutBounds& itemBounds = cell.itemBounds();
+                    const LayoutBounds& titleBounds = cell.titleBounds();
+                    addItem(cell.item(), itemBounds.width() / cell.scale(), itemBounds.height() / cell.scale(), titleBounds.width(), titleBounds.height());
+                }
+            }
+
             size_t indexOfRowAt(const float y) const {
                 for (size_t i = 0; i < m_rows.size(); ++i) {
                     const Row& row = m_rows[i];
@@ -630,6 +661,46 @@ namespace TrenchBroom {
                 m_height += (newGroupHeight - oldGroupHeight);
             }
 
+            /**
+             * Removes the group at the given index and all groups following it.
+             */
+            void removeGroupsFrom(const size_t groupIndex) {
+                if (!m_valid)
+                    validate();
+
+                if (groupIndex == 0) {
+                    m_groups.clear();
+                    m_height = 2.0f * m_outerMargin;
+                    return;
+                }
+
+                while (m_groups.size() > groupIndex) {
+                    m_height -= m_groups.back().bounds().height() + m_groupMargin;
+                    m_groups.pop_back();
+                }
+            }
+
+            /**
+             * Removes the cells of the group at the given index starting with the cell at the given index, and all
+             * groups following that group. The remaining cells keep their bounds, so that items can be added again
+             * in a different order without laying out the entire layout again.
+             */
+            void removeCellsFrom(const size_t groupIndex, const size_t cellIndex) {
+                if (!m_valid)
+                    validate();
+
+                if (groupIndex >= m_groups.size())
+                    return;
+
+                removeGroupsFrom(groupIndex + 1);
+
+                const float oldGroupHeight = m_groups.back().bounds().height();
+                m_groups.back().removeCellsFrom(cellIndex);
+                const float newGroupHeight = m_groups.back().bounds().height();
+
+                m_height += (newGroupHeight - oldGroupHeight);
+            }
+
             void clear() {
                 m_groups.clear();
                 invalidate();
@@ -78,6 +78,16 @@ namespace TrenchBroom {
             m_valid = false;
         }
 
+        void CellView::patchLayout() {
+            if (!m_valid)
+                return;
+
+            if (doPatchLayout(m_layout))
+                updateScrollBar();
+            else
+                invalidate();
+        }
+
         void CellView::clear() {
             m_layout.clear();
             doClear();
@@ -282,6 +292,7 @@ namespace TrenchBroom {
             glAssert(glShadeModel(GL_SMOOTH))
         }
 
+        bool CellView::doPatchLayout(Layout& /* layout */) { return false; }
         void CellView::doClear() {}
         void CellView::doLeftClick(Layout& /* layout */, float /* x */, float /* y */) {}
         void CellView::doContextMenu(Layout& /* layout */, float /* x */, float /* y */, QContextMenuEvent* /* event */) {}
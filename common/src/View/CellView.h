@@ -58,6 +58,12 @@ namespace TrenchBroom {
         public:
             explicit CellView(GLContextManager& contextManager, QScrollBar* scrollBar = nullptr);
             void invalidate();
+
+            /**
+             * Lets the subclass update the current layout in place instead of reloading it. If the layout is not
+             * valid, nothing happens because it will be reloaded before it is rendered anyway.
+             */
+            void patchLayout();
             void clear();
             void resizeEvent(QResizeEvent* event) override;
         private:
@@ -81,6 +87,12 @@ namespace TrenchBroom {
 
             virtual void doInitLayout(Layout& layout) = 0;
             virtual void doReloadLayout(Layout& layout) = 0;
+
+            /**
+             * Updates the given layout in place. Returns false if the layout could not be updated and must be reloaded.
+             * The default implementation always returns false.
+             */
+            virtual bool doPatchLayout(Layout& layout);
             virtual void doClear();
             virtual void doRender(Layout& layout, float y, float height) = 0;
             virtual void doLeftClick(Layout& layout, float x, float y);
@@ -71,5 +71,9 @@ namespace TrenchBroom {
             ChangeBrushFaceAttributesCommand* other = static_cast<ChangeBrushFaceAttributesCommand*>(command);
             return m_request.collateWith(other->m_request);
         }
+
+        size_t ChangeBrushFaceAttributesCommand::doGetMemoryUsage() const {
+            return sizeof(ChangeBrushFaceAttributesCommand) + (m_snapshot != nullptr ? m_snapshot->memoryUsage() : 0u);
+        }
     }
 }
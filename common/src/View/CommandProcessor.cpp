@@ -142,6 +142,20 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemoryUsage() const override {
+                auto result = sizeof(TransactionCommand);
+                for (const auto& command : m_commands) {
+                    result += command->memoryUsage();
+                }
+                return result;
+            }
+
+            void doCompact() override {
+                for (auto& command : m_commands) {
+                    command->compact();
+                }
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -149,6 +163,10 @@ namespace TrenchBroom {
         CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval) :
         m_document(document),
         m_collationInterval(collationInterval),
+        m_undoStackMemoryUsage(0u),
+        m_redoStackMemoryUsage(0u),
+        m_memoryBudget(0u),
+        m_compactedCommandCount(0u),
         m_lastCommandTimestamp(std::chrono::time_point<std::chrono::system_clock>()) {}
 
         CommandProcessor::~CommandProcessor() = default;
@@ -177,6 +195,21 @@ namespace TrenchBroom {
             }
         }
 
+        size_t CommandProcessor::memoryUsage() const {
+            return m_undoStackMemoryUsage + m_redoStackMemoryUsage;
+        }
+
+        size_t CommandProcessor::memoryBudget() const {
+            return m_memoryBudget;
+        }
+
+        void CommandProcessor::setMemoryBudget(const size_t memoryBudget) {
+            m_memoryBudget = memoryBudget;
+            if (m_transactionStack.empty()) {
+                applyMemoryBudget();
+            }
+        }
+
         void CommandProcessor::startTransaction(const std::string& name) {
             m_transactionStack.push_back(TransactionState(name));
         }
@@ -204,8 +237,8 @@ namespace TrenchBroom {
         std::unique_ptr<CommandResult> CommandProcessor::execute(std::unique_ptr<Command> command) {
             auto result = executeCommand(command.get());
             if (result->success()) {
-                m_undoStack.clear();
-                m_redoStack.clear();
+                clearUndoStack();
+                clearRedoStack();
             }
             return result;
         }
@@ -279,8 +312,8 @@ namespace TrenchBroom {
             assert(m_transactionStack.empty());
 
             clearRepeatStack();
-            m_undoStack.clear();
-            m_redoStack.clear();
+            clearUndoStack();
+            clearRedoStack();
             m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
         }
 
@@ -291,7 +324,7 @@ namespace TrenchBroom {
             }
 
             const auto commandStored = storeCommand(std::move(command), collate, repeatable);
-            m_redoStack.clear();
+            clearRedoStack();
             return SubmitAndStoreResult(std::move(commandResult), commandStored);
         }
 
@@ -379,6 +412,11 @@ namespace TrenchBroom {
             if (collatable(collate, timestamp)) {
                 auto& lastCommand = m_undoStack.back();
                 if (lastCommand->collateWith(command.get())) {
+                    // the topmost command has absorbed the given command, so its estimate must be updated
+                    auto& lastUsage = m_undoStackMemoryUsages.back();
+                    m_undoStackMemoryUsage -= lastUsage;
+                    lastUsage = lastCommand->memoryUsage();
+                    m_undoStackMemoryUsage += lastUsage;
                     return false;
                 }
             }
@@ -387,7 +425,12 @@ namespace TrenchBroom {
                 pushToRepeatStack(command.get());
             }
 
+            const auto usage = command->memoryUsage();
             m_undoStack.push_back(std::move(command));
+            m_undoStackMemoryUsages.push_back(usage);
+            m_undoStackMemoryUsage += usage;
+
+            applyMemoryBudget();
             return true;
         }
 
@@ -396,26 +439,81 @@ namespace TrenchBroom {
             assert(!m_undoStack.empty());
 
             auto lastCommand = kdl::vec_pop_back(m_undoStack);
+            m_undoStackMemoryUsage -= kdl::vec_pop_back(m_undoStackMemoryUsages);
             popFromRepeatStack(lastCommand.get());
+
+            // the command takes a new snapshot if it is redone
+            m_compactedCommandCount = std::min(m_compactedCommandCount, m_undoStack.size());
             return lastCommand;
         }
 
+        void CommandProcessor::applyMemoryBudget() {
+            assert(m_transactionStack.empty());
+
+            if (m_memoryBudget == 0u || m_undoStack.size() < 2u) {
+                return;
+            }
+
+            while (m_undoStackMemoryUsage > m_memoryBudget && m_compactedCommandCount < m_undoStack.size() - 1u) {
+                auto& command = m_undoStack[m_compactedCommandCount];
+                auto& usage = m_undoStackMemoryUsages[m_compactedCommandCount];
+                ++m_compactedCommandCount;
+
+                command->compact();
+                m_undoStackMemoryUsage -= usage;
+                usage = command->memoryUsage();
+                m_undoStackMemoryUsage += usage;
+            }
+
+            size_t dropCount = 0u;
+            while (m_undoStackMemoryUsage > m_memoryBudget && m_undoStack.size() - dropCount > 1u) {
+                kdl::vec_erase(m_repeatStack, m_undoStack[dropCount].get());
+                m_undoStackMemoryUsage -= m_undoStackMemoryUsages[dropCount];
+                ++dropCount;
+            }
+
+            if (dropCount > 0u) {
+                const auto dropCountDiff = static_cast<std::ptrdiff_t>(dropCount);
+                m_undoStack.erase(std::begin(m_undoStack), std::next(std::begin(m_undoStack), dropCountDiff));
+                m_undoStackMemoryUsages.erase(std::begin(m_undoStackMemoryUsages), std::next(std::begin(m_undoStackMemoryUsages), dropCountDiff));
+                m_compactedCommandCount -= std::min(m_compactedCommandCount, dropCount);
+            }
+        }
+
         bool CommandProcessor::collatable(const bool collate, const std::chrono::system_clock::time_point timestamp) const {
             return collate && !m_undoStack.empty() && timestamp - m_lastCommandTimestamp <= m_collationInterval;
         }
 
         void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command) {
             assert(m_transactionStack.empty());
+
+            const auto usage = command->memoryUsage();
             m_redoStack.push_back(std::move(command));
+            m_redoStackMemoryUsages.push_back(usage);
+            m_redoStackMemoryUsage += usage;
         }
 
         std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack() {
             assert(m_transactionStack.empty());
             assert(!m_redoStack.empty());
 
+            m_redoStackMemoryUsage -= kdl::vec_pop_back(m_redoStackMemoryUsages);
             return kdl::vec_pop_back(m_redoStack);
         }
 
+        void CommandProcessor::clearUndoStack() {
+            m_undoStack.clear();
+            m_undoStackMemoryUsages.clear();
+            m_undoStackMemoryUsage = 0u;
+            m_compactedCommandCount = 0u;
+        }
+
+        void CommandProcessor::clearRedoStack() {
+            m_redoStack.clear();
+            m_redoStackMemoryUsages.clear();
+            m_redoStackMemoryUsage = 0u;
+        }
+
         void CommandProcessor::pushToRepeatStack(UndoableCommand* command) {
             if (command->isRepeatDelimiter()) {
                 return;
@@ -50,6 +50,14 @@ namespace TrenchBroom {
          *
          * The command processor supports nested transactions. Each transaction can be committed or rolled back
          * individually. Committing a nested transaction adds it as a command to the containing transaction.
+         *
+         * The memory held by the undo stack can be limited by a budget. If the undo stack exceeds the budget after a
+         * command was stored, then its oldest commands are compacted, which makes undoing them slower. Only if that
+         * is not enough, the oldest commands are discarded. The most recent command is always kept intact.
+         *
+         * The memory held by a command is estimated once when it is stored on either stack, and again when it is
+         * compacted or collated with another command. The command processor keeps running totals of these estimates,
+         * so querying the memory usage does not visit the stored commands.
          */
         class CommandProcessor {
         private:
@@ -75,6 +83,36 @@ namespace TrenchBroom {
              */
             std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+            /**
+             * The estimated number of bytes held by each command on the undo stack, in the same order as the undo stack.
+             */
+            std::vector<size_t> m_undoStackMemoryUsages;
+
+            /**
+             * The estimated number of bytes held by each command on the redo stack, in the same order as the redo stack.
+             */
+            std::vector<size_t> m_redoStackMemoryUsages;
+
+            /**
+             * The sum of the estimates in m_undoStackMemoryUsages.
+             */
+            size_t m_undoStackMemoryUsage;
+
+            /**
+             * The sum of the estimates in m_redoStackMemoryUsages.
+             */
+            size_t m_redoStackMemoryUsage;
+
+            /**
+             * The maximum number of bytes that the commands on the undo stack should hold, or 0 if unlimited.
+             */
+            size_t m_memoryBudget;
+
+            /**
+             * The number of commands at the beginning of the undo stack that have been compacted.
+             */
+            size_t m_compactedCommandCount;
+
             /**
              * Holds the commands that can be repeated. The commands referenced here are owned by the undo or redo stack.
              * Updates to the undo or redo stacks take care to erase stale pointers from the repeat stack as needed.
@@ -167,6 +205,23 @@ namespace TrenchBroom {
              */
             const std::string& redoCommandName() const;
 
+            /**
+             * Returns an estimate of the number of bytes held by the commands on the undo and redo stacks.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * Returns the maximum number of bytes that the commands on the undo stack should hold, or 0 if the undo
+             * stack is not limited.
+             */
+            size_t memoryBudget() const;
+
+            /**
+             * Sets the maximum number of bytes that the commands on the undo stack should hold and applies it to the
+             * current undo stack. Pass 0 to remove the limit.
+             */
+            void setMemoryBudget(size_t memoryBudget);
+
             /**
              * Starts a new transaction. If a transaction is currently executing, then the newly started transaction
              * becomes a nested transaction and will be added as a command to its parent transaction upon commit.
@@ -394,6 +449,12 @@ namespace TrenchBroom {
              */
             std::unique_ptr<UndoableCommand> popFromUndoStack();
 
+            /**
+             * Compacts and, as a last resort, discards the oldest commands on the undo stack until the commands on
+             * the undo stack hold no more than the memory budget. The topmost command is left as it is.
+             */
+            void applyMemoryBudget();
+
             bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
             /**
@@ -412,6 +473,16 @@ namespace TrenchBroom {
              */
             std::unique_ptr<UndoableCommand> popFromRedoStack();
 
+            /**
+             * Deletes all commands on the undo stack.
+             */
+            void clearUndoStack();
+
+            /**
+             * Deletes all commands on the redo stack.
+             */
+            void clearRedoStack();
+
             /**
              * Pushes the given command onto the repeat stack unless it is a repeat delimiter.
              *
@@ -20,8 +20,11 @@
 #include "CompilationRun.h"
 
 #include "Ensure.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "EL/EvaluationContext.h"
 #include "EL/Interpolator.h"
+#include "IO/Path.h"
 #include "Model/CompilationProfile.h"
 #include "Model/Game.h"
 #include "View/CompilationContext.h"
@@ -30,9 +33,12 @@
 #include "View/MapDocument.h"
 #include "View/TextOutputAdapter.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
+#include <QThread>
+
 namespace TrenchBroom {
     namespace View {
         CompilationRun::CompilationRun() :
@@ -75,10 +81,17 @@ namespace TrenchBroom {
             assert(!doIsRunning());
             cleanup();
 
-            CompilationVariables variables(document, buildWorkDir(profile, document));
+            const auto workDir = buildWorkDir(profile, document);
+            CompilationVariables variables(document, workDir);
+
+            const auto jobLimit = pref(Preferences::CompilationJobLimit);
+            const auto jobs = jobLimit > 0 ? static_cast<size_t>(jobLimit) : static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+
+            // the hashes of the tasks' inputs are kept next to the compiled files
+            const auto statePath = workDir.empty() ? IO::Path() : IO::Path(workDir) + IO::Path(document->path().lastComponent().deleteExtension().asString() + ".tbcompile");
 
             auto compilationContext = std::make_unique<CompilationContext>(document, variables, TextOutputAdapter(currentOutput), test);
-            m_currentRun = std::make_unique<CompilationRunner>(std::move(compilationContext), profile);
+            m_currentRun = std::make_unique<CompilationRunner>(std::move(compilationContext), profile, jobs, statePath);
             connect(m_currentRun.get(), &CompilationRunner::compilationStarted, this, &CompilationRun::compilationStarted);
             connect(m_currentRun.get(), &CompilationRunner::compilationEnded, this, &CompilationRun::compilationEnded);
             m_currentRun->execute();
@@ -20,6 +20,7 @@
 #include "CompilationRunner.h"
 
 #include "Exceptions.h"
+#include "Macros.h"
 #include "IO/DiskIO.h"
 #include "IO/FileMatcher.h"
 #include "IO/Path.h"
@@ -29,6 +30,7 @@
 #include "View/CompilationVariables.h"
 #include "View/MapDocument.h"
 
+#include <algorithm>
 #include <string>
 
 #include <QtGlobal>
@@ -49,6 +51,30 @@ namespace TrenchBroom {
             doTerminate();
         }
 
+        CompilationTaskFiles CompilationTaskRunner::files() {
+            return doGetFiles();
+        }
+
+        std::string CompilationTaskRunner::signature() {
+            return doGetSignature();
+        }
+
+        bool CompilationTaskRunner::outputsChanged() const {
+            return doGetOutputsChanged();
+        }
+
+        bool CompilationTaskRunner::succeeded() const {
+            return doGetSucceeded();
+        }
+
+        bool CompilationTaskRunner::doGetOutputsChanged() const {
+            return true;
+        }
+
+        bool CompilationTaskRunner::doGetSucceeded() const {
+            return true;
+        }
+
         std::string CompilationTaskRunner::interpolate(const std::string& spec) {
             try {
                 return m_context.interpolate(spec);
@@ -58,14 +84,30 @@ namespace TrenchBroom {
             }
         }
 
+        IO::Path CompilationTaskRunner::workDir() const {
+            try {
+                return IO::Path(m_context.variableValue(CompilationVariableNames::WORK_DIR_PATH));
+            } catch (const Exception&) {
+                return IO::Path();
+            }
+        }
+
+        IO::Path CompilationTaskRunner::interpolatePath(const std::string& spec) {
+            const auto path = IO::Path(interpolate(spec));
+            const auto workDir = this->workDir();
+            return path.isEmpty() || path.isAbsolute() || workDir.isEmpty() ? path : workDir + path;
+        }
+
         CompilationExportMapTaskRunner::CompilationExportMapTaskRunner(CompilationContext& context, const Model::CompilationExportMap& task) :
         CompilationTaskRunner(context),
-        m_task(task.clone()) {}
+        m_task(task.clone()),
+        m_outputsChanged(true) {}
 
         CompilationExportMapTaskRunner::~CompilationExportMapTaskRunner() = default;
 
         void CompilationExportMapTaskRunner::doExecute() {
             emit start();
+            m_outputsChanged = true;
 
             try {
                 const IO::Path targetPath(interpolate(m_task->targetSpec()));
@@ -78,8 +120,35 @@ namespace TrenchBroom {
                             IO::Disk::createDirectory(directoryPath);
                         }
 
+                        // the map is exported to a temporary file first so that an unchanged map file is left alone and
+                        // the tasks that read it can be skipped
                         const auto document = m_context.document();
-                        document->saveDocumentTo(targetPath);
+                        const auto exportPath = targetPath.addExtension("tmp");
+                        switch (m_task->scope()) {
+                            case Model::CompilationExportMap::Scope::Map:
+                                document->saveDocumentTo(exportPath);
+                                break;
+                            case Model::CompilationExportMap::Scope::VisibleLayers:
+                                m_context << "#### Exporting visible layers only\n";
+                                document->exportVisibleLayersTo(exportPath);
+                                break;
+                            case Model::CompilationExportMap::Scope::Selection:
+                                if (!document->hasSelectedNodes()) {
+                                    throw Exception("Nothing is selected, the selection bounds define the exported region");
+                                }
+                                m_context << "#### Exporting selection bounds only\n";
+                                document->exportSelectionRegionTo(m_task->sealTexture(), exportPath);
+                                break;
+                            switchDefault()
+                        }
+
+                        if (IO::Disk::fileExists(targetPath) && IO::Disk::readFile(targetPath) == IO::Disk::readFile(exportPath)) {
+                            IO::Disk::deleteFile(exportPath);
+                            m_outputsChanged = false;
+                            m_context << "#### Map file is unchanged\n";
+                        } else {
+                            IO::Disk::moveFile(exportPath, targetPath, true);
+                        }
                     }
                     emit end();
                 } catch (const Exception& e) {
@@ -94,6 +163,18 @@ namespace TrenchBroom {
 
         void CompilationExportMapTaskRunner::doTerminate() {}
 
+        CompilationTaskFiles CompilationExportMapTaskRunner::doGetFiles() {
+            return CompilationTaskFiles{ true, {}, { interpolatePath(m_task->targetSpec()) } };
+        }
+
+        std::string CompilationExportMapTaskRunner::doGetSignature() {
+            return "export " + interpolate(m_task->targetSpec());
+        }
+
+        bool CompilationExportMapTaskRunner::doGetOutputsChanged() const {
+            return m_outputsChanged;
+        }
+
         CompilationCopyFilesTaskRunner::CompilationCopyFilesTaskRunner(CompilationContext& context, const Model::CompilationCopyFiles& task) :
         CompilationTaskRunner(context),
         m_task(task.clone()) {}
@@ -127,11 +208,20 @@ namespace TrenchBroom {
 
         void CompilationCopyFilesTaskRunner::doTerminate() {}
 
+        CompilationTaskFiles CompilationCopyFilesTaskRunner::doGetFiles() {
+            return CompilationTaskFiles{ true, { interpolatePath(m_task->sourceSpec()) }, { interpolatePath(m_task->targetSpec()) } };
+        }
+
+        std::string CompilationCopyFilesTaskRunner::doGetSignature() {
+            return "copy " + interpolate(m_task->sourceSpec()) + " to " + interpolate(m_task->targetSpec());
+        }
+
         CompilationRunToolTaskRunner::CompilationRunToolTaskRunner(CompilationContext& context, const Model::CompilationRunTool& task) :
         CompilationTaskRunner(context),
         m_task(task.clone()),
         m_process(nullptr),
-        m_terminated(false) {}
+        m_terminated(false),
+        m_succeeded(false) {}
 
         CompilationRunToolTaskRunner::~CompilationRunToolTaskRunner() = default;
 
@@ -148,6 +238,23 @@ namespace TrenchBroom {
             }
         }
 
+        CompilationTaskFiles CompilationRunToolTaskRunner::doGetFiles() {
+            const auto workDir = this->workDir();
+            return CompilationTaskFiles{
+                !m_task->inputSpec().empty() || !m_task->outputSpec().empty(),
+                CompilationTaskGraph::parsePaths(interpolate(m_task->inputSpec()), workDir),
+                CompilationTaskGraph::parsePaths(interpolate(m_task->outputSpec()), workDir)
+            };
+        }
+
+        std::string CompilationRunToolTaskRunner::doGetSignature() {
+            return cmd();
+        }
+
+        bool CompilationRunToolTaskRunner::doGetSucceeded() const {
+            return m_succeeded;
+        }
+
         void CompilationRunToolTaskRunner::startProcess() {
             assert(m_process == nullptr);
 
@@ -171,6 +278,7 @@ namespace TrenchBroom {
                         emit error();
                     }
                 } else {
+                    m_succeeded = true;
                     emit end();
                 }
             } catch (const Exception&) {
@@ -195,7 +303,8 @@ namespace TrenchBroom {
             emit error();
         }
 
-        void CompilationRunToolTaskRunner::processFinished(const int exitCode, const QProcess::ExitStatus /* exitStatus */) {
+        void CompilationRunToolTaskRunner::processFinished(const int exitCode, const QProcess::ExitStatus exitStatus) {
+            m_succeeded = exitCode == 0 && exitStatus == QProcess::NormalExit;
             m_context << "#### Finished with exit status " << exitCode << "\n\n";
             emit end();
         }
@@ -214,10 +323,13 @@ namespace TrenchBroom {
             }
         }
 
-        CompilationRunner::CompilationRunner(std::unique_ptr<CompilationContext> context, const Model::CompilationProfile* profile) :
+        CompilationRunner::CompilationRunner(std::unique_ptr<CompilationContext> context, const Model::CompilationProfile* profile, const size_t jobLimit, const IO::Path& statePath) :
         m_context(std::move(context)),
         m_taskRunners(createTaskRunners(*m_context, profile)),
-        m_currentTask(std::end(m_taskRunners)) {}
+        m_jobLimit(std::max(jobLimit, size_t(1))),
+        m_statePath(statePath),
+        m_running(false),
+        m_scheduling(false) {}
 
         CompilationRunner::~CompilationRunner() = default;
 
@@ -259,54 +371,197 @@ namespace TrenchBroom {
 
         void CompilationRunner::execute() {
             assert(!running());
-            m_currentTask = std::begin(m_taskRunners);
-            bindEvents(m_currentTask->get());
-            m_currentTask->get()->execute();
-
+            m_running = true;
             emit compilationStarted();
+
+            if (!prepare()) {
+                m_running = false;
+                emit compilationEnded();
+                return;
+            }
+
+            schedule();
         }
 
         void CompilationRunner::terminate() {
             assert(running());
-            unbindEvents(m_currentTask->get());
-            m_currentTask->get()->terminate();
-            m_currentTask = std::end(m_taskRunners);
+            terminateRunningTasks();
+            m_running = false;
+            saveState();
 
             emit compilationEnded();
         }
 
         bool CompilationRunner::running() const {
-            return m_currentTask != std::end(m_taskRunners);
+            return m_running;
         }
 
-        void CompilationRunner::bindEvents(CompilationTaskRunner* runner) {
-            connect(runner, &CompilationTaskRunner::error, this, &CompilationRunner::taskError);
-            connect(runner, &CompilationTaskRunner::end, this, &CompilationRunner::taskEnd);
-        }
+        bool CompilationRunner::prepare() {
+            try {
+                m_files.clear();
+                m_signatures.clear();
+                for (auto& runner : m_taskRunners) {
+                    m_files.push_back(runner->files());
+                    m_signatures.push_back(runner->signature());
+                }
+            } catch (const Exception&) {
+                return false;
+            }
 
-        void CompilationRunner::unbindEvents(CompilationTaskRunner* runner) {
-            runner->disconnect(this);
+            m_dependencies = CompilationTaskGraph::dependencies(m_files);
+            m_inputHashes = std::vector<std::uint64_t>(m_taskRunners.size(), 0u);
+            m_taskStates = std::vector<TaskState>(m_taskRunners.size(), TaskState::Pending);
+
+            if (!m_statePath.isEmpty() && !m_context->test()) {
+                m_state = CompilationState::load(m_statePath);
+            }
+            return true;
         }
 
-        void CompilationRunner::taskError() {
-            if (running()) {
-                unbindEvents(m_currentTask->get());
-                m_currentTask = std::end(m_taskRunners);
+        void CompilationRunner::schedule() {
+            // tasks can end while they are being started, so this must not be reentered
+            m_scheduling = true;
+
+            bool started;
+            do {
+                started = false;
+                for (size_t i = 0; i < m_taskRunners.size() && m_running && runningTaskCount() < m_jobLimit; ++i) {
+                    if (m_taskStates[i] == TaskState::Pending && ready(i)) {
+                        startTask(i);
+                        started = true;
+                    }
+                }
+            } while (started && m_running);
+
+            m_scheduling = false;
+
+            if (m_running && finished()) {
+                m_running = false;
+                saveState();
                 emit compilationEnded();
+            } else if (!m_running) {
+                // a task failed while it was being started
+                emit compilationEnded();
+            }
+        }
+
+        bool CompilationRunner::ready(const size_t index) const {
+            for (const auto dependency : m_dependencies[index]) {
+                if (m_taskStates[dependency] == TaskState::Pending || m_taskStates[dependency] == TaskState::Running) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t CompilationRunner::runningTaskCount() const {
+            return static_cast<size_t>(std::count(std::begin(m_taskStates), std::end(m_taskStates), TaskState::Running));
+        }
+
+        bool CompilationRunner::finished() const {
+            return std::all_of(std::begin(m_taskStates), std::end(m_taskStates), [](const auto state) {
+                return state == TaskState::Unchanged || state == TaskState::Changed;
+            });
+        }
+
+        void CompilationRunner::startTask(const size_t index) {
+            if (skippable(index)) {
+                m_inputHashes[index] = CompilationState::hashFiles(CompilationTaskGraph::externalInputs(m_files, index));
+                if (upToDate(index)) {
+                    *m_context << "#### Skipping '" << m_signatures[index] << "', its inputs are unchanged\n\n";
+                    m_taskStates[index] = TaskState::Unchanged;
+                    return;
+                }
+
+                // if this task fails, it must not be skipped next time even if its inputs are unchanged by then
+                m_state.taskStarted(m_signatures[index]);
+                saveState();
+            }
+
+            m_taskStates[index] = TaskState::Running;
+            bindEvents(index);
+            m_taskRunners[index]->execute();
+        }
+
+        bool CompilationRunner::skippable(const size_t index) const {
+            return !m_statePath.isEmpty()
+                && !m_context->test()
+                && m_files[index].declared
+                && !m_files[index].inputs.empty();
+        }
+
+        bool CompilationRunner::upToDate(const size_t index) const {
+            for (const auto dependency : m_dependencies[index]) {
+                if (m_taskStates[dependency] != TaskState::Unchanged) {
+                    return false;
+                }
+            }
+
+            for (const auto& output : m_files[index].outputs) {
+                if (!IO::Disk::fileExists(output) && !IO::Disk::directoryExists(output)) {
+                    return false;
+                }
+            }
+
+            return m_state.upToDate(m_signatures[index], m_inputHashes[index]);
+        }
+
+        void CompilationRunner::terminateRunningTasks() {
+            for (size_t i = 0; i < m_taskRunners.size(); ++i) {
+                if (m_taskStates[i] == TaskState::Running) {
+                    unbindEvents(i);
+                    m_taskRunners[i]->terminate();
+                    m_taskStates[i] = TaskState::Pending;
+                }
+            }
+        }
+
+        void CompilationRunner::saveState() {
+            if (!m_statePath.isEmpty() && !m_context->test()) {
+                try {
+                    m_state.save(m_statePath);
+                } catch (const Exception& e) {
+                    *m_context << "#### Could not save compilation state to '" << m_statePath.asString() << "': " << e.what() << "\n";
+                }
             }
         }
 
-        void CompilationRunner::taskEnd() {
+        void CompilationRunner::bindEvents(const size_t index) {
+            auto* runner = m_taskRunners[index].get();
+            connect(runner, &CompilationTaskRunner::error, this, [this, index]() { taskError(index); });
+            connect(runner, &CompilationTaskRunner::end, this, [this, index]() { taskEnd(index); });
+        }
+
+        void CompilationRunner::unbindEvents(const size_t index) {
+            m_taskRunners[index]->disconnect(this);
+        }
+
+        void CompilationRunner::taskError(const size_t index) {
             if (running()) {
-                unbindEvents(m_currentTask->get());
-                ++m_currentTask;
-                if (m_currentTask != std::end(m_taskRunners)) {
-                    bindEvents(m_currentTask->get());
-                    m_currentTask->get()->execute();
-                } else {
+                unbindEvents(index);
+                m_taskStates[index] = TaskState::Pending;
+                terminateRunningTasks();
+                m_running = false;
+                saveState();
+
+                if (!m_scheduling) {
                     emit compilationEnded();
                 }
             }
         }
+
+        void CompilationRunner::taskEnd(const size_t index) {
+            if (running()) {
+                unbindEvents(index);
+                m_taskStates[index] = m_taskRunners[index]->outputsChanged() ? TaskState::Changed : TaskState::Unchanged;
+                if (skippable(index) && m_taskRunners[index]->succeeded()) {
+                    m_state.taskSucceeded(m_signatures[index], m_inputHashes[index]);
+                }
+
+                if (!m_scheduling) {
+                    schedule();
+                }
+            }
+        }
     }
 }
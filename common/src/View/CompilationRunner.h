@@ -21,7 +21,10 @@
 #define CompilationRunner_h
 
 #include "Macros.h"
+#include "IO/Path.h"
+#include "View/CompilationTaskGraph.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -51,15 +54,47 @@ namespace TrenchBroom {
 
             void execute();
             void terminate();
+
+            /**
+             * Returns the files that the task reads and writes.
+             *
+             * @throw Exception if the task's specs cannot be interpolated
+             */
+            CompilationTaskFiles files();
+
+            /**
+             * Returns a description of what the task does, such as the command line of a tool. Tasks with the same
+             * signature are considered to be the same task across compilations.
+             *
+             * @throw Exception if the task's specs cannot be interpolated
+             */
+            std::string signature();
+
+            /**
+             * Indicates whether the last execution of this task might have changed its outputs.
+             */
+            bool outputsChanged() const;
+
+            /**
+             * Indicates whether the last execution of this task was successful. A tool that ends with a non-zero exit
+             * code does not stop the compilation, but it is not successful either.
+             */
+            bool succeeded() const;
         signals:
             void start();
             void error();
             void end();
         protected:
             std::string interpolate(const std::string& spec);
+            IO::Path workDir() const;
+            IO::Path interpolatePath(const std::string& spec);
         private:
             virtual void doExecute() = 0;
             virtual void doTerminate() = 0;
+            virtual CompilationTaskFiles doGetFiles() = 0;
+            virtual std::string doGetSignature() = 0;
+            virtual bool doGetOutputsChanged() const;
+            virtual bool doGetSucceeded() const;
 
             deleteCopyAndMove(CompilationTaskRunner)
         };
@@ -68,12 +103,16 @@ namespace TrenchBroom {
             Q_OBJECT
         private:
             std::unique_ptr<const Model::CompilationExportMap> m_task;
+            bool m_outputsChanged;
         public:
             CompilationExportMapTaskRunner(CompilationContext& context, const Model::CompilationExportMap& task);
             ~CompilationExportMapTaskRunner() override;
         private:
             void doExecute() override;
             void doTerminate() override;
+            CompilationTaskFiles doGetFiles() override;
+            std::string doGetSignature() override;
+            bool doGetOutputsChanged() const override;
 
             deleteCopyAndMove(CompilationExportMapTaskRunner)
         };
@@ -88,6 +127,8 @@ namespace TrenchBroom {
         private:
             void doExecute() override;
             void doTerminate() override;
+            CompilationTaskFiles doGetFiles() override;
+            std::string doGetSignature() override;
 
             deleteCopyAndMove(CompilationCopyFilesTaskRunner)
         };
@@ -98,12 +139,16 @@ namespace TrenchBroom {
             std::unique_ptr<const Model::CompilationRunTool> m_task;
             QProcess* m_process;
             bool m_terminated;
+            bool m_succeeded;
         public:
             CompilationRunToolTaskRunner(CompilationContext& context, const Model::CompilationRunTool& task);
             ~CompilationRunToolTaskRunner() override;
         private:
             void doExecute() override;
             void doTerminate() override;
+            CompilationTaskFiles doGetFiles() override;
+            std::string doGetSignature() override;
+            bool doGetSucceeded() const override;
         private:
             void startProcess();
             std::string cmd();
@@ -116,16 +161,43 @@ namespace TrenchBroom {
             deleteCopyAndMove(CompilationRunToolTaskRunner)
         };
 
+        /**
+         * Runs the tasks of a compilation profile.
+         *
+         * Tasks run concurrently up to the given job limit unless one of them depends on the other, see
+         * CompilationTaskGraph::dependencies. The tasks are started in the order of the profile.
+         *
+         * If a state path is given, a task that declares its inputs is skipped if none of the tasks it depends on changed
+         * their outputs, its outputs exist and its external inputs have the same hash as when it last succeeded.
+         */
         class CompilationRunner : public QObject {
             Q_OBJECT
         private:
             using TaskRunnerList = std::vector<std::unique_ptr<CompilationTaskRunner>>;
 
+            enum class TaskState {
+                Pending,
+                Running,
+                Unchanged,
+                Changed
+            };
+
             std::unique_ptr<CompilationContext> m_context;
             TaskRunnerList m_taskRunners;
-            TaskRunnerList::iterator m_currentTask;
+            size_t m_jobLimit;
+            IO::Path m_statePath;
+            CompilationState m_state;
+
+            std::vector<CompilationTaskFiles> m_files;
+            std::vector<std::string> m_signatures;
+            std::vector<std::vector<size_t>> m_dependencies;
+            std::vector<std::uint64_t> m_inputHashes;
+            std::vector<TaskState> m_taskStates;
+
+            bool m_running;
+            bool m_scheduling;
         public:
-            CompilationRunner(std::unique_ptr<CompilationContext> context, const Model::CompilationProfile* profile);
+            CompilationRunner(std::unique_ptr<CompilationContext> context, const Model::CompilationProfile* profile, size_t jobLimit = 1, const IO::Path& statePath = IO::Path());
             ~CompilationRunner() override;
         private:
             class CreateTaskRunnerVisitor;
@@ -135,11 +207,21 @@ namespace TrenchBroom {
             void terminate();
             bool running() const;
         private:
-            void bindEvents(CompilationTaskRunner* runner);
-            void unbindEvents(CompilationTaskRunner* runner);
-        private slots:
-            void taskError();
-            void taskEnd();
+            bool prepare();
+            void schedule();
+            bool ready(size_t index) const;
+            size_t runningTaskCount() const;
+            bool finished() const;
+            void startTask(size_t index);
+            bool skippable(size_t index) const;
+            bool upToDate(size_t index) const;
+            void terminateRunningTasks();
+            void saveState();
+
+            void bindEvents(size_t index);
+            void unbindEvents(size_t index);
+            void taskError(size_t index);
+            void taskEnd(size_t index);
         signals:
             void compilationStarted();
             void compilationEnded();
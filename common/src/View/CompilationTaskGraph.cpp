@@ -0,0 +1,197 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CompilationTaskGraph.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/FileMatcher.h"
+
+#include <kdl/string_utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace View {
+        namespace CompilationTaskGraph {
+            std::vector<IO::Path> parsePaths(const std::string& str, const IO::Path& workDir) {
+                std::vector<IO::Path> result;
+                for (const auto& part : kdl::str_split(str, ";")) {
+                    const auto path = IO::Path(part);
+                    if (!path.isEmpty()) {
+                        result.push_back(path.isAbsolute() || workDir.isEmpty() ? path : workDir + path);
+                    }
+                }
+                return result;
+            }
+
+            static bool isPattern(const IO::Path& path) {
+                return path.lastComponent().asString().find_first_of("*?[") != std::string::npos;
+            }
+
+            static bool matches(const IO::Path& pattern, const IO::Path& path) {
+                return isPattern(pattern)
+                    && path.length() == pattern.length()
+                    && path.deleteLastComponent().compare(pattern.deleteLastComponent(), false) == 0
+                    && IO::FileNameMatcher(pattern.lastComponent().asString())(path, false);
+            }
+
+            bool overlaps(const IO::Path& lhs, const IO::Path& rhs) {
+                return lhs.hasPrefix(rhs, false)
+                    || rhs.hasPrefix(lhs, false)
+                    || matches(lhs, rhs)
+                    || matches(rhs, lhs);
+            }
+
+            static bool overlaps(const std::vector<IO::Path>& lhs, const std::vector<IO::Path>& rhs) {
+                for (const auto& l : lhs) {
+                    for (const auto& r : rhs) {
+                        if (overlaps(l, r)) {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            static bool conflicts(const CompilationTaskFiles& previous, const CompilationTaskFiles& next) {
+                return !previous.declared
+                    || !next.declared
+                    || overlaps(previous.outputs, next.inputs)
+                    || overlaps(previous.outputs, next.outputs)
+                    || overlaps(previous.inputs, next.outputs);
+            }
+
+            std::vector<std::vector<size_t>> dependencies(const std::vector<CompilationTaskFiles>& tasks) {
+                std::vector<std::vector<size_t>> result(tasks.size());
+                for (size_t next = 0; next < tasks.size(); ++next) {
+                    for (size_t previous = 0; previous < next; ++previous) {
+                        if (conflicts(tasks[previous], tasks[next])) {
+                            result[next].push_back(previous);
+                        }
+                    }
+                }
+                return result;
+            }
+
+            std::vector<IO::Path> externalInputs(const std::vector<CompilationTaskFiles>& tasks, const size_t index) {
+                assert(index < tasks.size());
+
+                std::vector<IO::Path> result;
+                for (const auto& input : tasks[index].inputs) {
+                    const auto produced = std::any_of(std::begin(tasks), std::next(std::begin(tasks), static_cast<std::ptrdiff_t>(index)), [&](const auto& task) {
+                        return std::any_of(std::begin(task.outputs), std::end(task.outputs), [&](const auto& output) { return overlaps(output, input); });
+                    });
+                    if (!produced) {
+                        result.push_back(input);
+                    }
+                }
+                return result;
+            }
+        }
+
+        CompilationState CompilationState::load(const IO::Path& path) {
+            CompilationState result;
+
+            std::ifstream stream(path.asString());
+            std::uint64_t task, inputHash;
+            while (stream >> std::hex >> task >> inputHash) {
+                result.m_inputHashes[task] = inputHash;
+            }
+            return result;
+        }
+
+        void CompilationState::save(const IO::Path& path) const {
+            std::ofstream stream(path.asString(), std::ios::out | std::ios::trunc);
+            if (!stream.is_open()) {
+                throw FileSystemException("Cannot open file: " + path.asString());
+            }
+
+            stream << std::hex;
+            for (const auto& [task, inputHash] : m_inputHashes) {
+                stream << task << " " << inputHash << "\n";
+            }
+        }
+
+        static std::uint64_t hashString(const std::string& str) {
+            // 64 bit FNV-1a
+            std::uint64_t result = 14695981039346656037ull;
+            for (const auto c : str) {
+                result ^= static_cast<std::uint8_t>(c);
+                result *= 1099511628211ull;
+            }
+            return result;
+        }
+
+        bool CompilationState::upToDate(const std::string& task, const std::uint64_t inputHash) const {
+            const auto it = m_inputHashes.find(hashString(task));
+            return it != std::end(m_inputHashes) && it->second == inputHash;
+        }
+
+        void CompilationState::taskStarted(const std::string& task) {
+            m_inputHashes.erase(hashString(task));
+        }
+
+        void CompilationState::taskSucceeded(const std::string& task, const std::uint64_t inputHash) {
+            m_inputHashes[hashString(task)] = inputHash;
+        }
+
+        static std::vector<IO::Path> expandPath(const IO::Path& path) {
+            if (CompilationTaskGraph::isPattern(path)) {
+                const auto directory = path.deleteLastComponent();
+                if (IO::Disk::directoryExists(directory)) {
+                    return IO::Disk::findItems(directory, IO::FileNameMatcher(path.lastComponent().asString()));
+                }
+                return {};
+            } else if (IO::Disk::directoryExists(path)) {
+                return IO::Disk::findItemsRecursively(path, IO::FileTypeMatcher(true, false));
+            } else {
+                return { path };
+            }
+        }
+
+        std::uint64_t CompilationState::hashFiles(const std::vector<IO::Path>& paths) {
+            std::vector<IO::Path> files;
+            for (const auto& path : paths) {
+                const auto expanded = expandPath(path);
+                files.insert(std::end(files), std::begin(expanded), std::end(expanded));
+            }
+            std::sort(std::begin(files), std::end(files));
+
+            // the names are hashed along with the contents so that renaming or removing a file changes the hash
+            std::stringstream hashes;
+            hashes << std::hex;
+            for (const auto& file : files) {
+                hashes << file.asString() << "\n";
+
+                std::ifstream stream(file.asString(), std::ios::in | std::ios::binary);
+                if (stream.is_open()) {
+                    const auto contents = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+                    hashes << hashString(contents) << "\n";
+                }
+            }
+            return hashString(hashes.str());
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CompilationTaskGraph_h
+#define CompilationTaskGraph_h
+
+#include "IO/Path.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * The files that a compilation task reads and writes. A task that does not declare its files might read or
+         * write anything.
+         */
+        struct CompilationTaskFiles {
+            bool declared;
+            std::vector<IO::Path> inputs;
+            std::vector<IO::Path> outputs;
+        };
+
+        namespace CompilationTaskGraph {
+            /**
+             * Splits the given semicolon separated list of paths. Relative paths are made absolute using the given
+             * work directory and empty entries are omitted.
+             */
+            std::vector<IO::Path> parsePaths(const std::string& str, const IO::Path& workDir);
+
+            /**
+             * Indicates whether the given paths might refer to the same file. This is the case if the paths are equal, if
+             * one of them is a directory that contains the other one, or if the last component of one of them is a glob
+             * pattern that matches the other one.
+             */
+            bool overlaps(const IO::Path& lhs, const IO::Path& rhs);
+
+            /**
+             * Returns, for each of the given tasks, the indices of the previous tasks that must end before it can start.
+             *
+             * A task depends on a previous task if it reads a file that the previous task writes, or if it writes a file
+             * that the previous task reads or writes. A task that does not declare its files depends on all previous
+             * tasks, and all following tasks depend on it.
+             */
+            std::vector<std::vector<size_t>> dependencies(const std::vector<CompilationTaskFiles>& tasks);
+
+            /**
+             * Returns the inputs of the task at the given index which are not written by any previous task.
+             */
+            std::vector<IO::Path> externalInputs(const std::vector<CompilationTaskFiles>& tasks, size_t index);
+        }
+
+        /**
+         * Records a hash of the external inputs of every task that ended successfully so that a task can be skipped
+         * if its inputs have not changed since then. Tasks are identified by their interpolated command.
+         */
+        class CompilationState {
+        private:
+            std::map<std::uint64_t, std::uint64_t> m_inputHashes;
+        public:
+            /**
+             * Loads the state from the given file. Returns an empty state if the file does not exist or cannot be read.
+             */
+            static CompilationState load(const IO::Path& path);
+
+            /**
+             * Saves this state to the given file.
+             *
+             * @throw FileSystemException if the file cannot be written
+             */
+            void save(const IO::Path& path) const;
+
+            bool upToDate(const std::string& task, std::uint64_t inputHash) const;
+            void taskStarted(const std::string& task);
+            void taskSucceeded(const std::string& task, std::uint64_t inputHash);
+
+            /**
+             * Computes a hash of the names and contents of the given files. A path whose last component is a glob pattern
+             * stands for all matching files in its directory and a directory stands for all files within it. Missing
+             * files are hashed by their names only.
+             */
+            static std::uint64_t hashFiles(const std::vector<IO::Path>& paths);
+        };
+    }
+}
+
+#endif /* CompilationTaskGraph_h */
@@ -35,6 +35,7 @@
 #include <kdl/memory_utils.h>
 
 #include <QBoxLayout>
+#include <QComboBox>
 #include <QCompleter>
 #include <QFileDialog>
 #include <QFormLayout>
@@ -140,7 +141,9 @@ namespace TrenchBroom {
 
         CompilationExportMapTaskEditor::CompilationExportMapTaskEditor(std::weak_ptr<MapDocument> document, Model::CompilationProfile& profile, Model::CompilationExportMap& task, QWidget* parent) :
         CompilationTaskEditorBase("Export Map", std::move(document), profile, task, parent),
-        m_targetEditor(nullptr) {
+        m_targetEditor(nullptr),
+        m_scopeChoice(nullptr),
+        m_sealTextureEditor(nullptr) {
             auto* formLayout = new QFormLayout();
             formLayout->setContentsMargins(LayoutConstants::WideHMargin, LayoutConstants::WideVMargin, LayoutConstants::WideHMargin, LayoutConstants::WideVMargin);
             formLayout->setVerticalSpacing(LayoutConstants::NarrowVMargin);
@@ -151,7 +154,21 @@ namespace TrenchBroom {
             setupCompleter(m_targetEditor);
             formLayout->addRow("Target", m_targetEditor);
 
+            // the items must be in the same order as the values of CompilationExportMap::Scope
+            m_scopeChoice = new QComboBox();
+            m_scopeChoice->addItem("Entire map");
+            m_scopeChoice->addItem("Visible layers");
+            m_scopeChoice->addItem("Selection bounds");
+            m_scopeChoice->setToolTip("Exporting only a part of the map speeds up compiling while working on one area. The bounds of the selection are sealed with brushes.");
+            formLayout->addRow("Export", m_scopeChoice);
+
+            m_sealTextureEditor = new QLineEdit();
+            m_sealTextureEditor->setToolTip("The texture of the brushes that seal the selection bounds, i.e. 'skip' or 'caulk'.");
+            formLayout->addRow("Seal texture", m_sealTextureEditor);
+
             connect(m_targetEditor, &QLineEdit::textChanged, this, &CompilationExportMapTaskEditor::targetSpecChanged);
+            connect(m_scopeChoice, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &CompilationExportMapTaskEditor::scopeChanged);
+            connect(m_sealTextureEditor, &QLineEdit::textChanged, this, &CompilationExportMapTaskEditor::sealTextureChanged);
         }
 
         void CompilationExportMapTaskEditor::updateItem() {
@@ -159,6 +176,17 @@ namespace TrenchBroom {
             if (m_targetEditor->text() != targetSpec) {
                 m_targetEditor->setText(targetSpec);
             }
+
+            const auto scopeIndex = static_cast<int>(task().scope());
+            if (m_scopeChoice->currentIndex() != scopeIndex) {
+                m_scopeChoice->setCurrentIndex(scopeIndex);
+            }
+
+            const auto sealTexture = QString::fromStdString(task().sealTexture());
+            if (m_sealTextureEditor->text() != sealTexture) {
+                m_sealTextureEditor->setText(sealTexture);
+            }
+            m_sealTextureEditor->setEnabled(task().scope() == Model::CompilationExportMap::Scope::Selection);
         }
 
         Model::CompilationExportMap& CompilationExportMapTaskEditor::task() {
@@ -174,6 +202,20 @@ namespace TrenchBroom {
             }
         }
 
+        void CompilationExportMapTaskEditor::scopeChanged(const int index) {
+            const auto scope = static_cast<Model::CompilationExportMap::Scope>(index);
+            if (index >= 0 && task().scope() != scope) {
+                task().setScope(scope);
+            }
+        }
+
+        void CompilationExportMapTaskEditor::sealTextureChanged(const QString& text) {
+            const auto sealTexture = text.toStdString();
+            if (task().sealTexture() != sealTexture) {
+                task().setSealTexture(sealTexture);
+            }
+        }
+
         CompilationCopyFilesTaskEditor::CompilationCopyFilesTaskEditor(std::weak_ptr<MapDocument> document, Model::CompilationProfile& profile, Model::CompilationCopyFiles& task, QWidget* parent) :
         CompilationTaskEditorBase("Copy Files", std::move(document), profile, task, parent),
         m_sourceEditor(nullptr),
@@ -231,7 +273,9 @@ namespace TrenchBroom {
         CompilationRunToolTaskEditor::CompilationRunToolTaskEditor(std::weak_ptr<MapDocument> document, Model::CompilationProfile& profile, Model::CompilationRunTool& task, QWidget* parent) :
         CompilationTaskEditorBase("Run Tool", std::move(document), profile, task, parent),
         m_toolEditor(nullptr),
-        m_parametersEditor(nullptr) {
+        m_parametersEditor(nullptr),
+        m_inputsEditor(nullptr),
+        m_outputsEditor(nullptr) {
             auto* formLayout = new QFormLayout();
             formLayout->setContentsMargins(LayoutConstants::WideHMargin, LayoutConstants::WideVMargin, LayoutConstants::WideHMargin, LayoutConstants::WideVMargin);
             formLayout->setVerticalSpacing(LayoutConstants::NarrowVMargin);
@@ -256,9 +300,21 @@ namespace TrenchBroom {
             setupCompleter(m_parametersEditor);
             formLayout->addRow("Parameters", m_parametersEditor);
 
+            m_inputsEditor = new MultiCompletionLineEdit();
+            m_inputsEditor->setToolTip("The files read by the tool, separated by semicolons. Leave empty to run the tool after all previous tasks.");
+            setupCompleter(m_inputsEditor);
+            formLayout->addRow("Inputs", m_inputsEditor);
+
+            m_outputsEditor = new MultiCompletionLineEdit();
+            m_outputsEditor->setToolTip("The files written by the tool, separated by semicolons.");
+            setupCompleter(m_outputsEditor);
+            formLayout->addRow("Outputs", m_outputsEditor);
+
             connect(m_toolEditor, &QLineEdit::textChanged, this, &CompilationRunToolTaskEditor::toolSpecChanged);
             connect(browseToolButton, &QPushButton::clicked, this, &CompilationRunToolTaskEditor::browseTool);
             connect(m_parametersEditor, &QLineEdit::textChanged, this, &CompilationRunToolTaskEditor::parameterSpecChanged);
+            connect(m_inputsEditor, &QLineEdit::textChanged, this, &CompilationRunToolTaskEditor::inputSpecChanged);
+            connect(m_outputsEditor, &QLineEdit::textChanged, this, &CompilationRunToolTaskEditor::outputSpecChanged);
         }
 
         void CompilationRunToolTaskEditor::updateItem() {
@@ -272,6 +328,16 @@ namespace TrenchBroom {
                 m_parametersEditor->setText(parametersSpec);
             }
 
+            const auto inputSpec = QString::fromStdString(task().inputSpec());
+            if (m_inputsEditor->text() != inputSpec) {
+                m_inputsEditor->setText(inputSpec);
+            }
+
+            const auto outputSpec = QString::fromStdString(task().outputSpec());
+            if (m_outputsEditor->text() != outputSpec) {
+                m_outputsEditor->setText(outputSpec);
+            }
+
         }
 
         Model::CompilationRunTool& CompilationRunToolTaskEditor::task() {
@@ -304,6 +370,20 @@ namespace TrenchBroom {
             }
         }
 
+        void CompilationRunToolTaskEditor::inputSpecChanged(const QString& text) {
+            const auto inputSpec = text.toStdString();
+            if (task().inputSpec() != inputSpec) {
+                task().setInputSpec(inputSpec);
+            }
+        }
+
+        void CompilationRunToolTaskEditor::outputSpecChanged(const QString& text) {
+            const auto outputSpec = text.toStdString();
+            if (task().outputSpec() != outputSpec) {
+                task().setOutputSpec(outputSpec);
+            }
+        }
+
         CompilationTaskListBox::CompilationTaskListBox(std::weak_ptr<MapDocument> document, QWidget* parent) :
         ControlListBox("Click the '+' button to create a task.", QMargins(), false, parent),
         m_document(std::move(document)),
@@ -25,6 +25,7 @@
 #include <memory>
 #include <vector>
 
+class QComboBox;
 class QCompleter;
 class QLineEdit;
 class QWidget;
@@ -79,6 +80,8 @@ namespace TrenchBroom {
             Q_OBJECT
         private:
             MultiCompletionLineEdit* m_targetEditor;
+            QComboBox* m_scopeChoice;
+            QLineEdit* m_sealTextureEditor;
         public:
             CompilationExportMapTaskEditor(std::weak_ptr<MapDocument> document, Model::CompilationProfile& profile, Model::CompilationExportMap& task, QWidget* parent = nullptr);
         private:
@@ -86,6 +89,8 @@ namespace TrenchBroom {
             Model::CompilationExportMap& task();
         private slots:
             void targetSpecChanged(const QString& text);
+            void scopeChanged(int index);
+            void sealTextureChanged(const QString& text);
         };
 
         class CompilationCopyFilesTaskEditor : public CompilationTaskEditorBase {
@@ -108,6 +113,8 @@ namespace TrenchBroom {
         private:
             MultiCompletionLineEdit* m_toolEditor;
             MultiCompletionLineEdit* m_parametersEditor;
+            MultiCompletionLineEdit* m_inputsEditor;
+            MultiCompletionLineEdit* m_outputsEditor;
         public:
             CompilationRunToolTaskEditor(std::weak_ptr<MapDocument> document, Model::CompilationProfile& profile, Model::CompilationRunTool& task, QWidget* parent = nullptr);
         private:
@@ -117,6 +124,8 @@ namespace TrenchBroom {
             void browseTool();
             void toolSpecChanged(const QString& text);
             void parameterSpecChanged(const QString& text);
+            void inputSpecChanged(const QString& text);
+            void outputSpecChanged(const QString& text);
         };
 
         class CompilationTaskListBox : public ControlListBox {
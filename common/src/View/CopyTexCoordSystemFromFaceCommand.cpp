@@ -77,5 +77,9 @@ namespace TrenchBroom {
         bool CopyTexCoordSystemFromFaceCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t CopyTexCoordSystemFromFaceCommand::doGetMemoryUsage() const {
+            return sizeof(CopyTexCoordSystemFromFaceCommand) + (m_snapshot != nullptr ? m_snapshot->memoryUsage() : 0u);
+        }
     }
 }
@@ -129,7 +129,10 @@ namespace TrenchBroom {
         }
 
         void EntityBrowserView::usageCountDidChange() {
-            invalidate();
+            // the layout only depends on the usage counts if unused definitions are hidden or sorted by their usage
+            if (m_hideUnused || m_sortOrder == Assets::EntityDefinitionSortOrder::Usage) {
+                invalidate();
+            }
             update();
         }
 
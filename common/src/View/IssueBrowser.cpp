@@ -77,6 +77,7 @@ namespace TrenchBroom {
             document->documentWasSavedNotifier.addObserver(this, &IssueBrowser::documentWasSaved);
             document->documentWasNewedNotifier.addObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
             document->documentWasLoadedNotifier.addObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
+            document->documentWasClearedNotifier.addObserver(this, &IssueBrowser::documentWasCleared);
             document->nodesWereAddedNotifier.addObserver(this, &IssueBrowser::nodesWereAdded);
             document->nodesWereRemovedNotifier.addObserver(this, &IssueBrowser::nodesWereRemoved);
             document->nodesDidChangeNotifier.addObserver(this, &IssueBrowser::nodesDidChange);
@@ -89,6 +90,7 @@ namespace TrenchBroom {
                 document->documentWasSavedNotifier.removeObserver(this, &IssueBrowser::documentWasSaved);
                 document->documentWasNewedNotifier.removeObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
                 document->documentWasLoadedNotifier.removeObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
+                document->documentWasClearedNotifier.removeObserver(this, &IssueBrowser::documentWasCleared);
                 document->nodesWereAddedNotifier.removeObserver(this, &IssueBrowser::nodesWereAdded);
                 document->nodesWereRemovedNotifier.removeObserver(this, &IssueBrowser::nodesWereRemoved);
                 document->nodesDidChangeNotifier.removeObserver(this, &IssueBrowser::nodesDidChange);
@@ -101,24 +103,29 @@ namespace TrenchBroom {
             m_view->reload();
         }
 
+        void IssueBrowser::documentWasCleared(MapDocument*) {
+            // drops all rows, which refer to issues of the deleted world
+            m_view->reload();
+        }
+
         void IssueBrowser::documentWasSaved(MapDocument*) {
             m_view->update();
         }
 
         void IssueBrowser::nodesWereAdded(const std::vector<Model::Node*>&) {
-            m_view->reload();
+            m_view->invalidate();
         }
 
         void IssueBrowser::nodesWereRemoved(const std::vector<Model::Node*>&) {
-            m_view->reload();
+            m_view->invalidate();
         }
 
         void IssueBrowser::nodesDidChange(const std::vector<Model::Node*>&) {
-            m_view->reload();
+            m_view->invalidate();
         }
 
         void IssueBrowser::brushFacesDidChange(const std::vector<Model::BrushFace*>&) {
-            m_view->reload();
+            m_view->invalidate();
         }
 
         void IssueBrowser::issueIgnoreChanged(Model::Issue*) {
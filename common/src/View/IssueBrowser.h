@@ -62,6 +62,7 @@ namespace TrenchBroom {
             void bindObservers();
             void unbindObservers();
             void documentWasNewedOrLoaded(MapDocument* document);
+            void documentWasCleared(MapDocument* document);
             void documentWasSaved(MapDocument* document);
             void nodesWereAdded(const std::vector<Model::Node*>& nodes);
             void nodesWereRemoved(const std::vector<Model::Node*>& nodes);
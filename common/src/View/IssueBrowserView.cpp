@@ -20,15 +20,20 @@
 #include "IssueBrowserView.h"
 
 #include "Ensure.h"
-#include "Model/CollectMatchingIssuesVisitor.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/Issue.h"
+#include "Model/IssueGeneratorStats.h"
 #include "Model/IssueQuickFix.h"
+#include "Model/IssueValidationQueue.h"
 #include "Model/World.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <vector>
 
 #include <QHBoxLayout>
@@ -36,6 +41,7 @@
 #include <QMenu>
 #include <QHeaderView>
 #include <QItemSelectionModel>
+#include <QSignalBlocker>
 
 namespace TrenchBroom {
     namespace View {
@@ -44,11 +50,14 @@ namespace TrenchBroom {
         m_document(document),
         m_hiddenGenerators(0),
         m_showHiddenIssues(false),
-        m_valid(false) {
+        m_valid(true),
+        m_logStats(false) {
             createGui();
             bindEvents();
         }
 
+        IssueBrowserView::~IssueBrowserView() = default;
+
         void IssueBrowserView::createGui() {
             m_tableModel = new IssueBrowserModel(this);
 
@@ -74,16 +83,34 @@ namespace TrenchBroom {
             if (hiddenGenerators == m_hiddenGenerators)
                 return;
             m_hiddenGenerators = hiddenGenerators;
-            invalidate();
+            refilter();
         }
 
         void IssueBrowserView::setShowHiddenIssues(const bool show) {
             m_showHiddenIssues = show;
-            invalidate();
+            refilter();
         }
 
         void IssueBrowserView::reload() {
-            invalidate();
+            auto document = kdl::mem_lock(m_document);
+            Model::World* world = document->world();
+
+            m_stats.reset();
+            if (world != nullptr) {
+                world->issueValidationQueue().clear();
+                m_stats = std::make_unique<Model::IssueGeneratorStats>(world->registeredIssueGenerators());
+                m_logStats = true;
+            }
+            refilter();
+        }
+
+        void IssueBrowserView::invalidate() {
+            processValidationQueue();
+            scheduleValidation();
+        }
+
+        const Model::IssueGeneratorStats* IssueBrowserView::stats() const {
+            return m_stats.get();
         }
 
         void IssueBrowserView::deselectAll() {
@@ -103,13 +130,6 @@ namespace TrenchBroom {
             }
         };
 
-        class IssueBrowserView::IssueCmp {
-        public:
-            bool operator()(const Model::Issue* lhs, const Model::Issue* rhs) const {
-                return lhs->seqId() > rhs->seqId();
-            }
-        };
-
         /**
          * Updates the MapDocument selection to match the table view
          */
@@ -128,18 +148,105 @@ namespace TrenchBroom {
             document->select(nodes);
         }
 
-        void IssueBrowserView::updateIssues() {
+        /**
+         * Removes the rows of invalidated and removed nodes right away, since the issues of these nodes have already
+         * been deleted, and queues the invalidated nodes for validation.
+         */
+        void IssueBrowserView::processValidationQueue() {
+            auto document = kdl::mem_lock(m_document);
+            Model::World* world = document->world();
+            if (world == nullptr) {
+                return;
+            }
+
+            auto& queue = world->issueValidationQueue();
+            if (queue.empty()) {
+                return;
+            }
+
+            const auto removedNodes = queue.takeRemovedNodes();
+            const auto invalidatedNodes = queue.takeInvalidatedNodes();
+
+            auto staleNodes = std::unordered_set<Model::Node*>(std::begin(removedNodes), std::end(removedNodes));
+            staleNodes.insert(std::begin(invalidatedNodes), std::end(invalidatedNodes));
+            {
+                // we are called while the document notifies its observers, so we must not change its selection
+                const QSignalBlocker blocker(m_tableView->selectionModel());
+                m_tableModel->removeIssues(staleNodes);
+            }
+
+            for (auto* node : removedNodes) {
+                m_pendingNodeSet.erase(node);
+            }
+            addPendingNodes(invalidatedNodes);
+        }
+
+        /**
+         * Rebuilds the table from scratch. All nodes are queued, but the ones whose issues are still valid just have
+         * their issues collected again.
+         */
+        void IssueBrowserView::refilter() {
+            m_tableModel->clear();
+            m_pendingNodes.clear();
+            m_pendingNodeSet.clear();
+
             auto document = kdl::mem_lock(m_document);
             Model::World* world = document->world();
             if (world != nullptr) {
-                const std::vector<Model::IssueGenerator*>& issueGenerators = world->registeredIssueGenerators();
-                Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
+                Model::CollectNodesVisitor visitor;
                 world->acceptAndRecurse(visitor);
+                addPendingNodes(visitor.nodes());
+            }
+
+            invalidate();
+        }
+
+        void IssueBrowserView::addPendingNodes(const std::vector<Model::Node*>& nodes) {
+            for (auto* node : nodes) {
+                if (m_pendingNodeSet.insert(node).second) {
+                    m_pendingNodes.push_back(node);
+                }
+            }
+        }
+
+        std::vector<Model::Node*> IssueBrowserView::takePendingNodes(const size_t count) {
+            std::vector<Model::Node*> result;
+            while (!m_pendingNodes.empty() && result.size() < count) {
+                auto* node = m_pendingNodes.back();
+                m_pendingNodes.pop_back();
+
+                // nodes that were removed while pending are no longer in the set
+                if (m_pendingNodeSet.erase(node) > 0u) {
+                    result.push_back(node);
+                }
+            }
+            return result;
+        }
+
+        void IssueBrowserView::validateNodes(const std::vector<Model::Node*>& nodes) {
+            auto document = kdl::mem_lock(m_document);
+            Model::World* world = document->world();
+            if (world == nullptr || nodes.empty()) {
+                return;
+            }
+
+            const auto& issueGenerators = world->registeredIssueGenerators();
+            if (m_stats == nullptr) {
+                m_stats = std::make_unique<Model::IssueGeneratorStats>(issueGenerators);
+            }
+
+            Model::Node::validateIssues(nodes, issueGenerators, m_stats.get());
 
-                std::vector<Model::Issue*> issues = visitor.issues();
-                kdl::vec_sort(issues, IssueCmp());
-                m_tableModel->setIssues(std::move(issues));
+            const auto visible = IssueVisible(m_hiddenGenerators, m_showHiddenIssues);
+            std::vector<Model::Issue*> issues;
+            for (auto* node : nodes) {
+                for (auto* issue : node->issues(issueGenerators)) {
+                    if (visible(issue)) {
+                        issues.push_back(issue);
+                    }
+                }
             }
+            m_tableModel->addIssues(std::move(issues));
         }
 
         void IssueBrowserView::applyQuickFix(const Model::IssueQuickFix* quickFix) {
@@ -158,7 +265,7 @@ namespace TrenchBroom {
             for (QModelIndex index : indices) {
                 if (index.isValid()) {
                     const auto row = static_cast<size_t>(index.row());
-                    result.push_back(m_tableModel->issues().at(row));
+                    result.push_back(m_tableModel->issue(row));
                 }
             }
             return result;
@@ -174,7 +281,7 @@ namespace TrenchBroom {
                 if (!index.isValid()) {
                     continue;
                 }
-                const Model::Issue* issue = m_tableModel->issues().at(static_cast<size_t>(index.row()));
+                const Model::Issue* issue = m_tableModel->issue(static_cast<size_t>(index.row()));
                 issueTypes &= issue->type();
             }
 
@@ -197,7 +304,7 @@ namespace TrenchBroom {
                 document->setIssueHidden(issue, !show);
             }
 
-            invalidate();
+            refilter();
         }
 
         QList<QModelIndex> IssueBrowserView::getSelection() const {
@@ -253,17 +360,31 @@ namespace TrenchBroom {
             setIssueVisibility(false);
         }
 
-        void IssueBrowserView::invalidate() {
-            m_valid = false;
+        void IssueBrowserView::scheduleValidation() {
+            if (m_valid && !m_pendingNodeSet.empty()) {
+                m_valid = false;
 
-            QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+                QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+            }
         }
 
         void IssueBrowserView::validate() {
             if (!m_valid) {
                 m_valid = true;
 
-                updateIssues();
+                processValidationQueue();
+                validateNodes(takePendingNodes(ValidationBatchSize));
+
+                if (!m_pendingNodeSet.empty()) {
+                    // validate the remaining nodes after the event loop had a chance to process user input
+                    scheduleValidation();
+                } else if (m_logStats && m_stats != nullptr) {
+                    m_logStats = false;
+
+                    auto document = kdl::mem_lock(m_document);
+                    const auto ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(m_stats->totalTime());
+                    document->debug() << "Issue generators took " << ms.count() << " ms\n" << m_stats->summary();
+                }
             }
         }
 
@@ -271,23 +392,98 @@ namespace TrenchBroom {
 
         IssueBrowserModel::IssueBrowserModel(QObject* parent)
         : QAbstractTableModel(parent),
-          m_issues() {}
+          m_rows() {}
 
-        void IssueBrowserModel::setIssues(std::vector<Model::Issue*> issues) {
+        void IssueBrowserModel::clear() {
             beginResetModel();
-            m_issues = std::move(issues);
+            m_rows.clear();
             endResetModel();
         }
 
-        const std::vector<Model::Issue*>& IssueBrowserModel::issues() {
-            return m_issues;
+        void IssueBrowserModel::addIssues(std::vector<Model::Issue*> issues) {
+            if (issues.empty()) {
+                return;
+            }
+
+            std::vector<Row> rows;
+            rows.reserve(issues.size());
+            for (auto* issue : issues) {
+                rows.push_back(Row{ issue->node(), issue });
+            }
+
+            const auto cmp = [](const Row& lhs, const Row& rhs) { return lhs.issue->seqId() > rhs.issue->seqId(); };
+            std::sort(std::begin(rows), std::end(rows), cmp);
+
+            if (m_rows.empty() || cmp(rows.back(), m_rows.front())) {
+                // newly generated issues have greater sequence IDs than all existing ones
+                beginInsertRows(QModelIndex(), 0, static_cast<int>(rows.size()) - 1);
+                m_rows.insert(std::begin(m_rows), std::begin(rows), std::end(rows));
+                endInsertRows();
+            } else {
+                beginResetModel();
+                const auto oldSize = m_rows.size();
+                m_rows.insert(std::end(m_rows), std::begin(rows), std::end(rows));
+                std::inplace_merge(std::begin(m_rows), std::next(std::begin(m_rows), static_cast<std::ptrdiff_t>(oldSize)), std::end(m_rows), cmp);
+                endResetModel();
+            }
+        }
+
+        void IssueBrowserModel::removeIssues(const std::unordered_set<Model::Node*>& nodes) {
+            const auto isStale = [&](const Row& row) { return nodes.count(row.node) > 0u; };
+
+            size_t runCount = 0u;
+            for (size_t i = 0u; i < m_rows.size(); ++i) {
+                if (isStale(m_rows[i]) && (i == 0u || !isStale(m_rows[i - 1u]))) {
+                    ++runCount;
+                }
+            }
+
+            if (runCount == 0u) {
+                return;
+            }
+
+            if (runCount > MaxRemovedRuns) {
+                beginResetModel();
+                kdl::vec_erase_if(m_rows, isStale);
+                endResetModel();
+                return;
+            }
+
+            // remove contiguous runs of rows from the back so that the remaining row indices stay valid
+            size_t last = m_rows.size();
+            while (last > 0u) {
+                if (!isStale(m_rows[last - 1u])) {
+                    --last;
+                    continue;
+                }
+
+                size_t first = last - 1u;
+                while (first > 0u && isStale(m_rows[first - 1u])) {
+                    --first;
+                }
+
+                beginRemoveRows(QModelIndex(), static_cast<int>(first), static_cast<int>(last) - 1);
+                m_rows.erase(std::next(std::begin(m_rows), static_cast<std::ptrdiff_t>(first)),
+                             std::next(std::begin(m_rows), static_cast<std::ptrdiff_t>(last)));
+                endRemoveRows();
+
+                last = first;
+            }
+        }
+
+        size_t IssueBrowserModel::issueCount() const {
+            return m_rows.size();
+        }
+
+        Model::Issue* IssueBrowserModel::issue(const size_t row) const {
+            return m_rows.at(row).issue;
         }
 
         int IssueBrowserModel::rowCount(const QModelIndex& parent) const {
             if (parent.isValid()) {
                 return 0;
             }
-            return static_cast<int>(m_issues.size());
+            return static_cast<int>(m_rows.size());
         }
 
         int IssueBrowserModel::columnCount(const QModelIndex& parent) const {
@@ -300,13 +496,13 @@ namespace TrenchBroom {
         QVariant IssueBrowserModel::data(const QModelIndex& index, int role) const {
             if (!index.isValid()
                 || index.row() < 0
-                || index.row() >= static_cast<int>(m_issues.size())
+                || index.row() >= static_cast<int>(m_rows.size())
                 || index.column() < 0
                 || index.column() >= 2) {
                 return QVariant();
             }
 
-            const Model::Issue* issue = m_issues.at(static_cast<size_t>(index.row()));
+            const Model::Issue* issue = m_rows.at(static_cast<size_t>(index.row())).issue;
 
             if (role == Qt::DisplayRole) {
                 if (index.column() == 0) {
@@ -23,6 +23,7 @@
 #include "Model/IssueType.h"
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include <QWidget>
@@ -34,40 +35,75 @@ class QTableView;
 namespace TrenchBroom {
     namespace Model {
         class Issue;
+        class IssueGeneratorStats;
         class IssueQuickFix;
+        class Node;
     }
 
     namespace View {
         class IssueBrowserModel;
         class MapDocument;
 
+        /**
+         * Shows the issues of the current document's world.
+         *
+         * The view is updated incrementally: only the nodes that the world's issue validation queue reports as
+         * invalidated are revalidated, and their rows are replaced in the table. Nodes are validated in batches on
+         * worker threads, and each batch is scheduled as a separate event so that the editor stays responsive while a
+         * large map is being checked.
+         */
         class IssueBrowserView : public QWidget {
             Q_OBJECT
         private:
+            static constexpr size_t ValidationBatchSize = 2048u;
+
             std::weak_ptr<MapDocument> m_document;
 
             Model::IssueType m_hiddenGenerators;
             bool m_showHiddenIssues;
 
             bool m_valid;
+            std::vector<Model::Node*> m_pendingNodes;
+            std::unordered_set<Model::Node*> m_pendingNodeSet;
+            std::unique_ptr<Model::IssueGeneratorStats> m_stats;
+            bool m_logStats;
 
             QTableView* m_tableView;
             IssueBrowserModel* m_tableModel;
         public:
             explicit IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent = nullptr);
+            ~IssueBrowserView() override;
         private:
             void createGui();
         public:
             int hiddenGenerators() const;
             void setHiddenGenerators(int hiddenGenerators);
             void setShowHiddenIssues(bool show);
+
+            /**
+             * Discards all rows and revalidates every node of the world, e.g. after a document was loaded.
+             */
             void reload();
+
+            /**
+             * Removes the rows of the nodes that were invalidated or removed since the last call and schedules the
+             * invalidated nodes for revalidation.
+             */
+            void invalidate();
             void deselectAll();
+
+            /**
+             * The time spent in each issue generator since the last reload.
+             */
+            const Model::IssueGeneratorStats* stats() const;
         private:
             class IssueVisible;
-            class IssueCmp;
 
-            void updateIssues();
+            void processValidationQueue();
+            void refilter();
+            void addPendingNodes(const std::vector<Model::Node*>& nodes);
+            std::vector<Model::Node*> takePendingNodes(size_t count);
+            void validateNodes(const std::vector<Model::Node*>& nodes);
 
             std::vector<Model::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
             std::vector<Model::IssueQuickFix*> collectQuickFixes(const QList<QModelIndex>& indices) const;
@@ -85,24 +121,49 @@ namespace TrenchBroom {
             void hideIssues();
             void applyQuickFix(const Model::IssueQuickFix* quickFix);
         private:
-            void invalidate();
+            void scheduleValidation();
         public slots:
             void validate();
         };
 
         /**
-         * Trivial QAbstractTableModel subclass, when the issues list changes,
-         * it just refreshes the entire list with beginResetModel()/endResetModel().
+         * Holds the visible issues ordered by decreasing sequence ID, i.e. the most recently generated issues first.
+         *
+         * Each row remembers the node of its issue so that the rows of a node can be removed after the node's issues
+         * were invalidated and deleted, without accessing the deleted issues.
          */
         class IssueBrowserModel : public QAbstractTableModel {
             Q_OBJECT
         private:
-            std::vector<Model::Issue*> m_issues;
+            /**
+             * If the rows to remove are scattered across more runs than this, the model is reset instead.
+             */
+            static constexpr size_t MaxRemovedRuns = 64u;
+
+            struct Row {
+                Model::Node* node;
+                Model::Issue* issue;
+            };
+
+            std::vector<Row> m_rows;
         public:
             explicit IssueBrowserModel(QObject* parent);
 
-            void setIssues(std::vector<Model::Issue*> issues);
-            const std::vector<Model::Issue*>& issues();
+            void clear();
+
+            /**
+             * Adds the given issues. If they are newer than all existing issues, they are inserted at the top without
+             * resetting the model, which keeps the current selection and scroll position.
+             */
+            void addIssues(std::vector<Model::Issue*> issues);
+
+            /**
+             * Removes the rows of all issues of the given nodes.
+             */
+            void removeIssues(const std::unordered_set<Model::Node*>& nodes);
+
+            size_t issueCount() const;
+            Model::Issue* issue(size_t row) const;
         public: // QAbstractTableModel overrides
             int rowCount(const QModelIndex& parent) const override;
             int columnCount(const QModelIndex& parent) const override;
@@ -37,6 +37,7 @@
 #include "Model/AttributeValueWithDoubleQuotationMarksIssueGenerator.h"
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/ChangeBrushFaceAttributesRequest.h"
 #include "Model/CollectAttributableNodesVisitor.h"
@@ -55,6 +56,7 @@
 #include "Model/EmptyBrushEntityIssueGenerator.h"
 #include "Model/EmptyGroupIssueGenerator.h"
 #include "Model/Entity.h"
+#include "Model/Layer.h"
 #include "Model/LinkSourceIssueGenerator.h"
 #include "Model/LinkTargetIssueGenerator.h"
 #include "Model/Game.h"
@@ -120,6 +122,7 @@
 #include <kdl/collection_utils.h>
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
+#include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/polygon.h>
@@ -139,6 +142,16 @@ namespace TrenchBroom {
         const vm::bbox3 MapDocument::DefaultWorldBounds(-16384.0, 16384.0);
         const std::string MapDocument::DefaultDocumentName("unnamed.map");
 
+        static size_t textureBudget() {
+            const auto megabytes = pref(Preferences::TextureBudget);
+            return megabytes > 0 ? static_cast<size_t>(megabytes) * 1024u * 1024u : 0u;
+        }
+
+        static size_t undoBudget() {
+            const auto megabytes = pref(Preferences::UndoBudget);
+            return megabytes > 0 ? static_cast<size_t>(megabytes) * 1024u * 1024u : 0u;
+        }
+
         MapDocument::MapDocument() :
         m_worldBounds(DefaultWorldBounds),
         m_world(nullptr),
@@ -164,6 +177,8 @@ namespace TrenchBroom {
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
         m_viewEffectsService(nullptr) {
+                m_textureManager->setUseTextureArrays(pref(Preferences::TextureArrays));
+                m_textureManager->setTextureBudget(textureBudget());
                 bindObservers();
         }
 
@@ -177,6 +192,9 @@ namespace TrenchBroom {
                 unloadPortalFile();
             }
             clearWorld();
+
+            // frees the pooled faces and interned texture names once the last document has released its faces
+            Model::BrushFace::releaseUnusedMemory();
         }
 
         Logger& MapDocument::logger() {
@@ -317,6 +335,66 @@ namespace TrenchBroom {
             m_game->exportMap(*m_world, format, path);
         }
 
+        void MapDocument::exportVisibleLayersTo(const IO::Path& path) {
+            std::vector<Model::Node*> nodes;
+            for (auto* layer : m_world->allLayers()) {
+                if (layer->visible()) {
+                    kdl::vec_append(nodes, layer->children());
+                }
+            }
+
+            m_game->writePartialMap(*m_world, nodes, {}, path);
+        }
+
+        static std::vector<std::unique_ptr<Model::Brush>> createSealBrushes(const Model::BrushBuilder& builder, const vm::bbox3& region, const std::string& texture) {
+            static const auto Thickness = 16.0;
+            const auto outer = vm::bbox3(region.min - vm::vec3::fill(Thickness), region.max + vm::vec3::fill(Thickness));
+
+            std::vector<std::unique_ptr<Model::Brush>> result;
+            for (size_t i = 0; i < 3; ++i) {
+                auto below = outer;
+                below.max[i] = region.min[i];
+                result.emplace_back(builder.createCuboid(below, texture));
+
+                auto above = outer;
+                above.min[i] = region.max[i];
+                result.emplace_back(builder.createCuboid(above, texture));
+            }
+            return result;
+        }
+
+        void MapDocument::exportRegionTo(const vm::bbox3& region, const std::vector<Model::Node*>& excludedNodes, const std::string& sealTexture, const IO::Path& path) {
+            const auto excluded = kdl::vector_set<const Model::Node*>(std::begin(excludedNodes), std::end(excludedNodes));
+            const auto isExcluded = [&](const Model::Node* node) {
+                for (; node != nullptr; node = node->parent()) {
+                    if (excluded.count(node) > 0u) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            // Only the nodes near the region are visited. Brush entities are skipped because the query returns their
+            // brushes, and only the brushes inside the region are written with the entity.
+            std::vector<Model::Node*> nodes;
+            for (auto* node : m_world->findNodesIntersecting(region)) {
+                if (!node->hasChildren() && region.contains(node->logicalBounds()) && !isExcluded(node)) {
+                    nodes.push_back(node);
+                }
+            }
+
+            const auto builder = Model::BrushBuilder(m_world.get(), m_worldBounds);
+            const auto sealBrushes = createSealBrushes(builder, region, sealTexture);
+            const auto additionalBrushes = kdl::vec_transform(sealBrushes, [](const auto& brush) { return brush.get(); });
+
+            m_game->writePartialMap(*m_world, nodes, additionalBrushes, path);
+        }
+
+        void MapDocument::exportSelectionRegionTo(const std::string& sealTexture, const IO::Path& path) {
+            const auto& selection = selectedNodes().nodes();
+            exportRegionTo(selectionBounds(), selection, sealTexture, path);
+        }
+
         void MapDocument::doSaveDocument(const IO::Path& path) {
             saveDocumentTo(path);
             setLastSaveModificationCount();
@@ -407,11 +485,17 @@ namespace TrenchBroom {
                 unloadPointFile();
             }
 
-            m_pointFilePath = path;
-            m_pointFile = std::make_unique<Model::PointFile>(m_pointFilePath);
+            try {
+                m_pointFilePath = path;
+                m_pointFile = std::make_unique<Model::PointFile>(m_pointFilePath);
+            } catch (const std::exception& exception) {
+                info("Couldn't load point file " + m_pointFilePath.asString() + ": " + exception.what());
+            }
 
-            info("Loaded point file " + m_pointFilePath.asString());
-            pointFileWasLoadedNotifier();
+            if (isPointFileLoaded()) {
+                info("Loaded point file " + m_pointFilePath.asString());
+                pointFileWasLoadedNotifier();
+            }
         }
 
         bool MapDocument::isPointFileLoaded() const {
@@ -1522,6 +1606,14 @@ namespace TrenchBroom {
             return doGetRedoCommandName();
         }
 
+        size_t MapDocument::undoMemoryUsage() const {
+            return doGetUndoMemoryUsage();
+        }
+
+        void MapDocument::updateUndoMemoryBudget() {
+            doSetUndoMemoryBudget(undoBudget());
+        }
+
         void MapDocument::undoCommand() {
             doUndoCommand();
         }
@@ -1601,7 +1693,7 @@ namespace TrenchBroom {
         void MapDocument::loadWorld(const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game, const IO::Path& path) {
             m_worldBounds = worldBounds;
             m_game = game;
-            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, logger());
+            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, pref(Preferences::UseMapCache), logger());
             setCurrentLayer(m_world->defaultLayer());
 
             updateGameSearchPaths();
@@ -2154,6 +2246,14 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::TextureArrays.path()) {
+                // the textures are packed into arrays when they are added to the texture manager
+                m_textureManager->setUseTextureArrays(pref(Preferences::TextureArrays));
+                reloadTextureCollections();
+            } else if (path == Preferences::TextureBudget.path()) {
+                m_textureManager->setTextureBudget(textureBudget());
+            } else if (path == Preferences::UndoBudget.path()) {
+                updateUndoMemoryBudget();
             }
         }
 
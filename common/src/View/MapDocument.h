@@ -227,6 +227,25 @@ namespace TrenchBroom {
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
+
+            /**
+             * Writes the nodes of the visible layers to the given path for compiling.
+             */
+            void exportVisibleLayersTo(const IO::Path& path);
+
+            /**
+             * Writes the brushes and point entities whose bounds are contained in the given region to the given path
+             * for compiling. The given excluded nodes and their descendants are not written. The region is enclosed by
+             * brushes with the given texture so that the excluded parts of the map do not cause leaks.
+             */
+            void exportRegionTo(const vm::bbox3& region, const std::vector<Model::Node*>& excludedNodes, const std::string& sealTexture, const IO::Path& path);
+
+            /**
+             * Exports the region defined by the bounds of the current selection as described for exportRegionTo. The
+             * selected nodes only define the region and are not written, so that a brush drawn around the area to
+             * compile does not fill the sealed region.
+             */
+            void exportSelectionRegionTo(const std::string& sealTexture, const IO::Path& path);
         private:
             void doSaveDocument(const IO::Path& path);
             void clearDocument();
@@ -400,11 +419,14 @@ namespace TrenchBroom {
             bool canRedoCommand() const;
             const std::string& undoCommandName() const;
             const std::string& redoCommandName() const;
+            size_t undoMemoryUsage() const;
             void undoCommand();
             void redoCommand();
             bool canRepeatCommands() const;
             std::unique_ptr<CommandResult> repeatCommands();
             void clearRepeatableCommands();
+        protected:
+            void updateUndoMemoryBudget();
         public: // transactions
             void startTransaction(const std::string& name = "");
             void rollbackTransaction();
@@ -418,6 +440,8 @@ namespace TrenchBroom {
             virtual bool doCanRedoCommand() const = 0;
             virtual const std::string& doGetUndoCommandName() const = 0;
             virtual const std::string& doGetRedoCommandName() const = 0;
+            virtual size_t doGetUndoMemoryUsage() const = 0;
+            virtual void doSetUndoMemoryBudget(size_t memoryBudget) = 0;
             virtual void doUndoCommand() = 0;
             virtual void doRedoCommand() = 0;
             virtual bool doCanRepeatCommands() const = 0;
@@ -38,7 +38,6 @@
 #include "Model/Issue.h"
 #include "Model/ModelUtils.h"
 #include "Model/Snapshot.h"
-#include "Model/TransformObjectVisitor.h"
 #include "Model/World.h"
 #include "Model/NodeVisitor.h"
 #include "View/CommandProcessor.h"
@@ -67,6 +66,7 @@ namespace TrenchBroom {
 
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
         m_commandProcessor(std::make_unique<CommandProcessor>(this)) {
+            updateUndoMemoryBudget();
             bindObservers();
         }
 
@@ -466,36 +466,14 @@ namespace TrenchBroom {
             groupWasClosedNotifier(previousGroup);
         }
 
-        class CanTransformVisitor : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
-        private:
-            vm::mat4x4 m_transform;
-            vm::bbox3 m_worldBounds;
-        public:
-            CanTransformVisitor(const vm::mat4x4& transform, const vm::bbox3& worldBounds) :
-                m_transform(transform),
-                m_worldBounds(worldBounds) {}
-        private:
-            void doVisit(const Model::World*) override  { setResult(true); }
-            void doVisit(const Model::Layer*) override  { setResult(true); }
-            void doVisit(const Model::Group*) override  { setResult(true); }
-            void doVisit(const Model::Entity*) override { setResult(true); }
-            void doVisit(const Model::Brush* brush) override { setResult(brush->canTransform(m_transform, m_worldBounds)); }
-            bool doCombineResults(const bool oldResult, const bool newResult) const override {
-                return newResult && oldResult;
-            }
-        };
-
         bool MapDocumentCommandFacade::performTransform(const vm::mat4x4 &transform, const bool lockTextures) {
+          const std::vector<Model::Node*> &nodes = m_selectedNodes.nodes();
+
           // Test whether all brushes can be transformed; abort if any fail.
-          CanTransformVisitor canTransform(transform, m_worldBounds);
-          for (const auto* node : m_selectedNodes.nodes()) {
-              node->acceptAndRecurse(canTransform);
-          }
-          if (canTransform.hasResult() && !canTransform.result()) {
+          if (!Model::canTransformNodes(nodes, transform, m_worldBounds)) {
               return false;
           }
 
-          const std::vector<Model::Node*> &nodes = m_selectedNodes.nodes();
           const std::vector<Model::Node*> parents = collectParents(nodes);
 
           Notifier<const std::vector<Model::Node*> &>::NotifyBeforeAndAfter
@@ -504,9 +482,7 @@ namespace TrenchBroom {
           Notifier<const std::vector<Model::Node*> &>::NotifyBeforeAndAfter notifyNodes(
               nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
 
-          Model::TransformObjectVisitor visitor(transform, lockTextures,
-                                                m_worldBounds);
-          Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
+          Model::transformNodes(nodes, transform, lockTextures, m_worldBounds);
 
           invalidateSelectionBounds();
           return true;
@@ -1010,6 +986,14 @@ namespace TrenchBroom {
             return m_commandProcessor->redoCommandName();
         }
 
+        size_t MapDocumentCommandFacade::doGetUndoMemoryUsage() const {
+            return m_commandProcessor->memoryUsage();
+        }
+
+        void MapDocumentCommandFacade::doSetUndoMemoryBudget(const size_t memoryBudget) {
+            m_commandProcessor->setMemoryBudget(memoryBudget);
+        }
+
         void MapDocumentCommandFacade::doUndoCommand() {
             m_commandProcessor->undo();
         }
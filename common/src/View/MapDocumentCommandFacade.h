@@ -135,6 +135,8 @@ namespace TrenchBroom {
             bool doCanRedoCommand() const override;
             const std::string& doGetUndoCommandName() const override;
             const std::string& doGetRedoCommandName() const override;
+            size_t doGetUndoMemoryUsage() const override;
+            void doSetUndoMemoryBudget(size_t memoryBudget) override;
             void doUndoCommand() override;
             void doRedoCommand() override;
             bool doCanRepeatCommands() const override;
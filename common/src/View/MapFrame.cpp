@@ -108,6 +108,7 @@ namespace TrenchBroom {
         m_inspector(nullptr),
         m_gridChoice(nullptr),
         m_statusBarLabel(nullptr),
+        m_undoMemoryLabel(nullptr),
         m_compilationDialog(nullptr),
         m_recentDocumentsMenu(nullptr),
         m_undoAction(nullptr),
@@ -128,6 +129,7 @@ namespace TrenchBroom {
             updateShortcuts();
             updateActionState();
             updateUndoRedoActions();
+            updateUndoMemoryLabel();
             updateToolBarWidgets();
 
             m_document->setParentLogger(m_console);
@@ -413,6 +415,9 @@ namespace TrenchBroom {
         void MapFrame::createStatusBar() {
             m_statusBarLabel = new QLabel();
             statusBar()->addWidget(m_statusBarLabel);
+
+            m_undoMemoryLabel = new QLabel();
+            statusBar()->addPermanentWidget(m_undoMemoryLabel);
         }
 
         static Model::AttributableNode* commonEntityForBrushList(const std::vector<Model::Brush*>& list) {
@@ -539,6 +544,11 @@ namespace TrenchBroom {
             m_statusBarLabel->setText(QString(describeSelection(m_document.get())));
         }
 
+        void MapFrame::updateUndoMemoryLabel() {
+            const auto megabytes = static_cast<double>(m_document->undoMemoryUsage()) / (1024.0 * 1024.0);
+            m_undoMemoryLabel->setText(tr("Undo: %1 MiB").arg(QString::number(megabytes, 'f', 1)));
+        }
+
         void MapFrame::bindObservers() {
             PreferenceManager& prefs = PreferenceManager::instance();
             prefs.preferenceDidChangeNotifier.addObserver(this, &MapFrame::preferenceDidChange);
@@ -594,6 +604,7 @@ namespace TrenchBroom {
             updateTitle();
             updateActionState();
             updateRecentDocumentsMenu();
+            updateUndoMemoryLabel();
         }
 
         void MapFrame::documentModificationStateDidChange() {
@@ -609,6 +620,7 @@ namespace TrenchBroom {
                 // pushed onto the undo stack, but we need to read the undo stack in updateUndoRedoActions(),
                 // so this QTimer::singleShot is needed for now.
                 updateUndoRedoActions();
+                updateUndoMemoryLabel();
             });
         }
 
@@ -616,6 +628,7 @@ namespace TrenchBroom {
             QTimer::singleShot(0, this, [this]() {
                 // FIXME: see MapFrame::transactionDone
                 updateUndoRedoActions();
+                updateUndoMemoryLabel();
             });
         }
 
@@ -95,6 +95,7 @@ namespace TrenchBroom {
 
             QComboBox* m_gridChoice;
             QLabel* m_statusBarLabel;
+            QLabel* m_undoMemoryLabel;
 
             QDialog* m_compilationDialog;
         private: // shortcuts
@@ -133,6 +134,7 @@ namespace TrenchBroom {
         private: // status bar
             void createStatusBar();
             void updateStatusBar();
+            void updateUndoMemoryLabel();
         private: // gui creation
             void createGui();
         private: // notification handlers
@@ -69,7 +69,6 @@
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 
-#include <vecmath/polygon.h>
 #include <vecmath/util.h>
 
 #include <sstream>
@@ -935,18 +934,16 @@ namespace TrenchBroom {
             auto document = kdl::mem_lock(m_document);
             Model::PortalFile* portalFile = document->portalFile();
             if (portalFile != nullptr) {
-                for (const auto& poly : portalFile->portals()) {
-                    m_portalFileRenderer->renderFilledPolygon(pref(Preferences::PortalFileFillColor),
-                                                              Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-                                                              Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
-                                                              poly.vertices());
-
-                    const auto lineWidth = 4.0f;
-                    m_portalFileRenderer->renderPolygon(pref(Preferences::PortalFileBorderColor),
-                                                        lineWidth,
-                                                        Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-                                                        poly.vertices());
-                }
+                m_portalFileRenderer->renderFilledPolygons(pref(Preferences::PortalFileFillColor),
+                                                           Renderer::PrimitiveRendererOcclusionPolicy::Hide,
+                                                           Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
+                                                           portalFile->vertices(), portalFile->offsets());
+
+                const auto lineWidth = 4.0f;
+                m_portalFileRenderer->renderPolygons(pref(Preferences::PortalFileBorderColor),
+                                                     lineWidth,
+                                                     Renderer::PrimitiveRendererOcclusionPolicy::Hide,
+                                                     portalFile->vertices(), portalFile->offsets());
             }
         }
 
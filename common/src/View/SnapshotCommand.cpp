@@ -62,6 +62,16 @@ namespace TrenchBroom {
             m_snapshot.reset();
         }
 
+        size_t SnapshotCommand::doGetMemoryUsage() const {
+            return sizeof(SnapshotCommand) + (m_snapshot != nullptr ? m_snapshot->memoryUsage() : 0u);
+        }
+
+        void SnapshotCommand::doCompact() {
+            if (m_snapshot != nullptr) {
+                m_snapshot->compact();
+            }
+        }
+
         std::unique_ptr<Model::Snapshot> SnapshotCommand::doTakeSnapshot(MapDocumentCommandFacade *document) const {
             const auto& nodes = document->selectedNodes().nodes();
             return std::make_unique<Model::Snapshot>(std::begin(nodes), std::end(nodes));
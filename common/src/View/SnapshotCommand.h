@@ -45,6 +45,9 @@ namespace TrenchBroom {
             void takeSnapshot(MapDocumentCommandFacade* document);
             std::unique_ptr<CommandResult> restoreSnapshot(MapDocumentCommandFacade* document);
             void deleteSnapshot();
+
+            size_t doGetMemoryUsage() const override;
+            void doCompact() override;
         private:
             virtual std::unique_ptr<Model::Snapshot> doTakeSnapshot(MapDocumentCommandFacade* document) const;
 
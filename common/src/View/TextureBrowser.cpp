@@ -209,19 +209,19 @@ namespace TrenchBroom {
         }
 
         void TextureBrowser::nodesWereAdded(const std::vector<Model::Node*>&) {
-            reload();
+            refresh();
         }
 
         void TextureBrowser::nodesWereRemoved(const std::vector<Model::Node*>&) {
-            reload();
+            refresh();
         }
 
         void TextureBrowser::nodesDidChange(const std::vector<Model::Node*>&) {
-            reload();
+            refresh();
         }
 
         void TextureBrowser::brushFacesDidChange(const std::vector<Model::BrushFace*>&) {
-            reload();
+            refresh();
         }
 
         void TextureBrowser::textureCollectionsDidChange() {
@@ -250,6 +250,14 @@ namespace TrenchBroom {
             }
         }
 
+        void TextureBrowser::refresh() {
+            // changes to the usage counts are handled by the view, so there is no need to reload its layout here
+            if (m_view != nullptr) {
+                updateSelectedTexture();
+                m_view->update();
+            }
+        }
+
         void TextureBrowser::updateSelectedTexture() {
             auto document = kdl::mem_lock(m_document);
             const std::string& textureName = document->currentTextureName();
@@ -92,6 +92,7 @@ namespace TrenchBroom {
             void preferenceDidChange(const IO::Path& path);
 
             void reload();
+            void refresh();
             void updateSelectedTexture();
         };
     }
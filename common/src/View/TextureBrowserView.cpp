@@ -44,6 +44,8 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -63,7 +65,9 @@ namespace TrenchBroom {
         m_group(false),
         m_hideUnused(false),
         m_sortOrder(TextureSortOrder::Name),
-        m_selectedTexture(nullptr) {
+        m_selectedTexture(nullptr),
+        m_labelWidth(0.0f),
+        m_labelHeight(0.0f) {
             auto doc = kdl::mem_lock(m_document);
             doc->textureManager().usageCountDidChange.addObserver(this, &TextureBrowserView::usageCountDidChange);
         }
@@ -125,7 +129,11 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::usageCountDidChange() {
-            invalidate();
+            // the texture colors are determined when rendering, so the layout only changes if textures are hidden or
+            // sorted by their usage
+            if (m_hideUnused || m_sortOrder == TextureSortOrder::Usage) {
+                patchLayout();
+            }
             update();
         }
 
@@ -147,53 +155,108 @@ namespace TrenchBroom {
             assert(fontSize > 0);
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
+            const float maxCellWidth = layout.maxCellWidth();
 
-            if (m_group) {
-                for (const Assets::TextureCollection* collection : getCollections()) {
-                    layout.addGroup(collection->name(), static_cast<float>(fontSize) + 2.0f);
-                    for (Assets::Texture* texture : getTextures(collection))
-                        addTextureToLayout(layout, texture, font);
+            // the measured labels depend on the font and the cell width
+            if (!m_labelFont || m_labelFont->compare(font) != 0 || m_labelWidth != maxCellWidth) {
+                m_cellData.clear();
+                m_labelFont = font;
+                m_labelWidth = maxCellWidth;
+                m_labelHeight = fontManager().font(font).measure("").y();
+            }
+
+            // only the entries of textures that are still shown are carried over
+            CellDataMap newCellData;
+            m_layoutGroups = getLayoutGroups();
+            for (const TextureGroup& group : m_layoutGroups)
+                addTexturesToLayout(layout, group, 0, newCellData);
+            m_cellData = std::move(newCellData);
+        }
+
+        bool TextureBrowserView::doPatchLayout(Layout& layout) {
+            if (!m_labelFont)
+                return false;
+
+            auto newGroups = getLayoutGroups();
+
+            // find the first group whose name or textures differ from the current layout
+            size_t groupIndex = 0;
+            size_t textureIndex = 0;
+            bool keepGroup = false;
+            for (; groupIndex < std::min(m_layoutGroups.size(), newGroups.size()); ++groupIndex) {
+                const TextureGroup& oldGroup = m_layoutGroups[groupIndex];
+                const TextureGroup& newGroup = newGroups[groupIndex];
+                if (oldGroup.name != newGroup.name)
+                    break;
+
+                const auto [oldIt, newIt] = std::mismatch(std::begin(oldGroup.textures), std::end(oldGroup.textures), std::begin(newGroup.textures), std::end(newGroup.textures));
+                if (oldIt != std::end(oldGroup.textures) || newIt != std::end(newGroup.textures)) {
+                    textureIndex = static_cast<size_t>(std::distance(std::begin(oldGroup.textures), oldIt));
+                    keepGroup = true;
+                    break;
                 }
+            }
+
+            if (!keepGroup && groupIndex == m_layoutGroups.size() && groupIndex == newGroups.size())
+                return true;
+
+            // the cells before the first difference are left alone, only the following cells are added again
+            if (keepGroup) {
+                layout.removeCellsFrom(groupIndex, textureIndex);
+                addTexturesToLayout(layout, newGroups[groupIndex], textureIndex, m_cellData);
+                ++groupIndex;
             } else {
-                for (Assets::Texture* texture : getTextures())
-                    addTextureToLayout(layout, texture, font);
+                layout.removeGroupsFrom(groupIndex);
             }
+
+            for (; groupIndex < newGroups.size(); ++groupIndex)
+                addTexturesToLayout(layout, newGroups[groupIndex], 0, m_cellData);
+
+            m_layoutGroups = std::move(newGroups);
+            return true;
         }
 
-        void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font) {
-            const float maxCellWidth = layout.maxCellWidth();
+        void TextureBrowserView::addTexturesToLayout(Layout& layout, const TextureGroup& group, const size_t first, CellDataMap& newCellData) {
+            if (m_group && first == 0) {
+                const int fontSize = pref(Preferences::BrowserFontSize);
+                layout.addGroup(group.name, static_cast<float>(fontSize) + 2.0f);
+            }
+
+            for (size_t i = first; i < group.textures.size(); ++i)
+                addTextureToLayout(layout, group.textures[i], newCellData);
+        }
 
+        void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, CellDataMap& newCellData) {
             const auto& groupName   = texture->collection()->name();
             const auto  textureName = IO::Path(texture->name()).lastComponent().asString();
 
-            const auto textureFont = fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
-            const auto groupFont   = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
-
-            const auto defaultTextHeight = fontManager().font(font).measure(groupName + textureName).y();
-            const auto textureNameSize   = fontManager().font(textureFont).measure(textureName);
-            const auto groupNameSize     = fontManager().font(groupFont).measure(groupName);
-
-            const auto totalSize = vm::vec2f(vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
+            // the texture might have been deleted and another texture allocated at its address, so the titles must match
+            auto it = m_cellData.find(texture);
+            auto cellData = it != std::end(m_cellData) && it->second->mainTitle == textureName && it->second->subTitle == groupName
+                ? it->second
+                : std::shared_ptr<TextureCellData>(new TextureCellData{
+                    texture,
+                    textureName,
+                    groupName,
+                    false,
+                    vm::vec2f::zero(),
+                    vm::vec2f::zero(),
+                    *m_labelFont,
+                    *m_labelFont
+                });
+            newCellData[texture] = cellData;
 
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
             const float scaledTextureWidth = vm::round(scaleFactor * static_cast<float>(texture->width()));
             const float scaledTextureHeight = vm::round(scaleFactor * static_cast<float>(texture->height()));
 
-            auto cellData = std::shared_ptr<TextureCellData>(new TextureCellData{
-                texture,
-                textureName,
-                groupName,
-                vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
-                vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
-                textureFont,
-                groupFont
-            });
-
+            // the title size does not depend on the measured labels: the labels are centered in a title as wide as the
+            // cell and each label is at most one line of the default font high
             layout.addItem(QVariant::fromValue(cellData),
             scaledTextureWidth,
             scaledTextureHeight,
-            maxCellWidth,
-            totalSize.y());
+            m_labelWidth,
+            2.0f * m_labelHeight + 4.0f);
         }
 
         struct TextureBrowserView::CompareByUsageCount {
@@ -236,6 +299,17 @@ namespace TrenchBroom {
             }
         };
 
+        std::vector<TextureBrowserView::TextureGroup> TextureBrowserView::getLayoutGroups() const {
+            std::vector<TextureGroup> result;
+            if (m_group) {
+                for (const Assets::TextureCollection* collection : getCollections())
+                    result.push_back(TextureGroup{ collection->name(), getTextures(collection) });
+            } else {
+                result.push_back(TextureGroup{ "", getTextures() });
+            }
+            return result;
+        }
+
         std::vector<Assets::TextureCollection*> TextureBrowserView::getCollections() const {
             auto doc = kdl::mem_lock(m_document);
             std::vector<Assets::TextureCollection*> collections = doc->textureManager().collections();
@@ -281,7 +355,9 @@ namespace TrenchBroom {
             }
         }
 
-        void TextureBrowserView::doClear() {}
+        void TextureBrowserView::doClear() {
+            m_layoutGroups.clear();
+        }
 
         void TextureBrowserView::doRender(Layout& layout, const float y, const float height) {
             auto doc = kdl::mem_lock(m_document);
@@ -479,17 +555,18 @@ namespace TrenchBroom {
                             for (unsigned int k = 0; k < row.size(); k++) {
                                 const auto& cell = row[k];
                                 const auto titleBounds = cell.titleBounds();
-                                const auto& textureFont = fontManager().font(cellData(cell).mainTitleFont);
-                                const auto& groupFont   = fontManager().font(cellData(cell).subTitleFont);
+                                const auto& data = measuredCellData(cell);
+                                const auto& textureFont = fontManager().font(data.mainTitleFont);
+                                const auto& groupFont   = fontManager().font(data.subTitleFont);
 
                                 // y is relative to top, but OpenGL coords are relative to bottom, so invert
                                 const auto titleOffset = vm::vec2f(titleBounds.left(), y + height - titleBounds.bottom());
 
-                                const auto textureNameOffset = titleOffset + cellData(cell).mainTitleOffset;
-                                const auto groupNameOffset   = titleOffset + cellData(cell).subTitleOffset;
+                                const auto textureNameOffset = titleOffset + data.mainTitleOffset;
+                                const auto groupNameOffset   = titleOffset + data.subTitleOffset;
 
-                                const auto& textureName = cellData(cell).mainTitle;
-                                const auto& groupName   = cellData(cell).subTitle;
+                                const auto& textureName = data.mainTitle;
+                                const auto& groupName   = data.subTitle;
 
                                 const auto textureNameQuads = textureFont.quads(textureName, false, textureNameOffset);
                                 const auto groupNameQuads   = groupFont.quads(groupName, false, groupNameOffset);
@@ -506,8 +583,8 @@ namespace TrenchBroom {
                                     kdl::skip_iterator(std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2),
                                     kdl::skip_iterator(std::begin(subTextColor), std::end(subTextColor), 0, 0));
 
-                                kdl::vec_append(stringVertices[cellData(cell).mainTitleFont], textureNameVertices);
-                                kdl::vec_append(stringVertices[cellData(cell).subTitleFont], groupNameVertices);
+                                kdl::vec_append(stringVertices[data.mainTitleFont], textureNameVertices);
+                                kdl::vec_append(stringVertices[data.subTitleFont], groupNameVertices);
                             }
                         }
                     }
@@ -563,5 +640,24 @@ namespace TrenchBroom {
             auto ptr = any.value<std::shared_ptr<TextureCellData>>();
             return *ptr;
         }
+
+        const TextureCellData& TextureBrowserView::measuredCellData(const Cell& cell) {
+            QVariant any = cell.item();
+            auto ptr = any.value<std::shared_ptr<TextureCellData>>();
+            if (!ptr->measured) {
+                const auto textureFont = fontManager().selectFontSize(*m_labelFont, ptr->mainTitle, m_labelWidth, 6);
+                const auto groupFont   = fontManager().selectFontSize(*m_labelFont, ptr->subTitle, m_labelWidth, 6);
+
+                const auto textureNameSize = fontManager().font(textureFont).measure(ptr->mainTitle);
+                const auto groupNameSize   = fontManager().font(groupFont).measure(ptr->subTitle);
+
+                ptr->mainTitleOffset = vm::vec2f((m_labelWidth - textureNameSize.x()) / 2.0f, m_labelHeight + 3.0f);
+                ptr->subTitleOffset  = vm::vec2f((m_labelWidth - groupNameSize.x()) / 2.0f, 1.0f);
+                ptr->mainTitleFont   = textureFont;
+                ptr->subTitleFont    = groupFont;
+                ptr->measured        = true;
+            }
+            return *ptr;
+        }
     }
 }
@@ -26,7 +26,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class QScrollBar;
@@ -46,6 +48,12 @@ namespace TrenchBroom {
             Assets::Texture* texture;
             std::string mainTitle;
             std::string subTitle;
+
+            /**
+             * The label fonts and offsets are only measured once the cell becomes visible, see
+             * TextureBrowserView::measuredCellData.
+             */
+            bool measured;
             vm::vec2f mainTitleOffset;
             vm::vec2f subTitleOffset;
             Renderer::FontDescriptor mainTitleFont;
@@ -62,6 +70,16 @@ namespace TrenchBroom {
         private:
             using TextVertex = Renderer::GLVertexTypes::P2T2C4::Vertex;
             using StringMap = std::map<Renderer::FontDescriptor, std::vector<TextVertex>>;
+            using CellDataMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<TextureCellData>>;
+
+            /**
+             * The textures shown in one group of the layout, in layout order. If the textures are not grouped, the
+             * layout consists of a single group with an empty name.
+             */
+            struct TextureGroup {
+                std::string name;
+                std::vector<Assets::Texture*> textures;
+            };
 
             std::weak_ptr<MapDocument> m_document;
             bool m_group;
@@ -70,6 +88,22 @@ namespace TrenchBroom {
             std::string m_filterText;
 
             Assets::Texture* m_selectedTexture;
+
+            /**
+             * The cell data of the current layout by texture. The entries are reused when the layout is reloaded so that
+             * the labels of each texture are only measured once.
+             */
+            CellDataMap m_cellData;
+
+            /**
+             * The textures that the current layout was built from. When the usage counts change, the layout is patched
+             * starting with the first texture that differs from these.
+             */
+            std::vector<TextureGroup> m_layoutGroups;
+
+            std::optional<Renderer::FontDescriptor> m_labelFont;
+            float m_labelWidth;
+            float m_labelHeight;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
                                GLContextManager& contextManager,
@@ -88,7 +122,11 @@ namespace TrenchBroom {
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
-            void addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font);
+            bool doPatchLayout(Layout& layout) override;
+            void addTexturesToLayout(Layout& layout, const TextureGroup& group, size_t first, CellDataMap& newCellData);
+            void addTextureToLayout(Layout& layout, Assets::Texture* texture, CellDataMap& newCellData);
+
+            std::vector<TextureGroup> getLayoutGroups() const;
 
             struct CompareByUsageCount;
             struct CompareByName;
@@ -119,6 +157,7 @@ namespace TrenchBroom {
             void doContextMenu(Layout& layout, float x, float y, QContextMenuEvent* event) override;
 
             const TextureCellData& cellData(const Cell& cell) const;
+            const TextureCellData& measuredCellData(const Cell& cell);
         signals:
             void textureSelected(Assets::Texture* texture);
         };
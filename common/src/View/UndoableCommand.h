@@ -43,6 +43,17 @@ namespace TrenchBroom {
             std::unique_ptr<UndoableCommand> repeat(MapDocumentCommandFacade* document) const;
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns an estimate of the number of bytes this command keeps in order to be undone.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * Discards any data held by this command that can be reconstructed when it is undone, making the command
+             * cheaper to keep on the undo stack at the cost of a slower undo.
+             */
+            void compact();
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
@@ -51,6 +62,9 @@ namespace TrenchBroom {
             virtual std::unique_ptr<UndoableCommand> doRepeat(MapDocumentCommandFacade* document) const;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
+
+            virtual size_t doGetMemoryUsage() const;
+            virtual void doCompact();
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
 
@@ -167,6 +167,16 @@ namespace TrenchBroom {
             m_snapshot.reset();
         }
 
+        size_t VertexCommand::doGetMemoryUsage() const {
+            return sizeof(VertexCommand) + (m_snapshot != nullptr ? m_snapshot->memoryUsage() : 0u);
+        }
+
+        void VertexCommand::doCompact() {
+            if (m_snapshot != nullptr) {
+                m_snapshot->compact();
+            }
+        }
+
         bool VertexCommand::canCollateWith(const VertexCommand& other) const {
             return m_brushes == other.m_brushes;
         }
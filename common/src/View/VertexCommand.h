@@ -97,6 +97,9 @@ namespace TrenchBroom {
         private:
             void takeSnapshot();
             void deleteSnapshot();
+
+            size_t doGetMemoryUsage() const override;
+            void doCompact() override;
         protected:
             bool canCollateWith(const VertexCommand& other) const;
         private:
@@ -31,6 +31,7 @@ namespace TrenchBroom {
 
     void assertTree(const std::string& exp, const AABB& actual);
     void assertIntersectors(const AABB& tree, const RAY& ray, std::initializer_list<AABB::DataType> items);
+    void assertIntersectors(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items);
     void assertTreeContains(const AABB& tree, const BOX& box, AABB::DataType data);
     void assertTreeDoesNotContain(const AABB& tree, const BOX& box, AABB::DataType data);
 
@@ -484,6 +485,18 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST(AABBTreeTest, findBoxIntersectors) {
+        AABB tree;
+        tree.insert(BOX(VEC(-4.0, -1.0, -1.0), VEC(-2.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+2.0, +3.0, -1.0), VEC(+4.0, +5.0, +1.0)), 3u);
+
+        assertIntersectors(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), {});
+        assertIntersectors(tree, BOX(VEC(-3.0, -1.0, -1.0), VEC(+3.0, +1.0, +1.0)), { 1u, 2u });
+        assertIntersectors(tree, BOX(VEC(+3.0, -2.0, -1.0), VEC(+5.0, +4.0, +1.0)), { 2u, 3u });
+        assertIntersectors(tree, BOX(VEC(-8.0, -8.0, -8.0), VEC(+8.0, +8.0, +8.0)), { 1u, 2u, 3u });
+    }
+
     void assertTree(const std::string& exp, const AABB& actual) {
         std::stringstream str;
         actual.print(str);
@@ -499,6 +512,15 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         ASSERT_EQ(expected, actual);
     }
 
+    void assertIntersectors(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectors(box, std::inserter(actual, std::end(actual)));
+
+        ASSERT_EQ(expected, actual);
+    }
+
     void assertTreeContains(const AABB& tree, const BOX& box, AABB::DataType data) {
         ASSERT_TRUE(tree.contains(data));
 
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelPickingTree.h"
+#include "Renderer/IndexRangeMap.h"
+#include "Renderer/PrimType.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        static std::vector<EntityModelVertex> createVertices(const std::vector<vm::vec3f>& positions) {
+            std::vector<EntityModelVertex> result;
+            for (const auto& position : positions) {
+                result.emplace_back(position, vm::vec2f::zero());
+            }
+            return result;
+        }
+
+        TEST(EntityModelTest, buildSpacialTreeOnFirstIntersection) {
+            EntityModel model("model");
+            model.addFrames(1);
+            auto& frame = model.loadFrame(0, "frame", vm::bbox3f(vm::vec3f(-16.0f, -16.0f, 0.0f), vm::vec3f(16.0f, 16.0f, 32.0f)));
+
+            // two surfaces with separate vertex arrays, a quad at z=0 and one at z=32
+            for (const auto z : { 0.0f, 32.0f }) {
+                const auto vertices = createVertices({
+                    vm::vec3f(-16.0f, -16.0f, z), vm::vec3f( 16.0f, -16.0f, z), vm::vec3f( 16.0f,  16.0f, z),
+                    vm::vec3f(-16.0f, -16.0f, z), vm::vec3f( 16.0f,  16.0f, z), vm::vec3f(-16.0f,  16.0f, z)
+                });
+                auto& surface = model.addSurface("surface");
+                surface.addIndexedMesh(frame, vertices, Renderer::IndexRangeMap(Renderer::PrimType::Triangles, 0, vertices.size()));
+            }
+
+            ASSERT_FALSE(frame.hasSpacialTree());
+
+            ASSERT_FLOAT_EQ(32.0f, frame.intersect(vm::ray3f(vm::vec3f(8.0f, 8.0f, 64.0f), vm::vec3f::neg_z())));
+            ASSERT_TRUE(frame.hasSpacialTree());
+            ASSERT_EQ(4u, frame.spacialTree().triangleCount());
+
+            ASSERT_FLOAT_EQ(64.0f, frame.intersect(vm::ray3f(vm::vec3f(-8.0f, 8.0f, -64.0f), vm::vec3f::pos_z())));
+            ASSERT_FLOAT_EQ(16.0f, frame.intersect(vm::ray3f(vm::vec3f(0.0f, 0.0f, 16.0f), vm::vec3f::pos_z())));
+            ASSERT_TRUE(vm::is_nan(frame.intersect(vm::ray3f(vm::vec3f(32.0f, 0.0f, 64.0f), vm::vec3f::neg_z()))));
+            ASSERT_TRUE(vm::is_nan(frame.intersect(vm::ray3f(vm::vec3f(0.0f, 0.0f, 64.0f), vm::vec3f::pos_z()))));
+        }
+
+        TEST(EntityModelTest, intersectTriangleFan) {
+            const auto vertices = createVertices({
+                vm::vec3f(0.0f, 0.0f, 0.0f), vm::vec3f(32.0f, 0.0f, 0.0f), vm::vec3f(32.0f, 32.0f, 0.0f), vm::vec3f(-32.0f, 32.0f, 0.0f)
+            });
+
+            EntityModelPickingTree tree;
+            tree.addPrimitives(vertices, Renderer::PrimType::TriangleFan, 0, vertices.size());
+            tree.build();
+            ASSERT_EQ(2u, tree.triangleCount());
+
+            // the second triangle extends beyond the bounds of its first two vertices
+            ASSERT_FLOAT_EQ(8.0f, tree.intersect(vm::ray3f(vm::vec3f(-16.0f, 24.0f, 8.0f), vm::vec3f::neg_z())));
+            ASSERT_TRUE(vm::is_nan(tree.intersect(vm::ray3f(vm::vec3f(-16.0f, 8.0f, 8.0f), vm::vec3f::neg_z()))));
+        }
+
+        TEST(EntityModelTest, intersectManyTriangles) {
+            // a grid of 16x16 quads split into triangles, enough for several levels of nodes
+            std::vector<vm::vec3f> positions;
+            for (size_t y = 0; y < 16u; ++y) {
+                for (size_t x = 0; x < 16u; ++x) {
+                    const auto x0 = static_cast<float>(x) * 8.0f, y0 = static_cast<float>(y) * 8.0f;
+                    const auto x1 = x0 + 8.0f, y1 = y0 + 8.0f;
+                    const auto z = static_cast<float>(x + y);
+                    positions.insert(std::end(positions), {
+                        vm::vec3f(x0, y0, z), vm::vec3f(x1, y0, z), vm::vec3f(x1, y1, z),
+                        vm::vec3f(x0, y0, z), vm::vec3f(x1, y1, z), vm::vec3f(x0, y1, z)
+                    });
+                }
+            }
+            const auto vertices = createVertices(positions);
+
+            EntityModelPickingTree tree;
+            tree.addPrimitives(vertices, Renderer::PrimType::Triangles, 0, vertices.size());
+            tree.build();
+            ASSERT_EQ(512u, tree.triangleCount());
+            ASSERT_LT(1u, tree.nodeCount());
+
+            for (size_t y = 0; y < 16u; ++y) {
+                for (size_t x = 0; x < 16u; ++x) {
+                    const auto origin = vm::vec3f(static_cast<float>(x) * 8.0f + 3.0f, static_cast<float>(y) * 8.0f + 5.0f, 64.0f);
+                    ASSERT_FLOAT_EQ(64.0f - static_cast<float>(x + y), tree.intersect(vm::ray3f(origin, vm::vec3f::neg_z())));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Color.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureArray.h"
+#include "Assets/TextureCollection.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        static Texture* createTexture(const std::string& name, const size_t width, const size_t height, const TextureType type = TextureType::Opaque) {
+            auto buffer = std::vector<unsigned char>(width * height * 3u);
+            return new Texture(name, width, height, Color(), std::move(buffer), GL_RGB, type);
+        }
+
+        TEST(TextureArrayTest, packTexturesOfSameSize) {
+            auto collection = TextureCollection(std::vector<Texture*>{
+                createTexture("a", 64, 64),
+                createTexture("b", 32, 32),
+                createTexture("c", 64, 64),
+                createTexture("d", 32, 32),
+                createTexture("e", 64, 64)
+            });
+
+            const auto arrays = TextureArray::pack(collection.textures());
+            ASSERT_EQ(2u, arrays.size());
+
+            const auto& small = *arrays[0];
+            ASSERT_EQ(32u, small.width());
+            ASSERT_EQ(2u, small.layerCount());
+            ASSERT_EQ(collection.textureByName("b"), small.batchTexture());
+
+            const auto& large = *arrays[1];
+            ASSERT_EQ(64u, large.width());
+            ASSERT_EQ(3u, large.layerCount());
+
+            const auto* c = collection.textureByName("c");
+            ASSERT_EQ(&large, c->array());
+            ASSERT_EQ(1u, c->layer());
+            ASSERT_EQ(2u, collection.textureByName("e")->layer());
+        }
+
+        TEST(TextureArrayTest, leaveUnmatchedTexturesAlone) {
+            auto collection = TextureCollection(std::vector<Texture*>{
+                createTexture("a", 64, 64),
+                createTexture("b", 64, 32),
+                createTexture("c", 64, 64, TextureType::Masked),
+                createTexture("d", 64, 64)
+            });
+            collection.textureByName("d")->setCulling(TextureCulling::CullNone);
+
+            const auto arrays = TextureArray::pack(collection.textures());
+            ASSERT_TRUE(arrays.empty());
+
+            for (const auto* texture : collection.textures()) {
+                ASSERT_EQ(nullptr, texture->array());
+                ASSERT_EQ(0u, texture->layer());
+            }
+        }
+
+        TEST(TextureArrayTest, splitAtMaxLayers) {
+            std::vector<Texture*> textures;
+            for (size_t i = 0; i < 7u; ++i) {
+                textures.push_back(createTexture(std::to_string(i), 16, 16));
+            }
+            auto collection = TextureCollection(textures);
+
+            // the seventh texture would be alone in its array, so it isn't packed
+            const auto arrays = TextureArray::pack(collection.textures(), 3u);
+            ASSERT_EQ(2u, arrays.size());
+            ASSERT_EQ(3u, arrays[0]->layerCount());
+            ASSERT_EQ(3u, arrays[1]->layerCount());
+            ASSERT_EQ(arrays[1].get(), textures[5]->array());
+            ASSERT_EQ(2u, textures[5]->layer());
+            ASSERT_EQ(nullptr, textures[6]->array());
+        }
+
+        TEST(TextureArrayTest, repackCollection) {
+            auto collection = TextureCollection(std::vector<Texture*>{
+                createTexture("a", 64, 64),
+                createTexture("b", 64, 64),
+                createTexture("c", 64, 64)
+            });
+
+            collection.packTextureArrays(TextureArray::MaxLayers);
+            ASSERT_EQ(1u, collection.textureArrays().size());
+            ASSERT_EQ(2u, collection.textureByName("c")->layer());
+
+            collection.packTextureArrays(2u);
+            ASSERT_EQ(1u, collection.textureArrays().size());
+            ASSERT_EQ(collection.textureArrays().front().get(), collection.textureByName("b")->array());
+            ASSERT_EQ(nullptr, collection.textureByName("c")->array());
+            ASSERT_EQ(0u, collection.textureByName("c")->layer());
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Color.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureResidency.h"
+
+#include <kdl/vector_utils.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class StubTextureUploader : public TextureUploader {
+        public:
+            std::vector<const Texture*> uploaded;
+            std::vector<const Texture*> evicted;
+
+            size_t upload(const Texture& texture, const int /* minFilter */, const int /* magFilter */) override {
+                uploaded.push_back(&texture);
+                return texture.width() * texture.height() * 4u;
+            }
+
+            void evict(const Texture& texture) override {
+                evicted.push_back(&texture);
+            }
+        };
+
+        static Texture* createTexture(const std::string& name) {
+            auto buffer = std::vector<unsigned char>(16u * 16u * 3u);
+            return new Texture(name, 16u, 16u, Color(), std::move(buffer), GL_RGB, TextureType::Opaque);
+        }
+
+        static constexpr size_t TextureSize = 16u * 16u * 4u;
+
+        static void commitFrames(TextureResidency& residency, const size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                residency.commit();
+            }
+        }
+
+        TEST(TextureResidencyTest, uploadOnFirstUse) {
+            auto uploader = std::make_unique<StubTextureUploader>();
+            auto& stub = *uploader;
+            TextureResidency residency(std::move(uploader), TextureResidency::Unlimited, 0, 0);
+
+            std::vector<Texture*> textures{ createTexture("a"), createTexture("b") };
+            ASSERT_FALSE(residency.isResident(textures[0]));
+
+            residency.use(textures[0]);
+            residency.use(textures[0]);
+            ASSERT_TRUE(residency.isResident(textures[0]));
+            ASSERT_FALSE(residency.isResident(textures[1]));
+            ASSERT_EQ(std::vector<const Texture*>{ textures[0] }, stub.uploaded);
+            ASSERT_EQ(TextureSize, residency.residentBytes());
+
+            // without a budget, nothing is ever evicted
+            commitFrames(residency, 2u * TextureResidency::ProtectedFrames);
+            ASSERT_TRUE(residency.isResident(textures[0]));
+            ASSERT_TRUE(stub.evicted.empty());
+
+            residency.remove(textures);
+            ASSERT_EQ(0u, residency.residentCount());
+            ASSERT_EQ(std::vector<const Texture*>{ textures[0] }, stub.evicted);
+
+            kdl::vec_clear_and_delete(textures);
+        }
+
+        TEST(TextureResidencyTest, evictLeastRecentlyUsed) {
+            auto uploader = std::make_unique<StubTextureUploader>();
+            auto& stub = *uploader;
+            TextureResidency residency(std::move(uploader), 2u * TextureSize, 0, 0);
+
+            std::vector<Texture*> textures{ createTexture("a"), createTexture("b"), createTexture("c") };
+            for (auto* texture : textures) {
+                residency.use(texture);
+            }
+            residency.use(textures[0]);
+
+            // all textures were used recently, so the budget is exceeded
+            residency.commit();
+            ASSERT_EQ(3u, residency.residentCount());
+            ASSERT_EQ(3u * TextureSize, residency.residentBytes());
+
+            // once they are no longer protected, the least recently used texture is evicted
+            commitFrames(residency, TextureResidency::ProtectedFrames);
+            ASSERT_EQ(2u, residency.residentCount());
+            ASSERT_EQ(std::vector<const Texture*>{ textures[1] }, stub.evicted);
+            ASSERT_TRUE(residency.isResident(textures[0]));
+            ASSERT_TRUE(residency.isResident(textures[2]));
+
+            // using an evicted texture uploads it again
+            residency.use(textures[1]);
+            ASSERT_EQ(4u, residency.uploadCount());
+            ASSERT_EQ(1u, residency.evictionCount());
+
+            kdl::vec_clear_and_delete(textures);
+        }
+
+        TEST(TextureResidencyTest, keepRecentlyUsedTextures) {
+            auto uploader = std::make_unique<StubTextureUploader>();
+            auto& stub = *uploader;
+            TextureResidency residency(std::move(uploader), TextureSize, 0, 0);
+
+            std::vector<Texture*> textures{ createTexture("a"), createTexture("b") };
+            residency.use(textures[0]);
+            residency.use(textures[1]);
+
+            // texture b is used in every frame and must never be evicted
+            for (size_t i = 0; i < 2u * TextureResidency::ProtectedFrames; ++i) {
+                residency.use(textures[1]);
+                residency.commit();
+            }
+
+            ASSERT_EQ(std::vector<const Texture*>{ textures[0] }, stub.evicted);
+            ASSERT_TRUE(residency.isResident(textures[1]));
+            ASSERT_EQ(TextureSize, residency.residentBytes());
+
+            kdl::vec_clear_and_delete(textures);
+        }
+
+        TEST(TextureResidencyTest, lowerBudget) {
+            auto uploader = std::make_unique<StubTextureUploader>();
+            auto& stub = *uploader;
+            TextureResidency residency(std::move(uploader), TextureResidency::Unlimited, 0, 0);
+
+            std::vector<Texture*> textures{ createTexture("a"), createTexture("b"), createTexture("c") };
+            for (auto* texture : textures) {
+                residency.use(texture);
+            }
+            commitFrames(residency, TextureResidency::ProtectedFrames);
+            ASSERT_EQ(3u, residency.residentCount());
+
+            residency.setBudget(TextureSize);
+            residency.commit();
+            ASSERT_EQ((std::vector<const Texture*>{ textures[0], textures[1] }), stub.evicted);
+            ASSERT_TRUE(residency.isResident(textures[2]));
+
+            residency.clear();
+            ASSERT_EQ(0u, residency.residentCount());
+            ASSERT_EQ(0u, residency.residentBytes());
+
+            kdl::vec_clear_and_delete(textures);
+        }
+    }
+}
@@ -347,6 +347,74 @@ namespace TrenchBroom {
             profile->task(0)->accept(AssertCompilationRunToolVisitor("tyrbsp.exe", "this and that"));
         }
 
+        TEST(CompilationConfigParserTest, parseOneProfileWithNameAndOneToolTaskWithInputsAndOutputs) {
+            const std::string config("{\n"
+                                "    'version': 1,\n"
+                                "    'profiles': [\n"
+                                "        {\n"
+                                "             'name': 'A profile',\n"
+                                "             'workdir': '',\n"
+                                "             'tasks': [\n"
+                                "                 {\n"
+                                "                      'type':'tool',\n"
+                                "                      'tool': 'tyrlight.exe',\n"
+                                "                      'parameters': 'map.bsp',\n"
+                                "                      'inputs': 'map.bsp',\n"
+                                "                      'outputs': 'map.bsp;map.lit'\n"
+                                "                 }\n"
+                                "             ]\n"
+                                "        }\n"
+                                "    ]\n"
+                                "}\n");
+            CompilationConfigParser parser(config);
+
+            Model::CompilationConfig result = parser.parse();
+            ASSERT_EQ(1u, result.profileCount());
+
+            const auto* task = dynamic_cast<const Model::CompilationRunTool*>(result.profile(0)->task(0));
+            ASSERT_NE(nullptr, task);
+            ASSERT_EQ(std::string("map.bsp"), task->inputSpec());
+            ASSERT_EQ(std::string("map.bsp;map.lit"), task->outputSpec());
+        }
+
+        TEST(CompilationConfigParserTest, parseOneProfileWithNameAndOneExportTaskWithScope) {
+            const std::string config("{\n"
+                                "    'version': 1,\n"
+                                "    'profiles': [\n"
+                                "        {\n"
+                                "             'name': 'A profile',\n"
+                                "             'workdir': '',\n"
+                                "             'tasks': [\n"
+                                "                 {\n"
+                                "                      'type':'export',\n"
+                                "                      'target': 'map.map'\n"
+                                "                 },\n"
+                                "                 {\n"
+                                "                      'type':'export',\n"
+                                "                      'target': 'region.map',\n"
+                                "                      'scope': 'selection',\n"
+                                "                      'sealTexture': 'caulk'\n"
+                                "                 }\n"
+                                "             ]\n"
+                                "        }\n"
+                                "    ]\n"
+                                "}\n");
+            CompilationConfigParser parser(config);
+
+            Model::CompilationConfig result = parser.parse();
+            ASSERT_EQ(1u, result.profileCount());
+
+            const auto* mapTask = dynamic_cast<const Model::CompilationExportMap*>(result.profile(0)->task(0));
+            ASSERT_NE(nullptr, mapTask);
+            ASSERT_EQ(Model::CompilationExportMap::Scope::Map, mapTask->scope());
+
+            const auto* regionTask = dynamic_cast<const Model::CompilationExportMap*>(result.profile(0)->task(1));
+            ASSERT_NE(nullptr, regionTask);
+            ASSERT_EQ(std::string("region.map"), regionTask->targetSpec());
+            ASSERT_EQ(Model::CompilationExportMap::Scope::Selection, regionTask->scope());
+            ASSERT_EQ(std::string("caulk"), regionTask->sealTexture());
+        }
+
         TEST(CompilationConfigParserTest, parseOneProfileWithNameAndTwoTasks) {
             const std::string config("{\n"
                                 "    'version': 1,\n"
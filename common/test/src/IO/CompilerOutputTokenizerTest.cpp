@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/CompilerOutputTokenizer.h"
+
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static void assertToken(const CompilerOutputTokenizer::Token& token, const CompilerOutputToken::Type type, const std::string& data, const size_t line) {
+            ASSERT_EQ(type, token.type());
+            ASSERT_EQ(data, token.data());
+            ASSERT_EQ(line, token.line());
+        }
+
+        TEST(CompilerOutputTokenizerTest, tokenizeEmptyString) {
+            const std::string str;
+            CompilerOutputTokenizer tokenizer(str.data(), str.data() + str.size());
+            ASSERT_EQ(CompilerOutputToken::Eof, tokenizer.nextToken().type());
+        }
+
+        TEST(CompilerOutputTokenizerTest, tokenizeLines) {
+            const std::string str("1 -2.5 3\n\n4\t5 6\r\n");
+            CompilerOutputTokenizer tokenizer(str.data(), str.data() + str.size());
+
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "1", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Decimal, "-2.5", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "3", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Eol, "\n", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Eol, "\n", 2u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "4", 3u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "5", 3u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "6", 3u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Eol, "\n", 3u);
+            ASSERT_EQ(CompilerOutputToken::Eof, tokenizer.nextToken().type());
+        }
+
+        TEST(CompilerOutputTokenizerTest, skipLineBreaks) {
+            const std::string str("\n\n1 2 3\n\n");
+            CompilerOutputTokenizer tokenizer(str.data(), str.data() + str.size());
+
+            assertToken(tokenizer.nextToken(CompilerOutputToken::Eol), CompilerOutputToken::Integer, "1", 3u);
+            assertToken(tokenizer.nextToken(CompilerOutputToken::Eol), CompilerOutputToken::Integer, "2", 3u);
+            assertToken(tokenizer.nextToken(CompilerOutputToken::Eol), CompilerOutputToken::Integer, "3", 3u);
+            ASSERT_EQ(CompilerOutputToken::Eof, tokenizer.nextToken(CompilerOutputToken::Eol).type());
+        }
+
+        TEST(CompilerOutputTokenizerTest, skipParentheses) {
+            // portal files group the vertices of a portal by parentheses
+            const std::string str("4 0 1 (0 0 0 ) (64 0.5 0)\n");
+            CompilerOutputTokenizer tokenizer(str.data(), str.data() + str.size());
+
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "4", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "0", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "1", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "0", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "0", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "0", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "64", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Decimal, "0.5", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "0", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Eol, "\n", 1u);
+            ASSERT_EQ(CompilerOutputToken::Eof, tokenizer.nextToken().type());
+        }
+
+        TEST(CompilerOutputTokenizerTest, tokenizeWords) {
+            const std::string str("PRT1\n12x 3\n");
+            CompilerOutputTokenizer tokenizer(str.data(), str.data() + str.size());
+
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Word, "PRT1", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Eol, "\n", 1u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Word, "12x", 2u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Integer, "3", 2u);
+            assertToken(tokenizer.nextToken(), CompilerOutputToken::Eol, "\n", 2u);
+            ASSERT_EQ(CompilerOutputToken::Eof, tokenizer.nextToken().type());
+        }
+    }
+}
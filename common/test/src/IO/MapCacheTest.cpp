@@ -0,0 +1,165 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "IO/MapCache.h"
+#include "IO/NodeWriter.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/Node.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const std::string MapData(R"(// entity 0
+{
+"classname" "worldspawn"
+"message" "cached"
+// brush 0
+{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) tex1 0 0 0 1 1 0 0 0
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) tex1 0 0 0 1 1 0 0 0
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) tex2 16 8 45 0.5 0.5 1 2 3.5
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) tex1 0 0 0 1 1 0 0 0
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) tex1 0 0 0 1 1 0 0 0
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) tex1 0 0 0 1 1 0 0 0
+}
+}
+// entity 1
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "My Layer"
+"_tb_id" "1"
+}
+// entity 2
+{
+"classname" "light"
+"origin" "1 2 3"
+"_tb_layer" "1"
+}
+)");
+
+        static std::string writeWorld(Model::World& world) {
+            std::stringstream str;
+            NodeWriter writer(world, str);
+            writer.writeMap();
+            return str.str();
+        }
+
+        static std::string createCache(const std::string& data, const Model::MapFormat format) {
+            const vm::bbox3 worldBounds(8192.0);
+
+            MapCacheWriter cacheWriter;
+            TestParserStatus status;
+            WorldReader reader(data);
+            reader.setCacheWriter(&cacheWriter);
+            reader.read(format, worldBounds, status);
+
+            return cacheWriter.serialize(format, data.data(), data.data() + data.size());
+        }
+
+        TEST(MapCacheTest, readWorldFromCache) {
+            const auto format = Model::MapFormat::Quake2;
+            const vm::bbox3 worldBounds(8192.0);
+
+            TestParserStatus status;
+            WorldReader textReader(MapData);
+            auto expected = textReader.read(format, worldBounds, status);
+
+            const auto cacheData = createCache(MapData, format);
+            MapCacheReader cache(cacheData.data(), cacheData.data() + cacheData.size(), format, MapData.data(), MapData.data() + MapData.size());
+            WorldReader cacheReader(MapData);
+            auto actual = cacheReader.read(cache, worldBounds, status);
+
+            ASSERT_EQ(1u, actual->customLayers().size());
+            ASSERT_EQ(1u, actual->defaultLayer()->childCount());
+            ASSERT_EQ(writeWorld(*expected), writeWorld(*actual));
+
+            const auto* expectedBrush = expected->defaultLayer()->children().front();
+            const auto* actualBrush = actual->defaultLayer()->children().front();
+            ASSERT_EQ(expectedBrush->lineNumber(), actualBrush->lineNumber());
+        }
+
+        TEST(MapCacheTest, replayParserWarnings) {
+            const auto format = Model::MapFormat::Standard;
+            const vm::bbox3 worldBounds(8192.0);
+            const std::string data(R"(// entity 0
+{
+"classname" "worldspawn"
+"message" "first"
+"message" "duplicate"
+}
+)");
+
+            TestParserStatus textStatus;
+            WorldReader textReader(data);
+            textReader.read(format, worldBounds, textStatus);
+            ASSERT_EQ(1u, textStatus.countStatus(LogLevel::Warn));
+
+            // the warning is reported again when the world is read from the cache
+            TestParserStatus cacheStatus;
+            const auto cacheData = createCache(data, format);
+            MapCacheReader cache(cacheData.data(), cacheData.data() + cacheData.size(), format, data.data(), data.data() + data.size());
+            WorldReader cacheReader(data);
+            cacheReader.read(cache, worldBounds, cacheStatus);
+            ASSERT_EQ(1u, cacheStatus.countStatus(LogLevel::Warn));
+        }
+
+        TEST(MapCacheTest, rejectDifferentContent) {
+            const auto format = Model::MapFormat::Quake2;
+            const auto otherData = MapData + "\n";
+
+            const auto cache = createCache(MapData, format);
+
+            ASSERT_THROW(MapCacheReader(cache.data(), cache.data() + cache.size(), format, otherData.data(), otherData.data() + otherData.size()), FileFormatException);
+        }
+
+        TEST(MapCacheTest, rejectDifferentFormat) {
+            const auto cache = createCache(MapData, Model::MapFormat::Quake2);
+
+            ASSERT_THROW(MapCacheReader(cache.data(), cache.data() + cache.size(), Model::MapFormat::Standard, MapData.data(), MapData.data() + MapData.size()), FileFormatException);
+        }
+
+        TEST(MapCacheTest, rejectCorruptCache) {
+            const auto format = Model::MapFormat::Quake2;
+            const auto cache = createCache(MapData, format);
+
+            auto truncated = cache.substr(0u, cache.size() - 1u);
+            ASSERT_THROW(MapCacheReader(truncated.data(), truncated.data() + truncated.size(), format, MapData.data(), MapData.data() + MapData.size()), FileFormatException);
+
+            auto modified = cache;
+            modified[modified.size() - 10u] ^= 0x01;
+            ASSERT_THROW(MapCacheReader(modified.data(), modified.data() + modified.size(), format, MapData.data(), MapData.data() + MapData.size()), FileFormatException);
+
+            ASSERT_THROW(MapCacheReader(cache.data(), cache.data(), format, MapData.data(), MapData.data() + MapData.size()), FileFormatException);
+        }
+    }
+}
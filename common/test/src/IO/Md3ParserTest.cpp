@@ -56,6 +56,11 @@ namespace TrenchBroom {
             parser.loadFrame(0, *model, logger);
 
             ASSERT_NE(nullptr, model);
+            ASSERT_FALSE(model->skinsLoaded());
+            ASSERT_EQ(0u, model->surface(0).skinCount());
+
+            parser.loadSkins(*model, logger);
+            ASSERT_TRUE(model->skinsLoaded());
 
             ASSERT_EQ(1u, model->frameCount());
             ASSERT_EQ(2u, model->surfaceCount());
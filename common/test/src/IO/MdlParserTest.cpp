@@ -49,11 +49,20 @@ namespace TrenchBroom {
             EXPECT_NE(nullptr, model);
             EXPECT_EQ(1u, model->surfaceCount());
             EXPECT_EQ(1u, model->frameCount());
+            EXPECT_EQ(52120u, model->frameOffset(0));
+            EXPECT_TRUE(model->frame(0)->loaded());
 
             const auto surfaces = model->surfaces();
             const auto& surface = *surfaces.front();
-            EXPECT_EQ(3u, surface.skinCount());
             EXPECT_EQ(1u, surface.frameCount());
+
+            // the skins are only decoded when requested
+            EXPECT_FALSE(model->skinsLoaded());
+            EXPECT_EQ(0u, surface.skinCount());
+
+            parser.loadSkins(*model, logger);
+            EXPECT_TRUE(model->skinsLoaded());
+            EXPECT_EQ(3u, surface.skinCount());
         }
 
         TEST(MdlParserTest, loadInvalidMdl) {
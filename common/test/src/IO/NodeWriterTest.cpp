@@ -24,6 +24,7 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceAttributes.h"
+#include "Model/Entity.h"
 #include "Model/Group.h"
 #include "Model/Layer.h"
 #include "Model/MapFormat.h"
@@ -31,6 +32,8 @@
 
 #include <kdl/string_compare.h>
 
+#include <cstdio>
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -154,6 +157,125 @@ R"(// entity 0
             ASSERT_EQ(actual, expected);
         }
 
+        static std::string readFile(FILE* file) {
+            std::string result;
+            std::rewind(file);
+
+            char buffer[4096];
+            size_t count;
+            while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0u) {
+                result.append(buffer, count);
+            }
+            return result;
+        }
+
+        TEST(NodeWriterTest, writeQuake2ValveMapToFile) {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::World map(Model::MapFormat::Quake2_Valve);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            Model::BrushBuilder builder(&map, worldBounds);
+            Model::Brush* brush1 = builder.createCube(64.0, "none");
+            for (auto* face : brush1->faces()) {
+                face->setSurfaceValue(32.0f);
+                face->setXOffset(0.5f);
+                face->setYScale(0.1f);
+            }
+            map.defaultLayer()->addChild(brush1);
+
+            FILE* file = std::tmpfile();
+            ASSERT_NE(nullptr, file);
+
+            NodeWriter writer(map, file);
+            writer.writeMap();
+
+            const std::string expected =
+R"(// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none [ 0 -1 0 0.5 ] [ 0 0 -1 0 ] 0 1 0.1 0 0 32
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none [ 1 0 0 0.5 ] [ 0 0 -1 0 ] 0 1 0.1 0 0 32
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none [ -1 0 0 0.5 ] [ 0 -1 0 0 ] 0 1 0.1 0 0 32
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none [ 1 0 0 0.5 ] [ 0 -1 0 0 ] 0 1 0.1 0 0 32
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none [ -1 0 0 0.5 ] [ 0 0 -1 0 ] 0 1 0.1 0 0 32
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none [ 0 1 0 0.5 ] [ 0 0 -1 0 ] 0 1 0.1 0 0 32
+}
+}
+)";
+
+            const std::string actual = readFile(file);
+            std::fclose(file);
+
+            ASSERT_EQ(expected, actual);
+        }
+
+        TEST(NodeWriterTest, writeManyBrushes) {
+            // enough brushes so that they are formatted concurrently
+            const size_t brushCount = 1000u;
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::World map(Model::MapFormat::Standard);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            Model::BrushBuilder builder(&map, worldBounds);
+            for (size_t i = 0u; i < brushCount; ++i) {
+                map.defaultLayer()->addChild(builder.createCube(64.0, "none"));
+            }
+
+            std::string expected =
+R"(// entity 0
+{
+"classname" "worldspawn"
+)";
+            for (size_t i = 0u; i < brushCount; ++i) {
+                expected += "// brush " + std::to_string(i) + "\n";
+                expected +=
+R"({
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1
+}
+)";
+            }
+            expected += "}\n";
+
+            std::stringstream str;
+            NodeWriter streamWriter(map, str);
+            streamWriter.writeMap();
+            ASSERT_EQ(expected, str.str());
+
+            FILE* file = std::tmpfile();
+            ASSERT_NE(nullptr, file);
+
+            NodeWriter fileWriter(map, file);
+            fileWriter.writeMap();
+
+            const std::string actual = readFile(file);
+            std::fclose(file);
+            ASSERT_EQ(expected, actual);
+
+            // the file serializer records the file positions of every brush and face
+            const auto& brushes = map.defaultLayer()->children();
+            for (size_t i = 0u; i < brushCount; ++i) {
+                auto* brush = static_cast<Model::Brush*>(brushes[i]);
+                const size_t brushLine = 5u + i * 9u;
+                ASSERT_EQ(brushLine, brush->lineNumber());
+                ASSERT_TRUE(brush->containsLine(brushLine + 7u));
+                ASSERT_FALSE(brush->containsLine(brushLine + 8u));
+
+                const auto& faces = brush->faces();
+                for (size_t j = 0u; j < faces.size(); ++j) {
+                    ASSERT_EQ(brushLine + 1u + j, faces[j]->lineNumber());
+                }
+            }
+        }
+
         TEST(NodeWriterTest, writeWorldspawnWithBrushInDefaultLayer) {
             const vm::bbox3 worldBounds(8192.0);
 
@@ -456,6 +578,72 @@ R"(// entity 0
             ASSERT_TRUE(kdl::cs::str_matches_glob(actual, expected));
         }
 
+        TEST(NodeWriterTest, writePartialMap) {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::World map(Model::MapFormat::Standard);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            Model::BrushBuilder builder(&map, worldBounds);
+
+            Model::Brush* worldBrush = builder.createCube(64.0, "world");
+            map.defaultLayer()->addChild(worldBrush);
+
+            Model::Entity* brushEntity = map.createEntity();
+            brushEntity->addOrUpdateAttribute("classname", "func_door");
+            Model::Brush* includedBrush = builder.createCube(64.0, "door");
+            Model::Brush* excludedBrush = builder.createCuboid(vm::bbox3(vm::vec3(64.0, 64.0, 64.0), vm::vec3(128.0, 128.0, 128.0)), "other");
+            brushEntity->addChild(includedBrush);
+            brushEntity->addChild(excludedBrush);
+            map.defaultLayer()->addChild(brushEntity);
+
+            Model::Entity* pointEntity = map.createEntity();
+            pointEntity->addOrUpdateAttribute("classname", "light");
+            map.defaultLayer()->addChild(pointEntity);
+
+            std::unique_ptr<Model::Brush> additionalBrush(builder.createCube(64.0, "seal"));
+
+            std::stringstream str;
+            NodeWriter writer(map, str);
+            writer.writePartialMap({ includedBrush, pointEntity }, { additionalBrush.get() });
+
+            const std::string expected =
+R"(// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) seal 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) seal 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) seal 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) seal 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) seal 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) seal 0 0 0 1 1
+}
+}
+// entity 1
+{
+"classname" "func_door"
+// brush 0
+{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) door 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) door 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) door 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) door 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) door 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) door 0 0 0 1 1
+}
+}
+// entity 2
+{
+"classname" "light"
+}
+)";
+
+            const std::string actual = str.str();
+            ASSERT_EQ(expected, actual);
+        }
+
         TEST(NodeWriterTest, writeFaces) {
             const vm::bbox3 worldBounds(8192.0);
 
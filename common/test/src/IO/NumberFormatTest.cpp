@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/NumberFormat.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::string printfFloat(const double value, const int precision) {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            return buffer;
+        }
+
+        static std::string formatFloat(const double value, const int precision) {
+            std::string result;
+            appendFloat(result, value, precision);
+            return result;
+        }
+
+        static void assertFormatsLikePrintf(const double value) {
+            for (const int precision : { 6, 17 }) {
+                ASSERT_EQ(printfFloat(value, precision), formatFloat(value, precision)) << "value " << printfFloat(value, 17) << ", precision " << precision;
+            }
+        }
+
+        TEST(NumberFormatTest, formatSpecialValues) {
+            assertFormatsLikePrintf(0.0);
+            assertFormatsLikePrintf(-0.0);
+            assertFormatsLikePrintf(std::numeric_limits<double>::infinity());
+            assertFormatsLikePrintf(-std::numeric_limits<double>::infinity());
+            assertFormatsLikePrintf(std::numeric_limits<double>::max());
+            assertFormatsLikePrintf(std::numeric_limits<double>::min());
+            assertFormatsLikePrintf(std::numeric_limits<double>::denorm_min());
+        }
+
+        TEST(NumberFormatTest, formatIntegers) {
+            assertFormatsLikePrintf(1.0);
+            assertFormatsLikePrintf(-32.0);
+            assertFormatsLikePrintf(8192.0);
+            assertFormatsLikePrintf(100000.0);
+            assertFormatsLikePrintf(999999.0);
+            assertFormatsLikePrintf(1000000.0);
+            assertFormatsLikePrintf(-1234567.0);
+            assertFormatsLikePrintf(9007199254740992.0);
+            assertFormatsLikePrintf(1e17);
+            assertFormatsLikePrintf(1e300);
+        }
+
+        TEST(NumberFormatTest, formatFractions) {
+            assertFormatsLikePrintf(0.5);
+            assertFormatsLikePrintf(-0.25);
+            assertFormatsLikePrintf(0.1);
+            assertFormatsLikePrintf(0.0001);
+            assertFormatsLikePrintf(0.00001);
+            assertFormatsLikePrintf(1.0 / 3.0);
+            assertFormatsLikePrintf(123.456);
+            assertFormatsLikePrintf(4095.99609375);
+            assertFormatsLikePrintf(0.999999);
+            assertFormatsLikePrintf(0.9999995);
+            assertFormatsLikePrintf(static_cast<double>(0.1f));
+        }
+
+        TEST(NumberFormatTest, formatRandomValues) {
+            uint64_t state = 0x9E3779B97F4A7C15ull;
+            const auto next = [&]() {
+                state ^= state >> 12;
+                state ^= state << 25;
+                state ^= state >> 27;
+                return state * 0x2545F4914F6CDD1Dull;
+            };
+
+            for (size_t i = 0; i < 10000u; ++i) {
+                // grid aligned values with small power of two denominators, as found in most map files
+                const auto numerator = static_cast<double>(static_cast<int64_t>(next() % 2000001u) - 1000000);
+                const auto denominator = static_cast<double>(1u << (next() % 9u));
+                assertFormatsLikePrintf(numerator / denominator);
+
+                // arbitrary values
+                const auto mantissa = static_cast<double>(next() >> 11) / static_cast<double>(1ull << 53);
+                const auto exponent = static_cast<int>(next() % 40u) - 20;
+                assertFormatsLikePrintf((next() & 1u ? -1.0 : 1.0) * mantissa * std::pow(10.0, exponent));
+            }
+        }
+
+        TEST(NumberFormatTest, formatInteger) {
+            const auto format = [](const long long value) {
+                std::string result;
+                appendInteger(result, value);
+                return result;
+            };
+
+            ASSERT_EQ("0", format(0));
+            ASSERT_EQ("7", format(7));
+            ASSERT_EQ("-7", format(-7));
+            ASSERT_EQ("1234567890", format(1234567890));
+            ASSERT_EQ(std::to_string(std::numeric_limits<long long>::max()), format(std::numeric_limits<long long>::max()));
+            ASSERT_EQ(std::to_string(std::numeric_limits<long long>::min()), format(std::numeric_limits<long long>::min()));
+        }
+    }
+}
@@ -164,6 +164,75 @@ namespace TrenchBroom {
             delete entity1;
         }
 
+        TEST(EntityAttributeIndexTest, removeNumberedEntityAttribute) {
+            AttributableNodeIndex index;
+
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("test", "somevalue");
+            entity1->addOrUpdateAttribute("test2", "somevalue");
+
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("test1", "somevalue");
+            entity2->addOrUpdateAttribute("tester", "somevalue");
+
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1, entity2 }, findNumberedExact(index, "test", "somevalue"));
+
+            index.removeAttribute(entity1, "test2", "somevalue");
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1, entity2 }, findNumberedExact(index, "test", "somevalue"));
+
+            index.removeAttribute(entity2, "test1", "somevalue");
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1 }, findNumberedExact(index, "test", "somevalue"));
+
+            delete entity1;
+            delete entity2;
+        }
+
+        TEST(EntityAttributeIndexTest, findNumberedEntityAttributeWithDigitSuffix) {
+            AttributableNodeIndex index;
+
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("test1", "somevalue");
+
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("test12", "somevalue");
+
+            Entity* entity3 = new Entity();
+            entity3->addOrUpdateAttribute("test2", "somevalue");
+
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+            index.addAttributableNode(entity3);
+
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>{ entity1, entity2 }, findNumberedExact(index, "test1", "somevalue"));
+
+            delete entity1;
+            delete entity2;
+            delete entity3;
+        }
+
+        TEST(EntityAttributeIndexTest, findAppendsToResult) {
+            AttributableNodeIndex index;
+
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("test", "somevalue");
+
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("test", "someothervalue");
+
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+
+            std::vector<AttributableNode*> attributables;
+            index.findAttributableNodes(AttributableNodeIndexQuery::exact("test"), "somevalue", attributables);
+            index.findAttributableNodes(AttributableNodeIndexQuery::exact("test"), "someothervalue", attributables);
+            ASSERT_EQ((std::vector<AttributableNode*>{ entity1, entity2 }), attributables);
+
+            delete entity1;
+            delete entity2;
+        }
 
         TEST(EntityAttributeIndexTest, addRemoveFloatProperty) {
             AttributableNodeIndex index;
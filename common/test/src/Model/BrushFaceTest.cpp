@@ -126,6 +126,47 @@ namespace TrenchBroom {
             EXPECT_EQ(0u, texture2.usageCount());
         }
 
+        TEST(BrushFaceTest, textureNamesAreShared) {
+            const BrushFaceAttributes attribs1("some_texture");
+            const BrushFaceAttributes attribs2("some_texture");
+            const BrushFaceAttributes attribs3("other_texture");
+
+            ASSERT_EQ("some_texture", attribs1.textureName());
+            ASSERT_EQ(&attribs1.textureName(), &attribs2.textureName());
+            ASSERT_NE(&attribs1.textureName(), &attribs3.textureName());
+            ASSERT_TRUE(attribs1 == attribs2);
+
+            Assets::Texture texture("other_texture", 64, 64);
+            BrushFaceAttributes attribs4("");
+            attribs4.setTexture(&texture);
+            ASSERT_EQ(&attribs3.textureName(), &attribs4.textureName());
+
+            attribs4.unsetTexture();
+            ASSERT_EQ(BrushFaceAttributes::NoTextureName, attribs4.textureName());
+        }
+
+        TEST(BrushFaceTest, cloneKeepsTexCoordSystem) {
+            const vm::vec3 p0(0.0,  0.0, 4.0);
+            const vm::vec3 p1(1.0,  0.0, 4.0);
+            const vm::vec3 p2(0.0, -1.0, 4.0);
+
+            const BrushFaceAttributes attribs("");
+            const vm::vec3 xAxis = vm::normalize(vm::vec3(1.0, 1.0, 0.0));
+            const vm::vec3 yAxis = vm::normalize(vm::vec3(-1.0, 1.0, 0.0));
+            BrushFace face(p0, p1, p2, attribs, std::make_unique<ParallelTexCoordSystem>(xAxis, yAxis));
+            ASSERT_VEC_EQ(xAxis, face.textureXAxis());
+            ASSERT_VEC_EQ(yAxis, face.textureYAxis());
+
+            auto clone = std::unique_ptr<BrushFace>(face.clone());
+            ASSERT_VEC_EQ(xAxis, clone->textureXAxis());
+            ASSERT_VEC_EQ(yAxis, clone->textureYAxis());
+
+            // the clone must not share its texture coordinate system with the original
+            clone->rotateTexture(90.0f);
+            ASSERT_VEC_EQ(xAxis, face.textureXAxis());
+            ASSERT_VEC_EQ(yAxis, face.textureYAxis());
+        }
+
         static void getFaceVertsAndTexCoords(const BrushFace *face,
                                              std::vector<vm::vec3> *vertPositions,
                                              std::vector<vm::vec2f> *vertTexCoords) {
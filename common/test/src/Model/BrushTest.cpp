@@ -22,6 +22,7 @@
 #include "TestUtils.h"
 
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "IO/DiskIO.h"
 #include "IO/NodeReader.h"
 #include "IO/Path.h"
@@ -40,6 +41,8 @@
 #include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 #include <vecmath/ray.h>
@@ -48,6 +51,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace TrenchBroom {
@@ -768,6 +772,155 @@ namespace TrenchBroom {
             delete clone;
         }
 
+        static void assertTransformMatchesRebuild(const vm::mat4x4& transformation) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            auto brush = std::unique_ptr<Brush>(builder.createCuboid(vm::bbox3(vm::vec3(-32.0, -16.0, -8.0), vm::vec3(64.0, 32.0, 16.0)), "texture"));
+
+            ASSERT_TRUE(brush->canTransform(transformation, worldBounds));
+            brush->transform(transformation, false, worldBounds);
+            ASSERT_TRUE(brush->fullySpecified());
+
+            // cloning builds the geometry from the transformed faces
+            const auto rebuilt = std::unique_ptr<Brush>(brush->clone(worldBounds));
+
+            ASSERT_EQ(rebuilt->vertexCount(), brush->vertexCount());
+            ASSERT_EQ(rebuilt->faceCount(), brush->faceCount());
+            for (const auto& position : rebuilt->vertexPositions()) {
+                ASSERT_TRUE(brush->hasVertex(position, vm::C::almost_zero()));
+            }
+            ASSERT_VEC_EQ(rebuilt->physicalBounds().min, brush->physicalBounds().min);
+            ASSERT_VEC_EQ(rebuilt->physicalBounds().max, brush->physicalBounds().max);
+
+            for (const auto* face : brush->faces()) {
+                for (const auto& position : face->vertexPositions()) {
+                    ASSERT_EQ(vm::plane_status::inside, face->boundary().point_status(position));
+                }
+            }
+        }
+
+        TEST(BrushTest, transformTranslation) {
+            assertTransformMatchesRebuild(vm::translation_matrix(vm::vec3(16.0, -32.0, 8.0)));
+        }
+
+        TEST(BrushTest, transformRotation) {
+            assertTransformMatchesRebuild(vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0)));
+            assertTransformMatchesRebuild(vm::rotation_matrix(vm::to_radians(15.0), vm::to_radians(30.0), vm::to_radians(45.0)));
+        }
+
+        TEST(BrushTest, transformScaling) {
+            assertTransformMatchesRebuild(vm::scaling_matrix(vm::vec3(2.0, 0.5, 3.0)));
+        }
+
+        TEST(BrushTest, transformMirror) {
+            // mirroring changes the face orientation, so the geometry must be rebuilt
+            assertTransformMatchesRebuild(vm::scaling_matrix(vm::vec3(-1.0, 1.0, 1.0)));
+        }
+
+        TEST(BrushTest, canTransformOutsideWorldBounds) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            auto brush = std::unique_ptr<Brush>(builder.createCube(64.0, "texture"));
+
+            ASSERT_TRUE(brush->canTransform(vm::translation_matrix(vm::vec3(4000.0, 0.0, 0.0)), worldBounds));
+            ASSERT_FALSE(brush->canTransform(vm::translation_matrix(vm::vec3(8192.0, 0.0, 0.0)), worldBounds));
+            ASSERT_FALSE(brush->canTransform(vm::scaling_matrix(vm::vec3(0.0, 1.0, 1.0)), worldBounds));
+        }
+
+        TEST(BrushTest, transformBrushesConcurrently) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            // enough brushes to be transformed on several threads
+            std::vector<Brush*> brushes;
+            std::vector<std::unique_ptr<Brush>> expected;
+            for (size_t i = 0; i < 1000u; ++i) {
+                const auto min = vm::vec3(static_cast<FloatType>(i % 32u), static_cast<FloatType>(i / 32u), 0.0) * 64.0 - vm::vec3(1024.0, 1024.0, 0.0);
+                auto* brush = builder.createCuboid(vm::bbox3(min, min + vm::vec3(32.0, 32.0, 32.0)), "texture");
+                world.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+                expected.emplace_back(brush->clone(worldBounds));
+            }
+
+            const auto transformation = vm::translation_matrix(vm::vec3(16.0, 8.0, 4.0)) * vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0));
+            ASSERT_TRUE(Brush::canTransformBrushes(brushes, transformation, worldBounds));
+            Brush::transformBrushes(brushes, transformation, false, worldBounds);
+
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                expected[i]->transform(transformation, false, worldBounds);
+                ASSERT_EQ(expected[i]->physicalBounds(), brushes[i]->physicalBounds());
+
+                // the node tree of the world must have been updated
+                std::vector<Node*> containers;
+                world.findNodesContaining(brushes[i]->physicalBounds().center(), containers);
+                ASSERT_TRUE(kdl::vec_contains(containers, brushes[i]));
+            }
+
+            ASSERT_FALSE(Brush::canTransformBrushes(brushes, vm::translation_matrix(vm::vec3(4096.0, 0.0, 0.0)), worldBounds));
+        }
+
+        class UsageCountObserver {
+        public:
+            std::thread::id threadId;
+            size_t notificationCount = 0u;
+            bool notifiedOnOtherThread = false;
+
+            UsageCountObserver() :
+            threadId(std::this_thread::get_id()) {}
+
+            void usageCountDidChange() {
+                ++notificationCount;
+                notifiedOnOtherThread |= std::this_thread::get_id() != threadId;
+            }
+        };
+
+        TEST(BrushTest, mirrorTexturedBrushesConcurrently) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard);
+            BrushBuilder builder(&world, worldBounds);
+
+            auto* texture = new Assets::Texture("testTexture", 64, 64);
+            Assets::TextureCollection collection({ texture });
+
+            UsageCountObserver observer;
+            collection.usageCountDidChange.addObserver(&observer, &UsageCountObserver::usageCountDidChange);
+
+            // more brushes than are checked on a single thread
+            std::vector<Brush*> brushes;
+            for (size_t i = 0; i < 200u; ++i) {
+                const auto min = vm::vec3(static_cast<FloatType>(i % 16u), static_cast<FloatType>(i / 16u), 0.0) * 64.0 - vm::vec3(512.0, 512.0, 0.0);
+                auto* brush = builder.createCuboid(vm::bbox3(min, min + vm::vec3(32.0, 32.0, 32.0)), "testTexture");
+                for (auto* face : brush->faces()) {
+                    face->setTexture(texture);
+                }
+                world.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            const auto faceCount = 6u * brushes.size();
+            ASSERT_EQ(faceCount, texture->usageCount());
+            ASSERT_EQ(faceCount, collection.usageCount());
+
+            // mirroring cannot be applied in place, so every brush is checked using a clone
+            const auto transformation = vm::scaling_matrix(vm::vec3(-1.0, 1.0, 1.0));
+            ASSERT_TRUE(Brush::canTransformBrushes(brushes, transformation, worldBounds));
+            Brush::transformBrushes(brushes, transformation, false, worldBounds);
+
+            ASSERT_EQ(faceCount, texture->usageCount());
+            ASSERT_EQ(faceCount, collection.usageCount());
+            ASSERT_LT(0u, observer.notificationCount);
+            ASSERT_FALSE(observer.notifiedOnOtherThread);
+
+            world.defaultLayer()->removeChildren(std::begin(brushes), std::end(brushes));
+            kdl::vec_clear_and_delete(brushes);
+            ASSERT_EQ(0u, collection.usageCount());
+        }
+
         TEST(BrushTest, clip) {
             const vm::bbox3 worldBounds(4096.0);
 
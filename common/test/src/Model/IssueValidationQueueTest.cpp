@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Entity.h"
+#include "Model/Issue.h"
+#include "Model/IssueGeneratorStats.h"
+#include "Model/IssueValidationQueue.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/MissingClassnameIssueGenerator.h"
+#include "Model/World.h"
+
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(IssueValidationQueueTest, recordInvalidatedNodes) {
+            World world(MapFormat::Standard);
+            auto& queue = world.issueValidationQueue();
+            queue.clear();
+
+            auto* entity = world.createEntity();
+            world.defaultLayer()->addChild(entity);
+
+            const auto invalidatedNodes = queue.takeInvalidatedNodes();
+            ASSERT_TRUE(kdl::vec_contains(invalidatedNodes, entity));
+            ASSERT_TRUE(kdl::vec_contains(invalidatedNodes, world.defaultLayer()));
+            ASSERT_TRUE(queue.empty());
+
+            entity->addOrUpdateAttribute("some", "value");
+            entity->addOrUpdateAttribute("other", "value");
+
+            // every node is reported only once
+            const auto changedNodes = queue.takeInvalidatedNodes();
+            ASSERT_EQ(1, std::count(std::begin(changedNodes), std::end(changedNodes), entity));
+        }
+
+        TEST(IssueValidationQueueTest, recordRemovedNodes) {
+            World world(MapFormat::Standard);
+            auto& queue = world.issueValidationQueue();
+
+            auto* entity = world.createEntity();
+            world.defaultLayer()->addChild(entity);
+            queue.clear();
+
+            entity->addOrUpdateAttribute("some", "value");
+            ASSERT_EQ(1u, queue.invalidatedNodeCount());
+
+            world.defaultLayer()->removeChild(entity);
+            ASSERT_EQ(std::vector<Node*>{ entity }, queue.takeRemovedNodes());
+            ASSERT_FALSE(kdl::vec_contains(queue.takeInvalidatedNodes(), entity));
+
+            // adding the node again makes it an invalidated node
+            world.defaultLayer()->addChild(entity);
+            ASSERT_TRUE(queue.takeRemovedNodes().empty());
+            ASSERT_TRUE(kdl::vec_contains(queue.takeInvalidatedNodes(), entity));
+        }
+
+        TEST(IssueValidationQueueTest, validateNodesWithStats) {
+            World world(MapFormat::Standard);
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            const auto& generators = world.registeredIssueGenerators();
+
+            std::vector<Node*> entities;
+            for (size_t i = 0; i < 200u; ++i) {
+                auto* entity = world.createEntity();
+                world.defaultLayer()->addChild(entity);
+                entities.push_back(entity);
+            }
+
+            IssueGeneratorStats stats(generators);
+            Node::validateIssues(entities, generators, &stats);
+
+            for (auto* entity : entities) {
+                ASSERT_EQ(1u, entity->issues(generators).size());
+            }
+
+            const auto entries = stats.entries();
+            ASSERT_EQ(1u, entries.size());
+            ASSERT_EQ(generators.front(), entries.front().generator);
+            ASSERT_EQ(200u, entries.front().nodeCount);
+            ASSERT_EQ(200u, entries.front().issueCount);
+
+            // valid nodes are not validated again
+            Node::validateIssues(entities, generators, &stats);
+            ASSERT_EQ(200u, stats.entries().front().nodeCount);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Model/PointFile.h"
+#include "IO/Path.h"
+
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(PointFileTest, parsePointFile) {
+            const auto path = IO::Path("fixture/test/Model/PointFile/pointfile.pts");
+            const Model::PointFile pointFile(path);
+
+            // collinear points are merged and the remaining segments are split into steps of 64 units
+            const std::vector<vm::vec3f> expected {
+                { 0.0f, 0.0f, 0.0f },
+                { 64.0f, 0.0f, 0.0f },
+                { 128.0f, 0.0f, 0.0f },
+                { 128.0f, 64.0f, 0.0f },
+                { 128.0f, 128.0f, 0.0f }
+            };
+            ASSERT_EQ(expected, pointFile.points());
+        }
+
+        TEST(PointFileTest, parseInvalidPointFile) {
+            const auto path = IO::Path("fixture/test/Model/PointFile/pointfile_invalid.pts");
+            ASSERT_THROW(const Model::PointFile pointFile(path), FileFormatException);
+        }
+
+        TEST(PointFileTest, parseMissingPointFile) {
+            const auto path = IO::Path("fixture/test/Model/PointFile/does_not_exist.pts");
+            ASSERT_THROW(const Model::PointFile pointFile(path), FileFormatException);
+        }
+    }
+}
@@ -28,6 +28,9 @@
 
 #include <vecmath/polygon.h>
 
+#include <iterator>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         TEST(PortalFileTest, parseInvalidPRT1) {
@@ -44,22 +47,34 @@ namespace TrenchBroom {
                 {{-64,-32,0}, {-32,-32,0}, {-48,-32,64}}
         };
 
+        static std::vector<vm::polygon3f> portals(const Model::PortalFile& portalFile) {
+            std::vector<vm::polygon3f> result;
+            const auto& vertices = portalFile.vertices();
+            const auto& offsets = portalFile.offsets();
+            for (size_t i = 0; i < portalFile.portalCount(); ++i) {
+                result.emplace_back(std::vector<vm::vec3f>(std::next(std::begin(vertices), static_cast<std::ptrdiff_t>(offsets[i])),
+                                                           std::next(std::begin(vertices), static_cast<std::ptrdiff_t>(offsets[i + 1u]))));
+            }
+            return result;
+        }
+
         TEST(PortalFileTest, parsePRT1) {
             const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt1.prt");
             const Model::PortalFile portalFile(path);
-            ASSERT_EQ(ExpectedPortals, portalFile.portals());
+            ASSERT_EQ(ExpectedPortals, portals(portalFile));
+            ASSERT_EQ((std::vector<size_t>{ 0u, 4u, 8u, 16u, 24u, 27u }), portalFile.offsets());
         }
 
         TEST(PortalFileTest, parsePRT1AM) {
             const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt1am.prt");
             const Model::PortalFile portalFile(path);
-            ASSERT_EQ(ExpectedPortals, portalFile.portals());
+            ASSERT_EQ(ExpectedPortals, portals(portalFile));
         }
 
         TEST(PortalFileTest, parsePRT2) {
             const auto path = IO::Path("fixture/test/Model/PortalFile/portaltest_prt2.prt");
             const Model::PortalFile portalFile(path);
-            ASSERT_EQ(ExpectedPortals, portalFile.portals());
+            ASSERT_EQ(ExpectedPortals, portals(portalFile));
         }
     }
 }
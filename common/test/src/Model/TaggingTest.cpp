@@ -21,12 +21,18 @@
 
 #include "Model/Tag.h"
 #include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
+#include "Model/TextureNamePatternMatcher.h"
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/Layer.h"
 #include "Model/MapFormat.h"
 #include "Model/World.h"
 
+#include <memory>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         TEST(TaggingTest, testTagBrush) {
@@ -59,5 +65,63 @@ namespace TrenchBroom {
             ASSERT_FALSE(brush->hasTag(tag1));
             ASSERT_FALSE(brush->hasTag(tag2));
         }
+
+        TEST(TaggingTest, matchTextureNamePatterns) {
+            TextureNamePatternMatcher matcher;
+            matcher.addPattern("clip", 1u);
+            matcher.addPattern("trigger*", 2u);
+            matcher.addPattern("*sky*", 4u);
+            matcher.addPattern("Clip", 8u);
+            ASSERT_EQ(15u, matcher.mask());
+
+            ASSERT_EQ(9u, matcher.match("clip"));
+            ASSERT_EQ(9u, matcher.match("base/CLIP"));
+            ASSERT_EQ(0u, matcher.match("clipx"));
+            ASSERT_EQ(2u, matcher.match("TRIGGER_once"));
+            ASSERT_EQ(0u, matcher.match("trigge"));
+            ASSERT_EQ(4u, matcher.match("e1u1/bigsky1"));
+            ASSERT_EQ(6u, matcher.match("triggersky"));
+
+            ASSERT_EQ(9u, matcher.matchCached("base/clip"));
+            ASSERT_EQ(9u, matcher.matchCached("base/clip"));
+            ASSERT_EQ(1u, matcher.cacheSize());
+
+            matcher.addPattern("base*", 16u);
+            ASSERT_EQ(0u, matcher.cacheSize());
+        }
+
+        TEST(TaggingTest, updateTextureNameTags) {
+            SmartTag clipTag("clip", {}, std::make_unique<TextureNameTagMatcher>("clip"));
+            SmartTag skyTag("sky", {}, std::make_unique<TextureNameTagMatcher>("*sky*"));
+            clipTag.setIndex(0);
+            skyTag.setIndex(1);
+
+            TagManager tagManager;
+            tagManager.registerSmartTags({ clipTag, skyTag });
+
+            const vm::bbox3 worldBounds{4096.0};
+            World world{MapFormat::Standard};
+
+            BrushBuilder builder{&world, worldBounds};
+            Brush* brush = builder.createCube(64.0, "clip", "e1u1/sky1", "CLIP", "other", "clip", "other");
+            world.defaultLayer()->addChild(brush);
+
+            size_t clipCount = 0u;
+            size_t skyCount = 0u;
+            for (auto* face : brush->faces()) {
+                face->initializeTags(tagManager);
+                ASSERT_EQ(face->hasTag(clipTag), clipTag.matches(*face));
+                ASSERT_EQ(face->hasTag(skyTag), skyTag.matches(*face));
+                clipCount += face->hasTag(clipTag) ? 1u : 0u;
+                skyCount += face->hasTag(skyTag) ? 1u : 0u;
+            }
+
+            ASSERT_EQ(3u, clipCount);
+            ASSERT_EQ(1u, skyCount);
+
+            // texture name tags never match brushes
+            brush->initializeTags(tagManager);
+            ASSERT_FALSE(brush->hasAnyTag());
+        }
     }
 }
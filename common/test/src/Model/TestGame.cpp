@@ -35,7 +35,9 @@
 
 #include <kdl/string_utils.h>
 
+#include <cstdio>
 #include <memory>
+#include <sstream>
 #include <vector>
 
 namespace TrenchBroom {
@@ -76,7 +78,7 @@ namespace TrenchBroom {
             return std::make_unique<World>(format);
         }
 
-        std::unique_ptr<World> TestGame::doLoadMap(const MapFormat format, const vm::bbox3& /* worldBounds */, const IO::Path& /* path */, Logger& /* logger */) const {
+        std::unique_ptr<World> TestGame::doLoadMap(const MapFormat format, const vm::bbox3& /* worldBounds */, const IO::Path& /* path */, const bool /* useMapCache */, Logger& /* logger */) const {
             return std::make_unique<World>(format);
         }
 
@@ -90,6 +92,20 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        void TestGame::doWritePartialMap(World& world, const std::vector<Node*>& nodes, const std::vector<Brush*>& additionalWorldBrushes, const IO::Path& path) const {
+            const auto mapFormatName = formatName(world.format());
+
+            std::stringstream stream;
+            IO::NodeWriter writer(world, stream);
+            writer.writePartialMap(nodes, additionalWorldBrushes);
+
+            IO::OpenFile open(path, true);
+            IO::writeGameComment(open.file, gameName(), mapFormatName);
+
+            const auto str = stream.str();
+            std::fwrite(str.data(), 1, str.size(), open.file);
+        }
+
         void TestGame::doExportMap(World& /* world */, const Model::ExportFormat /* format */, const IO::Path& /* path */) const {}
 
         std::vector<Node*> TestGame::doParseNodes(const std::string& str, World& world, const vm::bbox3& worldBounds, Logger& /* logger */) const {
@@ -211,5 +227,6 @@ namespace TrenchBroom {
 
         std::unique_ptr<Assets::EntityModel> TestGame::doInitializeModel(const IO::Path& /* path */, Logger& /* logger */) const { return nullptr; }
         void TestGame::doLoadFrame(const IO::Path& /* path */, size_t /* frameIndex */, Assets::EntityModel& /* model */, Logger& /* logger */) const {}
+        void TestGame::doLoadSkins(const IO::Path& /* path */, Assets::EntityModel& /* model */, Logger& /* logger */) const {}
     }
 }
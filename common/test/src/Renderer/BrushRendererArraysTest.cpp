@@ -0,0 +1,165 @@
+/*
+ Copyright (C) 2018 Eric Wasylishen
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/BrushRendererArrays.h"
+#include "Renderer/VboBackend.h"
+#include "Renderer/VboManager.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        using Range = DirtyRangeTracker::Range;
+
+        TEST(DirtyRangeTrackerTest, constructor) {
+            DirtyRangeTracker t(100);
+            EXPECT_EQ(100u, t.capacity());
+            EXPECT_TRUE(t.clean());
+            EXPECT_EQ((std::vector<Range>{}), t.ranges());
+        }
+
+        TEST(DirtyRangeTrackerTest, markDisjointRanges) {
+            DirtyRangeTracker t(1000, 10);
+            t.markDirty(900, 10);
+            t.markDirty(0, 10);
+            t.markDirty(500, 5);
+
+            EXPECT_FALSE(t.clean());
+            EXPECT_EQ((std::vector<Range>{{0, 10}, {500, 5}, {900, 10}}), t.ranges());
+            EXPECT_EQ(25u, t.dirtySize());
+        }
+
+        TEST(DirtyRangeTrackerTest, mergeCloseRanges) {
+            DirtyRangeTracker t(1000, 10);
+            t.markDirty(0, 10);
+            t.markDirty(20, 10);
+            EXPECT_EQ((std::vector<Range>{{0, 30}}), t.ranges());
+
+            t.markDirty(41, 9);
+            EXPECT_EQ((std::vector<Range>{{0, 30}, {41, 9}}), t.ranges());
+
+            // bridges both ranges
+            t.markDirty(35, 1);
+            EXPECT_EQ((std::vector<Range>{{0, 50}}), t.ranges());
+        }
+
+        TEST(DirtyRangeTrackerTest, mergeOverlappingRanges) {
+            DirtyRangeTracker t(1000, 0);
+            t.markDirty(10, 10);
+            t.markDirty(100, 10);
+            t.markDirty(15, 90);
+            EXPECT_EQ((std::vector<Range>{{10, 100}}), t.ranges());
+
+            t.markDirty(20, 5);
+            EXPECT_EQ((std::vector<Range>{{10, 100}}), t.ranges());
+        }
+
+        TEST(DirtyRangeTrackerTest, expandMarksNewRangeDirty) {
+            DirtyRangeTracker t(100, 0);
+            t.expand(150);
+            EXPECT_EQ(150u, t.capacity());
+            EXPECT_EQ((std::vector<Range>{{100, 50}}), t.ranges());
+        }
+
+        TEST(DirtyRangeTrackerTest, clear) {
+            DirtyRangeTracker t(100);
+            t.markDirty(10, 10);
+            t.clear();
+            EXPECT_TRUE(t.clean());
+            EXPECT_EQ(100u, t.capacity());
+        }
+
+        TEST(DirtyRangeTrackerTest, invalidMarkDirty) {
+            DirtyRangeTracker t(100);
+            EXPECT_THROW(t.markDirty(90, 11), std::invalid_argument);
+        }
+
+        TEST(BrushIndexArrayTest, uploadOnlyDirtyRanges) {
+            auto backend = std::make_unique<RecordingVboBackend>();
+            auto& recorder = *backend;
+            VboManager vboManager(std::move(backend));
+
+            BrushIndexArray indexArray;
+            auto [firstKey, firstIndices] = indexArray.getPointerToInsertElementsAt(1000);
+            std::fill(firstIndices, firstIndices + 1000, 1u);
+            auto [secondKey, secondIndices] = indexArray.getPointerToInsertElementsAt(1000);
+            std::fill(secondIndices, secondIndices + 1000, 2u);
+            auto [thirdKey, thirdIndices] = indexArray.getPointerToInsertElementsAt(1000);
+            std::fill(thirdIndices, thirdIndices + 1000, 3u);
+
+            // the capacity doubles when growing
+            indexArray.prepare(vboManager);
+            EXPECT_TRUE(indexArray.prepared());
+            EXPECT_EQ(4000u * sizeof(GLuint), recorder.writtenBytes());
+
+            // zeroing the first and the last allocation must not upload the indices in between
+            recorder.reset();
+            indexArray.zeroElementsWithKey(firstKey);
+            indexArray.zeroElementsWithKey(thirdKey);
+            EXPECT_FALSE(indexArray.prepared());
+
+            indexArray.prepare(vboManager);
+            EXPECT_TRUE(indexArray.prepared());
+            EXPECT_EQ(0u, recorder.createdBytes());
+            ASSERT_EQ(2u, recorder.writes().size());
+            EXPECT_EQ(2000u * sizeof(GLuint), recorder.writtenBytes());
+        }
+
+        TEST(BrushIndexArrayTest, uploadSmallEditsSeparately) {
+            auto backend = std::make_unique<RecordingVboBackend>();
+            auto& recorder = *backend;
+            VboManager vboManager(std::move(backend));
+
+            std::vector<GLuint> indices(10000, 1u);
+            auto holder = IndexHolder::swap(indices);
+            holder->setMergeThreshold(16);
+            holder->prepare(vboManager);
+
+            recorder.reset();
+            *holder->getPointerToWriteElementsTo(0, 1) = 0u;
+            *holder->getPointerToWriteElementsTo(9999, 1) = 0u;
+            holder->prepare(vboManager);
+
+            ASSERT_EQ(2u, recorder.writes().size());
+            EXPECT_EQ(0u, recorder.writes()[0].offset);
+            EXPECT_EQ(9999u * sizeof(GLuint), recorder.writes()[1].offset);
+            EXPECT_EQ(2u * sizeof(GLuint), recorder.writtenBytes());
+        }
+
+        TEST(BrushIndexArrayTest, discardSnapshot) {
+            auto backend = std::make_unique<RecordingVboBackend>();
+            auto& recorder = *backend;
+            VboManager vboManager(std::move(backend));
+
+            std::vector<GLuint> indices(100, 1u);
+            auto holder = IndexHolder::swap(indices, VboSnapshot::Discard);
+            EXPECT_FALSE(holder->prepared());
+
+            holder->prepare(vboManager);
+            EXPECT_TRUE(holder->prepared());
+            EXPECT_EQ(100u, holder->size());
+            EXPECT_EQ(100u * sizeof(GLuint), recorder.writtenBytes());
+        }
+    }
+}
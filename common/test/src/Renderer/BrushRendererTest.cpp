@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+#include "Renderer/BrushRenderer.h"
+#include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static Model::Brush* createBrushAt(const Model::BrushBuilder& builder, const vm::vec3& center) {
+            return builder.createCuboid(vm::bbox3(center - vm::vec3(32.0, 32.0, 32.0), center + vm::vec3(32.0, 32.0, 32.0)), "texture");
+        }
+
+        TEST(BrushRendererTest, cullChunksOutsideOfFrustum) {
+            const vm::bbox3 worldBounds(8192.0);
+            Model::World world(Model::MapFormat::Standard);
+            Model::BrushBuilder builder(&world, worldBounds);
+
+            std::vector<Model::Brush*> brushes{
+                createBrushAt(builder, vm::vec3(512.0, 0.0, 0.0)),
+                createBrushAt(builder, vm::vec3(640.0, 128.0, 0.0)),
+                createBrushAt(builder, vm::vec3(-3000.0, 0.0, 0.0))
+            };
+
+            BrushRenderer renderer;
+            renderer.addBrushes(brushes);
+            renderer.validate();
+            ASSERT_EQ(2u, renderer.chunkCount());
+
+            // looking along the positive X axis, the third brush is behind the camera
+            const PerspectiveCamera camera(90.0f, 1.0f, 8192.0f, Camera::Viewport(0, 0, 800, 800), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+            const auto expectedBounds = vm::bbox3f(vm::vec3f(480.0f, -32.0f, -32.0f), vm::vec3f(672.0f, 160.0f, 32.0f));
+            ASSERT_EQ((std::vector<vm::bbox3f>{ expectedBounds }), renderer.visibleChunkBounds(camera));
+
+            // removing the visible brushes discards their chunk
+            renderer.setBrushes({ brushes[2] });
+            ASSERT_EQ(1u, renderer.chunkCount());
+            ASSERT_TRUE(renderer.visibleChunkBounds(camera).empty());
+
+            renderer.invalidate();
+            ASSERT_EQ(0u, renderer.chunkCount());
+
+            kdl::vec_clear_and_delete(brushes);
+        }
+
+        TEST(BrushRendererTest, moveInvalidatedBrushToNewChunk) {
+            const vm::bbox3 worldBounds(8192.0);
+            Model::World world(Model::MapFormat::Standard);
+            Model::BrushBuilder builder(&world, worldBounds);
+
+            std::vector<Model::Brush*> brushes{
+                createBrushAt(builder, vm::vec3(512.0, 0.0, 0.0)),
+                createBrushAt(builder, vm::vec3(1536.0, 0.0, 0.0))
+            };
+
+            BrushRenderer renderer;
+            renderer.addBrushes(brushes);
+            renderer.validate();
+            ASSERT_EQ(2u, renderer.chunkCount());
+
+            brushes[1]->transform(vm::translation_matrix(vm::vec3(-1024.0, 0.0, 0.0)), false, worldBounds);
+            renderer.invalidateBrushes({ brushes[1] });
+            ASSERT_EQ(1u, renderer.chunkCount());
+
+            renderer.validate();
+            ASSERT_EQ(1u, renderer.chunkCount());
+
+            kdl::vec_clear_and_delete(brushes);
+        }
+
+        static std::vector<vm::vec3f> cachedPositions(const BrushRendererBrushCache& cache) {
+            return kdl::vec_transform(cache.cachedVertices(), [](const auto& vertex) { return getVertexComponent<0>(vertex); });
+        }
+
+        TEST(BrushRendererTest, updateTextureCoordinatesOnly) {
+            const vm::bbox3 worldBounds(8192.0);
+            Model::World world(Model::MapFormat::Standard);
+            Model::BrushBuilder builder(&world, worldBounds);
+
+            auto* brush = createBrushAt(builder, vm::vec3(64.0, 0.0, 0.0));
+            auto& cache = brush->brushRendererBrushCache();
+            cache.validateVertexCache(brush);
+            const auto positions = cachedPositions(cache);
+
+            for (auto* face : brush->faces()) {
+                face->setXOffset(16.0f);
+            }
+
+            // the positions are kept, but the texture coordinates reflect the new offset
+            cache.validateVertexCache(brush);
+            ASSERT_EQ(positions, cachedPositions(cache));
+
+            for (const auto& cachedFace : cache.cachedFacesSortedByTexture()) {
+                for (size_t i = 0; i < cachedFace.vertexCount; ++i) {
+                    const auto& vertex = cache.cachedVertices()[cachedFace.indexOfFirstVertexRelativeToBrush + i];
+                    const auto expected = cachedFace.face->textureCoords(vm::vec3(getVertexComponent<0>(vertex)));
+                    ASSERT_TRUE(vm::is_equal(expected, getVertexComponent<2>(vertex).xy(), 0.0001f));
+                }
+            }
+
+            delete brush;
+        }
+    }
+}
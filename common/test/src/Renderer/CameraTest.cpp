@@ -21,8 +21,11 @@
 #include <gmock/gmock.h>
 
 #include "Renderer/Camera.h"
+#include "Renderer/OrthographicCamera.h"
 #include "Renderer/PerspectiveCamera.h"
 
+#include <vecmath/bbox.h>
+
 namespace TrenchBroom {
     namespace Renderer {
         TEST(CameraTest, testInvalidUp) {
@@ -66,5 +69,26 @@ namespace TrenchBroom {
             ASSERT_FALSE(vm::is_nan(c.right()));
             ASSERT_FALSE(vm::is_nan(c.up()));
         }
+
+        TEST(CameraTest, perspectiveFrustumIntersects) {
+            const PerspectiveCamera c(90.0f, 1.0f, 8192.0f, Camera::Viewport(0, 0, 800, 800), vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+
+            ASSERT_TRUE(c.frustumIntersects(vm::bbox3f(vm::vec3f(100.0f, -10.0f, -10.0f), vm::vec3f(120.0f, 10.0f, 10.0f))));
+            // straddles the right plane
+            ASSERT_TRUE(c.frustumIntersects(vm::bbox3f(vm::vec3f(100.0f, -150.0f, -10.0f), vm::vec3f(120.0f, -90.0f, 10.0f))));
+            // behind the camera
+            ASSERT_FALSE(c.frustumIntersects(vm::bbox3f(vm::vec3f(-120.0f, -10.0f, -10.0f), vm::vec3f(-100.0f, 10.0f, 10.0f))));
+            // outside of the left plane
+            ASSERT_FALSE(c.frustumIntersects(vm::bbox3f(vm::vec3f(100.0f, 200.0f, -10.0f), vm::vec3f(120.0f, 220.0f, 10.0f))));
+        }
+
+        TEST(CameraTest, orthographicFrustumIntersects) {
+            const OrthographicCamera c(1.0f, 8192.0f, Camera::Viewport(0, 0, 200, 100), vm::vec3f::zero(), vm::vec3f::neg_z(), vm::vec3f::pos_y());
+
+            ASSERT_TRUE(c.frustumIntersects(vm::bbox3f(vm::vec3f(-10.0f, -10.0f, -1000.0f), vm::vec3f(10.0f, 10.0f, -900.0f))));
+            ASSERT_TRUE(c.frustumIntersects(vm::bbox3f(vm::vec3f(90.0f, 40.0f, -10.0f), vm::vec3f(110.0f, 60.0f, 10.0f))));
+            ASSERT_FALSE(c.frustumIntersects(vm::bbox3f(vm::vec3f(110.0f, -10.0f, -10.0f), vm::vec3f(120.0f, 10.0f, 10.0f))));
+            ASSERT_FALSE(c.frustumIntersects(vm::bbox3f(vm::vec3f(-10.0f, -70.0f, -10.0f), vm::vec3f(10.0f, -60.0f, 10.0f))));
+        }
     }
 }
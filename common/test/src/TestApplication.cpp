@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestApplication.h"
+
+#include "Ensure.h"
+
+#include <gtest/gtest.h>
+
+#include <clocale>
+
+namespace TrenchBroom {
+    TestApplication::TestApplication(int& argc, char** argv) :
+    m_app(argc, argv) {
+        View::setCrashReportGUIEnbled(false);
+
+        ensure(qApp == &m_app, "invalid app instance");
+
+        ::testing::InitGoogleTest(&argc, argv);
+
+        // set the locale to US so that we can parse floats attribute
+        std::setlocale(LC_NUMERIC, "C");
+    }
+
+    int TestApplication::runAllTests() {
+        return RUN_ALL_TESTS();
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TestApplication_h
+#define TrenchBroom_TestApplication_h
+
+#include "TrenchBroomApp.h"
+
+namespace TrenchBroom {
+    /**
+     * Sets up the application instance, gtest and the locale for running tests. Used by the test and benchmark
+     * executables. gtest removes its own arguments from the given command line, so the remaining arguments can be
+     * processed by the caller after this has been constructed.
+     */
+    class TestApplication {
+    private:
+        View::TrenchBroomApp m_app;
+    public:
+        TestApplication(int& argc, char** argv);
+
+        /**
+         * Runs all registered tests and returns the result of RUN_ALL_TESTS.
+         */
+        int runAllTests();
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "View/CellLayout.h"
+
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QVariant>
+
+namespace TrenchBroom {
+    namespace View {
+        using LayoutGroups = std::vector<std::pair<std::string, std::vector<int>>>;
+
+        static void initLayout(CellLayout& layout) {
+            layout.setWidth(300.0f);
+            layout.setOuterMargin(5.0f);
+            layout.setGroupMargin(5.0f);
+            layout.setRowMargin(15.0f);
+            layout.setCellMargin(10.0f);
+            layout.setTitleMargin(2.0f);
+            layout.setCellWidth(64.0f, 64.0f);
+            layout.setCellHeight(64.0f, 128.0f);
+        }
+
+        static void addItems(CellLayout& layout, const std::vector<int>& items, const size_t first) {
+            for (size_t i = first; i < items.size(); ++i) {
+                const int item = items[i];
+                // vary the item sizes so that the rows get different heights
+                const float size = static_cast<float>(16 * (item % 5 + 1));
+                layout.addItem(QVariant(item), size, size, 64.0f, 12.0f);
+            }
+        }
+
+        static void buildLayout(CellLayout& layout, const LayoutGroups& groups, const bool grouped) {
+            for (const auto& [name, items] : groups) {
+                if (grouped)
+                    layout.addGroup(name, 14.0f);
+                addItems(layout, items, 0);
+            }
+        }
+
+        static void assertBoundsEqual(const LayoutBounds& expected, const LayoutBounds& actual) {
+            ASSERT_EQ(expected.left(), actual.left());
+            ASSERT_EQ(expected.top(), actual.top());
+            ASSERT_EQ(expected.width(), actual.width());
+            ASSERT_EQ(expected.height(), actual.height());
+        }
+
+        static void assertLayoutsEqual(CellLayout& expected, CellLayout& actual) {
+            ASSERT_EQ(expected.height(), actual.height());
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                const LayoutGroup& expectedGroup = expected[i];
+                const LayoutGroup& actualGroup = actual[i];
+                ASSERT_EQ(expectedGroup.item(), actualGroup.item());
+                assertBoundsEqual(expectedGroup.bounds(), actualGroup.bounds());
+                ASSERT_EQ(expectedGroup.size(), actualGroup.size());
+                for (size_t j = 0; j < expectedGroup.size(); ++j) {
+                    const LayoutRow& expectedRow = expectedGroup[j];
+                    const LayoutRow& actualRow = actualGroup[j];
+                    assertBoundsEqual(expectedRow.bounds(), actualRow.bounds());
+                    ASSERT_EQ(expectedRow.size(), actualRow.size());
+                    for (size_t k = 0; k < expectedRow.size(); ++k) {
+                        ASSERT_EQ(expectedRow[k].item(), actualRow[k].item());
+                        assertBoundsEqual(expectedRow[k].cellBounds(), actualRow[k].cellBounds());
+                        assertBoundsEqual(expectedRow[k].itemBounds(), actualRow[k].itemBounds());
+                        assertBoundsEqual(expectedRow[k].titleBounds(), actualRow[k].titleBounds());
+                    }
+                }
+            }
+        }
+
+        TEST(CellLayoutTest, removeCellsFrom) {
+            const LayoutGroups oldGroups = {
+                { "a", { 1, 2, 3, 4, 5, 6, 7, 8, 9 } },
+                { "b", { 10, 11, 12 } },
+            };
+            const LayoutGroups newGroups = {
+                { "a", { 1, 2, 3, 4, 5, 9, 8, 7 } },
+                { "b", { 12, 11 } },
+                { "c", { 13 } },
+            };
+
+            for (const bool grouped : { true, false }) {
+                CellLayout expected;
+                initLayout(expected);
+                buildLayout(expected, grouped ? newGroups : LayoutGroups{ newGroups[0] }, grouped);
+
+                CellLayout actual;
+                initLayout(actual);
+                buildLayout(actual, grouped ? oldGroups : LayoutGroups{ oldGroups[0] }, grouped);
+
+                actual.removeCellsFrom(0u, 5u);
+                addItems(actual, newGroups[0].second, 5u);
+                if (grouped) {
+                    buildLayout(actual, LayoutGroups(std::next(std::begin(newGroups)), std::end(newGroups)), true);
+                }
+
+                assertLayoutsEqual(expected, actual);
+            }
+        }
+
+        TEST(CellLayoutTest, removeAllCells) {
+            CellLayout expected;
+            initLayout(expected);
+            buildLayout(expected, { { "", { 3, 2, 1 } } }, false);
+
+            CellLayout actual;
+            initLayout(actual);
+            buildLayout(actual, { { "", { 1, 2, 3, 4, 5 } } }, false);
+
+            actual.removeCellsFrom(0u, 0u);
+            addItems(actual, { 3, 2, 1 }, 0u);
+
+            assertLayoutsEqual(expected, actual);
+        }
+
+        TEST(CellLayoutTest, removeGroupsFrom) {
+            const LayoutGroups oldGroups = {
+                { "a", { 1, 2, 3 } },
+                { "b", { 4, 5, 6, 7, 8, 9, 10 } },
+                { "c", { 11 } },
+            };
+            const LayoutGroups newGroups = {
+                { "a", { 1, 2, 3 } },
+                { "c", { 11, 12 } },
+            };
+
+            CellLayout expected;
+            initLayout(expected);
+            buildLayout(expected, newGroups, true);
+
+            CellLayout actual;
+            initLayout(actual);
+            buildLayout(actual, oldGroups, true);
+
+            actual.removeGroupsFrom(1u);
+            buildLayout(actual, { newGroups[1] }, true);
+
+            assertLayoutsEqual(expected, actual);
+
+            actual.removeGroupsFrom(0u);
+            expected.clear();
+            assertLayoutsEqual(expected, actual);
+
+            buildLayout(expected, newGroups, true);
+            buildLayout(actual, newGroups, true);
+            assertLayoutsEqual(expected, actual);
+        }
+    }
+}
@@ -150,6 +150,55 @@ namespace TrenchBroom {
 
         const Command::CommandType TestCommand::Type = Command::freeType();
 
+        class SizedCommand : public UndoableCommand {
+        private:
+            size_t m_memoryUsage;
+            bool m_collatable;
+            bool m_compacted;
+        public:
+            static const CommandType Type;
+
+            SizedCommand(const std::string& name, const size_t memoryUsage, const bool collatable = false) :
+            UndoableCommand(Type, name),
+            m_memoryUsage(memoryUsage),
+            m_collatable(collatable),
+            m_compacted(false) {}
+
+            bool compacted() const {
+                return m_compacted;
+            }
+        private:
+            std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade*) override {
+                return std::make_unique<CommandResult>(true);
+            }
+
+            std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade*) override {
+                return std::make_unique<CommandResult>(true);
+            }
+
+            bool doIsRepeatable(MapDocumentCommandFacade*) const override {
+                return false;
+            }
+
+            bool doCollateWith(UndoableCommand* command) override {
+                if (!m_collatable || command->type() != Type) {
+                    return false;
+                }
+                m_memoryUsage += static_cast<SizedCommand*>(command)->m_memoryUsage;
+                return true;
+            }
+
+            size_t doGetMemoryUsage() const override {
+                return m_compacted ? m_memoryUsage / 2u : m_memoryUsage;
+            }
+
+            void doCompact() override {
+                m_compacted = true;
+            }
+        };
+
+        const Command::CommandType SizedCommand::Type = Command::freeType();
+
         TEST(CommandProcessorTest, doAndUndoSuccessfulCommand) {
             /*
              * Execute a successful command, then undo it successfully.
@@ -606,5 +655,69 @@ namespace TrenchBroom {
             ASSERT_EQ(commandName1, commandProcessor.undoCommandName());
             ASSERT_EQ(commandName2, commandProcessor.redoCommandName());
         }
+
+        TEST(CommandProcessorTest, compactAndDiscardCommandsOverMemoryBudget) {
+            CommandProcessor commandProcessor(nullptr);
+            commandProcessor.setMemoryBudget(250u);
+
+            auto command4 = std::make_unique<SizedCommand>("cmd4", 100u);
+            auto command5 = std::make_unique<SizedCommand>("cmd5", 100u);
+            auto* command4Ptr = command4.get();
+            auto* command5Ptr = command5.get();
+
+            commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd1", 100u));
+            commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd2", 100u));
+            ASSERT_EQ(200u, commandProcessor.memoryUsage());
+
+            // the oldest command is compacted to stay within the budget
+            commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd3", 100u));
+            ASSERT_EQ(250u, commandProcessor.memoryUsage());
+
+            commandProcessor.executeAndStore(std::move(command4));
+            ASSERT_EQ(250u, commandProcessor.memoryUsage());
+            ASSERT_FALSE(command4Ptr->compacted());
+
+            // compacting isn't enough anymore, so the oldest command is discarded and the newest is left alone
+            commandProcessor.executeAndStore(std::move(command5));
+            ASSERT_EQ(250u, commandProcessor.memoryUsage());
+            ASSERT_TRUE(command4Ptr->compacted());
+            ASSERT_FALSE(command5Ptr->compacted());
+
+            for (const auto* name : { "cmd5", "cmd4", "cmd3", "cmd2" }) {
+                ASSERT_EQ(name, commandProcessor.undoCommandName());
+                ASSERT_TRUE(commandProcessor.undo()->success());
+            }
+            ASSERT_FALSE(commandProcessor.canUndo());
+        }
+
+        TEST(CommandProcessorTest, trackMemoryUsageOfUndoAndRedoStacks) {
+            CommandProcessor commandProcessor(nullptr);
+            ASSERT_EQ(0u, commandProcessor.memoryUsage());
+
+            commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd1", 100u, true));
+            ASSERT_EQ(100u, commandProcessor.memoryUsage());
+
+            // the topmost command grows when another command is collated with it
+            commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd2", 50u));
+            ASSERT_EQ(150u, commandProcessor.memoryUsage());
+            ASSERT_EQ("cmd1", commandProcessor.undoCommandName());
+
+            // undone commands are counted on the redo stack
+            ASSERT_TRUE(commandProcessor.undo()->success());
+            ASSERT_EQ(150u, commandProcessor.memoryUsage());
+
+            ASSERT_TRUE(commandProcessor.redo()->success());
+            ASSERT_EQ(150u, commandProcessor.memoryUsage());
+
+            ASSERT_TRUE(commandProcessor.undo()->success());
+            ASSERT_EQ(150u, commandProcessor.memoryUsage());
+
+            // storing a new command clears the redo stack
+            commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd3", 20u));
+            ASSERT_EQ(20u, commandProcessor.memoryUsage());
+
+            commandProcessor.clear();
+            ASSERT_EQ(0u, commandProcessor.memoryUsage());
+        }
     }
 }
@@ -22,11 +22,21 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 #include "View/MapDocumentTest.h"
 
 #include "EL/VariableStore.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "Model/CompilationProfile.h"
 #include "Model/CompilationTask.h"
 #include "View/CompilationContext.h"
 #include "View/CompilationRunner.h"
+#include "View/CompilationVariables.h"
 #include "View/TextOutputAdapter.h"
 
+#include <kdl/string_utils.h>
+
+#include <memory>
+#include <string>
+
 #include <QEventLoop>
 #include <QObject>
 #include <QTextEdit>
@@ -83,5 +93,59 @@ namespace TrenchBroom {
             ASSERT_TRUE(exec.errored);
             ASSERT_FALSE(exec.ended);
         }
+
+#ifndef _WIN32
+        TEST_F(CompilationTaskRunnerTest, skipToolsWithUnchangedInputs) {
+            IO::TestEnvironment env("compilationrunnertest");
+            env.createFile(IO::Path("a.txt"), "a");
+            env.createFile(IO::Path("copy.sh"), "cp \"$1\" \"$2\"\necho \"$2\" >> log.txt\n");
+
+            EL::VariableTable variables;
+            variables.declare(CompilationVariableNames::WORK_DIR_PATH, EL::Value(env.dir().asString()));
+
+            // the first and the last task can run at the same time, the second one depends on the first one
+            Model::CompilationProfile profile("profile", env.dir().asString());
+            profile.addTask(std::make_unique<Model::CompilationRunTool>("/bin/sh", "copy.sh a.txt b.txt", "a.txt", "b.txt"));
+            profile.addTask(std::make_unique<Model::CompilationRunTool>("/bin/sh", "copy.sh b.txt c.txt", "b.txt", "c.txt"));
+            profile.addTask(std::make_unique<Model::CompilationRunTool>("/bin/sh", "copy.sh a.txt d.txt", "a.txt", "d.txt"));
+
+            const auto compile = [&]() {
+                QTextEdit output;
+                TextOutputAdapter outputAdapter(&output);
+
+                auto context = std::make_unique<CompilationContext>(document, variables, outputAdapter, false);
+                CompilationRunner runner(std::move(context), &profile, 2u, env.dir() + IO::Path("profile.tbcompile"));
+
+                QEventLoop loop;
+                QObject::connect(&runner, &CompilationRunner::compilationEnded, &loop, &QEventLoop::quit);
+                QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+
+                runner.execute();
+                if (runner.running()) {
+                    loop.exec();
+                }
+                ASSERT_FALSE(runner.running());
+            };
+
+            const auto runCount = [&]() {
+                return kdl::str_split(IO::Disk::readFile(env.dir() + IO::Path("log.txt")), "\n").size();
+            };
+
+            compile();
+            ASSERT_EQ(3u, runCount());
+            ASSERT_TRUE(env.fileExists(IO::Path("c.txt")));
+
+            compile();
+            ASSERT_EQ(3u, runCount());
+
+            env.createFile(IO::Path("a.txt"), "changed");
+            compile();
+            ASSERT_EQ(6u, runCount());
+
+            IO::Disk::deleteFile(env.dir() + IO::Path("d.txt"));
+            compile();
+            ASSERT_EQ(7u, runCount());
+        }
+#endif
     }
 }
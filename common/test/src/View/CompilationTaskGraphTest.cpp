@@ -0,0 +1,150 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "View/CompilationTaskGraph.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        static CompilationTaskFiles taskFiles(const std::vector<std::string>& inputs, const std::vector<std::string>& outputs) {
+            CompilationTaskFiles result{ true, {}, {} };
+            for (const auto& input : inputs) {
+                result.inputs.push_back(IO::Path(input));
+            }
+            for (const auto& output : outputs) {
+                result.outputs.push_back(IO::Path(output));
+            }
+            return result;
+        }
+
+        TEST(CompilationTaskGraphTest, parsePaths) {
+            ASSERT_EQ((std::vector<IO::Path>{ IO::Path("/work/a.bsp"), IO::Path("/maps/b.bsp") }),
+                      CompilationTaskGraph::parsePaths("a.bsp; /maps/b.bsp;;", IO::Path("/work")));
+            ASSERT_TRUE(CompilationTaskGraph::parsePaths(" ", IO::Path("/work")).empty());
+        }
+
+        TEST(CompilationTaskGraphTest, overlaps) {
+            ASSERT_TRUE(CompilationTaskGraph::overlaps(IO::Path("/work/a.bsp"), IO::Path("/work/a.bsp")));
+            ASSERT_TRUE(CompilationTaskGraph::overlaps(IO::Path("/work"), IO::Path("/work/a.bsp")));
+            ASSERT_TRUE(CompilationTaskGraph::overlaps(IO::Path("/work/*.bsp"), IO::Path("/work/a.bsp")));
+            ASSERT_TRUE(CompilationTaskGraph::overlaps(IO::Path("/work/a.bsp"), IO::Path("/work/*.bsp")));
+            ASSERT_FALSE(CompilationTaskGraph::overlaps(IO::Path("/work/a.bsp"), IO::Path("/work/a.lit")));
+            ASSERT_FALSE(CompilationTaskGraph::overlaps(IO::Path("/work/*.bsp"), IO::Path("/work/a.lit")));
+            ASSERT_FALSE(CompilationTaskGraph::overlaps(IO::Path("/work/*.bsp"), IO::Path("/other/a.bsp")));
+        }
+
+        TEST(CompilationTaskGraphTest, independentVariantsHaveNoDependencies) {
+            const auto tasks = std::vector<CompilationTaskFiles>{
+                taskFiles({}, { "/work/a.map" }),
+                taskFiles({ "/work/a.map" }, { "/work/a.bsp" }),
+                taskFiles({ "/work/a.bsp" }, { "/work/a-fast.bsp" }),
+                taskFiles({ "/work/a.bsp" }, { "/work/a-full.bsp" }),
+                taskFiles({ "/work/a-*.bsp" }, { "/quake/maps" })
+            };
+
+            ASSERT_EQ((std::vector<std::vector<size_t>>{
+                {},
+                { 0u },
+                { 1u },
+                { 1u },
+                { 2u, 3u }
+            }), CompilationTaskGraph::dependencies(tasks));
+        }
+
+        TEST(CompilationTaskGraphTest, writingAFileThatWasReadBeforeIsADependency) {
+            const auto tasks = std::vector<CompilationTaskFiles>{
+                taskFiles({ "/work/a.bsp" }, { "/work/a.prt" }),
+                taskFiles({ "/work/a.map" }, { "/work/a.bsp" }),
+                taskFiles({ "/work/b.map" }, { "/work/a.bsp" })
+            };
+
+            ASSERT_EQ((std::vector<std::vector<size_t>>{
+                {},
+                { 0u },
+                { 0u, 1u }
+            }), CompilationTaskGraph::dependencies(tasks));
+        }
+
+        TEST(CompilationTaskGraphTest, undeclaredTaskIsABarrier) {
+            const auto tasks = std::vector<CompilationTaskFiles>{
+                taskFiles({ "/work/a.map" }, { "/work/a.bsp" }),
+                CompilationTaskFiles{ false, {}, {} },
+                taskFiles({ "/work/b.map" }, { "/work/b.bsp" })
+            };
+
+            // the last task only depends on the first one through the undeclared task
+            ASSERT_EQ((std::vector<std::vector<size_t>>{
+                {},
+                { 0u },
+                { 1u }
+            }), CompilationTaskGraph::dependencies(tasks));
+        }
+
+        TEST(CompilationTaskGraphTest, externalInputs) {
+            const auto tasks = std::vector<CompilationTaskFiles>{
+                taskFiles({}, { "/work/a.map" }),
+                taskFiles({ "/work/a.map", "/work/a.cfg" }, { "/work/a.bsp" })
+            };
+
+            ASSERT_EQ((std::vector<IO::Path>{ IO::Path("/work/a.cfg") }), CompilationTaskGraph::externalInputs(tasks, 1u));
+        }
+
+        TEST(CompilationStateTest, hashFiles) {
+            IO::TestEnvironment env("compilationstatetest");
+            env.createFile(IO::Path("a.bsp"), "some data");
+            env.createFile(IO::Path("b.bsp"), "other data");
+
+            const auto paths = std::vector<IO::Path>{ env.dir() + IO::Path("*.bsp") };
+            const auto hash = CompilationState::hashFiles(paths);
+            ASSERT_EQ(hash, CompilationState::hashFiles({ env.dir() + IO::Path("b.bsp"), env.dir() + IO::Path("a.bsp") }));
+            ASSERT_EQ(hash, CompilationState::hashFiles({ env.dir() }));
+
+            env.createFile(IO::Path("b.bsp"), "changed data");
+            ASSERT_NE(hash, CompilationState::hashFiles(paths));
+
+            IO::Disk::deleteFile(env.dir() + IO::Path("b.bsp"));
+            ASSERT_NE(hash, CompilationState::hashFiles(paths));
+        }
+
+        TEST(CompilationStateTest, saveAndLoad) {
+            IO::TestEnvironment env("compilationstatetest");
+            const auto statePath = env.dir() + IO::Path("a.tbcompile");
+
+            CompilationState state;
+            state.taskSucceeded("qbsp a.map", 1u);
+            state.taskSucceeded("light a.bsp", 2u);
+            state.taskStarted("light a.bsp");
+            state.save(statePath);
+
+            const auto loaded = CompilationState::load(statePath);
+            ASSERT_TRUE(loaded.upToDate("qbsp a.map", 1u));
+            ASSERT_FALSE(loaded.upToDate("qbsp a.map", 2u));
+            ASSERT_FALSE(loaded.upToDate("light a.bsp", 2u));
+
+            ASSERT_FALSE(CompilationState::load(env.dir() + IO::Path("missing.tbcompile")).upToDate("qbsp a.map", 1u));
+        }
+    }
+}
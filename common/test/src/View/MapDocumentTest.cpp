@@ -22,6 +22,11 @@
 #include "Exceptions.h"
 #include "TestUtils.h"
 #include "Assets/EntityDefinition.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
 #include "Model/Brush.h"
 #include "Model/Entity.h"
 #include "Model/Group.h"
@@ -44,6 +49,10 @@
 #include <vecmath/scalar.h>
 #include <vecmath/ray.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace TrenchBroom {
     namespace View {
         MapDocumentTest::MapDocumentTest() :
@@ -949,5 +958,74 @@ namespace TrenchBroom {
             ASSERT_TRUE(document->translateObjects(delta));
             ASSERT_EQ(box.translate(delta), document->selectionBounds());
         }
+
+        TEST_F(MapDocumentTest, exportSelectionRegion) {
+            IO::TestEnvironment env("export_region_test");
+
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            const auto region = vm::bbox3(vm::vec3(-128, -128, -128), vm::vec3(128, 128, 128));
+
+            // the brush drawn around the area to compile defines the region, but must not be exported
+            auto* regionBrush = builder.createCuboid(region, "region");
+            auto* insideBrush = builder.createCube(32.0, "inside");
+            auto* outsideBrush = builder.createCuboid(vm::bbox3(vm::vec3(256, 256, 256), vm::vec3(320, 320, 320)), "outside");
+            auto* crossingBrush = builder.createCuboid(vm::bbox3(vm::vec3(96, 0, 0), vm::vec3(160, 32, 32)), "crossing");
+            document->addNode(regionBrush, document->currentParent());
+            document->addNode(insideBrush, document->currentParent());
+            document->addNode(outsideBrush, document->currentParent());
+            document->addNode(crossingBrush, document->currentParent());
+
+            auto* playerStart = new Model::Entity();
+            playerStart->addOrUpdateAttribute("classname", "info_player_start");
+            playerStart->addOrUpdateAttribute("origin", "0 0 64");
+            document->addNode(playerStart, document->currentParent());
+
+            document->select(regionBrush);
+            ASSERT_EQ(region, document->selectionBounds());
+
+            const auto path = env.dir() + IO::Path("region.map");
+            document->exportSelectionRegionTo("seal", path);
+
+            IO::TestParserStatus status;
+            IO::WorldReader reader(IO::Disk::readFile(path));
+            auto world = reader.read(Model::MapFormat::Standard, document->worldBounds(), status);
+
+            std::vector<std::string> textures;
+            std::vector<vm::bbox3> sealBounds;
+            std::vector<Model::Entity*> entities;
+            for (auto* node : world->defaultLayer()->children()) {
+                if (auto* brush = dynamic_cast<Model::Brush*>(node)) {
+                    const auto& textureName = brush->faces().front()->textureName();
+                    textures.push_back(textureName);
+                    if (textureName == "seal") {
+                        sealBounds.push_back(brush->logicalBounds());
+                    }
+                } else if (auto* entity = dynamic_cast<Model::Entity*>(node)) {
+                    entities.push_back(entity);
+                }
+            }
+
+            ASSERT_EQ(std::vector<std::string>({ "inside", "seal", "seal", "seal", "seal", "seal", "seal" }), textures);
+
+            // the point entity is exported and lies within the sealed region
+            ASSERT_EQ(1u, entities.size());
+            ASSERT_EQ("info_player_start", entities.front()->classname());
+            ASSERT_TRUE(region.contains(entities.front()->logicalBounds()));
+
+            // the seal brushes enclose the region without reaching into it
+            for (const auto& bounds : sealBounds) {
+                ASSERT_FALSE(bounds.intersects(region.expand(-1.0)));
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                const auto below = std::count_if(std::begin(sealBounds), std::end(sealBounds), [&](const auto& bounds) { return bounds.max[i] == region.min[i] && bounds.min[(i + 1u) % 3u] < region.min[(i + 1u) % 3u]; });
+                const auto above = std::count_if(std::begin(sealBounds), std::end(sealBounds), [&](const auto& bounds) { return bounds.min[i] == region.max[i] && bounds.max[(i + 1u) % 3u] > region.max[(i + 1u) % 3u]; });
+                ASSERT_EQ(1, below);
+                ASSERT_EQ(1, above);
+            }
+        }
     }
 }
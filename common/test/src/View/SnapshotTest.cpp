@@ -59,5 +59,32 @@ namespace TrenchBroom {
             for (Model::BrushFace* face : brush->faces())
                 ASSERT_EQ(texture, face->texture());
         }
+
+        TEST_F(SnapshotTest, restoreSharedGeometry) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            const auto originalBounds = brush->logicalBounds();
+            const auto originalVertices = brush->vertexPositions();
+
+            document->translateObjects(vm::vec3(16, 0, 0));
+            ASSERT_EQ(originalBounds.translate(vm::vec3(16, 0, 0)), brush->logicalBounds());
+            ASSERT_LT(0u, document->undoMemoryUsage());
+
+            document->undoCommand();
+            ASSERT_EQ(originalBounds, brush->logicalBounds());
+            ASSERT_EQ(originalVertices, brush->vertexPositions());
+            for (const Model::BrushFace* face : brush->faces()) {
+                ASSERT_NE(nullptr, face->geometry());
+                ASSERT_EQ(brush, face->brush());
+            }
+
+            document->redoCommand();
+            ASSERT_EQ(originalBounds.translate(vm::vec3(16, 0, 0)), brush->logicalBounds());
+
+            document->undoCommand();
+            ASSERT_EQ(originalBounds, brush->logicalBounds());
+        }
     }
 }
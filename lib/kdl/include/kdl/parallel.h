@@ -0,0 +1,263 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef KDL_PARALLEL_H
+#define KDL_PARALLEL_H
+
+#include <algorithm> // for std::min, std::max
+#include <condition_variable>
+#include <cstddef> // for std::size_t
+#include <deque>
+#include <exception> // for std::exception_ptr
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits> // for std::invoke_result_t
+#include <utility> // for std::move
+#include <vector>
+
+namespace kdl {
+    /**
+     * Returns the number of threads to use for parallel work, which is the number of hardware threads, but at least 1.
+     */
+    inline std::size_t parallel_thread_count() {
+        return std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(1u));
+    }
+
+    /**
+     * A fixed set of worker threads that execute submitted tasks in submission order. The threads are started when the
+     * pool is created and joined when it is destroyed, after all pending tasks have been executed.
+     */
+    class thread_pool {
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::thread> m_threads;
+        bool m_stop;
+    public:
+        /**
+         * Creates a pool with the given number of worker threads.
+         */
+        explicit thread_pool(const std::size_t thread_count) :
+        m_stop(false) {
+            m_threads.reserve(thread_count);
+            for (std::size_t i = 0u; i < thread_count; ++i) {
+                m_threads.emplace_back([this]() { work(); });
+            }
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        /**
+         * Returns the number of worker threads.
+         */
+        std::size_t thread_count() const {
+            return m_threads.size();
+        }
+
+        /**
+         * Queues the given task for execution by a worker thread. The task must not throw.
+         */
+        void submit(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_condition.notify_one();
+        }
+
+        /**
+         * Removes the oldest pending task from the queue and executes it on the calling thread.
+         *
+         * @return true if a task was executed and false if the queue was empty
+         */
+        bool run_pending_task() {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_tasks.empty()) {
+                    return false;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+            return true;
+        }
+
+        /**
+         * Indicates whether the calling thread is a worker thread of any pool.
+         */
+        static bool is_worker_thread() {
+            return worker_flag();
+        }
+    private:
+        static bool& worker_flag() {
+            thread_local bool is_worker = false;
+            return is_worker;
+        }
+
+        void work() {
+            worker_flag() = true;
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                    if (m_tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+    };
+
+    /**
+     * Returns the pool used by parallel_for. It is created on first use with one thread less than
+     * parallel_thread_count(), because the calling thread always takes part in the work, and it lives until the
+     * program exits.
+     */
+    inline thread_pool& shared_thread_pool() {
+        static thread_pool pool(parallel_thread_count() - 1u);
+        return pool;
+    }
+
+    /**
+     * Calls the given function for every index in [0, count). The indices are split into contiguous ranges which are
+     * processed by the threads of the shared thread pool, and the calling thread processes the first range itself.
+     * While it waits for the other ranges, the calling thread executes pending tasks of the pool. No threads are
+     * created by this function.
+     *
+     * All indices are processed on the calling thread if count is smaller than the given minimum count per thread
+     * times two, if there is only one hardware thread, or if this function is called from a worker thread of the pool.
+     *
+     * The function is called with a single index. It must be safe to call it concurrently for different indices.
+     *
+     * If any call throws an exception, the remaining indices of the throwing range are skipped and the exception is
+     * rethrown on the calling thread once all ranges have finished. If several calls throw, only one of the
+     * exceptions is rethrown.
+     *
+     * @tparam L the type of the function
+     * @param count the number of indices
+     * @param lambda the function to call
+     * @param min_count_per_thread the minimum number of indices each thread should process
+     */
+    template <typename L>
+    void parallel_for(const std::size_t count, L&& lambda, const std::size_t min_count_per_thread = 1u) {
+        const auto max_threads = count / std::max(min_count_per_thread, static_cast<std::size_t>(1u));
+        const auto thread_count = std::min(parallel_thread_count(), max_threads);
+        if (thread_count < 2u || thread_pool::is_worker_thread()) {
+            for (std::size_t i = 0u; i < count; ++i) {
+                lambda(i);
+            }
+            return;
+        }
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::size_t pending = thread_count - 1u;
+        std::exception_ptr exception;
+
+        const auto process_range = [&](const std::size_t first, const std::size_t last) {
+            try {
+                for (std::size_t i = first; i < last; ++i) {
+                    lambda(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+        };
+
+        auto& pool = shared_thread_pool();
+        for (std::size_t t = 1u; t < thread_count; ++t) {
+            const auto first = t * count / thread_count;
+            const auto last = (t + 1u) * count / thread_count;
+            pool.submit([&, first, last]() {
+                process_range(first, last);
+
+                // notify while holding the lock, the waiting thread may destroy the condition variable once it sees
+                // that no ranges are pending
+                std::lock_guard<std::mutex> lock(mutex);
+                --pending;
+                finished.notify_one();
+            });
+        }
+
+        process_range(0u, count / thread_count);
+
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending == 0u) {
+                    break;
+                }
+            }
+            if (!pool.run_pending_task()) {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished.wait(lock, [&]() { return pending == 0u; });
+                break;
+            }
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    /**
+     * Applies the given function to every element of the given vector in parallel and returns a vector containing the
+     * results in the order of the given elements. See parallel_for for a description of how the work is distributed.
+     *
+     * @tparam T the type of the vector elements
+     * @tparam A the vector's allocator type
+     * @tparam L the type of the function
+     * @param v the vector
+     * @param lambda the function to apply
+     * @param min_count_per_thread the minimum number of elements each thread should process
+     * @return a vector containing the results
+     */
+    template <typename T, typename A, typename L>
+    auto parallel_transform(const std::vector<T, A>& v, L&& lambda, const std::size_t min_count_per_thread = 1u) {
+        using R = std::invoke_result_t<L, const T&>;
+
+        std::vector<R> result(v.size());
+        parallel_for(v.size(), [&](const std::size_t i) {
+            result[i] = lambda(v[i]);
+        }, min_count_per_thread);
+        return result;
+    }
+}
+
+#endif //KDL_PARALLEL_H
@@ -0,0 +1,120 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include "kdl/parallel.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kdl {
+    TEST(parallel_test, parallel_for_empty) {
+        std::atomic<std::size_t> calls(0u);
+        parallel_for(0u, [&](const std::size_t) { ++calls; });
+        ASSERT_EQ(0u, calls.load());
+    }
+
+    TEST(parallel_test, parallel_for_visits_every_index_once) {
+        for (const std::size_t count : { 1u, 2u, 3u, 17u, 1000u }) {
+            std::vector<int> visits(count, 0);
+            parallel_for(count, [&](const std::size_t i) { ++visits[i]; });
+            ASSERT_EQ(std::vector<int>(count, 1), visits);
+        }
+    }
+
+    TEST(parallel_test, parallel_for_min_count_per_thread) {
+        const auto caller = std::this_thread::get_id();
+        bool other_thread = false;
+        parallel_for(10u, [&](const std::size_t) {
+            if (std::this_thread::get_id() != caller) {
+                other_thread = true;
+            }
+        }, 10u);
+        ASSERT_FALSE(other_thread);
+    }
+
+    TEST(parallel_test, parallel_for_rethrows) {
+        ASSERT_THROW(parallel_for(1000u, [](const std::size_t i) {
+            if (i == 999u) {
+                throw std::runtime_error("fail");
+            }
+        }), std::runtime_error);
+    }
+
+    TEST(parallel_test, parallel_for_reuses_pool_threads) {
+        std::mutex mutex;
+        std::set<std::thread::id> thread_ids;
+        for (std::size_t i = 0u; i < 10u; ++i) {
+            parallel_for(1000u, [&](const std::size_t) {
+                std::lock_guard<std::mutex> lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+            });
+        }
+        ASSERT_LE(thread_ids.size(), shared_thread_pool().thread_count() + 1u);
+    }
+
+    TEST(parallel_test, parallel_for_nested) {
+        std::vector<std::atomic<std::size_t>> visits(100u);
+        parallel_for(100u, [&](const std::size_t i) {
+            parallel_for(100u, [&](const std::size_t) { ++visits[i]; });
+        });
+        for (const auto& v : visits) {
+            ASSERT_EQ(100u, v.load());
+        }
+    }
+
+    TEST(parallel_test, thread_pool_runs_submitted_tasks) {
+        std::atomic<std::size_t> calls(0u);
+        {
+            thread_pool pool(2u);
+            ASSERT_EQ(2u, pool.thread_count());
+            for (std::size_t i = 0u; i < 100u; ++i) {
+                pool.submit([&]() { ++calls; });
+            }
+        }
+        ASSERT_EQ(100u, calls.load());
+    }
+
+    TEST(parallel_test, thread_pool_run_pending_task) {
+        thread_pool pool(0u);
+        ASSERT_FALSE(pool.run_pending_task());
+
+        bool called = false;
+        pool.submit([&]() { called = true; });
+        ASSERT_TRUE(pool.run_pending_task());
+        ASSERT_TRUE(called);
+        ASSERT_FALSE(pool.run_pending_task());
+    }
+
+    TEST(parallel_test, parallel_transform) {
+        ASSERT_EQ(std::vector<std::string>(), parallel_transform(std::vector<int>(), [](const int i) { return std::to_string(i); }));
+
+        std::vector<int> v;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+            expected.push_back(std::to_string(i * 2));
+        }
+        ASSERT_EQ(expected, parallel_transform(v, [](const int i) { return std::to_string(i * 2); }));
+    }
+}